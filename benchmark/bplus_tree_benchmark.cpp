@@ -0,0 +1,210 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/index/bplus_tree.h"
+
+/**
+ * @brief BplusTreeHandler 插入、等值查找和全量扫描的开销
+ * @details 参数是键的类型和索引中的键值个数。键按照固定的随机种子打乱顺序插入，每次运行的结果可以复现。
+ * 索引的页面都在缓冲池中，不包含IO。
+ */
+
+static const char *INDEX_FILE = "bplus_tree_benchmark.index";
+static const int CHARS_KEY_LENGTH = 16;
+
+static int key_length(AttrType type) { return type == CHARS ? CHARS_KEY_LENGTH : 4; }
+
+/**
+ * @brief 生成 count 个不重复的键，顺序是打乱的
+ */
+static std::vector<std::string> make_keys(AttrType type, int count)
+{
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (int i = 0; i < count; i++) {
+    std::string key(key_length(type), '\0');
+    switch (type) {
+      case INTS: {
+        memcpy(key.data(), &i, sizeof(i));
+      } break;
+      case FLOATS: {
+        const float f = i * 0.5f;
+        memcpy(key.data(), &f, sizeof(f));
+      } break;
+      case CHARS: {
+        snprintf(key.data(), key.size(), "%0*d", CHARS_KEY_LENGTH - 1, i);
+      } break;
+      default: {
+      } break;
+    }
+    keys.emplace_back(std::move(key));
+  }
+
+  std::mt19937 random(20240101);
+  std::shuffle(keys.begin(), keys.end(), random);
+  return keys;
+}
+
+static RID make_rid(int i) { return RID(i / 100 + 1, i % 100); }
+
+/**
+ * @brief 在一个独立的缓冲池中创建索引
+ */
+class BplusTreeFixture
+{
+public:
+  RC create(AttrType type)
+  {
+    ::remove(INDEX_FILE);
+    bpm_ = new BufferPoolManager();
+    BufferPoolManager::set_instance(bpm_);
+    return handler_.create(INDEX_FILE, false /*is_unique*/, {type}, {key_length(type)});
+  }
+
+  RC insert(const std::vector<std::string> &keys)
+  {
+    RC rc = RC::SUCCESS;
+    for (int i = 0; i < static_cast<int>(keys.size()) && rc == RC::SUCCESS; i++) {
+      const char *multi_keys[] = {keys[i].data()};
+      const RID rid = make_rid(i);
+      rc = handler_.insert_entry(multi_keys, &rid);
+    }
+    return rc;
+  }
+
+  void destroy()
+  {
+    handler_.close();
+    BufferPoolManager::set_instance(nullptr);
+    delete bpm_;
+    bpm_ = nullptr;
+    ::remove(INDEX_FILE);
+  }
+
+  BplusTreeHandler &handler() { return handler_; }
+
+private:
+  BufferPoolManager *bpm_ = nullptr;
+  BplusTreeHandler handler_;
+};
+
+static void set_label(benchmark::State &state, AttrType type) { state.SetLabel(attr_type_to_string(type)); }
+
+/**
+ * @brief 每轮向一个新的索引中插入所有的键
+ */
+static void BM_BplusTreeInsert(benchmark::State &state)
+{
+  const AttrType type = static_cast<AttrType>(state.range(0));
+  const std::vector<std::string> keys = make_keys(type, static_cast<int>(state.range(1)));
+  set_label(state, type);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    BplusTreeFixture fixture;
+    RC rc = fixture.create(type);
+    state.ResumeTiming();
+
+    if (rc == RC::SUCCESS) {
+      rc = fixture.insert(keys);
+    }
+
+    state.PauseTiming();
+    fixture.destroy();
+    state.ResumeTiming();
+
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError(strrc(rc));
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static void BM_BplusTreeLookup(benchmark::State &state)
+{
+  const AttrType type = static_cast<AttrType>(state.range(0));
+  const std::vector<std::string> keys = make_keys(type, static_cast<int>(state.range(1)));
+  set_label(state, type);
+
+  BplusTreeFixture fixture;
+  RC rc = fixture.create(type);
+  if (rc == RC::SUCCESS) {
+    rc = fixture.insert(keys);
+  }
+
+  size_t index = 0;
+  std::list<RID> rids;
+  for (auto _ : state) {
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+    rids.clear();
+    const char *multi_keys[] = {keys[index].data()};
+    rc = fixture.handler().get_entry(multi_keys, rids);
+    if (rc == RC::SUCCESS && rids.size() != 1) {
+      rc = RC::NOTFOUND;
+    }
+    index = (index + 1) % keys.size();
+  }
+  if (rc != RC::SUCCESS) {
+    state.SkipWithError(strrc(rc));
+  }
+  state.SetItemsProcessed(state.iterations());
+  fixture.destroy();
+}
+
+/**
+ * @brief 从最左边的叶子开始扫描整个索引
+ */
+static void BM_BplusTreeScan(benchmark::State &state)
+{
+  const AttrType type = static_cast<AttrType>(state.range(0));
+  const std::vector<std::string> keys = make_keys(type, static_cast<int>(state.range(1)));
+  set_label(state, type);
+
+  BplusTreeFixture fixture;
+  RC rc = fixture.create(type);
+  if (rc == RC::SUCCESS) {
+    rc = fixture.insert(keys);
+  }
+
+  for (auto _ : state) {
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+    BplusTreeScanner scanner(fixture.handler());
+    rc = scanner.open(nullptr, 0, false, nullptr, 0, false);
+    size_t count = 0;
+    RID rid;
+    while (rc == RC::SUCCESS && (rc = scanner.next_entry(rid)) == RC::SUCCESS) {
+      count++;
+    }
+    if (rc == RC::RECORD_EOF) {
+      rc = count == keys.size() ? RC::SUCCESS : RC::INTERNAL;
+    }
+    scanner.close();
+  }
+  if (rc != RC::SUCCESS) {
+    state.SkipWithError(strrc(rc));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+  fixture.destroy();
+}
+
+static void bplus_tree_args(benchmark::internal::Benchmark *b)
+{
+  b->ArgsProduct({{INTS, FLOATS, CHARS}, {1000, 10000}});
+}
+
+BENCHMARK(BM_BplusTreeInsert)->Apply(bplus_tree_args);
+BENCHMARK(BM_BplusTreeLookup)->Apply(bplus_tree_args);
+BENCHMARK(BM_BplusTreeScan)->Apply(bplus_tree_args);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include <unistd.h>
+
+#include "include/storage_engine/buffer/buffer_pool.h"
+
+/**
+ * @brief FileBufferPool::get_this_page 命中和未命中的开销
+ * @details 未命中时从文件读取页面，文件刚刚写过，读取的数据一般都在操作系统的页缓存中，
+ * 所以测量的是缓冲池本身的开销加上一次 read 系统调用，不包含真正的磁盘IO。
+ * 页帧总是足够多，不会触发驱逐。
+ */
+
+static const char *DATA_FILE = "buffer_pool_benchmark.data";
+static const int MAX_THREADS = 16;
+static const int HOT_PAGES = 64;
+
+/**
+ * @brief 创建一个包含 page_num 个数据页的文件，数据页都是0
+ */
+static RC create_data_file(int page_num)
+{
+  ::remove(DATA_FILE);
+  BufferPoolManager bpm;
+  RC rc = bpm.create_file(DATA_FILE);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  if (truncate(DATA_FILE, (off_t)(page_num + 1) * BP_PAGE_SIZE) != 0) {
+    return RC::IOERR_WRITE;
+  }
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 能够容纳 page_num 个页面以及文件头的缓冲池
+ */
+static BufferPoolManager *create_buffer_pool_manager(int page_num)
+{
+  const int pool_num = page_num / DEFAULT_ITEM_NUM_PER_POOL + 2;
+  return new BufferPoolManager(pool_num * DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE);
+}
+
+static BufferPoolManager *hit_bpm = nullptr;
+static FileBufferPool *hit_bp = nullptr;
+
+static void open_hot_pages(const benchmark::State &)
+{
+  create_data_file(HOT_PAGES);
+  hit_bpm = create_buffer_pool_manager(HOT_PAGES);
+  hit_bpm->open_file(DATA_FILE, hit_bp);
+  for (PageNum page_num = 1; page_num <= HOT_PAGES; page_num++) {
+    Frame *frame = nullptr;
+    hit_bp->get_this_page(page_num, &frame);
+    hit_bp->unpin_page(frame);
+  }
+}
+
+static void close_hot_pages(const benchmark::State &)
+{
+  delete hit_bpm;
+  hit_bpm = nullptr;
+  hit_bp = nullptr;
+  ::remove(DATA_FILE);
+}
+
+static void BM_GetThisPageHit(benchmark::State &state)
+{
+  PageNum page_num = 1 + state.thread_index() % HOT_PAGES;
+  for (auto _ : state) {
+    Frame *frame = nullptr;
+    RC rc = hit_bp->get_this_page(page_num, &frame);
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError(strrc(rc));
+      break;
+    }
+    benchmark::DoNotOptimize(frame->data());
+    hit_bp->unpin_page(frame);
+    page_num = page_num % HOT_PAGES + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetThisPageHit)
+    ->Setup(open_hot_pages)
+    ->Teardown(close_hot_pages)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
+
+/**
+ * @brief 每轮使用一个新的缓冲池顺序读取所有的页面，每个页面都不在内存中
+ */
+static void BM_GetThisPageMiss(benchmark::State &state)
+{
+  const int page_count = static_cast<int>(state.range(0));
+  RC rc = create_data_file(page_count);
+  if (rc != RC::SUCCESS) {
+    state.SkipWithError(strrc(rc));
+    return;
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    BufferPoolManager *bpm = create_buffer_pool_manager(page_count);
+    FileBufferPool *bp = nullptr;
+    rc = bpm->open_file(DATA_FILE, bp);
+    state.ResumeTiming();
+
+    for (PageNum page_num = 1; rc == RC::SUCCESS && page_num <= page_count; page_num++) {
+      Frame *frame = nullptr;
+      rc = bp->get_this_page(page_num, &frame);
+      if (rc == RC::SUCCESS) {
+        bp->unpin_page(frame);
+      }
+    }
+
+    state.PauseTiming();
+    delete bpm;
+    state.ResumeTiming();
+
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError(strrc(rc));
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * page_count);
+  state.SetBytesProcessed(state.iterations() * page_count * BP_PAGE_SIZE);
+  ::remove(DATA_FILE);
+}
+BENCHMARK(BM_GetThisPageMiss)->Arg(256)->Arg(1024)->Arg(4096);
+
+BENCHMARK_MAIN();
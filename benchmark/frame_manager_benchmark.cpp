@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include "include/storage_engine/buffer/frame_manager.h"
+
+/**
+ * @brief FrameManager 在多线程下 alloc/free 和 get 的吞吐
+ * @details 每个线程使用自己的文件描述符，访问固定数量的页面，页帧足够多，不会触发驱逐。
+ * 多个线程之间竞争的是 FrameManager 的锁和内存池的锁。
+ */
+
+static const int MAX_THREADS = 16;
+static const int PAGES_PER_THREAD = 64;
+static const int POOL_NUM = MAX_THREADS * PAGES_PER_THREAD / DEFAULT_ITEM_NUM_PER_POOL + 1;
+
+static FrameManager *frame_manager = nullptr;
+
+static void create_frame_manager(const benchmark::State &)
+{
+  frame_manager = new FrameManager("Benchmark");
+  frame_manager->init(POOL_NUM);
+}
+
+static void destroy_frame_manager(const benchmark::State &)
+{
+  delete frame_manager;
+  frame_manager = nullptr;
+}
+
+/**
+ * @brief 为每个线程提前分配好页帧，get 时都能命中
+ */
+static void create_frame_manager_with_frames(const benchmark::State &state)
+{
+  create_frame_manager(state);
+  for (int file_desc = 0; file_desc < MAX_THREADS; file_desc++) {
+    for (PageNum page_num = 0; page_num < PAGES_PER_THREAD; page_num++) {
+      Frame *frame = frame_manager->alloc(file_desc, page_num);
+      frame->set_file_desc(file_desc);
+      frame->unpin();
+    }
+  }
+}
+
+static void destroy_frame_manager_with_frames(const benchmark::State &state)
+{
+  for (int file_desc = 0; file_desc < MAX_THREADS; file_desc++) {
+    for (PageNum page_num = 0; page_num < PAGES_PER_THREAD; page_num++) {
+      Frame *frame = frame_manager->get(file_desc, page_num);
+      frame_manager->free(file_desc, page_num, frame);
+    }
+  }
+  destroy_frame_manager(state);
+}
+
+static void BM_FrameManagerAllocFree(benchmark::State &state)
+{
+  const int file_desc = state.thread_index();
+  PageNum page_num = 0;
+  for (auto _ : state) {
+    Frame *frame = frame_manager->alloc(file_desc, page_num);
+    if (frame == nullptr) {
+      state.SkipWithError("no free frame");
+      break;
+    }
+    frame_manager->free(file_desc, page_num, frame);
+    page_num = (page_num + 1) % PAGES_PER_THREAD;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameManagerAllocFree)
+    ->Setup(create_frame_manager)
+    ->Teardown(destroy_frame_manager)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
+
+static void BM_FrameManagerGet(benchmark::State &state)
+{
+  const int file_desc = state.thread_index();
+  PageNum page_num = 0;
+  for (auto _ : state) {
+    Frame *frame = frame_manager->get(file_desc, page_num);
+    if (frame == nullptr) {
+      state.SkipWithError("frame not found");
+      break;
+    }
+    frame->unpin();
+    page_num = (page_num + 1) % PAGES_PER_THREAD;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameManagerGet)
+    ->Setup(create_frame_manager_with_frames)
+    ->Teardown(destroy_frame_manager_with_frames)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
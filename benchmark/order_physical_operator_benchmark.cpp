@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "include/query_engine/analyzer/statement/orderby_stmt.h"
+#include "include/query_engine/planner/operator/order_physical_operator.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/tuple/row_tuple.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/transaction/trx.h"
+
+/**
+ * @brief OrderPhysicalOperator 在内存中排序的开销
+ * @details 表结构是 (id int, name char(16), score float)，子算子直接从内存中的记录返回数据，
+ * 测量的是复制记录、计算排序键、排序以及逐行输出的时间。没有会话，不会溢出到磁盘。
+ * 参数是排序键和行数，排序键 0: id，1: name，2: score, id。
+ */
+
+static const int NAME_LENGTH = 16;
+
+/**
+ * @brief 只有元数据的表，记录由 benchmark 生成，不需要数据文件
+ */
+static Table *create_table()
+{
+  static bool trx_inited = false;
+  if (!trx_inited) {
+    TrxManager::init_global("vacuous");
+    trx_inited = true;
+  }
+
+  const AttrInfoSqlNode attributes[] = {
+      {INTS, "id", 4, false},
+      {CHARS, "name", NAME_LENGTH, false},
+      {FLOATS, "score", 4, false},
+  };
+  Table *table = new Table();
+  RC rc = table->create_system_table(1, "t", sizeof(attributes) / sizeof(attributes[0]), attributes, nullptr);
+  if (rc != RC::SUCCESS) {
+    delete table;
+    return nullptr;
+  }
+  return table;
+}
+
+/**
+ * @brief 按顺序返回内存中的记录
+ */
+class MemoryScanPhysicalOperator : public PhysicalOperator
+{
+public:
+  MemoryScanPhysicalOperator(const Table *table, std::vector<Record> &records) : records_(records)
+  {
+    tuple_.set_schema(table, table->name(), table->table_meta().field_metas());
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN; }
+
+  RC open(Trx *) override
+  {
+    next_ = 0;
+    return RC::SUCCESS;
+  }
+
+  RC next() override
+  {
+    if (next_ >= records_.size()) {
+      return RC::RECORD_EOF;
+    }
+    tuple_._set_record(&records_[next_++]);
+    return RC::SUCCESS;
+  }
+
+  RC close() override { return RC::SUCCESS; }
+
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  std::vector<Record> &records_;
+  size_t next_ = 0;
+  RowTuple tuple_;
+};
+
+/**
+ * @brief 生成随机的记录，score 的取值范围很小，按 score 排序时会有很多相同的值
+ */
+static void make_records(const Table *table, int count, std::vector<char> &data, std::vector<Record> &records)
+{
+  const TableMeta &table_meta = table->table_meta();
+  const int record_size = table_meta.record_size();
+  const FieldMeta *id_field = table_meta.field("id");
+  const FieldMeta *name_field = table_meta.field("name");
+  const FieldMeta *score_field = table_meta.field("score");
+
+  data.assign((size_t)count * record_size, 0);
+  records.resize(count);
+
+  std::mt19937 random(20240101);
+  std::uniform_int_distribution<int> dist(0, 1000000);
+  for (int i = 0; i < count; i++) {
+    char *record_data = data.data() + (size_t)i * record_size;
+    const int id = dist(random);
+    const float score = dist(random) % 100;
+    memcpy(record_data + id_field->offset(), &id, sizeof(id));
+    snprintf(record_data + name_field->offset(), NAME_LENGTH, "name-%08d", dist(random));
+    memcpy(record_data + score_field->offset(), &score, sizeof(score));
+
+    records[i].set_rid(i / 100 + 1, i % 100);
+    records[i].set_data(record_data, record_size);
+  }
+}
+
+static void BM_OrderPhysicalOperator(benchmark::State &state)
+{
+  const int key_kind = static_cast<int>(state.range(0));
+  const int row_count = static_cast<int>(state.range(1));
+
+  Table *table = create_table();
+  if (table == nullptr) {
+    state.SkipWithError("failed to create table");
+    return;
+  }
+
+  std::vector<const char *> key_fields;
+  switch (key_kind) {
+    case 0: key_fields = {"id"}; break;
+    case 1: key_fields = {"name"}; break;
+    default: key_fields = {"score", "id"}; break;
+  }
+  std::vector<std::unique_ptr<FieldExpr>> exprs;
+  std::vector<std::unique_ptr<OrderByUnit>> units;
+  std::string label;
+  for (const char *field_name : key_fields) {
+    exprs.emplace_back(new FieldExpr(table, table->table_meta().field(field_name)));
+    exprs.back()->set_field_table_alias(table->name());
+    auto unit = std::make_unique<OrderByUnit>();
+    unit->set_expr(exprs.back().get());
+    unit->set_sort_type(true);
+    units.emplace_back(std::move(unit));
+    label += label.empty() ? field_name : std::string(",") + field_name;
+  }
+  state.SetLabel(label);
+
+  std::vector<char> data;
+  std::vector<Record> records;
+  make_records(table, row_count, data, records);
+
+  RC rc = RC::SUCCESS;
+  for (auto _ : state) {
+    std::vector<OrderByUnit *> order_units;
+    for (auto &unit : units) {
+      order_units.push_back(unit.get());
+    }
+    OrderPhysicalOperator order(std::move(order_units));
+    order.add_child(std::make_unique<MemoryScanPhysicalOperator>(table, records));
+
+    rc = order.open(nullptr);
+    int count = 0;
+    while (rc == RC::SUCCESS && (rc = order.next()) == RC::SUCCESS) {
+      benchmark::DoNotOptimize(order.current_tuple());
+      count++;
+    }
+    order.close();
+    if (rc == RC::RECORD_EOF) {
+      rc = count == row_count ? RC::SUCCESS : RC::INTERNAL;
+    }
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError(strrc(rc));
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * row_count);
+
+  units.clear();
+  exprs.clear();
+  delete table;
+}
+BENCHMARK(BM_OrderPhysicalOperator)->ArgsProduct({{0, 1, 2}, {1000, 100000}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
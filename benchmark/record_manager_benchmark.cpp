@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/recorder/record.h"
+#include "include/storage_engine/recorder/record_manager.h"
+
+/**
+ * @brief RecordPageHandler 在一个页面内插入和读取记录的开销
+ * @details 页面一直在缓冲池中，不包含IO。参数是记录的长度。
+ */
+
+static const char *DATA_FILE = "record_manager_benchmark.data";
+
+/**
+ * @brief 一个只有一个记录页面的文件
+ */
+class RecordPageFixture
+{
+public:
+  RC open(int record_size)
+  {
+    ::remove(DATA_FILE);
+    bpm_ = new BufferPoolManager();
+    RC rc = bpm_->create_file(DATA_FILE);
+    if (rc == RC::SUCCESS) {
+      rc = bpm_->open_file(DATA_FILE, bp_);
+    }
+
+    Frame *frame = nullptr;
+    if (rc == RC::SUCCESS) {
+      rc = bp_->allocate_page(&frame);
+    }
+    if (rc == RC::SUCCESS) {
+      page_num_ = frame->page_num();
+      rc = handler_.init_empty_page(*bp_, page_num_, record_size);
+      // allocate_page 时已经 pin 过一次，init_empty_page 又会 pin 一次
+      frame->unpin();
+    }
+    record_size_ = record_size;
+    return rc;
+  }
+
+  void close()
+  {
+    handler_.cleanup();
+    delete bpm_;
+    bpm_ = nullptr;
+    ::remove(DATA_FILE);
+  }
+
+  /**
+   * @brief 重新初始化为空页面
+   */
+  RC reset()
+  {
+    handler_.cleanup();
+    return handler_.init_empty_page(*bp_, page_num_, record_size_);
+  }
+
+  RecordPageHandler &handler() { return handler_; }
+
+private:
+  BufferPoolManager *bpm_ = nullptr;
+  FileBufferPool *bp_ = nullptr;
+  PageNum page_num_ = 0;
+  int record_size_ = 0;
+  RecordPageHandler handler_;
+};
+
+static void BM_RecordPageInsert(benchmark::State &state)
+{
+  const int record_size = static_cast<int>(state.range(0));
+  std::vector<char> data(record_size, 'a');
+
+  RecordPageFixture fixture;
+  RC rc = fixture.open(record_size);
+  if (rc != RC::SUCCESS) {
+    state.SkipWithError(strrc(rc));
+    fixture.close();
+    return;
+  }
+
+  RID rid;
+  for (auto _ : state) {
+    rc = fixture.handler().insert_record(data.data(), &rid);
+    if (rc == RC::RECORD_NOMEM) {
+      // 页面满了，清空之后继续插入，清空的时间不计入
+      state.PauseTiming();
+      rc = fixture.reset();
+      state.ResumeTiming();
+      if (rc == RC::SUCCESS) {
+        rc = fixture.handler().insert_record(data.data(), &rid);
+      }
+    }
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError(strrc(rc));
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * record_size);
+  fixture.close();
+}
+BENCHMARK(BM_RecordPageInsert)->Arg(8)->Arg(64)->Arg(256);
+
+static void BM_RecordPageGet(benchmark::State &state)
+{
+  const int record_size = static_cast<int>(state.range(0));
+  std::vector<char> data(record_size, 'a');
+
+  RecordPageFixture fixture;
+  RC rc = fixture.open(record_size);
+  std::vector<RID> rids;
+  RID rid;
+  while (rc == RC::SUCCESS && !fixture.handler().is_full()) {
+    rc = fixture.handler().insert_record(data.data(), &rid);
+    rids.push_back(rid);
+  }
+  if (rc != RC::SUCCESS) {
+    state.SkipWithError(strrc(rc));
+    fixture.close();
+    return;
+  }
+
+  size_t index = 0;
+  Record record;
+  for (auto _ : state) {
+    rc = fixture.handler().get_record(&rids[index], &record);
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError(strrc(rc));
+      break;
+    }
+    benchmark::DoNotOptimize(record.data());
+    index = (index + 1) % rids.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+  fixture.close();
+}
+BENCHMARK(BM_RecordPageGet)->Arg(8)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "include/query_engine/parser/value.h"
+
+/**
+ * @brief Value::compare 在各种类型组合下的开销
+ * @details 比较的值提前生成好，循环中依次比较相邻的两个值，避免分支预测总是命中。
+ */
+
+static const int VALUE_NUM = 1024;
+
+enum class ComparePair
+{
+  INT_INT,
+  FLOAT_FLOAT,
+  INT_FLOAT,
+  CHARS_CHARS,
+};
+
+static const char *compare_pair_name(ComparePair pair)
+{
+  switch (pair) {
+    case ComparePair::INT_INT: return "ints-ints";
+    case ComparePair::FLOAT_FLOAT: return "floats-floats";
+    case ComparePair::INT_FLOAT: return "ints-floats";
+    case ComparePair::CHARS_CHARS: return "chars-chars";
+  }
+  return "unknown";
+}
+
+/**
+ * @brief 生成 VALUE_NUM 个值，INT_FLOAT 时交替生成整数和浮点数
+ */
+static std::vector<Value> make_values(ComparePair pair)
+{
+  std::mt19937 random(20240101);
+  std::uniform_int_distribution<int> dist(0, 1000000);
+
+  std::vector<Value> values;
+  values.reserve(VALUE_NUM);
+  for (int i = 0; i < VALUE_NUM; i++) {
+    const int v = dist(random);
+    switch (pair) {
+      case ComparePair::INT_INT: {
+        values.emplace_back(v);
+      } break;
+      case ComparePair::FLOAT_FLOAT: {
+        values.emplace_back(v * 0.5f);
+      } break;
+      case ComparePair::INT_FLOAT: {
+        if (i % 2 == 0) {
+          values.emplace_back(v);
+        } else {
+          values.emplace_back(v * 0.5f);
+        }
+      } break;
+      case ComparePair::CHARS_CHARS: {
+        // 共同的前缀让比较不会在第一个字符就结束
+        char buf[32];
+        snprintf(buf, sizeof(buf), "tdb-value-%08d", v);
+        values.emplace_back(buf);
+      } break;
+    }
+  }
+  return values;
+}
+
+static void BM_ValueCompare(benchmark::State &state)
+{
+  const ComparePair pair = static_cast<ComparePair>(state.range(0));
+  const std::vector<Value> values = make_values(pair);
+  state.SetLabel(compare_pair_name(pair));
+
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(values[i].compare(values[i + 1]));
+    i = (i + 1) % (VALUE_NUM - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ValueCompare)
+    ->Arg(static_cast<int>(ComparePair::INT_INT))
+    ->Arg(static_cast<int>(ComparePair::FLOAT_FLOAT))
+    ->Arg(static_cast<int>(ComparePair::INT_FLOAT))
+    ->Arg(static_cast<int>(ComparePair::CHARS_CHARS));
+
+BENCHMARK_MAIN();
@@ -0,0 +1,224 @@
+#include <cstdint>
+#include <cstring>
+
+#include "common/compress/lz4_block.h"
+
+namespace common {
+
+static constexpr int MIN_MATCH = 4;
+static constexpr int LAST_LITERALS = 5;  ///< 块的最后5个字节一定是字面量
+static constexpr int MF_LIMIT = 12;      ///< 最后一个匹配的开始位置距离块尾至少12个字节
+static constexpr int MAX_OFFSET = 65535;
+static constexpr int HASH_LOG = 14;
+static constexpr int SKIP_TRIGGER = 6;   ///< 连续找不到匹配时加快前进的速度
+
+static inline uint32_t read32(const char *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t hash32(uint32_t v)
+{
+  return (v * 2654435761U) >> (32 - HASH_LOG);
+}
+
+/**
+ * @brief 写入长度的扩展字节，每个字节最多表示255
+ */
+static inline bool write_length(char *&op, const char *op_end, int len)
+{
+  while (len >= 255) {
+    if (op >= op_end) {
+      return false;
+    }
+    *op++ = static_cast<char>(255);
+    len -= 255;
+  }
+  if (op >= op_end) {
+    return false;
+  }
+  *op++ = static_cast<char>(len);
+  return true;
+}
+
+/**
+ * @brief 写入一个序列：token、字面量长度、字面量、偏移量、匹配长度
+ * @param match_len 为0时表示最后一个只有字面量的序列
+ */
+static bool write_sequence(
+    char *&op, const char *op_end, const char *literals, int literal_len, int offset, int match_len)
+{
+  char *token = op++;
+  if (token >= op_end) {
+    return false;
+  }
+
+  if (literal_len >= 15) {
+    *token = static_cast<char>(15 << 4);
+    if (!write_length(op, op_end, literal_len - 15)) {
+      return false;
+    }
+  } else {
+    *token = static_cast<char>(literal_len << 4);
+  }
+
+  if (op_end - op < literal_len) {
+    return false;
+  }
+  memcpy(op, literals, literal_len);
+  op += literal_len;
+
+  if (match_len == 0) {
+    return true;
+  }
+
+  if (op_end - op < 2) {
+    return false;
+  }
+  *op++ = static_cast<char>(offset & 0xff);
+  *op++ = static_cast<char>(offset >> 8);
+
+  const int len = match_len - MIN_MATCH;
+  if (len >= 15) {
+    *token |= 15;
+    return write_length(op, op_end, len - 15);
+  }
+  *token |= len;
+  return true;
+}
+
+int lz4_compress_bound(int src_size)
+{
+  return src_size + src_size / 255 + 16;
+}
+
+int lz4_compress(const char *src, int src_size, char *dst, int dst_capacity)
+{
+  char *op = dst;
+  const char *op_end = dst + dst_capacity;
+  int anchor = 0;
+
+  if (src_size >= MF_LIMIT + 1) {
+    uint32_t table[1 << HASH_LOG];
+    memset(table, 0, sizeof(table));
+
+    const int match_start_limit = src_size - MF_LIMIT;
+    const int match_end_limit = src_size - LAST_LITERALS;
+    int ip = 0;
+    int search_count = 1 << SKIP_TRIGGER;
+    while (ip < match_start_limit) {
+      const uint32_t sequence = read32(src + ip);
+      const uint32_t h = hash32(sequence);
+      int ref = static_cast<int>(table[h]);
+      table[h] = ip;
+
+      if (ref >= ip || ip - ref > MAX_OFFSET || read32(src + ref) != sequence) {
+        ip += search_count++ >> SKIP_TRIGGER;
+        continue;
+      }
+      search_count = 1 << SKIP_TRIGGER;
+
+      // 向前扩展匹配
+      while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+        ip--;
+        ref--;
+      }
+
+      int match_len = MIN_MATCH;
+      while (ip + match_len < match_end_limit && src[ip + match_len] == src[ref + match_len]) {
+        match_len++;
+      }
+
+      if (!write_sequence(op, op_end, src + anchor, ip - anchor, ip - ref, match_len)) {
+        return 0;
+      }
+
+      ip += match_len;
+      anchor = ip;
+      if (ip - 2 >= 0 && ip - 2 < match_start_limit) {
+        table[hash32(read32(src + ip - 2))] = ip - 2;
+      }
+    }
+  }
+
+  if (!write_sequence(op, op_end, src + anchor, src_size - anchor, 0, 0)) {
+    return 0;
+  }
+  return static_cast<int>(op - dst);
+}
+
+int lz4_decompress(const char *src, int src_size, char *dst, int dst_capacity)
+{
+  const uint8_t *ip = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *ip_end = ip + src_size;
+  char *op = dst;
+  char *op_end = dst + dst_capacity;
+
+  while (ip < ip_end) {
+    const uint8_t token = *ip++;
+
+    size_t literal_len = token >> 4;
+    if (literal_len == 15) {
+      uint8_t b;
+      do {
+        if (ip >= ip_end) {
+          return -1;
+        }
+        b = *ip++;
+        literal_len += b;
+      } while (b == 255);
+    }
+    if (static_cast<size_t>(ip_end - ip) < literal_len || static_cast<size_t>(op_end - op) < literal_len) {
+      return -1;
+    }
+    memcpy(op, ip, literal_len);
+    ip += literal_len;
+    op += literal_len;
+
+    if (ip == ip_end) {
+      // 最后一个序列只有字面量
+      break;
+    }
+
+    if (ip_end - ip < 2) {
+      return -1;
+    }
+    const size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+      return -1;
+    }
+
+    size_t match_len = token & 15;
+    if (match_len == 15) {
+      uint8_t b;
+      do {
+        if (ip >= ip_end) {
+          return -1;
+        }
+        b = *ip++;
+        match_len += b;
+      } while (b == 255);
+    }
+    match_len += MIN_MATCH;
+    if (static_cast<size_t>(op_end - op) < match_len) {
+      return -1;
+    }
+
+    // 匹配可能和输出重叠，比如offset为1表示重复上一个字节
+    const char *match = op - offset;
+    if (offset >= match_len) {
+      memcpy(op, match, match_len);
+      op += match_len;
+    } else {
+      for (size_t i = 0; i < match_len; i++) {
+        *op++ = *match++;
+      }
+    }
+  }
+  return static_cast<int>(op - dst);
+}
+
+}  // namespace common
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace common {
+
+/**
+ * @brief LZ4块格式(block format)的压缩和解压
+ * @details 实现了LZ4的块格式(https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md)，
+ * 压缩结果可以被标准的LZ4_decompress_safe解压，反之亦然。
+ * 压缩使用单个哈希表的贪心匹配，不追求压缩率，只追求速度，适合在网络传输时使用。
+ * 只处理单个块，不包含LZ4帧格式的头和校验，调用者需要自己记录原始数据的长度。
+ */
+
+/**
+ * @brief 压缩结果最大可能的长度
+ */
+int lz4_compress_bound(int src_size);
+
+/**
+ * @brief 压缩一个块
+ * @param dst_capacity dst的大小，不小于lz4_compress_bound(src_size)时一定能压缩成功
+ * @return 压缩后的长度，dst空间不足时返回0
+ */
+int lz4_compress(const char *src, int src_size, char *dst, int dst_capacity);
+
+/**
+ * @brief 解压一个块
+ * @details 会检查输入的合法性，不会越界读写
+ * @param dst_capacity dst的大小，通常就是原始数据的长度
+ * @return 解压后的长度，数据损坏或者dst空间不足时返回-1
+ */
+int lz4_decompress(const char *src, int src_size, char *dst, int dst_capacity);
+
+}  // namespace common
@@ -258,6 +258,96 @@ void LockTrace::toString(std::string &result)
   return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::atomic<bool> LockProfiler::enabled_{false};
+thread_local LockProfiler::WaitObserver LockProfiler::wait_observer_ = nullptr;
+
+namespace {
+struct LockSiteRegistry
+{
+  std::mutex                                   lock;
+  std::map<std::string, LockSite *>            sites;
+  std::function<void(LockSite &site)>          listener;
+};
+
+/// 锁可能是全局对象，进程退出时还在使用，所以注册表不释放
+LockSiteRegistry &lock_site_registry()
+{
+  static LockSiteRegistry *registry = new LockSiteRegistry();
+  return *registry;
+}
+}  // namespace
+
+void LockProfiler::set_enabled(bool enabled)
+{
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+LockSite *LockProfiler::site(const char *name)
+{
+  LockSiteRegistry &registry = lock_site_registry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  LockSite *&site = registry.sites[name];
+  if (site == nullptr) {
+    site = new LockSite(name);
+    if (registry.listener) {
+      registry.listener(*site);
+    }
+  }
+  return site;
+}
+
+void LockProfiler::foreach_site(const std::function<void(LockSite &site)> &visitor)
+{
+  LockSiteRegistry &registry = lock_site_registry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  for (auto &[name, site] : registry.sites) {
+    visitor(*site);
+  }
+}
+
+void LockProfiler::set_site_listener(std::function<void(LockSite &site)> listener)
+{
+  LockSiteRegistry &registry = lock_site_registry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  registry.listener = std::move(listener);
+  if (registry.listener) {
+    for (auto &[name, site] : registry.sites) {
+      registry.listener(*site);
+    }
+  }
+}
+
+void LockProfiler::reset()
+{
+  foreach_site([](LockSite &site) {
+    site.acquisitions.store(0, std::memory_order_relaxed);
+    site.contentions.store(0, std::memory_order_relaxed);
+    site.wait_ns.store(0, std::memory_order_relaxed);
+  });
+}
+
+void LockProfiler::lock(pthread_mutex_t *mutex, LockSite *site)
+{
+  struct PthreadLock
+  {
+    pthread_mutex_t *mutex;
+    void lock() { pthread_mutex_lock(mutex); }
+    bool try_lock() { return pthread_mutex_trylock(mutex) == 0; }
+  } lock{mutex};
+  LockProfiler::lock(lock, site);
+}
+
+bool ProfiledMutex::try_lock()
+{
+  bool result = lock_.try_lock();
+  if (result && site_ != nullptr && LockProfiler::enabled()) {
+    site_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
 void DebugMutex::lock()
 {
 #ifdef DEBUG
@@ -278,7 +368,7 @@ void DebugMutex::unlock()
 void Mutex::lock()
 {
 #ifdef CONCURRENCY
-  lock_.lock();
+  LockProfiler::lock(lock_, site_);
   LOG_DEBUG("lock %p, lbt=%s", &lock_, lbt());
 #endif
 }
@@ -288,6 +378,9 @@ bool Mutex::try_lock()
 #ifdef CONCURRENCY
   bool result = lock_.try_lock();
   if (result) {
+    if (site_ != nullptr && LockProfiler::enabled()) {
+      site_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
     LOG_DEBUG("try lock success %p, lbt=%s", &lock_, lbt());
   }
   return result;
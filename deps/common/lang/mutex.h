@@ -18,6 +18,9 @@ See the Mulan PSL v2 for more details. */
 #include <errno.h>
 #include <pthread.h>
 #include <string.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <unordered_map>
 #include <condition_variable>
 #include <map>
@@ -244,6 +247,110 @@ protected:
 
 #endif  // DEBUG_LOCK
 
+/**
+ * @brief 一个加锁位置的竞争统计
+ * @details 同一个名字的锁共享一个统计对象，比如所有 FileBufferPool 的 lock_ 都记在 "buffer_pool.file" 上
+ */
+struct LockSite
+{
+  explicit LockSite(const char *site_name) : name(site_name) {}
+
+  const std::string     name;
+  std::atomic<uint64_t> acquisitions{0};  ///< 加锁次数
+  std::atomic<uint64_t> contentions{0};   ///< 锁被其它线程持有，需要等待的次数
+  std::atomic<uint64_t> wait_ns{0};       ///< 等待锁的总时间
+};
+
+/**
+ * @brief 锁竞争统计
+ * @details 统计每个加锁位置的加锁次数、发生竞争的次数以及等待的时间，用来判断并发提高之后应该先拆分哪个锁。
+ * 加锁时先 try_lock，失败了才计时并阻塞等待，所以没有竞争时只多了两个原子计数。
+ * 默认关闭，关闭时加锁只多读一次原子变量和一个线程局部变量，可以在运行过程中打开或关闭。
+ * 统计对象创建之后不会释放，指针可以一直使用。
+ */
+class LockProfiler
+{
+public:
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  static void set_enabled(bool enabled);
+
+  /**
+   * @brief 获取指定名字的统计对象，不存在时创建
+   */
+  static LockSite *site(const char *name);
+
+  static void foreach_site(const std::function<void(LockSite &site)> &visitor);
+
+  /**
+   * @brief 设置创建统计对象时的回调，设置时对已经存在的统计对象也会调用一次。用来把统计导出到指标中
+   */
+  static void set_site_listener(std::function<void(LockSite &site)> listener);
+
+  /**
+   * @brief 清零所有的统计
+   */
+  static void reset();
+
+  /**
+   * @brief 当前线程等待锁时的回调，参数是加锁位置以及开始和结束等待的时间。用于跟踪单个线程的执行过程
+   */
+  using WaitObserver = void (*)(const LockSite &site, std::chrono::steady_clock::time_point begin,
+      std::chrono::steady_clock::time_point end);
+  static void set_thread_wait_observer(WaitObserver observer) { wait_observer_ = observer; }
+
+  template <typename Lock>
+  static void lock(Lock &lock, LockSite *site)
+  {
+    const bool profiling = enabled();
+    if (site == nullptr || (!profiling && wait_observer_ == nullptr)) {
+      lock.lock();
+      return;
+    }
+
+    if (profiling) {
+      site->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (lock.try_lock()) {
+      return;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    lock.lock();
+    const auto end = std::chrono::steady_clock::now();
+    if (profiling) {
+      site->contentions.fetch_add(1, std::memory_order_relaxed);
+      site->wait_ns.fetch_add(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(), std::memory_order_relaxed);
+    }
+    if (wait_observer_ != nullptr) {
+      wait_observer_(*site, begin, end);
+    }
+  }
+
+  static void lock(pthread_mutex_t *mutex, LockSite *site);
+
+private:
+  static std::atomic<bool> enabled_;
+  static thread_local WaitObserver wait_observer_;
+};
+
+/**
+ * @brief 带竞争统计的 std::mutex，用于不受 CONCURRENCY 控制、一直需要加锁的地方
+ */
+class ProfiledMutex final
+{
+public:
+  explicit ProfiledMutex(const char *site_name) : site_(LockProfiler::site(site_name)) {}
+
+  void lock() { LockProfiler::lock(lock_, site_); }
+  bool try_lock();
+  void unlock() { lock_.unlock(); }
+
+private:
+  std::mutex lock_;
+  LockSite  *site_ = nullptr;
+};
+
 class DebugMutex final
 {
 public:
@@ -262,6 +369,10 @@ class Mutex final
 {
 public:
   Mutex() = default;
+  /**
+   * @param site_name 竞争统计中使用的名字，参考 LockProfiler
+   */
+  explicit Mutex(const char *site_name) : site_(LockProfiler::site(site_name)) {}
   ~Mutex() = default;
 
   void lock();
@@ -272,6 +383,7 @@ private:
 #ifdef CONCURRENCY
   std::mutex lock_;
 #endif
+  LockSite *site_ = nullptr;
 };
 
 class SharedMutex final
@@ -0,0 +1,220 @@
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+#include "common/log/async_log.h"
+
+namespace common {
+
+static size_t round_up_power_of_two(size_t value)
+{
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+LogBuffer::LogBuffer(size_t capacity)
+{
+  capacity_ = round_up_power_of_two(std::max(capacity, static_cast<size_t>(4096)));
+  mask_ = capacity_ - 1;
+  data_ = new char[capacity_];
+}
+
+LogBuffer::~LogBuffer()
+{
+  delete[] data_;
+  data_ = nullptr;
+}
+
+bool LogBuffer::try_append(const char *data, size_t size)
+{
+  const size_t head = head_.load(std::memory_order_relaxed);
+  const size_t tail = tail_.load(std::memory_order_acquire);
+  if (capacity_ - (head - tail) < size) {
+    return false;
+  }
+
+  const size_t pos = head & mask_;
+  const size_t first = std::min(size, capacity_ - pos);
+  memcpy(data_ + pos, data, first);
+  memcpy(data_, data + first, size - first);
+  head_.store(head + size, std::memory_order_release);
+  return true;
+}
+
+size_t LogBuffer::drain(std::string &out)
+{
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  const size_t head = head_.load(std::memory_order_acquire);
+  const size_t size = head - tail;
+  if (size == 0) {
+    return 0;
+  }
+
+  const size_t pos = tail & mask_;
+  const size_t first = std::min(size, capacity_ - pos);
+  out.append(data_ + pos, first);
+  out.append(data_, size - first);
+  tail_.store(head, std::memory_order_release);
+  return size;
+}
+
+/**
+ * @brief 线程在各个 AsyncLogWriter 中注册的缓存
+ * @details 一个线程可能同时写多个 AsyncLogWriter，比如运行日志和慢查询日志，每个 writer 一个缓存。
+ * 线程退出时标记缓存已关闭，后台线程读取完剩余的数据后释放它
+ */
+struct ThreadLogBuffers
+{
+  std::vector<std::pair<uint64_t, std::shared_ptr<LogBuffer>>> buffers;  ///< writer的编号和对应的缓存
+
+  ~ThreadLogBuffers()
+  {
+    for (auto &item : buffers) {
+      item.second->close();
+    }
+  }
+};
+
+static thread_local ThreadLogBuffers thread_log_buffers;
+static std::atomic<uint64_t> next_writer_id{1};
+
+AsyncLogWriter::AsyncLogWriter(size_t buffer_size, LOG_OVERFLOW overflow, int flush_interval_ms, WriteFunc write_func)
+    : id_(next_writer_id.fetch_add(1)),
+      buffer_size_(buffer_size),
+      overflow_(overflow),
+      flush_interval_ms_(std::max(flush_interval_ms, 1)),
+      write_func_(std::move(write_func))
+{}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+  stop();
+}
+
+void AsyncLogWriter::start()
+{
+  if (running_.exchange(true)) {
+    return;
+  }
+  stop_ = false;
+  thread_ = std::thread(&AsyncLogWriter::run, this);
+}
+
+void AsyncLogWriter::stop()
+{
+  if (!running_.exchange(false)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    stop_ = true;
+  }
+  cond_.notify_one();
+  thread_.join();
+  drain();
+}
+
+LogBuffer *AsyncLogWriter::thread_buffer()
+{
+  ThreadLogBuffers &local = thread_log_buffers;
+  for (auto &item : local.buffers) {
+    if (item.first == id_) {
+      return item.second.get();
+    }
+  }
+
+  auto buffer = std::make_shared<LogBuffer>(buffer_size_);
+  local.buffers.emplace_back(id_, buffer);
+
+  std::lock_guard<std::mutex> guard(lock_);
+  buffers_.push_back(buffer);
+  return buffer.get();
+}
+
+void AsyncLogWriter::append(const char *data, size_t size)
+{
+  LogBuffer *buffer = thread_buffer();
+
+  std::string truncated;
+  if (size > buffer->capacity()) {
+    // 超长的日志截断，保证能放进缓存
+    truncated.assign(data, buffer->capacity() - 1);
+    truncated.push_back('\n');
+    data = truncated.data();
+    size = truncated.size();
+  }
+
+  while (!buffer->try_append(data, size)) {
+    if (overflow_ == LOG_OVERFLOW_DROP || !running_.load(std::memory_order_relaxed)) {
+      dropped_lines_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    cond_.notify_one();
+    std::this_thread::yield();
+  }
+
+  if (buffer->size() > buffer->capacity() / 2) {
+    cond_.notify_one();
+  }
+}
+
+void AsyncLogWriter::flush()
+{
+  drain();
+}
+
+void AsyncLogWriter::run()
+{
+  while (true) {
+    bool stop = false;
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      cond_.wait_for(guard, std::chrono::milliseconds(flush_interval_ms_));
+      stop = stop_;
+    }
+
+    drain();
+    if (stop) {
+      break;
+    }
+  }
+}
+
+void AsyncLogWriter::drain()
+{
+  std::lock_guard<std::mutex> drain_guard(drain_lock_);
+
+  std::vector<std::shared_ptr<LogBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    buffers = buffers_;
+  }
+
+  for (const std::shared_ptr<LogBuffer> &buffer : buffers) {
+    // 先判断是否关闭再读取，避免漏掉线程退出前最后写入的数据
+    const bool closed = buffer->closed();
+    buffer->drain(batch_);
+    if (closed) {
+      std::lock_guard<std::mutex> guard(lock_);
+      buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+    }
+  }
+
+  const uint64_t dropped_lines = dropped_lines_.load(std::memory_order_relaxed);
+  if (dropped_lines != reported_dropped_lines_) {
+    batch_.append("[async log] ")
+        .append(std::to_string(dropped_lines - reported_dropped_lines_))
+        .append(" log lines dropped because the log buffer is full\n");
+    reported_dropped_lines_ = dropped_lines;
+  }
+
+  if (!batch_.empty()) {
+    write_func_(batch_);
+    batch_.clear();
+  }
+}
+
+}  // namespace common
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common {
+
+/**
+ * @brief 异步日志的缓存写满时的处理方式
+ */
+typedef enum {
+  LOG_OVERFLOW_BLOCK = 0,  ///< 等待后台线程把缓存写出去，不会丢失日志
+  LOG_OVERFLOW_DROP,       ///< 丢弃这条日志，后台线程会在日志中记录丢弃的条数
+  LOG_OVERFLOW_LAST
+} LOG_OVERFLOW;
+
+/**
+ * @brief 异步日志使用的单生产者单消费者环形缓存
+ * @details 每个写日志的线程有自己的 LogBuffer，只有这个线程写入，只有后台的日志线程读取，
+ * 所以读写都不需要加锁，只通过读写位置的原子变量同步。
+ * 一条日志要么完整写入，要么完全不写入，后台线程不会读到半条日志。
+ */
+class LogBuffer
+{
+public:
+  /**
+   * @param capacity 缓存大小，会向上取整为2的幂
+   */
+  explicit LogBuffer(size_t capacity);
+  ~LogBuffer();
+
+  LogBuffer(const LogBuffer &) = delete;
+  LogBuffer &operator=(const LogBuffer &) = delete;
+
+  /**
+   * @brief 写入一条日志，只能由所属的线程调用
+   * @return 空间不足时返回false，不会写入任何数据
+   */
+  bool try_append(const char *data, size_t size);
+
+  /**
+   * @brief 把缓存中所有的数据追加到out中，只能由后台日志线程调用
+   * @return 读取的字节数
+   */
+  size_t drain(std::string &out);
+
+  size_t capacity() const { return capacity_; }
+
+  /**
+   * @brief 缓存中还没有被读取的数据量
+   */
+  size_t size() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief 所属的线程已经退出，数据读取完成后就可以释放
+   */
+  void close() { closed_.store(true, std::memory_order_release); }
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+private:
+  char  *data_ = nullptr;
+  size_t capacity_ = 0;
+  size_t mask_ = 0;
+
+  /// 读写位置只增不减，取模之后才是在缓存中的位置。分开放在不同的cache line上，避免生产者和消费者互相干扰
+  alignas(64) std::atomic<size_t> head_{0};  ///< 写位置，生产者修改
+  alignas(64) std::atomic<size_t> tail_{0};  ///< 读位置，消费者修改
+  std::atomic<bool> closed_{false};
+};
+
+/**
+ * @brief 异步写日志
+ * @details 线程第一次写日志时创建自己的 LogBuffer 并注册到这里，之后写日志只是一次内存拷贝。
+ * 后台线程定期(或者某个缓存超过一半时)把所有缓存中的数据收集成一批，通过一次 write 回调写出去，
+ * 这样写日志的线程不会因为日志文件的锁和 flush 互相等待。
+ * 同一个线程的日志保持顺序，不同线程之间的日志在文件中的顺序与时间顺序可能略有不同。
+ */
+class AsyncLogWriter
+{
+public:
+  /**
+   * @brief 写出一批日志，在后台线程或者调用 flush 的线程中执行
+   */
+  using WriteFunc = std::function<void(const std::string &batch)>;
+
+  /**
+   * @param buffer_size 每个线程的缓存大小
+   * @param overflow 缓存写满时的处理方式
+   * @param flush_interval_ms 后台线程没有被唤醒时，多久收集一次日志
+   */
+  AsyncLogWriter(size_t buffer_size, LOG_OVERFLOW overflow, int flush_interval_ms, WriteFunc write_func);
+  ~AsyncLogWriter();
+
+  void start();
+
+  /**
+   * @brief 停止后台线程，停止前会把缓存中的日志都写出去
+   */
+  void stop();
+
+  /**
+   * @brief 写入一条完整的日志，需要包含结尾的换行符
+   */
+  void append(const char *data, size_t size);
+
+  /**
+   * @brief 在当前线程中把所有缓存中的日志写出去，比如打印PANIC日志之后
+   */
+  void flush();
+
+  /**
+   * @brief 由于缓存满了被丢弃的日志条数
+   */
+  uint64_t dropped_lines() const { return dropped_lines_.load(std::memory_order_relaxed); }
+
+private:
+  LogBuffer *thread_buffer();
+  void run();
+  void drain();
+
+private:
+  const uint64_t     id_;
+  const size_t       buffer_size_;
+  const LOG_OVERFLOW overflow_;
+  const int          flush_interval_ms_;
+  WriteFunc          write_func_;
+
+  std::thread             thread_;
+  std::atomic<bool>       running_{false};
+  std::mutex              lock_;  ///< 保护 buffers_ 和 stop_
+  std::condition_variable cond_;
+  bool                    stop_ = false;
+  std::vector<std::shared_ptr<LogBuffer>> buffers_;
+
+  std::mutex            drain_lock_;  ///< LogBuffer 只允许一个消费者，后台线程和 flush 通过这个锁互斥
+  std::string           batch_;
+  std::atomic<uint64_t> dropped_lines_{0};
+  uint64_t              reported_dropped_lines_ = 0;
+};
+
+}  // namespace common
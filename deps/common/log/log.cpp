@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include <assert.h>
+#include <algorithm>
 #include <exception>
 #include <stdarg.h>
 #include <stdio.h>
@@ -20,6 +21,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/string.h"
 #include "common/log/log.h"
+#include "common/lang/mutex.h"
 namespace common {
 
 Log *g_log = nullptr;
@@ -35,6 +37,7 @@ Log::Log(const std::string &log_file_name, const LOG_LEVEL log_level, const LOG_
   prefix_map_[LOG_LEVEL_TRACE] = "TRACE:";
 
   pthread_mutex_init(&lock_, nullptr);
+  lock_site_ = LockProfiler::site("log");
 
   log_date_.year_ = -1;
   log_date_.mon_ = -1;
@@ -50,6 +53,12 @@ Log::Log(const std::string &log_file_name, const LOG_LEVEL log_level, const LOG_
 
 Log::~Log(void)
 {
+  if (async_writer_ != nullptr) {
+    async_writer_->stop();
+    delete async_writer_;
+    async_writer_ = nullptr;
+  }
+
   pthread_mutex_lock(&lock_);
   if (ofs_.is_open()) {
     ofs_.close();
@@ -68,24 +77,8 @@ void Log::check_param_valid()
   return;
 }
 
-bool Log::check_output(const LOG_LEVEL level, const char *module)
-{
-  if (LOG_LEVEL_LAST > level && level <= console_level_) {
-    return true;
-  }
-  if (LOG_LEVEL_LAST > level && level <= log_level_) {
-    return true;
-  }
-  // in order to improve speed
-  if (default_set_.empty() == false && default_set_.find(module) != default_set_.end()) {
-    return true;
-  }
-  return false;
-}
-
 int Log::output(const LOG_LEVEL level, const char *module, const char *prefix, const char *f, ...)
 {
-  bool locked = false;
   try {
     va_list args;
     char msg[ONE_KILO];
@@ -101,31 +94,12 @@ int Log::output(const LOG_LEVEL level, const char *module, const char *prefix, c
     }
 
     if (LOG_LEVEL_PANIC <= level && level <= log_level_) {
-      pthread_mutex_lock(&lock_);
-      locked = true;
-      ofs_ << prefix;
-      ofs_ << msg;
-      ofs_ << "\n";
-      ofs_.flush();
-      log_line_++;
-      pthread_mutex_unlock(&lock_);
-      locked = false;
+      write_line(level, prefix, msg);
     } else if (default_set_.find(module) != default_set_.end()) {
-      pthread_mutex_lock(&lock_);
-      locked = true;
-      ofs_ << prefix;
-      ofs_ << msg;
-      ofs_ << "\n";
-      ofs_.flush();
-      log_line_++;
-      pthread_mutex_unlock(&lock_);
-      locked = false;
+      write_line(level, prefix, msg);
     }
 
   } catch (std::exception &e) {
-    if (locked) {
-      pthread_mutex_unlock(&lock_);
-    }
     std::cerr << e.what() << std::endl;
     return LOG_STATUS_ERR;
   }
@@ -133,6 +107,70 @@ int Log::output(const LOG_LEVEL level, const char *module, const char *prefix, c
   return LOG_STATUS_OK;
 }
 
+void Log::write_line(const LOG_LEVEL level, const char *prefix, const char *msg)
+{
+  if (async_writer_ != nullptr) {
+    char line[2 * ONE_KILO];
+    int len = snprintf(line, sizeof(line), "%s%s\n", prefix, msg);
+    if (len < 0) {
+      return;
+    }
+    if (len >= static_cast<int>(sizeof(line))) {
+      len = sizeof(line) - 1;
+      line[len - 1] = '\n';
+    }
+    async_writer_->append(line, len);
+    if (level == LOG_LEVEL_PANIC) {
+      async_writer_->flush();
+    }
+    return;
+  }
+
+  lock_file();
+  ofs_ << prefix;
+  ofs_ << msg;
+  ofs_ << "\n";
+  ofs_.flush();
+  log_line_++;
+  pthread_mutex_unlock(&lock_);
+}
+
+int Log::enable_async(size_t buffer_size, LOG_OVERFLOW overflow, int flush_interval_ms)
+{
+  if (async_writer_ != nullptr || overflow < LOG_OVERFLOW_BLOCK || overflow >= LOG_OVERFLOW_LAST) {
+    return LOG_STATUS_ERR;
+  }
+
+  async_writer_ = new AsyncLogWriter(
+      buffer_size, overflow, flush_interval_ms, [this](const std::string &batch) { write_batch(batch); });
+  async_writer_->start();
+  return LOG_STATUS_OK;
+}
+
+void Log::lock_file()
+{
+  LockProfiler::lock(&lock_, lock_site_);
+}
+
+void Log::write_batch(const std::string &batch)
+{
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  struct tm tm;
+  localtime_r(&tv.tv_sec, &tm);
+
+  lock_file();
+  if (rotate_type_ == LOG_ROTATE_BYDAY) {
+    rotate_by_day(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+  } else {
+    rotate_by_size();
+  }
+  ofs_.write(batch.data(), batch.size());
+  ofs_.flush();
+  log_line_ += static_cast<int>(std::count(batch.begin(), batch.end(), '\n'));
+  pthread_mutex_unlock(&lock_);
+}
+
 int Log::set_console_level(LOG_LEVEL console_level)
 {
   if (LOG_LEVEL_PANIC <= console_level && console_level < LOG_LEVEL_LAST) {
@@ -301,8 +339,13 @@ int Log::rotate_by_size()
 
 int Log::rotate(const int year, const int month, const int day)
 {
+  if (async_writer_ != nullptr) {
+    // 异步模式下由后台线程在写文件之前切换
+    return 0;
+  }
+
   int result = 0;
-  pthread_mutex_lock(&lock_);
+  lock_file();
   if (rotate_type_ == LOG_ROTATE_BYDAY) {
     result = rotate_by_day(year, month, day);
   } else {
@@ -24,10 +24,12 @@ See the Mulan PSL v2 for more details. */
 #include <iostream>
 #include <map>
 #include <set>
+#include <sstream>
 #include <string>
 #include <functional>
 
 #include "common/defs.h"
+#include "common/log/async_log.h"
 
 namespace common {
 
@@ -50,6 +52,8 @@ typedef enum {
 
 typedef enum { LOG_ROTATE_BYDAY = 0, LOG_ROTATE_BYSIZE, LOG_ROTATE_LAST } LOG_ROTATE;
 
+struct LockSite;
+
 class Log 
 {
 public:
@@ -105,10 +109,21 @@ public:
    * it will output whatever output level is lower than log_level_ or not
    */
   void set_default_module(const std::string &modules);
-  bool check_output(const LOG_LEVEL log_level, const char *module);
+  inline bool check_output(const LOG_LEVEL log_level, const char *module);
 
   int rotate(const int year = 0, const int month = 0, const int day = 0);
 
+  /**
+   * @brief 打开异步写日志，需要在启动其它线程之前调用
+   * @details 打开后线程把日志写到自己的无锁缓存中，由后台线程批量写入文件，参考 AsyncLogWriter。
+   * 日志文件的切换也由后台线程负责。PANIC日志写入后会立即写到文件中。
+   * @param buffer_size 每个线程的缓存大小
+   * @param overflow 缓存写满时的处理方式
+   * @param flush_interval_ms 后台线程多久收集一次日志
+   */
+  int enable_async(size_t buffer_size, LOG_OVERFLOW overflow, int flush_interval_ms);
+  bool async() const { return async_writer_ != nullptr; }
+
   /**
    * @brief 设置一个在日志中打印当前上下文信息的回调函数
    * @details 比如设置一个获取当前session标识的函数，那么每次在打印日志时都会输出session信息。
@@ -127,8 +142,15 @@ private:
   template <class T>
   int out(const LOG_LEVEL console_level, const LOG_LEVEL log_level, T &message);
 
+  void write_line(const LOG_LEVEL level, const char *prefix, const char *msg);
+  void write_batch(const std::string &batch);
+
+  /// 对 lock_ 加锁，同时记录锁竞争，参考 LockProfiler
+  void lock_file();
+
 private:
   pthread_mutex_t lock_;
+  LockSite *lock_site_ = nullptr;
   std::ofstream ofs_;
   std::string log_name_;
   LOG_LEVEL log_level_;
@@ -151,6 +173,8 @@ private:
   DefaultSet default_set_;
 
   std::function<intptr_t()> context_getter_;
+
+  AsyncLogWriter *async_writer_ = nullptr;
 };
 
 class LoggerFactory {
@@ -224,6 +248,21 @@ extern Log *g_log;
 #define LOG_DEBUG(fmt, ...) LOG_OUTPUT(common::LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
 #define LOG_TRACE(fmt, ...) LOG_OUTPUT(common::LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
 
+/**
+ * 在日志宏中格式化参数之前调用，关闭的日志级别不会有格式化的开销
+ */
+bool Log::check_output(const LOG_LEVEL level, const char *module)
+{
+  if (LOG_LEVEL_LAST > level && (level <= console_level_ || level <= log_level_)) {
+    return true;
+  }
+  // in order to improve speed
+  if (default_set_.empty() == false && default_set_.find(module) != default_set_.end()) {
+    return true;
+  }
+  return false;
+}
+
 template <class T>
 Log &Log::operator<<(T msg)
 {
@@ -283,8 +322,13 @@ int Log::out(const LOG_LEVEL console_level, const LOG_LEVEL log_level, T &msg)
       std::cout << prefix_map_[console_level] << msg;
     }
 
-    if (LOG_LEVEL_PANIC <= log_level && log_level <= log_level_) {
-      pthread_mutex_lock(&lock_);
+    if (LOG_LEVEL_PANIC <= log_level && log_level <= log_level_ && async_writer_ != nullptr) {
+      std::ostringstream oss;
+      oss << prefix << msg;
+      std::string line = oss.str();
+      async_writer_->append(line.data(), line.size());
+    } else if (LOG_LEVEL_PANIC <= log_level && log_level <= log_level_) {
+      lock_file();
       locked = true;
       ofs_ << prefix;
       ofs_ << msg;
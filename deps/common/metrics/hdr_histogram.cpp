@@ -0,0 +1,158 @@
+#include "common/metrics/hdr_histogram.h"
+
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace common {
+
+static constexpr int  SUB_BUCKET_COUNT = 1 << HdrHistogram::SUB_BUCKET_BITS;
+static constexpr int  SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+static constexpr long MAX_UNITS = (1L << HdrHistogram::MAX_VALUE_BITS) - 1;
+
+/**
+ * 一个线程写入的数据，放在独立的cache line上
+ */
+struct alignas(64) HdrHistogram::Shard
+{
+  std::atomic<long> sum_units{0};
+  std::atomic<long> min_units{std::numeric_limits<long>::max()};
+  std::atomic<long> max_units{0};
+  std::atomic<long> counts[SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF]{};
+};
+
+int HdrHistogram::bucket_count()
+{
+  return SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+}
+
+int HdrHistogram::bucket_index(long units)
+{
+  if (units < SUB_BUCKET_COUNT) {
+    return static_cast<int>(units);
+  }
+
+  // 保留最高的 SUB_BUCKET_BITS 位，shift 表示舍弃的低位数
+  const int  highest_bit = 63 - __builtin_clzl(units);
+  const int  shift = highest_bit - SUB_BUCKET_BITS + 1;
+  const long mantissa = units >> shift;
+  return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + static_cast<int>(mantissa - SUB_BUCKET_HALF);
+}
+
+long HdrHistogram::bucket_highest_units(int index)
+{
+  if (index < SUB_BUCKET_COUNT) {
+    return index;
+  }
+  const int  shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+  const long mantissa = SUB_BUCKET_HALF + (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+HdrHistogram::HdrHistogram(double resolution) : resolution_(resolution), shards_(new Shard[SHARD_NUM]())
+{}
+
+HdrHistogram::~HdrHistogram()
+{
+  if (snapshot_value_ != nullptr) {
+    delete snapshot_value_;
+    snapshot_value_ = nullptr;
+  }
+}
+
+int HdrHistogram::shard_index()
+{
+  static std::atomic<int> next_index{0};
+  static thread_local int index = next_index.fetch_add(1, std::memory_order_relaxed) % SHARD_NUM;
+  return index;
+}
+
+void HdrHistogram::update(double value)
+{
+  long units = value <= 0 ? 0 : llround(value / resolution_);
+  units = std::min(units, MAX_UNITS);
+
+  Shard &shard = shards_[shard_index()];
+  shard.counts[bucket_index(units)].fetch_add(1, std::memory_order_relaxed);
+  shard.sum_units.fetch_add(units, std::memory_order_relaxed);
+
+  // 同一个分片通常只有一个线程写入，这里的CAS几乎不会失败
+  long current = shard.max_units.load(std::memory_order_relaxed);
+  while (units > current && !shard.max_units.compare_exchange_weak(current, units, std::memory_order_relaxed)) {
+  }
+  current = shard.min_units.load(std::memory_order_relaxed);
+  while (units < current && !shard.min_units.compare_exchange_weak(current, units, std::memory_order_relaxed)) {
+  }
+}
+
+void HdrHistogram::merge_to(HdrHistogramSnapshot &snapshot)
+{
+  const int buckets = bucket_count();
+  snapshot.resolution_ = resolution_;
+  snapshot.counts_.assign(buckets, 0);
+  snapshot.count_ = 0;
+  snapshot.sum_units_ = 0;
+  snapshot.min_units_ = std::numeric_limits<long>::max();
+  snapshot.max_units_ = 0;
+
+  for (int s = 0; s < SHARD_NUM; s++) {
+    const Shard &shard = shards_[s];
+    for (int i = 0; i < buckets; i++) {
+      const long count = shard.counts[i].load(std::memory_order_relaxed);
+      snapshot.counts_[i] += count;
+      snapshot.count_ += count;
+    }
+    snapshot.sum_units_ += shard.sum_units.load(std::memory_order_relaxed);
+    snapshot.min_units_ = std::min(snapshot.min_units_, shard.min_units.load(std::memory_order_relaxed));
+    snapshot.max_units_ = std::max(snapshot.max_units_, shard.max_units.load(std::memory_order_relaxed));
+  }
+  // 与update并发时可能已经统计了数量但是还没有更新最小值
+  snapshot.min_units_ = std::min(snapshot.min_units_, snapshot.max_units_);
+}
+
+void HdrHistogram::snapshot()
+{
+  if (snapshot_value_ == nullptr) {
+    snapshot_value_ = new HdrHistogramSnapshot();
+  }
+  merge_to(*static_cast<HdrHistogramSnapshot *>(snapshot_value_));
+}
+
+double HdrHistogramSnapshot::quantile(double quantile) const
+{
+  if (count_ == 0) {
+    return 0;
+  }
+
+  const long rank = std::max(1L, static_cast<long>(ceil(std::clamp(quantile, 0.0, 1.0) * count_)));
+  long seen = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      const long units = std::clamp(HdrHistogram::bucket_highest_units(static_cast<int>(i)), min_units_, max_units_);
+      return units * resolution_;
+    }
+  }
+  return max();
+}
+
+long HdrHistogramSnapshot::count_below_power_of_two(int bits) const
+{
+  const long limit = (1L << bits) - 1;
+  long count = 0;
+  for (size_t i = 0; i < counts_.size() && HdrHistogram::bucket_highest_units(static_cast<int>(i)) <= limit; i++) {
+    count += counts_[i];
+  }
+  return count;
+}
+
+std::string HdrHistogramSnapshot::to_string()
+{
+  std::stringstream oss;
+  oss << "count:" << count_ << ",mean:" << mean() << ",min:" << min() << ",median:" << quantile(0.5)
+      << ",90th:" << quantile(0.9) << ",99th:" << quantile(0.99) << ",999th:" << quantile(0.999) << ",max:" << max();
+  return oss.str();
+}
+
+}  // namespace common
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/metrics/metric.h"
+#include "common/metrics/snapshot.h"
+
+namespace common {
+
+/**
+ * HdrHistogram 的快照，所有分片合并之后的结果
+ */
+class HdrHistogramSnapshot : public Snapshot {
+public:
+  HdrHistogramSnapshot() = default;
+  virtual ~HdrHistogramSnapshot() = default;
+
+  long count() const { return count_; }
+  double sum() const { return sum_units_ * resolution_; }
+  double mean() const { return count_ == 0 ? 0 : sum() / count_; }
+  double min() const { return count_ == 0 ? 0 : min_units_ * resolution_; }
+  double max() const { return count_ == 0 ? 0 : max_units_ * resolution_; }
+
+  /**
+   * 分位数，返回所在桶能表示的最大值(不超过实际的最大值)，相对误差小于 1/64
+   * @param quantile 取值范围 [0, 1]
+   */
+  double quantile(double quantile) const;
+
+  /**
+   * 不超过 2^bits - 1 个单位的数据个数，这些边界与桶的边界对齐，结果是准确的
+   */
+  long count_below_power_of_two(int bits) const;
+
+  /**
+   * 每个单位代表的数值，比如以毫秒记录、精确到微秒时是0.001
+   */
+  double resolution() const { return resolution_; }
+
+  std::string to_string() override;
+
+private:
+  friend class HdrHistogram;
+
+  double resolution_ = 1;
+  std::vector<long> counts_;
+  long count_ = 0;
+  long sum_units_ = 0;
+  long min_units_ = 0;
+  long max_units_ = 0;
+};
+
+/**
+ * 对数-线性分桶的直方图，参考 HdrHistogram
+ * @details 数据先按 resolution 转换成整数个单位。小于128的值每个值一个桶，之后每个2的幂区间均分成64个桶，
+ * 所以任何值所在桶的宽度都不超过它的 1/64，分位数的相对误差也不超过这个值。最大值和最小值单独记录，是准确的。
+ *
+ * 每个线程固定写入一个分片，记录一条数据只是几次没有竞争的原子操作，不加锁；
+ * snapshot 时把所有分片合并起来，不会清零。
+ * 超过 2^MAX_VALUE_BITS 个单位的数据放在最后一个桶中。
+ */
+class HdrHistogram : public Metric {
+public:
+  static constexpr int SUB_BUCKET_BITS = 7;
+  static constexpr int MAX_VALUE_BITS = 40;
+  static constexpr int SHARD_NUM = 8;
+
+  /**
+   * @param resolution 每个单位代表的数值，小于它的差别会被忽略
+   */
+  explicit HdrHistogram(double resolution = 1);
+  virtual ~HdrHistogram();
+
+  void update(double value);
+
+  void snapshot() override;
+
+  static int bucket_count();
+  static int bucket_index(long units);
+  static long bucket_highest_units(int index);
+
+protected:
+  /**
+   * 合并所有分片的数据到snapshot中
+   */
+  void merge_to(HdrHistogramSnapshot &snapshot);
+
+private:
+  struct Shard;
+
+  static int shard_index();
+
+private:
+  const double resolution_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace common
@@ -37,10 +37,6 @@ HistogramSnapShot::~HistogramSnapShot()
 
 void HistogramSnapShot::set_collection(const std::vector<double> &collection)
 {
-  if (collection.empty()) {
-    return;
-  }
-
   data_ = collection;
   std::sort(data_.begin(), data_.end());
 }
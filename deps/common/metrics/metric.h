@@ -28,8 +28,10 @@ public:
     return snapshot_value_;
   }
 
+  virtual ~Metric() = default;
+
 protected:
-  Snapshot *snapshot_value_;
+  Snapshot *snapshot_value_ = nullptr;
 };
 
 }  // namespace structor
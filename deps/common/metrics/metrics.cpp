@@ -15,7 +15,45 @@ See the Mulan PSL v2 for more details. */
 #include "common/metrics/metrics.h"
 #include "common/lang/mutex.h"
 
+#include <algorithm>
+
 namespace common {
+
+/**
+ * 距离上一次snapshot的秒数，不足一毫秒时按一毫秒计算
+ */
+static double elapsed_seconds(long now_tick, long snapshot_tick)
+{
+  long elapsed = now_tick - snapshot_tick;
+  return (elapsed < 1000 ? 1000 : elapsed) / 1000000.0;
+}
+
+Counter::Counter()
+{
+  snapshot_value_ = &value_;
+}
+
+int Counter::shard_index()
+{
+  static std::atomic<int> next_index{0};
+  static thread_local int index = next_index.fetch_add(1, std::memory_order_relaxed) % SHARD_NUM;
+  return index;
+}
+
+long Counter::value() const
+{
+  long value = 0;
+  for (const Shard &shard : shards_) {
+    value += shard.value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+void Counter::snapshot()
+{
+  long total = value();
+  value_.setValue(total);
+}
 Meter::Meter()
 {
   struct timeval start_time;
@@ -52,7 +90,7 @@ void Meter::snapshot()
 
   long now_tick = now.tv_sec * 1000000 + now.tv_usec;
 
-  double temp_value = ((double)value_.exchange(0l)) / ((now_tick - snapshot_tick_) / 1000000);
+  double temp_value = ((double)value_.exchange(0l)) / elapsed_seconds(now_tick, snapshot_tick_);
   snapshot_tick_ = now_tick;
 
   if (snapshot_value_ == NULL) {
@@ -96,7 +134,7 @@ void SimpleTimer::snapshot()
   double mean = 0;
 
   if (times_snapshot > 0) {
-    tps = ((double)times_snapshot) / ((now_tick - snapshot_tick_) / 1000000);
+    tps = ((double)times_snapshot) / elapsed_seconds(now_tick, snapshot_tick_);
     mean = ((double)value_snapshot) / times_snapshot;
   }
 
@@ -108,30 +146,13 @@ void SimpleTimer::snapshot()
   ((SimplerTimerSnapshot *)snapshot_value_)->setValue(mean, tps);
 }
 
-Histogram::Histogram(RandomGenerator &random) : UniformReservoir(random)
-{}
-
-Histogram::Histogram(RandomGenerator &random, size_t size) : UniformReservoir(random, size)
+Histogram::Histogram(double resolution) : HdrHistogram(resolution)
 {}
 
 Histogram::~Histogram()
 {}
 
-void Histogram::snapshot()
-{
-  UniformReservoir::snapshot();
-}
-
-Timer::Timer(RandomGenerator &random) : UniformReservoir(random)
-{
-  struct timeval start_time;
-  gettimeofday(&start_time, NULL);
-
-  snapshot_tick_ = start_time.tv_sec * 1000000 + start_time.tv_usec;
-  value_.store(0l);
-}
-
-Timer::Timer(RandomGenerator &random, size_t size) : UniformReservoir(random, size)
+Timer::Timer(double resolution_ms) : HdrHistogram(resolution_ms)
 {
   struct timeval start_time;
   gettimeofday(&start_time, NULL);
@@ -141,16 +162,11 @@ Timer::Timer(RandomGenerator &random, size_t size) : UniformReservoir(random, si
 }
 
 Timer::~Timer()
-{
-  if (snapshot_value_ == NULL) {
-    delete snapshot_value_;
-    snapshot_value_ = NULL;
-  }
-}
+{}
 
 void Timer::update(double ms)
 {
-  UniformReservoir::update(ms);
+  HdrHistogram::update(ms);
   value_.fetch_add(1l);
 }
 
@@ -166,14 +182,10 @@ void Timer::snapshot()
 
   long now_tick = now.tv_sec * 1000000 + now.tv_usec;
 
-  double tps = ((double)value_.exchange(0l)) / ((now_tick - snapshot_tick_) / 1000000);
+  double tps = ((double)value_.exchange(0l)) / elapsed_seconds(now_tick, snapshot_tick_);
   snapshot_tick_ = now_tick;
 
-  MUTEX_LOCK(&mutex);
-  std::vector<double> output = data;
-  MUTEX_UNLOCK(&mutex);
-
-  timer_snapshot->set_collection(output);
+  merge_to(*timer_snapshot);
   timer_snapshot->set_tps(tps);
 }
 
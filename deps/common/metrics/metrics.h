@@ -16,11 +16,13 @@ See the Mulan PSL v2 for more details. */
 #define __COMMON_METRICS_METRICS_H__
 
 #include "common/lang/string.h"
+#include "common/metrics/hdr_histogram.h"
 #include "common/metrics/metric.h"
 #include "common/metrics/snapshot.h"
 #include "common/metrics/timer_snapshot.h"
-#include "common/metrics/uniform_reservoir.h"
 #include <sys/time.h>
+#include <atomic>
+#include <functional>
 
 namespace common {
 
@@ -33,11 +35,57 @@ public:
   }
 };
 
+/**
+ * 通过回调函数获取当前值的Gauge，比如某个对象当前的大小
+ */
+class CallbackGauge : public Gauge {
+public:
+  explicit CallbackGauge(std::function<long()> getter) : getter_(std::move(getter))
+  {
+    snapshot_value_ = &value_;
+  }
+
+  void snapshot() override
+  {
+    long value = getter_();
+    value_.setValue(value);
+  }
+
+private:
+  std::function<long()> getter_;
+  SnapshotBasic<long> value_;
+};
+
+/**
+ * 累计计数器，按线程分片
+ * 每个线程固定使用其中一个分片，inc只是一次没有竞争的原子加，可以放在很热的路径上。
+ * 读取时把所有的分片加起来，不会清零。
+ */
 class Counter : public Metric {
-  void set_snapshot(SnapshotBasic<long> *value)
+public:
+  Counter();
+  virtual ~Counter() = default;
+
+  void inc(long increase = 1)
   {
-    snapshot_value_ = value;
+    shards_[shard_index()].value.fetch_add(increase, std::memory_order_relaxed);
   }
+
+  long value() const;
+  void snapshot() override;
+
+private:
+  static int shard_index();
+
+private:
+  static constexpr int SHARD_NUM = 64;
+
+  struct alignas(64) Shard {
+    std::atomic<long> value{0};
+  };
+
+  Shard shards_[SHARD_NUM];
+  SnapshotBasic<long> value_;
 };
 
 class Meter : public Metric {
@@ -71,25 +119,19 @@ protected:
   std::atomic<long> times_;
 };
 
-// Histogram metric is complicated, in normal case ,
-//  please skip us histogram or Timer as more as possible
-//  try use SimpleTimer to replace them.
-//  if use histogram , please use sampling method.
-class Histogram : public UniformReservoir {
+// Histogram records every value into a log-linear HdrHistogram,
+//  recording is lock free and quantiles are accurate to 1/64.
+class Histogram : public HdrHistogram {
 public:
-  Histogram(RandomGenerator &random);
-  Histogram(RandomGenerator &random, size_t size);
+  explicit Histogram(double resolution = 1);
   virtual ~Histogram();
-
-  void snapshot();
 };
 
-// timeunit is ms
+// timeunit is ms, recorded with microsecond resolution by default
 // Timer = Histogram + Meter
-class Timer : public UniformReservoir {
+class Timer : public HdrHistogram {
 public:
-  Timer(RandomGenerator &random);
-  Timer(RandomGenerator &random, size_t size);
+  explicit Timer(double resolution_ms = 0.001);
   virtual ~Timer();
 
   void snapshot();
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 #include <map>
 #include <list>
+#include <mutex>
 
 #include "common/metrics/metric.h"
 #include "common/metrics/reporter.h"
@@ -36,12 +37,19 @@ public:
 
   void report();
 
+  /**
+   * 对所有的指标做一次snapshot，然后交给指定的reporter，比如查询当前所有指标时使用
+   */
+  void report(Reporter &reporter);
+
   void add_reporter(Reporter *reporter)
   {
+    std::lock_guard<std::mutex> guard(lock_);
     reporters.push_back(reporter);
   }
 
 protected:
+  std::mutex lock_;  // 指标可能在运行过程中注册和注销，与定期的report并发
   std::map<std::string, Metric *> metrics;
   std::list<Reporter *> reporters;
 };
@@ -0,0 +1,126 @@
+#include "common/metrics/prometheus_reporter.h"
+
+#include <stdio.h>
+#include <math.h>
+
+#include "common/metrics/hdr_histogram.h"
+#include "common/metrics/histogram_snapshot.h"
+#include "common/metrics/metrics.h"
+
+namespace common {
+
+/**
+ * Prometheus 的指标名只能包含字母、数字、下划线和冒号
+ */
+static std::string sanitize_name(const std::string &name)
+{
+  std::string result = name;
+  for (char &c : result) {
+    if (!isalnum(static_cast<unsigned char>(c)) && c != '_' && c != ':') {
+      c = '_';
+    }
+  }
+  if (!result.empty() && isdigit(static_cast<unsigned char>(result[0]))) {
+    result.insert(0, "_");
+  }
+  return result;
+}
+
+static std::string format_value(double value)
+{
+  if (isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  if (isnan(value)) {
+    return "NaN";
+  }
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.15g", value);
+  return buf;
+}
+
+void PrometheusReporter::write_type(const std::string &name, const char *type)
+{
+  if (name == last_family_) {
+    return;
+  }
+  last_family_ = name;
+  text_.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void PrometheusReporter::write_sample(
+    const std::string &name, const std::string &labels, const std::string &extra_label, double value)
+{
+  text_.append(name);
+  if (!labels.empty() || !extra_label.empty()) {
+    text_.append("{").append(labels);
+    if (!labels.empty() && !extra_label.empty()) {
+      text_.append(",");
+    }
+    text_.append(extra_label).append("}");
+  }
+  text_.append(" ").append(format_value(value)).append("\n");
+}
+
+void PrometheusReporter::report(const std::string &tag, Metric *metric)
+{
+  std::string name = tag;
+  std::string labels;
+  const size_t brace = tag.find('{');
+  if (brace != std::string::npos && tag.back() == '}') {
+    name = tag.substr(0, brace);
+    labels = tag.substr(brace + 1, tag.size() - brace - 2);
+  }
+  name = sanitize_name(prefix_ + name);
+
+  if (Counter *counter = dynamic_cast<Counter *>(metric)) {
+    write_type(name + "_total", "counter");
+    write_sample(name + "_total", labels, "", counter->value());
+    return;
+  }
+
+  Snapshot *snapshot = metric->get_snapshot();
+  if (snapshot == nullptr) {
+    return;
+  }
+
+  if (HdrHistogramSnapshot *histogram = dynamic_cast<HdrHistogramSnapshot *>(snapshot)) {
+    // 桶的上界取 2^k-1 个单位，与HdrHistogram桶的边界对齐，每个桶的数量都是准确的
+    write_type(name, "histogram");
+    for (int bits = 0; bits <= HdrHistogram::MAX_VALUE_BITS; bits++) {
+      const double bound = ((1L << bits) - 1) * histogram->resolution();
+      write_sample(name + "_bucket", labels, "le=\"" + format_value(bound) + "\"", histogram->count_below_power_of_two(bits));
+    }
+    write_sample(name + "_bucket", labels, "le=\"+Inf\"", histogram->count());
+    write_sample(name + "_sum", labels, "", histogram->sum());
+    write_sample(name + "_count", labels, "", histogram->count());
+    return;
+  }
+
+  if (HistogramSnapShot *histogram = dynamic_cast<HistogramSnapShot *>(snapshot)) {
+    // 采样得到的分位数只能作为summary输出，没有准确的总数
+    static const double quantiles[] = {0.5, 0.75, 0.9, 0.99, 0.999};
+    write_type(name, "summary");
+    for (double quantile : quantiles) {
+      write_sample(name, labels, "quantile=\"" + format_value(quantile) + "\"", histogram->get_value(quantile));
+    }
+    return;
+  }
+
+  if (dynamic_cast<Gauge *>(metric) != nullptr) {
+    double value = 0;
+    if (auto *basic = dynamic_cast<SnapshotBasic<long> *>(snapshot)) {
+      value = basic->get_value();
+    } else if (auto *basic = dynamic_cast<SnapshotBasic<int> *>(snapshot)) {
+      value = basic->get_value();
+    } else if (auto *basic = dynamic_cast<SnapshotBasic<double> *>(snapshot)) {
+      value = basic->get_value();
+    } else {
+      return;
+    }
+    write_type(name, "gauge");
+    write_sample(name, labels, "", value);
+  }
+}
+
+}  // namespace common
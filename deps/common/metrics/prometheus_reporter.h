@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+#include "common/metrics/reporter.h"
+
+namespace common {
+
+/**
+ * 把指标转换成 Prometheus 的文本格式(text exposition format 0.0.4)
+ * 指标的tag可以带上标签，比如 query.latency_ms{stmt="SELECT"}，名字相同的指标输出为同一个指标族。
+ * tag中的'.'等字符转换为'_'，并加上统一的前缀。
+ * Counter 输出为 counter，Gauge 输出为 gauge，Histogram/Timer 等 HdrHistogram 输出为 histogram，
+ * UniformReservoir 的采样数据输出为 summary 的分位数，其它的指标不输出。
+ * 需要在snapshot之后report，一般通过 MetricsRegistry::report(Reporter &) 使用。
+ */
+class PrometheusReporter : public Reporter {
+public:
+  explicit PrometheusReporter(const std::string &prefix = "") : prefix_(prefix)
+  {}
+  virtual ~PrometheusReporter() = default;
+
+  void report(const std::string &tag, Metric *metric) override;
+
+  const std::string &text() const
+  {
+    return text_;
+  }
+
+private:
+  void write_type(const std::string &name, const char *type);
+  void write_sample(const std::string &name, const std::string &labels, const std::string &extra_label, double value);
+
+private:
+  std::string prefix_;
+  std::string text_;
+  std::string last_family_;  ///< 同一个指标族的TYPE只输出一次
+};
+
+}  // namespace common
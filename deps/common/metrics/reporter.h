@@ -22,6 +22,7 @@ namespace common {
 
 class Reporter {
 public:
+  virtual ~Reporter() = default;
   virtual void report(const std::string &tag, Metric *metric) = 0;
 };
 }  // namespace structor
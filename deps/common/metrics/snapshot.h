@@ -41,6 +41,11 @@ public:
     value = input;
   }
 
+  const T &get_value() const
+  {
+    return value;
+  }
+
   std::string to_string()
   {
     std::string ret;
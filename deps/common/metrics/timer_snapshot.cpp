@@ -37,7 +37,7 @@ std::string TimerSnapshot::to_string()
 {
   std::stringstream oss;
 
-  oss << HistogramSnapShot::to_string() << ",tps:" << tps;
+  oss << HdrHistogramSnapshot::to_string() << ",tps:" << tps;
 
   return oss.str();
 }
@@ -14,10 +14,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
-#include "common/metrics/histogram_snapshot.h"
+#include "common/metrics/hdr_histogram.h"
 
 namespace common {
-class TimerSnapshot : public HistogramSnapShot {
+class TimerSnapshot : public HdrHistogramSnapshot {
 public:
   TimerSnapshot();
   virtual ~TimerSnapshot();
@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/metrics/uniform_reservoir.h"
 
 #include <stdint.h>
+#include <algorithm>
 
 #include "common/lang/mutex.h"
 #include "common/metrics/histogram_snapshot.h"
@@ -47,7 +48,7 @@ UniformReservoir::UniformReservoir(RandomGenerator &random, size_t size) : Reser
 
 UniformReservoir::~UniformReservoir()
 {
-  if (snapshot_value_ == NULL) {
+  if (snapshot_value_ != NULL) {
     delete snapshot_value_;
     snapshot_value_ = NULL;
   }
@@ -80,7 +81,7 @@ size_t UniformReservoir::get_count()
 void UniformReservoir::update(double value)
 {
   MUTEX_LOCK(&mutex);
-  size_t count = ++counter;
+  size_t count = counter++;
 
   if (count < data.size()) {
     data[count] = (value);
@@ -94,8 +95,9 @@ void UniformReservoir::update(double value)
 
 void UniformReservoir::snapshot()
 {
+  // 还没有写满时只有前面counter个是有效的数据
   MUTEX_LOCK(&mutex);
-  std::vector<double> output = data;
+  std::vector<double> output(data.begin(), data.begin() + std::min(counter, data.size()));
   MUTEX_UNLOCK(&mutex);
 
   if (snapshot_value_ == NULL) {
@@ -107,11 +109,10 @@ void UniformReservoir::snapshot()
 void UniformReservoir::reset()
 {
 
+  // 保留缓存的大小，counter清零之后旧的数据不会再被读到
   MUTEX_LOCK(&mutex);
   counter = 0;
-  data.clear();
 
-  // clear snapshot
   MUTEX_UNLOCK(&mutex);
 }
 
@@ -17,7 +17,14 @@ See the Mulan PSL v2 for more details. */
 #include <sys/time.h>
 namespace common {
 
-TimeoutInfo::TimeoutInfo(time_t deadLine) : deadline_(deadLine), is_timed_out_(false), ref_cnt_(0)
+TimeoutInfo::TimeoutInfo(time_t deadLine)
+    : deadline_(deadLine), deadline_usec_(0), is_timed_out_(false), is_cancelled_(false), ref_cnt_(0)
+{
+  MUTEX_INIT(&mutex_, NULL);
+}
+
+TimeoutInfo::TimeoutInfo(time_t deadline_sec, long deadline_usec)
+    : deadline_(deadline_sec), deadline_usec_(deadline_usec), is_timed_out_(false), is_cancelled_(false), ref_cnt_(0)
 {
   MUTEX_INIT(&mutex_, NULL);
 }
@@ -55,11 +62,27 @@ bool TimeoutInfo::has_timed_out()
     struct timeval tv;
     gettimeofday(&tv, NULL);
 
-    ret = is_timed_out_ = (tv.tv_sec >= deadline_);
+    ret = is_timed_out_ = (tv.tv_sec > deadline_ || (tv.tv_sec == deadline_ && tv.tv_usec >= deadline_usec_));
   }
   MUTEX_UNLOCK(&mutex_);
 
   return ret;
 }
 
+void TimeoutInfo::cancel()
+{
+  MUTEX_LOCK(&mutex_);
+  is_timed_out_ = true;
+  is_cancelled_ = true;
+  MUTEX_UNLOCK(&mutex_);
+}
+
+bool TimeoutInfo::is_cancelled()
+{
+  MUTEX_LOCK(&mutex_);
+  bool ret = is_cancelled_;
+  MUTEX_UNLOCK(&mutex_);
+  return ret;
+}
+
 }  // namespace structor
\ No newline at end of file
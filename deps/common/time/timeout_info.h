@@ -35,15 +35,28 @@ public:
    */
   TimeoutInfo(time_t deadline_);
 
+  /**
+   * Constructor with a sub-second deadline
+   * @param[in] deadline_sec   seconds part of the deadline
+   * @param[in] deadline_usec  microseconds part of the deadline
+   */
+  TimeoutInfo(time_t deadline_sec, long deadline_usec);
+
   // Increase ref count
   void attach();
 
   // Decrease ref count
   void detach();
 
-  // Check if it has timed out
+  // Check if it has timed out or has been cancelled
   bool has_timed_out();
 
+  // Mark it as timed out right now, e.g. the operation is killed by others
+  void cancel();
+
+  // Check if it is timed out because of cancel()
+  bool is_cancelled();
+
 private:
   // Forbid copy ctor and =() to support ref count
 
@@ -61,12 +74,14 @@ protected:
   ~TimeoutInfo();
 
 private:
-  time_t deadline_;  // when should this be timed out
+  time_t deadline_;       // when should this be timed out
+  long   deadline_usec_;  // microseconds part of deadline_
 
   // used to predict timeout if now + reservedTime > deadline_
   // time_t reservedTime;
 
   bool is_timed_out_;  // timeout flag
+  bool is_cancelled_;  // cancel flag
 
   int ref_cnt_;            // reference count of this object
   pthread_mutex_t mutex_;  // mutex_ to protect ref_cnt_ and flag
@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 #include <errno.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -28,8 +29,16 @@ See the Mulan PSL v2 for more details. */
 #include <termios.h>
 #include <time.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "common/defs.h"
 #include "common/lang/string.h"
+#include "common/compress/lz4_block.h"
+#include "src/server/include/session/binary_result_protocol.h"
+#include "src/server/include/session/compression_protocol.h"
+#include "src/server/include/session/cancel_protocol.h"
 
 #ifdef USE_READLINE
 #include "readline/readline.h"
@@ -95,6 +104,36 @@ bool is_exit_command(const char *cmd) {
          0 == strncasecmp("\\q", cmd, 2) ;
 }
 
+/**
+ * @brief 取消正在执行的语句时使用，参考 cancel_protocol.h
+ * @details 信号处理函数中只能调用异步信号安全的函数，所以服务端的地址和取消语句都提前准备好
+ */
+struct sockaddr_storage server_addr;
+socklen_t               server_addr_len = 0;
+char                    kill_query_sql[64] = {0};
+volatile sig_atomic_t   query_running = 0;
+
+void cancel_query_handler(int signo)
+{
+  if (!query_running || kill_query_sql[0] == 0) {
+    // 没有正在执行的语句时与默认的行为一样，直接退出
+    signal(signo, SIG_DFL);
+    raise(signo);
+    return;
+  }
+
+  int saved_errno = errno;
+  int sockfd = socket(server_addr.ss_family, SOCK_STREAM, 0);
+  if (sockfd >= 0) {
+    if (connect(sockfd, (struct sockaddr *)&server_addr, server_addr_len) == 0) {
+      ssize_t ret = write(sockfd, kill_query_sql, strlen(kill_query_sql) + 1);
+      (void)ret;
+    }
+    close(sockfd);
+  }
+  errno = saved_errno;
+}
+
 int init_unix_sock(const char *unix_sock_path)
 {
   int sockfd = socket(PF_UNIX, SOCK_STREAM, 0);
@@ -118,6 +157,8 @@ int init_unix_sock(const char *unix_sock_path)
     close(sockfd);
     return -1;
   }
+  memcpy(&server_addr, &sockaddr, sizeof(sockaddr));
+  server_addr_len = sizeof(sockaddr);
   return sockfd;
 }
 
@@ -152,18 +193,345 @@ int init_tcp_sock(const char *server_host, int server_port)
     close(sockfd);
     return -1;
   }
+  memcpy(&server_addr, &serv_addr, sizeof(serv_addr));
+  server_addr_len = sizeof(serv_addr);
   return sockfd;
 }
 
+bool recv_exact(int sockfd, char *buf, size_t size)
+{
+  while (size > 0) {
+    ssize_t len = recv(sockfd, buf, size, 0);
+    if (len <= 0) {
+      if (len < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buf += len;
+    size -= len;
+  }
+  return true;
+}
+
+/**
+ * @brief 接收服务端的回复，打开压缩时先按照 compression_protocol.h 的格式解压
+ */
+class ResponseReader
+{
+public:
+  explicit ResponseReader(int sockfd) : sockfd_(sockfd)
+  {}
+
+  void set_compression(bool compress)
+  {
+    compress_ = compress;
+  }
+
+  /**
+   * @brief 与recv相同，返回读取的字节数，0表示连接已经关闭，-1表示出错
+   */
+  ssize_t read(char *buf, size_t size)
+  {
+    if (!compress_) {
+      return recv(sockfd_, buf, size, 0);
+    }
+    while (pos_ == decoded_.size()) {
+      if (!read_frame()) {
+        return decoded_.empty() ? 0 : -1;
+      }
+    }
+    size_t len = std::min(size, decoded_.size() - pos_);
+    memcpy(buf, decoded_.data() + pos_, len);
+    pos_ += len;
+    return len;
+  }
+
+  /**
+   * @brief 丢弃已经解压但还没有读取的数据
+   */
+  void discard()
+  {
+    pos_ = decoded_.size();
+  }
+
+  bool read_exact(char *buf, size_t size)
+  {
+    while (size > 0) {
+      ssize_t len = read(buf, size);
+      if (len <= 0) {
+        if (len < 0 && errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      buf += len;
+      size -= len;
+    }
+    return true;
+  }
+
+private:
+  bool read_frame()
+  {
+    char header[compression::FRAME_HEADER_SIZE];
+    if (!recv_exact(sockfd_, header, sizeof(header))) {
+      decoded_.clear();
+      pos_ = 0;
+      return false;
+    }
+    const uint32_t raw_size = binary_result::get_u32(header + 1);
+    frame_.resize(binary_result::get_u32(header + 5));
+    if (!recv_exact(sockfd_, frame_.data(), frame_.size())) {
+      return false;
+    }
+
+    pos_ = 0;
+    if (header[0] == compression::FRAME_RAW) {
+      decoded_.swap(frame_);
+      return decoded_.size() == raw_size;
+    }
+
+    decoded_.resize(raw_size);
+    int len = common::lz4_decompress(frame_.data(), frame_.size(), decoded_.data(), decoded_.size());
+    if (header[0] != compression::FRAME_LZ4 || len != static_cast<int>(raw_size)) {
+      fprintf(stderr, "malformed compressed frame\n");
+      return false;
+    }
+    return true;
+  }
+
+private:
+  int               sockfd_ = -1;
+  bool              compress_ = false;
+  std::vector<char> frame_;
+  std::vector<char> decoded_;  ///< 解压之后的数据
+  size_t            pos_ = 0;  ///< decoded_中已经读取的位置
+};
+
+/**
+ * @brief 发送协商连接选项的消息，并等待服务端的确认
+ * @details 参考 binary_result_protocol.h 和 compression_protocol.h
+ */
+bool negotiate(int sockfd, ResponseReader &reader, const char *hello, size_t hello_size, const char *ack)
+{
+  if (write(sockfd, hello, hello_size) != static_cast<ssize_t>(hello_size)) {
+    return false;
+  }
+
+  std::string reply;
+  char c = 0;
+  while (reader.read_exact(&c, 1) && c != 0) {
+    reply.push_back(c);
+  }
+  return c == 0 && reply == ack;
+}
+
+/**
+ * @brief 获取当前连接在服务端的会话编号，准备好取消语句时使用的SQL
+ */
+bool request_session_id(int sockfd, ResponseReader &reader)
+{
+  if (write(sockfd, cancel::HELLO, sizeof(cancel::HELLO)) != static_cast<ssize_t>(sizeof(cancel::HELLO))) {
+    return false;
+  }
+
+  std::string reply;
+  char c = 0;
+  while (reader.read_exact(&c, 1) && c != 0) {
+    reply.push_back(c);
+  }
+  if (c != 0 || reply.empty() || reply.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  snprintf(kill_query_sql, sizeof(kill_query_sql), "kill query %s", reply.c_str());
+  return true;
+}
+
+void print_cell(const std::string &cell, size_t min_width)
+{
+  if (cell.size() < min_width) {
+    printf("%*s", (int)(min_width - cell.size()), "");
+  }
+  fwrite(cell.data(), 1, cell.size(), stdout);
+}
+
+/**
+ * @brief 把一个BATCH帧按照文本协议的格式输出
+ */
+bool print_batch(const std::vector<uint8_t> &types, const char *data, const char *end, size_t min_width)
+{
+  if (end - data < 4) {
+    return false;
+  }
+  const uint32_t rows = binary_result::get_u32(data);
+  data += 4;
+
+  // 先按列解码，再按行输出
+  std::vector<std::vector<std::string>> columns(types.size());
+  for (size_t col = 0; col < types.size(); col++) {
+    const size_t null_bytes = (rows + 7) / 8;
+    if ((size_t)(end - data) < null_bytes) {
+      return false;
+    }
+    const char *nulls = data;
+    data += null_bytes;
+
+    const uint32_t *offsets = nullptr;
+    size_t value_size = 4;
+    switch (types[col]) {
+      case binary_result::COLUMN_BOOL: value_size = 1; break;
+      case binary_result::COLUMN_STRING: {
+        if ((size_t)(end - data) < (rows + 1) * sizeof(uint32_t)) {
+          return false;
+        }
+        offsets = reinterpret_cast<const uint32_t *>(data);
+        data += (rows + 1) * sizeof(uint32_t);
+        value_size = 0;
+      } break;
+      default: break;
+    }
+    const size_t data_size = offsets != nullptr ? offsets[rows] : value_size * rows;
+    if ((size_t)(end - data) < data_size) {
+      return false;
+    }
+
+    std::vector<std::string> &cells = columns[col];
+    cells.resize(rows);
+    for (uint32_t row = 0; row < rows; row++) {
+      if (nulls[row / 8] & (1 << (row % 8))) {
+        cells[row] = "NULL";
+        continue;
+      }
+      switch (types[col]) {
+        case binary_result::COLUMN_INT32: {
+          int32_t v;
+          memcpy(&v, data + row * 4, sizeof(v));
+          cells[row] = std::to_string(v);
+        } break;
+        case binary_result::COLUMN_FLOAT32: {
+          float v;
+          memcpy(&v, data + row * 4, sizeof(v));
+          cells[row] = common::double_to_str(v);
+        } break;
+        case binary_result::COLUMN_BOOL: {
+          cells[row] = data[row] ? "1" : "0";
+        } break;
+        case binary_result::COLUMN_DATE: {
+          int32_t v;
+          memcpy(&v, data + row * 4, sizeof(v));
+          char buf[16];
+          snprintf(buf, sizeof(buf), "%04d-%02d-%02d", v / 10000, (v % 10000) / 100, v % 100);
+          cells[row] = buf;
+        } break;
+        default: {
+          cells[row].assign(data + offsets[row], offsets[row + 1] - offsets[row]);
+        } break;
+      }
+    }
+    data += data_size;
+  }
+
+  for (uint32_t row = 0; row < rows; row++) {
+    for (size_t col = 0; col < columns.size(); col++) {
+      if (col != 0) {
+        printf(" | ");
+      }
+      print_cell(columns[col][row], min_width);
+    }
+    printf("\n");
+  }
+  return true;
+}
+
+/**
+ * @brief 接收一个二进制格式的回复并按照文本协议的格式输出
+ */
+bool print_binary_result(ResponseReader &reader)
+{
+  std::vector<uint8_t> types;
+  size_t min_width = 0;
+  std::vector<char> frame;
+  while (true) {
+    char header[binary_result::FRAME_HEADER_SIZE];
+    if (!reader.read_exact(header, sizeof(header))) {
+      return false;
+    }
+    frame.resize(binary_result::get_u32(header + 1));
+    if (!reader.read_exact(frame.data(), frame.size())) {
+      return false;
+    }
+
+    const char *data = frame.data();
+    const char *end = data + frame.size();
+    switch (header[0]) {
+      case binary_result::FRAME_SCHEMA: {
+        const uint16_t cell_num = binary_result::get_u16(data);
+        data += 2;
+        std::vector<std::string> names;
+        for (uint16_t i = 0; i < cell_num && data + 3 <= end; i++) {
+          types.push_back(static_cast<uint8_t>(data[0]));
+          const uint16_t len = binary_result::get_u16(data + 1);
+          names.emplace_back(data + 3, len);
+          min_width = std::max(min_width, (size_t)len);
+          data += 3 + len;
+        }
+        for (size_t i = 0; i < names.size(); i++) {
+          if (i != 0) {
+            printf(" | ");
+          }
+          print_cell(names[i], min_width);
+        }
+        if (!names.empty()) {
+          printf("\n");
+        }
+      } break;
+      case binary_result::FRAME_BATCH: {
+        if (!print_batch(types, data, end, min_width)) {
+          fprintf(stderr, "malformed result batch\n");
+          return false;
+        }
+      } break;
+      case binary_result::FRAME_END: {
+        const int32_t rc = binary_result::get_u32(data);
+        const uint16_t name_len = binary_result::get_u16(data + 4);
+        std::string rc_name(data + 6, name_len);
+        std::string state(data + 10 + name_len, binary_result::get_u32(data + 6 + name_len));
+        // 与文本协议的输出保持一致，有结果集并且成功时不输出状态
+        if (!state.empty()) {
+          printf("%s > %s\n", rc_name.c_str(), state.c_str());
+        } else if (rc != 0) {
+          printf("Failure : %s\n", rc_name.c_str());
+        } else if (types.empty()) {
+          printf("SUCCESS\n");
+        }
+        return true;
+      }
+      default: {
+        fprintf(stderr, "unknown frame type %d\n", header[0]);
+        return false;
+      }
+    }
+  }
+}
+
 int main(int argc, char *argv[])
 {
   const char *unix_socket_path = nullptr;
   const char *server_host = "127.0.0.1";
   int server_port = PORT_DEFAULT;
+  bool binary_result = false;
+  bool compress = false;
   int opt;
   extern char *optarg;
-  while ((opt = getopt(argc, argv, "s:h:p:")) > 0) {
+  while ((opt = getopt(argc, argv, "s:h:p:bz")) > 0) {
     switch (opt) {
+      case 'z':
+        compress = true;
+        break;
+      case 'b':
+        binary_result = true;
+        break;
       case 's':
         unix_socket_path = optarg;
         break;
@@ -188,6 +556,32 @@ int main(int argc, char *argv[])
   if (sockfd < 0) {
     return 1;
   }
+  ResponseReader reader(sockfd);
+  // 获取会话编号之后，Ctrl-C 可以取消正在执行的语句。需要在协商压缩之前获取
+  if (request_session_id(sockfd, reader)) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = cancel_query_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+  } else {
+    fprintf(stderr, "failed to get session id, query cancel is not supported\n");
+  }
+  if (binary_result &&
+      !negotiate(sockfd, reader, binary_result::HELLO, sizeof(binary_result::HELLO), binary_result::HELLO_ACK)) {
+    fprintf(stderr, "server doesn't support binary result set\n");
+    close(sockfd);
+    return 1;
+  }
+  if (compress) {
+    if (!negotiate(sockfd, reader, compression::HELLO, sizeof(compression::HELLO), compression::HELLO_ACK)) {
+      fprintf(stderr, "server doesn't support compression\n");
+      close(sockfd);
+      return 1;
+    }
+    reader.set_compression(true);
+  }
 
   char send_buf[MAX_MEM_BUFFER_SIZE];
 
@@ -208,10 +602,20 @@ int main(int argc, char *argv[])
       exit(1);
     }
     free(input_command);
+    query_running = 1;
+    if (binary_result) {
+      bool ok = print_binary_result(reader);
+      query_running = 0;
+      if (!ok) {
+        printf("Connection has been closed\n");
+        break;
+      }
+      continue;
+    }
     memset(send_buf, 0, sizeof(send_buf));
 
     int len = 0;
-    while ((len = recv(sockfd, send_buf, MAX_MEM_BUFFER_SIZE, 0)) > 0) {
+    while ((len = reader.read(send_buf, MAX_MEM_BUFFER_SIZE)) > 0) {
       bool msg_end = false;
       for (int i = 0; i < len; i++) {
         if (0 == send_buf[i]) {
@@ -221,10 +625,13 @@ int main(int argc, char *argv[])
         printf("%c", send_buf[i]);
       }
       if (msg_end) {
+        // 与不压缩时一样，丢弃同一次接收到的消息结尾之后的数据
+        reader.discard();
         break;
       }
       memset(send_buf, 0, MAX_MEM_BUFFER_SIZE);
     }
+    query_running = 0;
 
     if (len < 0) {
       perror("recv error");
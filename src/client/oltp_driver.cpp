@@ -0,0 +1,622 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/lang/string.h"
+#include "common/metrics/hdr_histogram.h"
+#include "src/server/include/session/binary_result_protocol.h"
+
+/**
+ * @brief TDB 的 OLTP 压测工具
+ * @details 类似 sysbench oltp 的负载：先建表并按照规模因子导入数据，然后多个连接同时执行
+ * 点查、范围查询、插入、更新和删除的混合负载，最后按事务类型输出吞吐和延迟分位数。
+ * 每个连接一个线程，每个事务就是一条语句，延迟是从发送语句到收到完整回复的时间。
+ * 连接使用二进制结果集协议(参考 binary_result_protocol.h)，根据返回码判断语句是否成功。
+ *
+ * 示例：
+ *   ./bin/oltp_driver -p 6789 -c 8 -S 2 -t 60
+ *   ./bin/oltp_driver -s /tmp/tdb.sock -L -m point=80,range=20
+ */
+
+#define PORT_DEFAULT 6789
+
+static const int ROWS_PER_SCALE = 10000;  ///< 规模因子为1时导入的行数
+static const int LOAD_BATCH_ROWS = 100;   ///< 导入数据时每条insert语句的行数
+static const int MAX_ERROR_LOGS = 10;     ///< 最多输出多少条失败的语句
+static const char *TABLE_NAME = "oltp";
+
+enum TxnType
+{
+  POINT_SELECT,
+  RANGE_SCAN,
+  INSERT,
+  UPDATE,
+  DELETE,
+  TXN_TYPE_NUM,
+};
+
+static const char *TXN_TYPE_NAMES[TXN_TYPE_NUM] = {"point", "range", "insert", "update", "delete"};
+
+struct Options
+{
+  const char *host = "127.0.0.1";
+  int         port = PORT_DEFAULT;
+  const char *unix_socket_path = nullptr;
+  int         connections = 4;
+  int         duration_seconds = 30;
+  int         scale = 1;
+  int         range_size = 100;
+  int         report_interval = 10;  ///< 运行过程中输出进度的间隔，0表示不输出
+  bool        skip_load = false;     ///< 使用已经导入的数据，不重新建表
+  int         weights[TXN_TYPE_NUM] = {50, 10, 15, 20, 5};
+};
+
+/**
+ * @brief 一条语句的执行结果
+ */
+struct Result
+{
+  int         rc = 0;
+  std::string rc_name;
+  std::string state;
+  long        rows = 0;
+};
+
+/**
+ * @brief 到服务端的一个连接
+ */
+class Connection
+{
+public:
+  Connection() = default;
+  ~Connection() { close(); }
+
+  bool open(const Options &options)
+  {
+    if (options.unix_socket_path != nullptr) {
+      fd_ = connect_unix(options.unix_socket_path);
+    } else {
+      fd_ = connect_tcp(options.host, options.port);
+    }
+    if (fd_ < 0) {
+      return false;
+    }
+
+    if (!send(binary_result::HELLO, sizeof(binary_result::HELLO))) {
+      return false;
+    }
+    std::string reply;
+    char c = 0;
+    while (recv_exact(&c, 1) && c != 0) {
+      reply.push_back(c);
+    }
+    if (c != 0 || reply != binary_result::HELLO_ACK) {
+      fprintf(stderr, "server doesn't support binary result set\n");
+      return false;
+    }
+    return true;
+  }
+
+  void close()
+  {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  /**
+   * @brief 执行一条语句，读取完整的回复
+   * @return 连接断开或者回复格式不对时返回false
+   */
+  bool execute(const std::string &sql, Result &result)
+  {
+    result = Result();
+    if (!send(sql.c_str(), sql.size() + 1)) {
+      return false;
+    }
+
+    while (true) {
+      char header[binary_result::FRAME_HEADER_SIZE];
+      if (!recv_exact(header, sizeof(header))) {
+        return false;
+      }
+      frame_.resize(binary_result::get_u32(header + 1));
+      if (!recv_exact(frame_.data(), frame_.size())) {
+        return false;
+      }
+
+      const char *data = frame_.data();
+      switch (header[0]) {
+        case binary_result::FRAME_SCHEMA: {
+        } break;
+        case binary_result::FRAME_BATCH: {
+          if (frame_.size() < 4) {
+            return false;
+          }
+          result.rows += binary_result::get_u32(data);
+        } break;
+        case binary_result::FRAME_END: {
+          if (frame_.size() < 10) {
+            return false;
+          }
+          result.rc = static_cast<int32_t>(binary_result::get_u32(data));
+          const uint16_t name_len = binary_result::get_u16(data + 4);
+          result.rc_name.assign(data + 6, name_len);
+          result.state.assign(data + 10 + name_len, binary_result::get_u32(data + 6 + name_len));
+          return true;
+        }
+        default: {
+          fprintf(stderr, "unknown frame type %d\n", header[0]);
+          return false;
+        }
+      }
+    }
+  }
+
+private:
+  static int connect_unix(const char *path)
+  {
+    int sockfd = socket(PF_UNIX, SOCK_STREAM, 0);
+    if (sockfd < 0) {
+      fprintf(stderr, "failed to create unix socket. %s\n", strerror(errno));
+      return -1;
+    }
+
+    struct sockaddr_un sockaddr;
+    memset(&sockaddr, 0, sizeof(sockaddr));
+    sockaddr.sun_family = PF_UNIX;
+    snprintf(sockaddr.sun_path, sizeof(sockaddr.sun_path), "%s", path);
+    if (connect(sockfd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) < 0) {
+      fprintf(stderr, "failed to connect to server. unix socket path '%s'. error %s\n", path, strerror(errno));
+      ::close(sockfd);
+      return -1;
+    }
+    return sockfd;
+  }
+
+  static int connect_tcp(const char *host, int port)
+  {
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *addr = nullptr;
+    int ret = getaddrinfo(host, std::to_string(port).c_str(), &hints, &addr);
+    if (ret != 0) {
+      fprintf(stderr, "failed to resolve %s. %s\n", host, gai_strerror(ret));
+      return -1;
+    }
+
+    int sockfd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (sockfd < 0) {
+      fprintf(stderr, "create socket error. errmsg=%d:%s\n", errno, strerror(errno));
+      freeaddrinfo(addr);
+      return -1;
+    }
+    if (connect(sockfd, addr->ai_addr, addr->ai_addrlen) < 0) {
+      fprintf(stderr, "Failed to connect %s:%d. errmsg=%d:%s\n", host, port, errno, strerror(errno));
+      ::close(sockfd);
+      freeaddrinfo(addr);
+      return -1;
+    }
+    freeaddrinfo(addr);
+    return sockfd;
+  }
+
+  bool send(const char *data, size_t size)
+  {
+    while (size > 0) {
+      ssize_t len = write(fd_, data, size);
+      if (len < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += len;
+      size -= len;
+    }
+    return true;
+  }
+
+  bool recv_exact(char *buf, size_t size)
+  {
+    while (size > 0) {
+      ssize_t len = recv(fd_, buf, size, 0);
+      if (len <= 0) {
+        if (len < 0 && errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      buf += len;
+      size -= len;
+    }
+    return true;
+  }
+
+private:
+  int               fd_ = -1;
+  std::vector<char> frame_;
+};
+
+/**
+ * @brief 一种事务类型的统计，所有连接共用
+ */
+struct TxnStat
+{
+  std::atomic<long>    count{0};
+  std::atomic<long>    errors{0};
+  common::HdrHistogram latency_us;  ///< 以微秒为单位
+};
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void stop_handler(int) { stop_requested = 1; }
+
+static std::atomic<int> error_logs{0};
+
+static void log_error(const std::string &sql, const Result &result)
+{
+  if (error_logs.fetch_add(1) < MAX_ERROR_LOGS) {
+    fprintf(stderr, "failed to execute '%s'. rc=%s %s\n", sql.c_str(), result.rc_name.c_str(), result.state.c_str());
+  }
+}
+
+static std::string make_c_value(std::mt19937 &random)
+{
+  char buf[32];
+  snprintf(buf, sizeof(buf), "c-%08u-%08u", (unsigned)random() % 100000000, (unsigned)random() % 100000000);
+  return buf;
+}
+
+static std::string make_row(int id, std::mt19937 &random)
+{
+  return "(" + std::to_string(id) + "," + std::to_string(random() % 1000000) + ",'" + make_c_value(random) +
+         "','pad-" + std::to_string(id % 1000) + "')";
+}
+
+/**
+ * @brief 执行一条必须成功的语句，失败时输出错误
+ */
+static bool execute_checked(Connection &connection, const std::string &sql)
+{
+  Result result;
+  if (!connection.execute(sql, result)) {
+    fprintf(stderr, "connection broken while executing '%s'\n", sql.c_str());
+    return false;
+  }
+  if (result.rc != 0) {
+    fprintf(stderr, "failed to execute '%s'. rc=%s %s\n", sql.c_str(), result.rc_name.c_str(), result.state.c_str());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief 建表并导入 [1, rows] 的数据，导入由所有连接分段并行完成
+ */
+static bool load_data(const Options &options, int rows)
+{
+  Connection connection;
+  if (!connection.open(options)) {
+    return false;
+  }
+
+  Result result;
+  connection.execute(std::string("drop table ") + TABLE_NAME, result);  // 表不存在时会失败，忽略
+  const std::string create_table =
+      std::string("create table ") + TABLE_NAME + "(id int, k int, c char(32), pad char(16))";
+  const std::string create_index = std::string("create index ") + TABLE_NAME + "_id on " + TABLE_NAME + "(id)";
+  if (!execute_checked(connection, create_table) || !execute_checked(connection, create_index)) {
+    return false;
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+  std::atomic<bool> ok{true};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < options.connections; i++) {
+    threads.emplace_back([&options, &ok, rows, i]() {
+      Connection loader;
+      if (!loader.open(options)) {
+        ok = false;
+        return;
+      }
+      std::mt19937 random(i + 1);
+      const int first = (long)rows * i / options.connections + 1;
+      const int last = (long)rows * (i + 1) / options.connections;
+      for (int id = first; id <= last && ok && !stop_requested; id += LOAD_BATCH_ROWS) {
+        std::string sql = std::string("insert into ") + TABLE_NAME + " values ";
+        for (int j = id; j < id + LOAD_BATCH_ROWS && j <= last; j++) {
+          if (j != id) {
+            sql += ",";
+          }
+          sql += make_row(j, random);
+        }
+        if (!execute_checked(loader, sql)) {
+          ok = false;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  if (ok && !stop_requested) {
+    printf("loaded %d rows in %.2f s (%.0f rows/s)\n", rows, seconds, rows / seconds);
+  }
+  return ok && !stop_requested;
+}
+
+/**
+ * @brief 按照权重随机选择事务类型
+ */
+static TxnType choose_txn(const Options &options, int total_weight, std::mt19937 &random)
+{
+  int value = random() % total_weight;
+  for (int i = 0; i < TXN_TYPE_NUM; i++) {
+    if (value < options.weights[i]) {
+      return static_cast<TxnType>(i);
+    }
+    value -= options.weights[i];
+  }
+  return POINT_SELECT;
+}
+
+/**
+ * @brief 运行阶段共享的状态
+ * @details 插入的id从导入的数据之后开始递增，删除按顺序删除运行期间插入的数据，所以导入的数据一直都在，
+ * 点查和更新总是能找到记录。删除追上插入之后删除的记录不存在，语句仍然是成功的。
+ */
+struct Workload
+{
+  const Options      *options = nullptr;
+  int                 rows = 0;
+  int                 total_weight = 0;
+  std::atomic<int>    next_insert_id{0};
+  std::atomic<int>    next_delete_id{0};
+  std::atomic<bool>   stopped{false};
+  std::atomic<int>    broken_connections{0};
+  TxnStat             stats[TXN_TYPE_NUM];
+};
+
+static std::string make_sql(TxnType type, Workload &workload, std::mt19937 &random)
+{
+  const std::string table = TABLE_NAME;
+  const int id = random() % workload.rows + 1;
+  switch (type) {
+    case POINT_SELECT: {
+      return "select id, k, c from " + table + " where id = " + std::to_string(id);
+    }
+    case RANGE_SCAN: {
+      return "select id, k from " + table + " where id >= " + std::to_string(id) +
+             " and id < " + std::to_string(id + workload.options->range_size);
+    }
+    case INSERT: {
+      return "insert into " + table + " values " + make_row(workload.next_insert_id.fetch_add(1), random);
+    }
+    case UPDATE: {
+      return "update " + table + " set k = " + std::to_string(random() % 1000000) + " where id = " + std::to_string(id);
+    }
+    default: {
+      return "delete from " + table + " where id = " + std::to_string(workload.next_delete_id.fetch_add(1));
+    }
+  }
+}
+
+static void run_worker(Workload &workload, int index)
+{
+  Connection connection;
+  if (!connection.open(*workload.options)) {
+    workload.broken_connections++;
+    return;
+  }
+
+  std::mt19937 random(1000 + index);
+  Result result;
+  while (!workload.stopped.load(std::memory_order_relaxed)) {
+    const TxnType type = choose_txn(*workload.options, workload.total_weight, random);
+    const std::string sql = make_sql(type, workload, random);
+
+    const auto begin = std::chrono::steady_clock::now();
+    if (!connection.execute(sql, result)) {
+      fprintf(stderr, "connection %d broken while executing '%s'\n", index, sql.c_str());
+      workload.broken_connections++;
+      return;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    TxnStat &stat = workload.stats[type];
+    stat.count.fetch_add(1, std::memory_order_relaxed);
+    stat.latency_us.update(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+    if (result.rc != 0) {
+      stat.errors.fetch_add(1, std::memory_order_relaxed);
+      log_error(sql, result);
+    }
+  }
+}
+
+static long total_count(Workload &workload)
+{
+  long count = 0;
+  for (TxnStat &stat : workload.stats) {
+    count += stat.count.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+static void print_report(Workload &workload, double seconds)
+{
+  printf("\n%-8s %10s %8s %10s %9s %9s %9s %9s %9s\n",
+      "type", "count", "errors", "tps", "avg(ms)", "p50(ms)", "p95(ms)", "p99(ms)", "max(ms)");
+  long total = 0;
+  long total_errors = 0;
+  for (int i = 0; i < TXN_TYPE_NUM; i++) {
+    TxnStat &stat = workload.stats[i];
+    stat.latency_us.snapshot();
+    auto *snapshot = static_cast<common::HdrHistogramSnapshot *>(stat.latency_us.get_snapshot());
+    const long count = stat.count.load();
+    const long errors = stat.errors.load();
+    total += count;
+    total_errors += errors;
+    if (workload.options->weights[i] == 0) {
+      continue;
+    }
+    printf("%-8s %10ld %8ld %10.1f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+        TXN_TYPE_NAMES[i], count, errors, count / seconds,
+        snapshot->mean() / 1000, snapshot->quantile(0.5) / 1000, snapshot->quantile(0.95) / 1000,
+        snapshot->quantile(0.99) / 1000, snapshot->max() / 1000);
+  }
+  printf("%-8s %10ld %8ld %10.1f\n", "total", total, total_errors, total / seconds);
+}
+
+/**
+ * @brief 解析 point=50,range=10 格式的负载比例，没有出现的类型权重为0
+ */
+static bool parse_mix(const char *mix, Options &options)
+{
+  int weights[TXN_TYPE_NUM] = {0};
+  std::vector<std::string> items;
+  common::split_string(mix, ",", items);
+  for (std::string &item : items) {
+    common::strip(item);
+    const size_t pos = item.find('=');
+    if (pos == std::string::npos) {
+      return false;
+    }
+    const std::string name = item.substr(0, pos);
+    int i = 0;
+    while (i < TXN_TYPE_NUM && name != TXN_TYPE_NAMES[i]) {
+      i++;
+    }
+    if (i == TXN_TYPE_NUM) {
+      return false;
+    }
+    weights[i] = atoi(item.c_str() + pos + 1);
+    if (weights[i] < 0) {
+      return false;
+    }
+  }
+  memcpy(options.weights, weights, sizeof(weights));
+  return true;
+}
+
+static void usage(const char *program)
+{
+  fprintf(stderr,
+      "Usage: %s [-h host] [-p port] [-s unix_socket] [-c connections] [-t seconds] [-S scale]\n"
+      "          [-r range_size] [-m mix] [-i report_interval] [-L]\n"
+      "  -S scale   load scale * %d rows, default 1\n"
+      "  -m mix     weights of transaction types, default point=50,range=10,insert=15,update=20,delete=5\n"
+      "  -L         skip creating table and loading data, use the data loaded before with the same scale\n",
+      program, ROWS_PER_SCALE);
+}
+
+int main(int argc, char *argv[])
+{
+  Options options;
+  int opt;
+  extern char *optarg;
+  while ((opt = getopt(argc, argv, "h:p:s:c:t:S:r:m:i:L")) > 0) {
+    switch (opt) {
+      case 'h': options.host = optarg; break;
+      case 'p': options.port = atoi(optarg); break;
+      case 's': options.unix_socket_path = optarg; break;
+      case 'c': options.connections = atoi(optarg); break;
+      case 't': options.duration_seconds = atoi(optarg); break;
+      case 'S': options.scale = atoi(optarg); break;
+      case 'r': options.range_size = atoi(optarg); break;
+      case 'i': options.report_interval = atoi(optarg); break;
+      case 'L': options.skip_load = true; break;
+      case 'm': {
+        if (!parse_mix(optarg, options)) {
+          fprintf(stderr, "invalid mix: %s\n", optarg);
+          usage(argv[0]);
+          return 1;
+        }
+      } break;
+      default: {
+        usage(argv[0]);
+        return 1;
+      }
+    }
+  }
+
+  int total_weight = 0;
+  for (int weight : options.weights) {
+    total_weight += weight;
+  }
+  if (options.connections <= 0 || options.duration_seconds <= 0 || options.scale <= 0 || options.range_size <= 0 ||
+      total_weight <= 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  signal(SIGPIPE, SIG_IGN);
+  signal(SIGINT, stop_handler);
+  signal(SIGTERM, stop_handler);
+
+  const int rows = options.scale * ROWS_PER_SCALE;
+  if (!options.skip_load && !load_data(options, rows)) {
+    fprintf(stderr, "failed to load data\n");
+    return 1;
+  }
+
+  Workload workload;
+  workload.options = &options;
+  workload.rows = rows;
+  workload.total_weight = total_weight;
+  workload.next_insert_id = rows + 1;
+  workload.next_delete_id = rows + 1;
+
+  printf("running %d connections for %d s on %d rows\n", options.connections, options.duration_seconds, rows);
+  const auto begin = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < options.connections; i++) {
+    threads.emplace_back(run_worker, std::ref(workload), i);
+  }
+
+  long last_count = 0;
+  int elapsed = 0;
+  while (elapsed < options.duration_seconds && !stop_requested &&
+         workload.broken_connections.load() < options.connections) {
+    std::this_thread::sleep_until(begin + std::chrono::seconds(elapsed + 1));
+    elapsed++;
+    if (options.report_interval > 0 && elapsed % options.report_interval == 0) {
+      const long count = total_count(workload);
+      printf("[%4d s] tps %.1f\n", elapsed, (double)(count - last_count) / options.report_interval);
+      fflush(stdout);
+      last_count = count;
+    }
+  }
+  workload.stopped = true;
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  print_report(workload, seconds);
+  if (workload.broken_connections.load() > 0) {
+    fprintf(stderr, "%d connections broken\n", workload.broken_connections.load());
+    return 1;
+  }
+  return 0;
+}
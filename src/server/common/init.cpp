@@ -12,6 +12,12 @@
 #include "include/storage_engine/schema/default_handler.h"
 #include "include/storage_engine/transaction/trx.h"
 #include "include/common/global_context.h"
+#include "include/query_engine/executor/query_cache.h"
+#include "include/query_engine/executor/admission_controller.h"
+#include "include/query_engine/executor/slow_query_log.h"
+#include "include/common/server_metrics.h"
+#include "include/common/query_trace.h"
+#include "include/session/metrics_http_server.h"
 
 using namespace common;
 
@@ -98,6 +104,34 @@ int init_log(ProcessParam *process_cfg, Ini &properties)
       g_log->set_default_module(it->second);
     }
 
+    key = ("ASYNC");
+    it = log_section.find(key);
+    int async = 0;
+    if (it != log_section.end()) {
+      str_to_val(it->second, async);
+    }
+    if (async != 0) {
+      size_t buffer_size = 1024 * 1024;
+      it = log_section.find("ASYNC_BUFFER_SIZE");
+      if (it != log_section.end()) {
+        str_to_val(it->second, buffer_size);
+      }
+
+      LOG_OVERFLOW overflow = LOG_OVERFLOW_BLOCK;
+      it = log_section.find("ASYNC_OVERFLOW");
+      if (it != log_section.end() && 0 == strcasecmp(it->second.c_str(), "drop")) {
+        overflow = LOG_OVERFLOW_DROP;
+      }
+
+      int flush_interval_ms = 10;
+      it = log_section.find("ASYNC_FLUSH_INTERVAL_MS");
+      if (it != log_section.end()) {
+        str_to_val(it->second, flush_interval_ms);
+      }
+
+      g_log->enable_async(buffer_size, overflow, flush_interval_ms);
+    }
+
     if (process_cfg->is_demon()) {
       sys_log_redirect(log_file_name.c_str(), log_file_name.c_str());
     }
@@ -111,6 +145,194 @@ int init_log(ProcessParam *process_cfg, Ini &properties)
   return 0;
 }
 
+int init_query_cache(Ini &properties)
+{
+  const std::string query_cache_section_name = "QUERY_CACHE";
+  std::map<std::string, std::string> query_cache_section = properties.get(query_cache_section_name);
+
+  int enable = 0;
+  std::map<std::string, std::string>::iterator it = query_cache_section.find("ENABLE");
+  if (it != query_cache_section.end()) {
+    str_to_val(it->second, enable);
+  }
+  if (enable == 0) {
+    return 0;
+  }
+
+  size_t capacity = 64 * 1024 * 1024;
+  it = query_cache_section.find("CAPACITY");
+  if (it != query_cache_section.end()) {
+    str_to_val(it->second, capacity);
+  }
+
+  GCTX.query_cache_ = new QueryCache(capacity);
+  LOG_INFO("query cache enabled. capacity=%zu", capacity);
+  return 0;
+}
+
+int init_admission_controller(Ini &properties)
+{
+  const std::string admission_section_name = "ADMISSION";
+  std::map<std::string, std::string> admission_section = properties.get(admission_section_name);
+
+  int enable = 0;
+  std::map<std::string, std::string>::iterator it = admission_section.find("ENABLE");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, enable);
+  }
+  if (enable == 0) {
+    return 0;
+  }
+
+  AdmissionController::Options options;
+  it = admission_section.find("MEMORY_BUDGET");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.memory_budget);
+  }
+  it = admission_section.find("QUERY_MEMORY_LIMIT");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.query_memory_limit);
+  }
+  it = admission_section.find("INITIAL_GRANT");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.initial_grant);
+  }
+  it = admission_section.find("OLTP_SLOTS");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.oltp_slots);
+  }
+  it = admission_section.find("ANALYTIC_SLOTS");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.analytic_slots);
+  }
+  it = admission_section.find("MAX_QUEUE_LENGTH");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.max_queue_length);
+  }
+  it = admission_section.find("QUEUE_TIMEOUT_MS");
+  if (it != admission_section.end()) {
+    str_to_val(it->second, options.queue_timeout_ms);
+  }
+
+  GCTX.admission_controller_ = new AdmissionController(options);
+  LOG_INFO("admission control enabled. memory_budget=%zu, query_memory_limit=%zu, oltp_slots=%d, analytic_slots=%d",
+           options.memory_budget, options.query_memory_limit, options.oltp_slots, options.analytic_slots);
+  return 0;
+}
+
+int init_slow_query_log(Ini &properties)
+{
+  const std::string slow_query_section_name = "SLOW_QUERY";
+  std::map<std::string, std::string> slow_query_section = properties.get(slow_query_section_name);
+
+  int enable = 0;
+  std::map<std::string, std::string>::iterator it = slow_query_section.find("ENABLE");
+  if (it != slow_query_section.end()) {
+    str_to_val(it->second, enable);
+  }
+  if (enable == 0) {
+    return 0;
+  }
+
+  SlowQueryLog::Options options;
+  it = slow_query_section.find("THRESHOLD_MS");
+  if (it != slow_query_section.end()) {
+    str_to_val(it->second, options.threshold_ms);
+  }
+  it = slow_query_section.find("LOG_FILE");
+  if (it != slow_query_section.end()) {
+    options.file_name = it->second;
+  }
+  int operator_stats = 0;
+  it = slow_query_section.find("OPERATOR_STATS");
+  if (it != slow_query_section.end()) {
+    str_to_val(it->second, operator_stats);
+  }
+  options.operator_stats = operator_stats != 0;
+  it = slow_query_section.find("MAX_ENTRIES");
+  if (it != slow_query_section.end()) {
+    str_to_val(it->second, options.max_entries);
+  }
+
+  // 日志文件打不开时不影响数据库本身的服务
+  SlowQueryLog *slow_query_log = new SlowQueryLog(options);
+  RC rc = slow_query_log->start();
+  if (RC_FAIL(rc)) {
+    LOG_ERROR("failed to start slow query log. rc=%s", strrc(rc));
+    delete slow_query_log;
+    return 0;
+  }
+  GCTX.slow_query_log_ = slow_query_log;
+  LOG_INFO("slow query log enabled. threshold_ms=%ld, file=%s, operator_stats=%d",
+           options.threshold_ms, options.file_name.c_str(), operator_stats);
+  return 0;
+}
+
+int init_query_trace(Ini &properties)
+{
+  const std::string trace_section_name = "TRACE";
+  std::map<std::string, std::string> trace_section = properties.get(trace_section_name);
+
+  QueryTrace::Options options;
+  std::map<std::string, std::string>::iterator it = trace_section.find("DIR");
+  if (it != trace_section.end()) {
+    options.dir = it->second;
+  }
+  it = trace_section.find("MAX_EVENTS");
+  if (it != trace_section.end()) {
+    str_to_val(it->second, options.max_events);
+  }
+  QueryTrace::set_options(options);
+  return 0;
+}
+
+int init_metrics(Ini &properties)
+{
+  const std::string metrics_section_name = "METRICS";
+  std::map<std::string, std::string> metrics_section = properties.get(metrics_section_name);
+
+  int report_interval_sec = 0;
+  std::map<std::string, std::string>::iterator it = metrics_section.find("REPORT_INTERVAL_SEC");
+  if (it != metrics_section.end()) {
+    str_to_val(it->second, report_interval_sec);
+  }
+
+  ServerMetrics::instance().init(report_interval_sec);
+
+  int lock_profiling = 0;
+  it = metrics_section.find("LOCK_PROFILING");
+  if (it != metrics_section.end()) {
+    str_to_val(it->second, lock_profiling);
+  }
+  common::LockProfiler::set_enabled(lock_profiling != 0);
+
+  int http_port = 0;
+  it = metrics_section.find("HTTP_PORT");
+  if (it != metrics_section.end()) {
+    str_to_val(it->second, http_port);
+  }
+  if (http_port <= 0) {
+    return 0;
+  }
+
+  std::string http_address = "127.0.0.1";
+  it = metrics_section.find("HTTP_ADDRESS");
+  if (it != metrics_section.end()) {
+    http_address = it->second;
+  }
+
+  // 指标服务启动失败不影响数据库本身的服务
+  MetricsHttpServer *http_server = new MetricsHttpServer();
+  RC rc = http_server->start(http_address, http_port);
+  if (RC_FAIL(rc)) {
+    LOG_ERROR("failed to start metrics http server. rc=%s", strrc(rc));
+    delete http_server;
+    return 0;
+  }
+  GCTX.metrics_http_server_ = http_server;
+  return 0;
+}
+
 void cleanup_log()
 {
 
@@ -143,11 +365,38 @@ int init_global_objects(ProcessParam *process_param, Ini &properties)
     LOG_ERROR("failed to init handler. rc=%s", strrc(rc));
     return -1;
   }
+
+  init_query_cache(properties);
+  init_admission_controller(properties);
+  init_slow_query_log(properties);
+  init_query_trace(properties);
+  init_metrics(properties);
   return ret;
 }
 
 int uninit_global_objects()
 {
+  if (GCTX.metrics_http_server_ != nullptr) {
+    delete GCTX.metrics_http_server_;
+    GCTX.metrics_http_server_ = nullptr;
+  }
+  ServerMetrics::instance().cleanup();
+
+  if (GCTX.query_cache_ != nullptr) {
+    delete GCTX.query_cache_;
+    GCTX.query_cache_ = nullptr;
+  }
+
+  if (GCTX.admission_controller_ != nullptr) {
+    delete GCTX.admission_controller_;
+    GCTX.admission_controller_ = nullptr;
+  }
+
+  if (GCTX.slow_query_log_ != nullptr) {
+    delete GCTX.slow_query_log_;
+    GCTX.slow_query_log_ = nullptr;
+  }
+
   // TODO use global context
   DefaultHandler *default_handler = &DefaultHandler::get_default();
   if (default_handler != nullptr) {
@@ -0,0 +1,200 @@
+#include "include/common/query_trace.h"
+#include "common/lang/mutex.h"
+#include "common/log/log.h"
+#include "common/os/path.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+thread_local QueryTrace::ThreadBuffer *QueryTrace::thread_buffer_ = nullptr;
+
+static QueryTrace::Options &trace_options()
+{
+  static QueryTrace::Options options;
+  return options;
+}
+
+static std::atomic<uint64_t> trace_sequence{0};
+
+static void observe_lock_wait(const common::LockSite &site, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end)
+{
+  QueryTrace::complete("lock_wait", site.name, begin, end);
+}
+
+void QueryTrace::set_options(const Options &options)
+{
+  trace_options() = options;
+}
+
+const QueryTrace::Options &QueryTrace::options()
+{
+  return trace_options();
+}
+
+QueryTrace::QueryTrace() : start_(std::chrono::steady_clock::now())
+{}
+
+QueryTrace::~QueryTrace()
+{
+  if (thread_buffer_ != nullptr && thread_buffer_->trace == this) {
+    detach();
+  }
+}
+
+void QueryTrace::attach()
+{
+  auto buffer = std::make_unique<ThreadBuffer>();
+  buffer->trace = this;
+  buffer->tid = static_cast<uint64_t>(gettid());
+  thread_buffer_ = buffer.get();
+  common::LockProfiler::set_thread_wait_observer(observe_lock_wait);
+
+  std::lock_guard<std::mutex> guard(lock_);
+  buffers_.push_back(std::move(buffer));
+}
+
+void QueryTrace::detach()
+{
+  thread_buffer_ = nullptr;
+  common::LockProfiler::set_thread_wait_observer(nullptr);
+}
+
+void QueryTrace::complete(const char *category, std::string name, std::chrono::steady_clock::time_point begin,
+    std::string args)
+{
+  complete(category, std::move(name), begin, std::chrono::steady_clock::now(), std::move(args));
+}
+
+void QueryTrace::complete(const char *category, std::string name, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end, std::string args)
+{
+  ThreadBuffer *buffer = thread_buffer_;
+  if (buffer == nullptr) {
+    return;
+  }
+
+  QueryTrace *trace = buffer->trace;
+  if (trace->total_events_.fetch_add(1, std::memory_order_relaxed) >= options().max_events) {
+    trace->dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Event event;
+  event.category = category;
+  event.name = std::move(name);
+  event.ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - trace->start_).count();
+  event.dur_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  event.args = std::move(args);
+  buffer->events.push_back(std::move(event));
+}
+
+std::string QueryTrace::json_string(const std::string &str)
+{
+  std::string result;
+  result.reserve(str.size() + 2);
+  result.push_back('"');
+  for (char c : str) {
+    switch (c) {
+      case '"': result.append("\\\""); break;
+      case '\\': result.append("\\\\"); break;
+      case '\n': result.append("\\n"); break;
+      case '\r': result.append("\\r"); break;
+      case '\t': result.append("\\t"); break;
+      default: {
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          result.append(buf);
+        } else {
+          result.push_back(c);
+        }
+      } break;
+    }
+  }
+  result.push_back('"');
+  return result;
+}
+
+size_t QueryTrace::event_count() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  size_t count = 0;
+  for (const auto &buffer : buffers_) {
+    count += buffer->events.size();
+  }
+  return count;
+}
+
+std::string QueryTrace::to_json() const
+{
+  const uint64_t pid = static_cast<uint64_t>(getpid());
+  std::string out;
+  out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+  std::lock_guard<std::mutex> guard(lock_);
+  bool first = true;
+  char buf[160];
+  for (const auto &buffer : buffers_) {
+    // 嵌套的事件按开始时间排序，开始时间相同的外层事件在前
+    std::vector<const Event *> events;
+    events.reserve(buffer->events.size());
+    for (const Event &event : buffer->events) {
+      events.push_back(&event);
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event *a, const Event *b) {
+      return a->ts_ns != b->ts_ns ? a->ts_ns < b->ts_ns : a->dur_ns > b->dur_ns;
+    });
+
+    for (const Event *event : events) {
+      out.append(first ? "\n" : ",\n");
+      first = false;
+      out.append("{\"name\":").append(json_string(event->name));
+      snprintf(buf, sizeof(buf), ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lu,\"tid\":%lu",
+          event->category, event->ts_ns / 1000.0, event->dur_ns / 1000.0,
+          static_cast<unsigned long>(pid), static_cast<unsigned long>(buffer->tid));
+      out.append(buf);
+      if (!event->args.empty()) {
+        out.append(",\"args\":{").append(event->args).append("}");
+      }
+      out.append("}");
+    }
+  }
+
+  snprintf(buf, sizeof(buf), "\n],\"otherData\":{\"dropped_events\":%lu}}\n",
+      static_cast<unsigned long>(dropped_count()));
+  out.append(buf);
+  return out;
+}
+
+RC QueryTrace::dump(uint64_t session_id, std::string &file_name) const
+{
+  std::string dir = options().dir;
+  if (!common::check_directory(dir)) {
+    LOG_WARN("failed to create trace directory. dir=%s", dir.c_str());
+    return RC::IOERR_OPEN;
+  }
+
+  char name[128];
+  snprintf(name, sizeof(name), "/trace-%lu-%lu.json",
+      static_cast<unsigned long>(session_id), static_cast<unsigned long>(trace_sequence.fetch_add(1) + 1));
+  file_name = dir + name;
+
+  FILE *file = fopen(file_name.c_str(), "w");
+  if (file == nullptr) {
+    LOG_WARN("failed to open trace file. file=%s, error=%s", file_name.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  const std::string json = to_json();
+  const size_t written = fwrite(json.data(), 1, json.size(), file);
+  fclose(file);
+  if (written != json.size()) {
+    LOG_WARN("failed to write trace file. file=%s, error=%s", file_name.c_str(), strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  return RC::SUCCESS;
+}
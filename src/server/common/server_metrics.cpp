@@ -0,0 +1,180 @@
+#include "include/common/server_metrics.h"
+
+#include <chrono>
+
+#include "common/log/log.h"
+#include "common/metrics/log_reporter.h"
+#include "common/metrics/metrics_registry.h"
+#include "include/storage_engine/index/bplus_tree.h"
+
+using namespace common;
+
+ServerMetrics &ServerMetrics::instance()
+{
+  static ServerMetrics instance;
+  return instance;
+}
+
+ServerMetrics::ServerMetrics()
+    : bplus_tree_max_height([]() { return (long)BplusTreeHandler::max_open_height(); })
+{
+  for (std::atomic<Timer *> &timer : query_timers_) {
+    timer.store(nullptr, std::memory_order_relaxed);
+  }
+
+  metrics_ = {
+      {"buffer_pool.hits", &buffer_pool_hits},
+      {"buffer_pool.misses", &buffer_pool_misses},
+      {"buffer_pool.evictions", &buffer_pool_evictions},
+      {"buffer_pool.dirty_flushes", &buffer_pool_dirty_flushes},
+      {"buffer_pool.read_latency_us", &buffer_pool_read_latency_us},
+      {"buffer_pool.write_latency_us", &buffer_pool_write_latency_us},
+      {"bplus_tree.splits", &bplus_tree_splits},
+      {"bplus_tree.merges", &bplus_tree_merges},
+      {"bplus_tree.redistributions", &bplus_tree_redistributions},
+      {"bplus_tree.max_height", &bplus_tree_max_height},
+      {"record.inserted", &records_inserted},
+      {"record.deleted", &records_deleted},
+      {"record.scanned", &records_scanned},
+      {"record.pages_allocated", &record_pages_allocated},
+      {"trx.commits", &trx_commits},
+      {"trx.rollbacks", &trx_rollbacks},
+      {"query.latency_ms{stmt=\"SELECT_CACHED\"}", &query_cached_latency_ms},
+  };
+}
+
+ServerMetrics::~ServerMetrics()
+{
+  cleanup();
+  for (std::atomic<Timer *> &timer : query_timers_) {
+    delete timer.load();
+  }
+}
+
+void ServerMetrics::init(int report_interval_sec)
+{
+  MetricsRegistry &registry = get_metrics_registry();
+  if (!registered_) {
+    for (auto &[tag, metric] : metrics_) {
+      registry.register_metric(tag, metric);
+    }
+
+    std::lock_guard<std::mutex> guard(query_timers_lock_);
+    for (int i = 0; i < STMT_TYPE_NUM; i++) {
+      Timer *timer = query_timers_[i].load();
+      if (timer != nullptr) {
+        registry.register_metric(query_latency_tag(static_cast<StmtType>(i)), timer);
+      }
+    }
+    registered_ = true;
+
+    LockProfiler::set_site_listener([this](LockSite &site) { register_lock_site(site); });
+  }
+
+  if (report_interval_sec > 0 && !report_thread_.joinable()) {
+    registry.add_reporter(get_log_reporter());
+    report_stop_ = false;
+    report_thread_ = std::thread(&ServerMetrics::report_loop, this, report_interval_sec);
+    LOG_INFO("metrics will be reported to log every %d seconds", report_interval_sec);
+  }
+}
+
+void ServerMetrics::cleanup()
+{
+  if (report_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(report_lock_);
+      report_stop_ = true;
+    }
+    report_cond_.notify_all();
+    report_thread_.join();
+  }
+
+  if (!registered_) {
+    return;
+  }
+
+  LockProfiler::set_site_listener(nullptr);
+
+  MetricsRegistry &registry = get_metrics_registry();
+  for (auto &[tag, metric] : metrics_) {
+    registry.unregister(tag);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock_metrics_lock_);
+    for (auto &[tag, metric] : lock_metrics_) {
+      registry.unregister(tag);
+      delete metric;
+    }
+    lock_metrics_.clear();
+  }
+
+  std::lock_guard<std::mutex> guard(query_timers_lock_);
+  for (int i = 0; i < STMT_TYPE_NUM; i++) {
+    if (query_timers_[i].load() != nullptr) {
+      registry.unregister(query_latency_tag(static_cast<StmtType>(i)));
+    }
+  }
+  registered_ = false;
+}
+
+void ServerMetrics::record_query(StmtType type, double latency_ms)
+{
+  const int index = static_cast<int>(type);
+  if (index < 0 || index >= STMT_TYPE_NUM) {
+    return;
+  }
+
+  Timer *timer = query_timers_[index].load(std::memory_order_acquire);
+  if (timer == nullptr) {
+    std::lock_guard<std::mutex> guard(query_timers_lock_);
+    timer = query_timers_[index].load(std::memory_order_relaxed);
+    if (timer == nullptr) {
+      timer = new Timer();
+      query_timers_[index].store(timer, std::memory_order_release);
+      if (registered_) {
+        get_metrics_registry().register_metric(query_latency_tag(type), timer);
+      }
+    }
+  }
+  timer->update(latency_ms);
+}
+
+std::string ServerMetrics::query_latency_tag(StmtType type)
+{
+  return std::string("query.latency_ms{stmt=\"") + stmt_type_name(type) + "\"}";
+}
+
+void ServerMetrics::register_lock_site(LockSite &site)
+{
+  const std::string label = "{site=\"" + site.name + "\"}";
+  LockSite *site_ptr = &site;
+  std::pair<std::string, Metric *> metrics[] = {
+      {"lock.acquisitions" + label, new CallbackGauge([site_ptr]() { return (long)site_ptr->acquisitions.load(); })},
+      {"lock.contentions" + label, new CallbackGauge([site_ptr]() { return (long)site_ptr->contentions.load(); })},
+      {"lock.wait_us" + label, new CallbackGauge([site_ptr]() { return (long)(site_ptr->wait_ns.load() / 1000); })},
+  };
+
+  MetricsRegistry &registry = get_metrics_registry();
+  std::lock_guard<std::mutex> guard(lock_metrics_lock_);
+  for (auto &[tag, metric] : metrics) {
+    registry.register_metric(tag, metric);
+    lock_metrics_.emplace_back(tag, metric);
+  }
+}
+
+void ServerMetrics::report_loop(int report_interval_sec)
+{
+  MetricsRegistry &registry = get_metrics_registry();
+  std::unique_lock<std::mutex> guard(report_lock_);
+  while (!report_stop_) {
+    report_cond_.wait_for(guard, std::chrono::seconds(report_interval_sec));
+    if (report_stop_) {
+      break;
+    }
+
+    registry.snapshot();
+    registry.report();
+  }
+}
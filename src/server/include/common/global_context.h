@@ -3,6 +3,10 @@
 class BufferPoolManager;
 class DefaultHandler;
 class TrxManager;
+class QueryCache;
+class AdmissionController;
+class MetricsHttpServer;
+class SlowQueryLog;
 
 /**
  * @brief 放一些全局对象
@@ -13,6 +17,10 @@ struct GlobalContext
   BufferPoolManager *buffer_pool_manager_ = nullptr;
   DefaultHandler *handler_ = nullptr;
   TrxManager *trx_manager_ = nullptr;
+  QueryCache *query_cache_ = nullptr;  ///< 查询结果缓存，没有开启时为空
+  AdmissionController *admission_controller_ = nullptr;  ///< 准入控制，没有开启时为空
+  MetricsHttpServer *metrics_http_server_ = nullptr;  ///< 输出指标的HTTP服务，没有开启时为空
+  SlowQueryLog *slow_query_log_ = nullptr;  ///< 慢查询日志，没有开启时为空
 
   static GlobalContext &instance();
 };
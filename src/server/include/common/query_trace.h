@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+
+/**
+ * @brief 单条语句的执行过程跟踪
+ * @details 会话执行 SET trace = on 之后，每条语句都会记录带时间戳的事件：查询的各个阶段、
+ * 每个算子的 open/next/close、buffer pool 未命中时加载页面以及等待锁的时间。
+ * 语句结束时以 Chrome trace 的 JSON 格式写到 [TRACE] DIR 目录下，可以用 Perfetto 或 chrome://tracing 查看。
+ * 参与执行的每个线程通过 attach 把事件记录到自己的缓存中，记录时不需要加锁，以后并行执行时不同的线程分开显示。
+ * 没有开启跟踪的线程，记录事件只多读一次线程局部变量。
+ */
+class QueryTrace
+{
+public:
+  struct Options
+  {
+    std::string dir = "trace";         ///< 跟踪文件的目录
+    size_t      max_events = 1000000;  ///< 每条语句最多记录的事件数，超过之后丢弃
+  };
+
+  static void set_options(const Options &options);
+  static const Options &options();
+
+public:
+  QueryTrace();
+  ~QueryTrace();
+
+  /**
+   * @brief 当前线程的事件记录到这个跟踪中，直到 detach
+   */
+  void attach();
+  void detach();
+
+  /**
+   * @brief 当前线程是否在记录事件
+   */
+  static bool active() { return thread_buffer_ != nullptr; }
+
+  /**
+   * @brief 记录一个从begin开始到现在结束的事件
+   * @param category 事件的分类，比如 phase、operator、buffer_pool
+   * @param args JSON对象的内容，比如 "page":1，可以为空
+   */
+  static void complete(const char *category, std::string name, std::chrono::steady_clock::time_point begin,
+      std::string args = std::string());
+  static void complete(const char *category, std::string name, std::chrono::steady_clock::time_point begin,
+      std::chrono::steady_clock::time_point end, std::string args = std::string());
+
+  /**
+   * @brief 转义为JSON字符串，包含两边的引号
+   */
+  static std::string json_string(const std::string &str);
+
+  /**
+   * @brief 按照 Chrome trace 的格式输出所有事件
+   */
+  std::string to_json() const;
+
+  /**
+   * @brief 写到跟踪目录下的一个新文件中
+   * @param session_id 文件名中包含会话编号和序号，比如 trace-3-17.json
+   * @param file_name 写入的文件
+   */
+  RC dump(uint64_t session_id, std::string &file_name) const;
+
+  size_t event_count() const;
+  uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  struct Event
+  {
+    const char *category;
+    std::string name;
+    int64_t     ts_ns;   ///< 相对于跟踪开始的时间
+    int64_t     dur_ns;
+    std::string args;
+  };
+
+  struct ThreadBuffer
+  {
+    QueryTrace        *trace = nullptr;
+    uint64_t           tid = 0;
+    std::vector<Event> events;
+  };
+
+private:
+  const std::chrono::steady_clock::time_point start_;
+
+  mutable std::mutex                         lock_;  ///< 保护 buffers_，只在 attach 和输出时使用
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::atomic<size_t>                        total_events_{0};
+  std::atomic<uint64_t>                      dropped_{0};
+
+  static thread_local ThreadBuffer *thread_buffer_;
+};
+
+/**
+ * @brief 在构造和析构之间记录一个事件，当前线程没有开启跟踪时什么都不做
+ */
+class TraceSpan
+{
+public:
+  TraceSpan(const char *category, const char *name) : active_(QueryTrace::active())
+  {
+    if (active_) {
+      category_ = category;
+      name_ = name;
+      begin_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~TraceSpan()
+  {
+    if (active_) {
+      QueryTrace::complete(category_, std::move(name_), begin_, std::move(args_));
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+  bool active() const { return active_; }
+  void set_name(std::string name) { name_ = std::move(name); }
+  void set_args(std::string args) { args_ = std::move(args); }
+
+private:
+  const bool  active_;
+  const char *category_ = nullptr;
+  std::string name_;
+  std::string args_;
+  std::chrono::steady_clock::time_point begin_;
+};
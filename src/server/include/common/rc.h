@@ -60,7 +60,11 @@
   DEFINE_RC(VARIABLE_NOT_EXISTS)            \
   DEFINE_RC(VARIABLE_NOT_VALID)             \
   DEFINE_RC(LOGBUF_FULL)                    \
-  DEFINE_RC(ONLY_FUNCTIONS)
+  DEFINE_RC(ONLY_FUNCTIONS)                 \
+  DEFINE_RC(QUERY_QUEUE_FULL)               \
+  DEFINE_RC(QUERY_QUEUE_TIMEOUT)            \
+  DEFINE_RC(QUERY_TIMEOUT)                  \
+  DEFINE_RC(QUERY_CANCELLED)
 
 enum class RC
 {
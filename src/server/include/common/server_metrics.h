@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/lang/mutex.h"
+#include "common/metrics/metrics.h"
+#include "include/query_engine/analyzer/statement/stmt.h"
+
+/**
+ * @brief 引擎的运行指标
+ * @details 指标对象一直存在，没有初始化时也可以直接累加。计数器按线程分片(参考 common::Counter)，
+ * 放在缓冲池、记录扫描这样的热路径上开销也很小。
+ * init 时把所有指标注册到 common::MetricsRegistry，可以通过 SHOW METRICS 查看；
+ * 配置了 [METRICS] REPORT_INTERVAL_SEC 时，还会启动一个线程定期通过 LogReporter 把指标输出到日志中。
+ * 每个锁的竞争统计(参考 common::LockProfiler)以 lock.xxx{site="名字"} 的形式导出，新的加锁位置出现时自动注册。
+ */
+class ServerMetrics
+{
+public:
+  static ServerMetrics &instance();
+
+  ServerMetrics();
+  ~ServerMetrics();
+
+  /**
+   * @brief 注册所有指标
+   * @param report_interval_sec 定期输出到日志的间隔，0表示不输出
+   */
+  void init(int report_interval_sec);
+  void cleanup();
+
+  /**
+   * @brief 记录一条语句的执行时间，按语句类型分别统计
+   */
+  void record_query(StmtType type, double latency_ms);
+
+public:
+  /// 缓冲池
+  common::Counter     buffer_pool_hits;
+  common::Counter     buffer_pool_misses;
+  common::Counter     buffer_pool_evictions;
+  common::Counter     buffer_pool_dirty_flushes;
+  common::Histogram   buffer_pool_read_latency_us;
+  common::Histogram   buffer_pool_write_latency_us;
+
+  /// B+树
+  common::Counter       bplus_tree_splits;
+  common::Counter       bplus_tree_merges;
+  common::Counter       bplus_tree_redistributions;
+  common::CallbackGauge bplus_tree_max_height;
+
+  /// 记录管理
+  common::Counter records_inserted;
+  common::Counter records_deleted;
+  common::Counter records_scanned;
+  common::Counter record_pages_allocated;
+
+  /// 事务
+  common::Counter trx_commits;
+  common::Counter trx_rollbacks;
+
+  /// 命中查询缓存的SELECT没有解析和执行，不按语句类型统计，单独记录执行时间
+  common::Timer query_cached_latency_ms;
+
+private:
+  void report_loop(int report_interval_sec);
+
+  static std::string query_latency_tag(StmtType type);
+
+  void register_lock_site(common::LockSite &site);
+
+private:
+  std::vector<std::pair<std::string, common::Metric *>> metrics_;  ///< 注册到MetricsRegistry的指标
+
+  std::mutex                   lock_metrics_lock_;  ///< 新的加锁位置可能在任何线程中出现
+  std::vector<std::pair<std::string, common::Metric *>> lock_metrics_;
+
+  std::mutex                   query_timers_lock_;  ///< 只在第一次遇到某种语句时使用
+  std::atomic<common::Timer *> query_timers_[STMT_TYPE_NUM];
+
+  bool                    registered_ = false;
+  std::thread             report_thread_;
+  std::mutex              report_lock_;
+  std::condition_variable report_cond_;
+  bool                    report_stop_ = false;
+};
@@ -8,6 +8,13 @@
 #define MAX_CONNECTION_NUM_DEFAULT (65535*2)
 #define PORT "PORT"
 #define PORT_DEFAULT 6789
+#define EVENT_MODEL "EVENT_MODEL"
+
+#define SQL_THREADS "SQLThreads"
+#define IO_THREADS "IOThreads"
+#define THREAD_COUNT "count"
+
+#define SESSION_POOL "SESSION_POOL"
 
 #define SESSION_STAGE_NAME "SessionStage"
 
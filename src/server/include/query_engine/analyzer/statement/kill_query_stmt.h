@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include "stmt.h"
+
+/**
+ * @brief KILL QUERY 语句，取消指定会话正在执行的语句
+ * @ingroup Statement
+ */
+class KillQueryStmt : public Stmt
+{
+public:
+  explicit KillQueryStmt(uint64_t session_id) : session_id_(session_id)
+  {}
+  virtual ~KillQueryStmt() = default;
+
+  StmtType type() const override { return StmtType::KILL_QUERY; }
+
+  uint64_t session_id() const { return session_id_; }
+
+  static RC create(const KillQuerySqlNode &kill_query, Stmt *&stmt);
+
+private:
+  uint64_t session_id_ = 0;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+#include "stmt.h"
+
+/**
+ * @brief SET 语句，设置会话变量
+ * @ingroup Statement
+ * @details 支持的变量：
+ * - statement_timeout 语句执行的超时时间，单位毫秒，0表示不限制
+ * - sql_debug 是否输出SQL调试信息
+ * - lock_profiling 是否统计锁竞争，对整个服务生效
+ * - trace 是否把每条语句的执行过程记录为 Chrome trace 文件，参考 QueryTrace
+ * 开关类的变量可以设置为 on/off、true/false 或者 1/0
+ */
+class SetVariableStmt : public Stmt
+{
+public:
+  SetVariableStmt(const std::string &name, const Value &value) : name_(name), value_(value)
+  {}
+  virtual ~SetVariableStmt() = default;
+
+  StmtType type() const override { return StmtType::SET_VARIABLE; }
+
+  const std::string &var_name() const { return name_; }
+  const Value &var_value() const { return value_; }
+
+  static RC create(const SetVariableSqlNode &set_variable, Stmt *&stmt);
+
+private:
+  std::string name_;
+  Value       value_;
+};
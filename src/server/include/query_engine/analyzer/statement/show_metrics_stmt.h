@@ -0,0 +1,22 @@
+#pragma once
+
+#include "stmt.h"
+
+/**
+ * @brief 查看引擎运行指标的语句
+ * @ingroup Statement
+ */
+class ShowMetricsStmt : public Stmt
+{
+public:
+  ShowMetricsStmt() = default;
+  virtual ~ShowMetricsStmt() = default;
+
+  StmtType type() const override { return StmtType::SHOW_METRICS; }
+
+  static RC create(Stmt *&stmt)
+  {
+    stmt = new ShowMetricsStmt();
+    return RC::SUCCESS;
+  }
+};
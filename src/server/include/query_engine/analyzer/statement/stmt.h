@@ -31,6 +31,7 @@ class Db;
   DEFINE_ENUM_ITEM(DROP_INDEX)      \
   DEFINE_ENUM_ITEM(SYNC)            \
   DEFINE_ENUM_ITEM(SHOW_TABLES)     \
+  DEFINE_ENUM_ITEM(SHOW_METRICS)    \
   DEFINE_ENUM_ITEM(DESC_TABLE)      \
   DEFINE_ENUM_ITEM(BEGIN)           \
   DEFINE_ENUM_ITEM(COMMIT)          \
@@ -41,6 +42,7 @@ class Db;
   DEFINE_ENUM_ITEM(EXPLAIN)         \
   DEFINE_ENUM_ITEM(PREDICATE)       \
   DEFINE_ENUM_ITEM(SET_VARIABLE)    \
+  DEFINE_ENUM_ITEM(KILL_QUERY)      \
   DEFINE_ENUM_ITEM(GROUP_BY)        \
   DEFINE_ENUM_ITEM(CREATE_VIEW)
 
@@ -50,6 +52,13 @@ enum class StmtType {
   #undef DEFINE_ENUM_ITEM
 };
 
+/// 语句类型的个数，可以用来定义按语句类型索引的数组
+constexpr int STMT_TYPE_NUM = 0
+  #define DEFINE_ENUM_ITEM(name)  +1
+  DEFINE_ENUM()
+  #undef DEFINE_ENUM_ITEM
+  ;
+
 inline const char *stmt_type_name(StmtType type)
 {
   switch (type) {
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "common/lang/mutex.h"
+#include "include/common/rc.h"
+
+class AdmissionController;
+class PhysicalOperator;
+
+/**
+ * @brief 查询的类别，不同类别的查询在不同的队列中排队
+ * @ingroup Executor
+ */
+enum class QueryClass
+{
+  OLTP,      ///< 短查询，比如点查、插入、删除以及DDL
+  ANALYTIC,  ///< 需要物化数据或者扫描大量数据的查询，比如排序、聚合和连接
+};
+
+const char *query_class_name(QueryClass query_class);
+
+/**
+ * @brief 一个查询的内存预留
+ * @ingroup Executor
+ * @details 需要缓存数据的算子(比如排序)在缓存数据之前先调用 reserve 申请内存，申请失败时算子应该把数据溢出到磁盘，
+ * 而不是失败。预留的内存从 AdmissionController 的全局预算中按块申请，查询结束时全部归还。
+ * 同一个查询只在一个线程中执行，这个类不是线程安全的。
+ */
+class MemoryReservation
+{
+public:
+  MemoryReservation() = default;
+  MemoryReservation(AdmissionController *controller, size_t limit, size_t granted);
+  ~MemoryReservation() = default;
+
+  MemoryReservation(const MemoryReservation &) = delete;
+  MemoryReservation &operator=(const MemoryReservation &) = delete;
+
+  /**
+   * @brief 申请内存
+   * @return 超过单个查询的上限或者全局预算不足时返回false
+   */
+  bool reserve(size_t bytes);
+
+  /**
+   * @brief 归还申请的内存，比如数据溢出到磁盘之后。从全局预算申请的内存直到查询结束才归还
+   */
+  void release(size_t bytes);
+
+  size_t used() const { return used_; }
+  size_t peak() const { return peak_; }
+  size_t granted() const { return granted_; }
+  size_t limit() const { return limit_; }
+
+private:
+  AdmissionController *controller_ = nullptr;
+  size_t limit_ = 0;    ///< 单个查询最多能使用的内存
+  size_t granted_ = 0;  ///< 已经从全局预算申请到的内存
+  size_t used_ = 0;     ///< 算子当前正在使用的内存
+  size_t peak_ = 0;
+};
+
+/**
+ * @brief 通过准入控制之后得到的凭证，析构时归还执行槽位和内存
+ * @ingroup Executor
+ */
+class AdmissionTicket
+{
+public:
+  AdmissionTicket() = default;
+  ~AdmissionTicket();
+
+  AdmissionTicket(const AdmissionTicket &) = delete;
+  AdmissionTicket &operator=(const AdmissionTicket &) = delete;
+
+  /**
+   * @brief 当前查询的内存预留，没有通过准入控制时为空
+   */
+  MemoryReservation *memory_reservation() { return reservation_; }
+
+private:
+  friend class AdmissionController;
+
+  AdmissionController *controller_ = nullptr;
+  QueryClass           query_class_ = QueryClass::OLTP;
+  MemoryReservation   *reservation_ = nullptr;
+};
+
+/**
+ * @brief 准入控制
+ * @ingroup Executor
+ * @details 限制同时执行的查询个数以及查询缓存数据使用的内存总量，避免突发的大查询耗尽内存。
+ * OLTP和分析型查询各自有执行槽位和先进先出的等待队列，分析型查询再多也不会占用OLTP的槽位。
+ * 分析型查询准入时需要先从全局内存预算中拿到一块初始的内存，预算不足时排队等待。
+ * 排队的查询超过队列长度时立即拒绝，等待超时也会被拒绝，这样过载时查询的延迟是有上限的。
+ * 默认关闭，通过配置文件中的 [ADMISSION] 打开和设置。
+ */
+class AdmissionController
+{
+public:
+  struct Options
+  {
+    size_t  memory_budget = 256 * 1024 * 1024;      ///< 所有查询可以预留的内存总量
+    size_t  query_memory_limit = 64 * 1024 * 1024;  ///< 单个查询可以预留的内存上限
+    size_t  initial_grant = 4 * 1024 * 1024;        ///< 分析型查询准入时需要拿到的内存
+    int     oltp_slots = 0;                         ///< 同时执行的OLTP查询个数，0表示不限制
+    int     analytic_slots = 2;                     ///< 同时执行的分析型查询个数，0表示不限制
+    int     max_queue_length = 64;                  ///< 每个队列最多排队的查询个数
+    int64_t queue_timeout_ms = 10000;               ///< 排队等待的最长时间，0表示不等待
+  };
+
+  /**
+   * @brief 向全局预算申请内存的粒度，避免每次reserve都加锁
+   */
+  static constexpr size_t GRANT_CHUNK_SIZE = 256 * 1024;
+
+public:
+  explicit AdmissionController(const Options &options);
+  ~AdmissionController() = default;
+
+  /**
+   * @brief 根据执行计划判断查询的类别
+   * @param oper 物理执行计划，没有执行计划的语句(比如DDL)当做OLTP
+   */
+  static QueryClass classify(PhysicalOperator *oper);
+
+  /**
+   * @brief 准入，需要时排队等待
+   * @param ticket[out] 成功时返回的凭证
+   * @return 队列已满返回 QUERY_QUEUE_FULL，等待超时返回 QUERY_QUEUE_TIMEOUT
+   */
+  RC admit(QueryClass query_class, AdmissionTicket &ticket);
+
+  const Options &options() const { return options_; }
+
+  size_t  memory_reserved() const;
+  int     running(QueryClass query_class) const;
+  int     queued(QueryClass query_class) const;
+  uint64_t rejected() const;
+
+private:
+  friend class AdmissionTicket;
+  friend class MemoryReservation;
+
+  struct Queue
+  {
+    int                  slots = 0;
+    int                  running = 0;
+    std::deque<uint64_t> waiters;  ///< 排队的查询，按照到达的顺序
+  };
+
+  Queue &queue(QueryClass query_class)
+  {
+    return query_class == QueryClass::OLTP ? oltp_ : analytic_;
+  }
+  const Queue &queue(QueryClass query_class) const
+  {
+    return query_class == QueryClass::OLTP ? oltp_ : analytic_;
+  }
+
+  /**
+   * @brief 排在队首的查询是否可以开始执行，调用时需要持有锁
+   */
+  bool can_run(const Queue &queue, size_t initial_grant) const;
+
+  /**
+   * @brief 查询执行过程中申请更多的内存，不会等待
+   */
+  bool grow(size_t bytes);
+
+  /**
+   * @brief 查询结束，归还槽位以及从预算中拿到的内存
+   */
+  void leave(QueryClass query_class, size_t granted);
+
+private:
+  const Options options_;
+
+  mutable common::ProfiledMutex lock_{"admission"};
+  std::condition_variable_any   cond_;
+  Queue                         oltp_;
+  Queue                         analytic_;
+  size_t                        memory_reserved_ = 0;  ///< 所有查询从预算中拿到的内存
+  uint64_t                      next_waiter_id_ = 0;
+  uint64_t                      rejected_ = 0;
+};
@@ -10,9 +10,12 @@
 #include <cstddef>
 #include <memory>
 
+/**
+ * @brief 把值转换成发送给客户端的字符串，TEXT类型会读取保存内容的文件
+ */
+RC value_to_string(Value &value, std::string &cell_str);
+
 class Executor{
     public:
         RC execute(SessionRequest *request, QueryInfo *queryInfo, bool &need_disconnect);
-    private:
-        size_t min_width = 0;
 };
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "include/common/rc.h"
+
+class QueryInfo;
+
+/**
+ * @brief KILL QUERY 语句的执行器
+ * @ingroup Executor
+ * @details 只是给目标会话的语句打上取消标识，语句在下一次检查时结束(参考 Session::check_interrupt)
+ */
+class KillQueryExecutor
+{
+public:
+  KillQueryExecutor() = default;
+  virtual ~KillQueryExecutor() = default;
+
+  RC execute(QueryInfo *query_info);
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/lang/mutex.h"
+
+class Db;
+class Table;
+
+namespace common {
+class Metric;
+}
+
+/**
+ * @brief 查询结果缓存
+ * @ingroup Executor
+ * @details 缓存SELECT语句发送给客户端的结果字节流，key为规范化之后的SQL(以及参数)。
+ * 每个缓存项记录了查询涉及的表在执行时的版本号(参考 Table::version)，
+ * 表中有任何插入、删除或更新时版本号都会变化，读取缓存时发现版本号不一致就淘汰该缓存项。
+ * 缓存占用的内存按照结果字节数统计，超过上限时按照LRU淘汰。
+ * 默认关闭，通过配置文件中的 [QUERY_CACHE] 开启。
+ */
+class QueryCache
+{
+public:
+  /**
+   * @param capacity 缓存结果的总字节数上限
+   */
+  explicit QueryCache(size_t capacity);
+  ~QueryCache();
+
+  /**
+   * @brief 生成缓存的key
+   * @details 合并引号之外多余的空白，去掉结尾的分号。大小写保持不变，因为列名的大小写会影响返回的表头。
+   * 只有SELECT语句可以缓存，其它语句返回空字符串
+   * @param db_name 当前会话的数据库
+   * @param sql     原始SQL
+   * @param params  绑定的参数，已经序列化成字符串，没有参数时为空
+   */
+  static std::string make_key(const char *db_name, const std::string &sql, const std::string &params = "");
+
+  /**
+   * @brief 记录查询涉及的表以及当前的版本号，在执行查询之前获取
+   */
+  static void collect_table_versions(const std::vector<Table *> &tables, Db *db,
+      std::vector<std::pair<std::string, uint64_t>> &table_versions);
+
+  /**
+   * @brief 查找缓存
+   * @param db 用来校验表的版本号
+   * @param result[out] 命中时返回缓存的结果字节
+   * @return 是否命中
+   */
+  bool get(const std::string &key, Db *db, std::string &result);
+
+  /**
+   * @brief 保存查询结果
+   */
+  void put(const std::string &key, std::vector<std::pair<std::string, uint64_t>> table_versions, std::string result);
+
+  size_t capacity() const { return capacity_; }
+  size_t size() const;
+  size_t entry_count() const;
+
+  uint64_t hits() const { return hits_.load(); }
+  uint64_t misses() const { return misses_.load(); }
+  uint64_t invalidations() const { return invalidations_.load(); }
+  uint64_t evictions() const { return evictions_.load(); }
+
+private:
+  struct Entry
+  {
+    std::string key;
+    std::string result;
+    std::vector<std::pair<std::string, uint64_t>> table_versions;  ///< 表名和生成结果时的版本号
+  };
+
+  using EntryList = std::list<Entry>;
+
+  bool valid(const Entry &entry, Db *db) const;
+  void erase(EntryList::iterator iter);
+
+private:
+  const size_t capacity_;
+  size_t size_ = 0;          ///< 当前所有缓存结果的字节数
+
+  mutable common::ProfiledMutex lock_{"query_cache"};
+  EntryList entries_;        ///< 链表头部是最近使用的
+  std::unordered_map<std::string, EntryList::iterator> index_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> invalidations_{0};
+  std::atomic<uint64_t> evictions_{0};
+
+  std::vector<std::pair<std::string, common::Metric *>> metrics_;  ///< 注册到MetricsRegistry的指标
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief 在一段内存中查找字段分隔符和换行符
+ * @details 每次比较32个字节，把分隔符和换行符的位置合并成一个位图，然后逐个取出最低位。
+ * CPU支持AVX2时使用 cmpeq + movemask，否则逐个字节比较。最后不足32字节的部分也逐个字节比较，
+ * 不会读取超出范围的内存。
+ * @ingroup Executor
+ */
+class SeparatorScanner
+{
+public:
+  static constexpr int CHUNK_SIZE = 32;
+
+  /**
+   * @param use_simd 为false时总是逐个字节比较，用来验证两种实现的结果一致
+   */
+  SeparatorScanner(const char *begin, const char *end, char delim, bool use_simd = true)
+      : chunk_(begin), end_(end), delim_(delim),
+        chunk_mask_(use_simd ? simd_chunk_mask_func() : scalar_chunk_mask)
+  {
+    load_mask();
+  }
+
+  /**
+   * @brief 当前CPU是否可以使用向量指令比较
+   */
+  static bool simd_supported()
+  {
+    return simd_chunk_mask_func() != scalar_chunk_mask;
+  }
+
+  /**
+   * @brief 返回下一个分隔符或者换行符的位置，没有时返回end
+   */
+  const char *next()
+  {
+    while (mask_ == 0) {
+      chunk_ += CHUNK_SIZE;
+      if (chunk_ >= end_) {
+        chunk_ = end_;
+        return end_;
+      }
+      load_mask();
+    }
+    const char *pos = chunk_ + __builtin_ctz(mask_);
+    mask_ &= mask_ - 1;
+    return pos;
+  }
+
+private:
+  using MaskFunc = uint32_t (*)(const char *, char);
+
+  void load_mask()
+  {
+    if (end_ - chunk_ >= CHUNK_SIZE) {
+      mask_ = chunk_mask_(chunk_, delim_);
+    } else {
+      mask_ = scalar_mask(chunk_, end_ - chunk_, delim_);
+    }
+  }
+
+  static uint32_t scalar_mask(const char *p, long len, char delim)
+  {
+    uint32_t mask = 0;
+    for (long i = 0; i < len; i++) {
+      if (p[i] == delim || p[i] == '\n') {
+        mask |= 1U << i;
+      }
+    }
+    return mask;
+  }
+
+  static uint32_t scalar_chunk_mask(const char *p, char delim)
+  {
+    return scalar_mask(p, CHUNK_SIZE, delim);
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  __attribute__((target("avx2"))) static uint32_t avx2_chunk_mask(const char *p, char delim)
+  {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    const __m256i delims = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(delim));
+    const __m256i newlines = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(delims, newlines)));
+  }
+#endif
+
+  static MaskFunc simd_chunk_mask_func()
+  {
+    static const MaskFunc func = []() -> MaskFunc {
+#if defined(__x86_64__) || defined(__i386__)
+      if (__builtin_cpu_supports("avx2")) {
+        return avx2_chunk_mask;
+      }
+#endif
+      return scalar_chunk_mask;
+    }();
+    return func;
+  }
+
+private:
+  const char *chunk_;       ///< 当前32字节块的起始位置
+  const char *end_;
+  const char  delim_;
+  MaskFunc    chunk_mask_;  ///< 比较一个完整的32字节块
+  uint32_t    mask_ = 0;    ///< 当前块中还没有返回的分隔符位置
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "include/common/rc.h"
+
+class QueryInfo;
+
+/**
+ * @brief SET 语句的执行器，修改当前会话的变量
+ * @ingroup Executor
+ */
+class SetVariableExecutor
+{
+public:
+  SetVariableExecutor() = default;
+  virtual ~SetVariableExecutor() = default;
+
+  RC execute(QueryInfo *query_info);
+};
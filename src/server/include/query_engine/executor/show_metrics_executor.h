@@ -0,0 +1,57 @@
+#pragma once
+
+#include "common/metrics/metrics_registry.h"
+#include "common/metrics/reporter.h"
+#include "include/common/rc.h"
+#include "include/query_engine/planner/operator/string_list_physical_operator.h"
+#include "include/query_engine/structor/query_info.h"
+#include "include/session/session_request.h"
+#include "sql_result.h"
+
+/**
+ * @brief 显示所有运行指标的执行器
+ * @ingroup Executor
+ * @details 对注册到 MetricsRegistry 中的指标做一次snapshot，每个指标输出一行
+ */
+class ShowMetricsExecutor
+{
+public:
+  ShowMetricsExecutor() = default;
+  virtual ~ShowMetricsExecutor() = default;
+
+  RC execute(QueryInfo *query_info)
+  {
+    SqlResult *sql_result = query_info->session_event()->sql_result();
+
+    TupleSchema tuple_schema;
+    tuple_schema.append_cell(TupleCellSpec("", "Metric", "Metric"));
+    tuple_schema.append_cell(TupleCellSpec("", "Value", "Value"));
+    sql_result->set_tuple_schema(tuple_schema);
+
+    auto oper = new StringListPhysicalOperator;
+    RowReporter reporter(*oper);
+    common::get_metrics_registry().report(reporter);
+
+    sql_result->set_operator(std::unique_ptr<PhysicalOperator>(oper));
+    return RC::SUCCESS;
+  }
+
+private:
+  /**
+   * @brief 把每个指标的snapshot转换成一行结果
+   */
+  class RowReporter : public common::Reporter
+  {
+  public:
+    explicit RowReporter(StringListPhysicalOperator &oper) : oper_(oper) {}
+
+    void report(const std::string &tag, common::Metric *metric) override
+    {
+      common::Snapshot *snapshot = metric->get_snapshot();
+      oper_.append({tag, snapshot != nullptr ? snapshot->to_string() : std::string()});
+    }
+
+  private:
+    StringListPhysicalOperator &oper_;
+  };
+};
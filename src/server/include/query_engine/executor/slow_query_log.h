@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/structor/query_info.h"
+
+namespace common {
+class AsyncLogWriter;
+class Metric;
+}
+
+/**
+ * @brief 慢查询日志
+ * @ingroup Executor
+ * @details 执行时间超过阈值的语句，记录SQL、会话、各个阶段的耗时、检查和返回的行数、页面访问以及执行计划。
+ * 打开 OPERATOR_STATS 时，每条语句执行之前都用 InstrumentedPhysicalOperator 包装算子树，
+ * 执行计划中同时输出每个算子的运行统计(与 EXPLAIN ANALYZE 相同)，但是所有语句都会有额外的计时开销。
+ * 日志通过 AsyncLogWriter 异步写入文件，执行语句的线程不会等待磁盘IO，缓存满了就丢弃。
+ * 最近的若干条记录同时保存在内存中，可以通过系统表 sys.slow_queries 查询。
+ * 默认关闭，通过配置文件中的 [SLOW_QUERY] 开启。
+ */
+class SlowQueryLog
+{
+public:
+  struct Options
+  {
+    int64_t     threshold_ms = 1000;              ///< 执行时间不小于这个值的语句才记录，0表示记录所有语句
+    std::string file_name = "slow_query.log";     ///< 日志文件，为空时只保存在内存中
+    bool        operator_stats = false;           ///< 是否统计每个算子的运行信息
+    size_t      max_entries = 128;                ///< 内存中保存的最近的记录数
+  };
+
+  /**
+   * @brief 一条慢查询记录
+   */
+  struct Entry
+  {
+    int64_t      start_time_us = 0;  ///< 语句开始处理的时间，从1970年开始的微秒数
+    uint64_t     session_id = 0;
+    std::string  db_name;
+    std::string  sql;
+    RC           rc = RC::SUCCESS;   ///< 语句的执行结果
+    QueryProfile profile;
+    std::string  plan;               ///< 执行计划，没有物理计划的语句为空
+
+    /**
+     * @brief 日志文件中的格式，以 '#' 开头的若干行注释加上SQL
+     */
+    std::string to_string() const;
+  };
+
+public:
+  explicit SlowQueryLog(const Options &options);
+  ~SlowQueryLog();
+
+  /**
+   * @brief 打开日志文件并启动后台写日志的线程
+   */
+  RC start();
+
+  /**
+   * @brief 停止后台线程，缓存中的日志都会写到文件中
+   */
+  void stop();
+
+  const Options &options() const { return options_; }
+
+  bool is_slow(int64_t elapsed_ns) const { return elapsed_ns >= options_.threshold_ms * 1000000; }
+
+  /**
+   * @brief 记录一条慢查询，由执行语句的线程调用
+   */
+  void record(Entry entry);
+
+  /**
+   * @brief 内存中保存的最近的记录，按时间从早到晚排列
+   */
+  std::vector<Entry> recent_entries() const;
+
+  /**
+   * @brief 启动之后记录过的慢查询条数
+   */
+  uint64_t logged_count() const { return logged_count_.load(std::memory_order_relaxed); }
+
+private:
+  void write_batch(const std::string &batch);
+
+private:
+  const Options options_;
+  FILE         *file_ = nullptr;
+  std::unique_ptr<common::AsyncLogWriter> writer_;
+
+  mutable std::mutex lock_;        ///< 保护 entries_
+  std::deque<Entry>  entries_;
+  std::atomic<uint64_t> logged_count_{0};
+
+  std::vector<std::pair<std::string, common::Metric *>> metrics_;  ///< 注册到MetricsRegistry的指标
+};
@@ -22,6 +22,11 @@ public:
   ~SqlResult()
   {}
 
+  void set_session(Session *session)
+  {
+    session_ = session;
+  }
+
   void set_tuple_schema(const TupleSchema &schema);
   void set_return_code(RC rc)
   {
@@ -55,12 +60,39 @@ public:
   RC close();
   RC next_tuple(Tuple *&tuple);
 
+  /**
+   * @brief close之后保留执行计划，直到SqlResult释放
+   * @details 慢查询日志在语句结束之后输出执行计划以及算子的运行统计
+   */
+  void set_retain_operator(bool retain)
+  {
+    retain_operator_ = retain;
+  }
+  /**
+   * @brief close之后保留下来的执行计划，没有保留时为空
+   */
+  PhysicalOperator *retained_operator() const
+  {
+    return retained_operator_.get();
+  }
+
+  /**
+   * @brief next_tuple返回的行数
+   */
+  uint64_t rows_returned() const
+  {
+    return rows_returned_;
+  }
+
 public:
   std::vector<FuncResult> function_results_;
 
 private:
   Session *session_ = nullptr; ///< 当前所属会话
   std::unique_ptr<PhysicalOperator> operator_;  ///< 执行计划
+  std::unique_ptr<PhysicalOperator> retained_operator_;  ///< close之后保留的执行计划
+  bool retain_operator_ = false;
+  uint64_t rows_returned_ = 0;
   TupleSchema tuple_schema_;   ///< 返回的表头信息。可能有也可能没有
   RC return_code_ = RC::SUCCESS;
   std::string state_string_;
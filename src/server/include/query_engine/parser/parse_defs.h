@@ -315,6 +315,16 @@ struct SetVariableSqlNode
   Value       value;
 };
 
+/**
+ * @brief 描述一个KILL QUERY语句
+ * @ingroup SQLParser
+ * @details 取消指定会话正在执行的查询，会话本身不会关闭
+ */
+struct KillQuerySqlNode
+{
+  int session_id = 0;
+};
+
 class ParsedSqlNode;
 
 /**
@@ -327,6 +337,7 @@ class ParsedSqlNode;
 struct ExplainSqlNode
 {
   std::unique_ptr<ParsedSqlNode> sql_node;
+  bool analyze = false;  ///< EXPLAIN ANALYZE，执行语句并输出每个算子的运行统计
 };
 
 /**
@@ -362,6 +373,7 @@ enum SqlCommandFlag
   SCF_DROP_INDEX,
   SCF_SYNC,
   SCF_SHOW_TABLES,
+  SCF_SHOW_METRICS, ///< 查看引擎的运行指标
   SCF_DESC_TABLE,
   SCF_BEGIN,        ///< 事务开始语句，可以在这里扩展只读事务
   SCF_COMMIT,
@@ -372,6 +384,7 @@ enum SqlCommandFlag
   SCF_EXIT,
   SCF_EXPLAIN,
   SCF_SET_VARIABLE, ///< 设置变量
+  SCF_KILL_QUERY,   ///< 取消其它会话正在执行的查询
 };
 /**
  * @brief 表示一个SQL语句
@@ -397,6 +410,7 @@ public:
   LoadDataSqlNode           load_data;
   ExplainSqlNode            explain;
   SetVariableSqlNode        set_variable;
+  KillQuerySqlNode          kill_query;
 
 public:
   ParsedSqlNode();
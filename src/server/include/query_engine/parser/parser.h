@@ -7,4 +7,11 @@
 
 namespace Parser {
     RC parse(QueryInfo *query_info);
+
+    /**
+     * @brief 执行之前先做语法解析，结果保存在请求中，之后 parse 直接使用，不会重复解析
+     * @details 没有打开CONCURRENCY编译选项时，服务端需要在等待存储引擎的锁之前知道语句的类型
+     * @return 第一条语句的类型，语法错误或者没有语句时返回 SCF_ERROR
+     */
+    SqlCommandFlag preparse(SessionRequest *request);
 }
\ No newline at end of file
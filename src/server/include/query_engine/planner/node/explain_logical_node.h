@@ -9,7 +9,8 @@
 class ExplainLogicalNode : public LogicalNode
 {
 public:
-  ExplainLogicalNode() = default;
+  explicit ExplainLogicalNode(bool analyze = false) : analyze_(analyze)
+  {}
   ~ExplainLogicalNode() override = default;
 
   LogicalNodeType type() const override
@@ -17,5 +18,11 @@ public:
     return LogicalNodeType::EXPLAIN;
   }
 
+  bool analyze() const
+  {
+    return analyze_;
+  }
+
 private:
+  bool analyze_ = false;
 };
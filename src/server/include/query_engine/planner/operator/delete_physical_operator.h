@@ -4,18 +4,20 @@
 
 class Trx;
 class DeleteStmt;
+class Record;
 
 /**
  * @brief 物理算子，删除
  * @ingroup PhysicalOperator
+ * @details 把子算子输出的记录收集起来，每收集 BATCH_SIZE 个批量删除一次，批量删除时可以按照页面和索引键值顺序访问。
+ * 删除的都是已经扫描过的记录，不影响表扫描接下来要返回的记录。
+ * 如果子算子中有索引扫描，删除索引项会改变索引扫描的位置，这时候等扫描结束之后再一起删除
  */
 class DeletePhysicalOperator : public PhysicalOperator
 {
 public:
   DeletePhysicalOperator(Table *table) : table_(table)
-  {
-    isdelete_ = true;
-  }
+  {}
 
   virtual ~DeletePhysicalOperator() = default;
 
@@ -33,7 +35,14 @@ public:
     return nullptr;
   }
 
+  static constexpr size_t BATCH_SIZE = 1024;  ///< 一批最多删除的记录数
+
+private:
+  RC flush_records();
+
 private:
   Table *table_ = nullptr;
   Trx *trx_ = nullptr;
+  bool scan_index_ = false;      ///< 子算子中是否有索引扫描，参考类的说明
+  std::vector<Record> records_;  ///< 待删除的记录
 };
@@ -1,16 +1,20 @@
 #pragma once
 
+#include <chrono>
 #include "physical_operator.h"
 #include "include/query_engine/structor/tuple/values_tuple.h"
 
 /**
  * @brief Explain物理算子
  * @ingroup PhysicalOperator
+ * @details EXPLAIN ANALYZE 时会真正执行子算子，并输出每个算子的运行统计，
+ * 参考 InstrumentedPhysicalOperator
  */
 class ExplainPhysicalOperator : public PhysicalOperator
 {
 public:
-  ExplainPhysicalOperator() = default;
+  explicit ExplainPhysicalOperator(bool analyze = false) : analyze_(analyze)
+  {}
   virtual ~ExplainPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override
@@ -23,10 +27,19 @@ public:
   RC close() override;
   Tuple *current_tuple() override;
 
+  /**
+   * @brief 以树的形式输出算子树，与EXPLAIN的输出相同，不包括表头
+   * @details 被 InstrumentedPhysicalOperator 包装的算子同时输出运行统计。慢查询日志也使用这个格式
+   */
+  static std::string plan_to_string(PhysicalOperator *oper);
+
 private:
-  void to_string(std::ostream &os, PhysicalOperator *oper, int level, bool last_child, std::vector<bool> &ends);
+  static void to_string(std::ostream &os, PhysicalOperator *oper, int level, bool last_child, std::vector<bool> &ends);
+  RC execute_child(int64_t &elapsed_ns);
 
 private:
+  bool analyze_ = false;
+  std::chrono::steady_clock::time_point start_time_;  ///< EXPLAIN ANALYZE 开始执行的时间
   std::string physical_plan_;
   ValueListTuple tuple_;
 };
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "physical_operator.h"
+
+/**
+ * @brief 算子运行时统计
+ * @ingroup PhysicalOperator
+ * @details 时间和页面访问都包含了子算子的开销
+ */
+struct OperatorRuntimeStats
+{
+  uint64_t rows = 0;        ///< next返回成功的次数，也就是输出的行数
+  uint64_t next_calls = 0;  ///< next被调用的次数
+  int64_t  wall_ns = 0;     ///< open/next/close花费的时间
+  int64_t  cpu_ns = 0;      ///< open/next/close花费的线程CPU时间
+  uint64_t page_hits = 0;   ///< buffer pool命中的页面数
+  uint64_t page_misses = 0; ///< buffer pool未命中的页面数
+  uint64_t page_reads = 0;  ///< 从磁盘读取的页面数
+
+  std::string to_string() const;
+};
+
+/**
+ * @brief 统计运行信息的算子包装
+ * @ingroup PhysicalOperator
+ * @details EXPLAIN ANALYZE 使用。包装的算子作为唯一的子节点，所有接口都转发给它，
+ * 并在 open/next/close 前后统计耗时与buffer pool访问。开启了 QueryTrace 时每次调用还会记录一个事件。
+ */
+class InstrumentedPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit InstrumentedPhysicalOperator(std::unique_ptr<PhysicalOperator> oper);
+  virtual ~InstrumentedPhysicalOperator() = default;
+
+  /**
+   * @brief 把整棵算子树的每个算子都包装起来
+   */
+  static void instrument(std::unique_ptr<PhysicalOperator> &oper);
+
+  PhysicalOperatorType type() const override
+  {
+    return target()->type();
+  }
+  std::string name() const override
+  {
+    return target()->name();
+  }
+  std::string param() const override
+  {
+    return target()->param();
+  }
+  size_t peak_memory() const override
+  {
+    return target()->peak_memory();
+  }
+  size_t spilled_bytes() const override
+  {
+    return target()->spilled_bytes();
+  }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override
+  {
+    return target()->current_tuple();
+  }
+
+  PhysicalOperator *target() const
+  {
+    return children_[0].get();
+  }
+  const OperatorRuntimeStats &stats() const
+  {
+    return stats_;
+  }
+
+private:
+  class StatGuard;
+
+  /**
+   * @brief 跟踪事件的名字，比如 TABLE_SCAN(t) next
+   */
+  std::string trace_name(const char *action);
+
+private:
+  OperatorRuntimeStats stats_;
+  std::string          trace_label_;
+};
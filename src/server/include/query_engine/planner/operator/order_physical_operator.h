@@ -4,19 +4,24 @@
 #include "physical_operator.h"
 #include "include/query_engine/structor/expression/expression.h"
 #include "include/query_engine/analyzer/statement/orderby_stmt.h"
+#include "include/storage_engine/recorder/record.h"
 
 class OrderByStmt;
+class MemoryReservation;
 
 /**
  * @brief 排序物理算子
  * @ingroup PhysicalOperator
+ * @details 缓存的数据从当前查询的内存预留(参考 MemoryReservation)中申请，申请不到时把已经缓存的数据排好序写到临时文件，
+ * 最后对所有的有序段做多路归并。没有开启准入控制时全部在内存中排序。
+ * 有序段不会小于已经申请到的内存和 MIN_RUN_MEMORY(单个查询的内存上限更小时以上限为准)，同一层的有序段攒够 MERGE_WAYS 个时先归并成一个，打开的临时文件个数是有限的。
  */
 class OrderPhysicalOperator : public PhysicalOperator
 {
 public:
   OrderPhysicalOperator(std::vector<OrderByUnit *> order_units);
 
-  virtual ~OrderPhysicalOperator() = default;
+  virtual ~OrderPhysicalOperator();
 
   PhysicalOperatorType type() const override
   {
@@ -28,13 +33,62 @@ public:
   RC close() override;
 
   Tuple *current_tuple() override;
+
+  size_t peak_memory() const override { return peak_memory_; }
+  size_t spilled_bytes() const override { return spilled_bytes_; }
+
 private:
+  /**
+   * @brief 缓存的一行，记录的数据是复制出来的
+   */
+  struct SortRow
+  {
+    std::vector<Value>  keys;
+    std::vector<Record> records;
+  };
+
+  class SortRun;
+
   RC sort_table();
+  RC spill();
+  /**
+   * @brief 有序段太多时提前归并，减少同时打开的临时文件
+   */
+  RC compact_runs();
+  /**
+   * @brief 把 runs_ 中从first开始的有序段归并成一个
+   */
+  RC merge_runs(size_t first);
+  RC next_merged(SortRow *&row);
+
+  /**
+   * @brief 溢出到磁盘时一个有序段最少缓存的数据量
+   */
+  size_t min_run_memory() const;
+
+  bool less(const SortRow &a, const SortRow &b) const;
+  bool run_greater(int a, int b) const;
+  static size_t row_memory(const SortRow &row);
 
 private:
+  static constexpr size_t MIN_RUN_MEMORY = 4 * 1024 * 1024;  ///< 参考 min_run_memory
+  static constexpr int    MERGE_WAYS = 8;                     ///< 提前归并时，一次归并的有序段个数
+  static constexpr int    MAX_OPEN_RUNS = 64;                 ///< 同时打开的有序段个数上限
+
   std::vector<OrderByUnit *> order_units_;
+  std::vector<bool> is_asc_;
   bool is_init_ = true;
-  std::vector<std::vector<Record *>> st_;  // sort table
-  std::vector<int> st_idx_;
-  std::vector<int>::iterator it_;
+
+  std::vector<SortRow> rows_;       ///< 内存中缓存的行，全部在内存中排序时就是最终的结果
+  size_t rows_memory_ = 0;          ///< rows_ 占用的内存
+  size_t reserved_memory_ = 0;      ///< rows_ 占用的内存中从 reservation_ 申请到的部分
+  size_t next_row_ = 0;
+  std::vector<std::unique_ptr<SortRun>> runs_;  ///< 溢出到磁盘的有序段
+  std::vector<int> merge_heap_;     ///< 归并时每个有序段当前的行组成的堆
+  int last_run_ = -1;               ///< 上一次输出的行来自哪个有序段
+  std::vector<Record *> current_records_;
+
+  MemoryReservation *reservation_ = nullptr;
+  size_t peak_memory_ = 0;  ///< 排序缓存的记录和排序键占用的内存
+  size_t spilled_bytes_ = 0;
 };
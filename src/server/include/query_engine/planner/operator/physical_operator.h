@@ -14,6 +14,7 @@ class Trx;
 enum class PhysicalOperatorType
 {
   TABLE_SCAN,
+  SYSTEM_TABLE_SCAN,
   EXPLAIN,
   PREDICATE,
   PROJECT,
@@ -51,6 +52,17 @@ public:
 
   virtual Tuple *current_tuple() = 0;
 
+  /**
+   * @brief 算子执行过程中缓存数据占用内存的峰值，单位字节
+   * @details 只有需要物化数据的算子(比如排序)才有意义，EXPLAIN ANALYZE 中输出
+   */
+  virtual size_t peak_memory() const { return 0; }
+
+  /**
+   * @brief 内存预留不足时溢出到磁盘的数据量，单位字节，EXPLAIN ANALYZE 中输出
+   */
+  virtual size_t spilled_bytes() const { return 0; }
+
   void add_child(std::unique_ptr<PhysicalOperator> oper) {
     children_.emplace_back(std::move(oper));
   }
@@ -66,9 +78,6 @@ public:
     }
   }
 
-public:
-  bool isdelete_ = false;
-
 protected:
   const Tuple *father_tuple_ = nullptr;
   std::vector<std::unique_ptr<PhysicalOperator>> children_;
@@ -29,17 +29,17 @@ public:
   PhysicalOperatorGenerator() = default;
   virtual ~PhysicalOperatorGenerator() = default;
 
-  RC create(LogicalNode &logical_operator, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
+  RC create(LogicalNode &logical_operator, std::unique_ptr<PhysicalOperator> &oper);
 
 private:
-  RC create_plan(TableGetLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
-  RC create_plan(PredicateLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
-  RC create_plan(ProjectLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
+  RC create_plan(TableGetLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+  RC create_plan(PredicateLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+  RC create_plan(ProjectLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(AggrLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(OrderByLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(InsertLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(DeleteLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(UpdateLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
-  RC create_plan(ExplainLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
+  RC create_plan(ExplainLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(JoinLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
 };
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "physical_operator.h"
+#include "include/storage_engine/recorder/record.h"
+#include "include/common/rc.h"
+#include "include/query_engine/structor/tuple/row_tuple.h"
+
+class Table;
+
+/**
+ * @brief 系统表扫描物理算子
+ * @ingroup PhysicalOperator
+ * @details open 时由 SystemTable::fill_rows 生成当时的快照，之后逐行返回，与 TableScanPhysicalOperator 一样支持下推的过滤条件
+ */
+class SystemTableScanPhysicalOperator : public PhysicalOperator
+{
+public:
+  SystemTableScanPhysicalOperator(Table *table, const std::string &table_alias)
+      : table_(table), table_alias_(table_alias)
+  {}
+
+  virtual ~SystemTableScanPhysicalOperator() = default;
+
+  std::string param() const override;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::SYSTEM_TABLE_SCAN;
+  }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
+  void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
+
+private:
+  RC filter(RowTuple &tuple, bool &result);
+
+private:
+  Table *                                  table_ = nullptr;
+  std::string                              table_alias_;
+  std::vector<Record>                      records_;
+  size_t                                   next_index_ = 0;
+  Record *                                 current_record_ = nullptr;
+  RowTuple                                 tuple_;
+  std::vector<std::unique_ptr<Expression>> predicates_;
+};
@@ -16,6 +16,9 @@ public:
     if (aggr_type_ == AggrType::AGGR_COUNT) {
       return AttrType::INTS;
     }
+    if (aggr_type_ == AggrType::AGGR_AVG) {
+      return AttrType::FLOATS;
+    }
     return ((FieldExpr *) expr_.get())->value_type();
   }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include "include/session/session_request.h"
@@ -9,6 +10,24 @@ class SessionRequest;
 class Stmt;
 class ParsedSqlNode;
 
+/**
+ * @brief 一条语句各个阶段的耗时以及执行过程中的统计，慢查询日志使用
+ */
+struct QueryProfile
+{
+  int64_t  parse_ns = 0;
+  int64_t  analyze_ns = 0;
+  int64_t  plan_ns = 0;         ///< 生成逻辑计划和物理计划
+  int64_t  optimize_ns = 0;
+  int64_t  execute_ns = 0;      ///< 执行并把结果发送给客户端
+  int64_t  total_ns = 0;
+  uint64_t rows_examined = 0;   ///< 遍历过的记录数，参考 RecordScanStat
+  uint64_t rows_returned = 0;   ///< 返回给客户端的行数
+  uint64_t page_hits = 0;       ///< buffer pool命中的页面数
+  uint64_t page_misses = 0;     ///< buffer pool未命中的页面数
+  uint64_t page_reads = 0;      ///< 从磁盘读取的页面数
+};
+
 class QueryInfo
 {
 public:
@@ -60,11 +79,17 @@ public:
         return operator_;
     }
 
+    QueryProfile &profile()
+    {
+        return profile_;
+    }
+
 private:
   std::unique_ptr<ParsedSqlNode> sql_node_;
   Stmt *stmt_ = nullptr;
   std::unique_ptr<PhysicalOperator> operator_;
   SessionRequest                   *session_event_ = nullptr;
   std::string sql_;
+  QueryProfile profile_;
 };
 
@@ -53,9 +53,11 @@ public:
     cells_.push_back(cell);
   }
 
-  void append_cell(const char *alias)
+  void append_cell(const char *alias, AttrType type = UNDEFINED)
   {
-    append_cell(TupleCellSpec(alias));
+    TupleCellSpec cell(alias);
+    cell.set_type(type);
+    append_cell(cell);
   }
 
   int cell_num() const
@@ -32,9 +32,21 @@ public:
       return expression_;
   }
 
+  /**
+   * @brief 这一列的值类型，由表达式或字段确定，不知道时是UNDEFINED
+   */
+  AttrType type() const {
+    return type_;
+  }
+
+  void set_type(AttrType type) {
+    type_ = type;
+  }
+
 private:
   Expression* expression_ = nullptr;
   std::string alias_;
+  AttrType type_ = UNDEFINED;
 
   std::string table_name_;
   std::string field_name_;
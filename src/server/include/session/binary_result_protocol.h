@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief 普通文本协议(PlainCommunicator)的二进制结果集格式
+ * @ingroup Communicator
+ * @details 服务端和客户端(src/client)共用。
+ * 连接建立后，客户端发送的第一个消息如果是 HELLO，服务端回复 HELLO_ACK(以'\0'结尾)，
+ * 之后这个连接上所有请求的回复都使用二进制格式，不再有'\0'分隔符和"Cost time"。
+ *
+ * 每个回复由若干帧组成，每一帧是 1字节类型 + 4字节长度 + 内容，最后一帧一定是 END：
+ * - SCHEMA: u16列数，每一列 u8类型 + u16名字长度 + 名字
+ * - BATCH:  u32行数，然后按列依次存放：NULL位图((行数+7)/8字节)，
+ *           定长类型是行数个值，STRING是(行数+1)个u32偏移量加上所有字符串
+ * - END:    i32返回码 + u16返回码名字长度 + 返回码名字 + u32状态信息长度 + 状态信息
+ * 所有整数都是小端存储。没有结果集的语句(比如DDL)只有END帧。
+ */
+namespace binary_result {
+
+constexpr char HELLO[] = "\x01" "binary_result";
+constexpr char HELLO_ACK[] = "binary_result";
+
+enum FrameType : char
+{
+  FRAME_SCHEMA = 'S',
+  FRAME_BATCH = 'B',
+  FRAME_END = 'E',
+};
+
+enum ColumnType : uint8_t
+{
+  COLUMN_INT32 = 1,
+  COLUMN_FLOAT32 = 2,
+  COLUMN_BOOL = 3,
+  COLUMN_DATE = 4,  ///< int32，格式是yyyymmdd
+  COLUMN_STRING = 5,
+};
+
+constexpr int FRAME_HEADER_SIZE = 5;
+constexpr int BATCH_ROWS = 1024;  ///< 每个BATCH帧最多包含的行数
+
+inline void put_u16(std::string &buf, uint16_t v)
+{
+  buf.push_back(static_cast<char>(v & 0xff));
+  buf.push_back(static_cast<char>(v >> 8));
+}
+
+inline void put_u32(std::string &buf, uint32_t v)
+{
+  put_u16(buf, v & 0xffff);
+  put_u16(buf, v >> 16);
+}
+
+inline uint16_t get_u16(const char *data)
+{
+  return static_cast<uint8_t>(data[0]) | (static_cast<uint8_t>(data[1]) << 8);
+}
+
+inline uint32_t get_u32(const char *data)
+{
+  return get_u16(data) | (static_cast<uint32_t>(get_u16(data + 2)) << 16);
+}
+
+/**
+ * @brief 写入帧头，长度先占位，由 finish_frame 回填
+ * @return 帧头在buf中的位置
+ */
+inline size_t begin_frame(std::string &buf, FrameType type)
+{
+  size_t offset = buf.size();
+  buf.push_back(type);
+  put_u32(buf, 0);
+  return offset;
+}
+
+inline void finish_frame(std::string &buf, size_t frame_offset)
+{
+  std::string len;
+  put_u32(len, static_cast<uint32_t>(buf.size() - frame_offset - FRAME_HEADER_SIZE));
+  memcpy(&buf[frame_offset + 1], len.data(), len.size());
+}
+
+}  // namespace binary_result
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include "include/common/rc.h"
+
+/**
+ * @brief 由多个固定大小的块组成的写缓存
+ * @ingroup Communicator
+ * @details 数据追加到最后一个块，写满之后再分配新块，大的结果集也不需要一整块连续的内存。
+ * 发送时使用writev一次写出多个块，已经写出的块会留下一个备用，避免反复分配。
+ * 不是线程安全的。
+ */
+class BufferChain
+{
+public:
+  static constexpr int32_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+  explicit BufferChain(int32_t block_size = DEFAULT_BLOCK_SIZE);
+  ~BufferChain();
+
+  BufferChain(const BufferChain &) = delete;
+  BufferChain &operator=(const BufferChain &) = delete;
+
+  /**
+   * @brief 追加数据
+   */
+  void append(const char *data, int32_t size);
+
+  /**
+   * @brief 把缓存的数据写到fd，直到全部写完或者fd不可写(EAGAIN)
+   * @param write_size[out] 本次写出的数据量
+   */
+  RC write_to(int fd, int64_t &write_size);
+
+  /**
+   * @brief 丢弃所有数据
+   */
+  void clear();
+
+  int64_t size() const
+  {
+    return size_;
+  }
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+private:
+  struct Block
+  {
+    char   *data = nullptr;
+    int32_t begin = 0;  ///< 还没有写出的数据的开始位置
+    int32_t end = 0;    ///< 数据的结束位置
+  };
+
+  Block new_block();
+  void  release_block(Block &block);
+
+  /**
+   * @brief 移除已经写出的数据
+   */
+  void consume(int64_t size);
+
+private:
+  const int32_t     block_size_;
+  std::deque<Block> blocks_;
+  Block             spare_;     ///< 备用的空块
+  int64_t           size_ = 0;  ///< 还没有写出的数据总量
+};
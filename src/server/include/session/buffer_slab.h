@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/lang/mutex.h"
+
+/**
+ * @brief 固定大小内存块的分配器
+ * @ingroup Communicator
+ * @details 每次从系统申请一大块内存(slab)，切分成大小相同的内存块，释放的内存块放到空闲链表中复用，
+ * 不会归还给系统。epoll网络层中每个连接的读缓存从这里分配，避免连接频繁建立和断开时反复申请内存。
+ * 每个reactor线程有一个自己的分配器，连接也可能在SQL工作线程中关闭，所以分配和释放需要加锁，通常不会有竞争。
+ */
+class BufferSlab
+{
+public:
+  /**
+   * @param chunk_size 每个内存块的大小
+   * @param chunks_per_slab 每次向系统申请的内存块个数
+   */
+  BufferSlab(int32_t chunk_size, int32_t chunks_per_slab);
+  ~BufferSlab();
+
+  BufferSlab(const BufferSlab &) = delete;
+  BufferSlab &operator=(const BufferSlab &) = delete;
+
+  /**
+   * @brief 分配一个内存块，大小为 chunk_size
+   */
+  char *alloc();
+
+  /**
+   * @brief 释放一个由 alloc 分配的内存块
+   */
+  void free(char *chunk);
+
+  int32_t chunk_size() const
+  {
+    return chunk_size_;
+  }
+
+  /**
+   * @brief 已经分配出去的内存块个数
+   */
+  int32_t used() const;
+
+private:
+  const int32_t chunk_size_;
+  const int32_t chunks_per_slab_;
+
+  mutable common::ProfiledMutex lock_{"buffer_slab"};
+  std::vector<char *> slabs_;        ///< 向系统申请的大块内存
+  std::vector<char *> free_chunks_;  ///< 空闲的内存块
+  int32_t             used_ = 0;
+};
@@ -1,18 +1,30 @@
 #pragma once
 
-#include "ring_buffer.h"
+#include <string>
+#include <vector>
+
+#include "buffer_chain.h"
 
 /**
  * @brief 支持以缓存模式写入数据到文件/socket
- * @details 缓存使用ring buffer实现，当缓存满时会自动刷新缓存。
+ * @details 缓存使用 BufferChain 实现，写入的数据先追加到缓存中，缓存的数据超过高水位时会尝试写出，
+ * 如果对端接收得慢，写入者会等待fd可写，直到缓存的数据降到高水位以下(背压)，而不是忙等。
+ * 等待期间定期检查语句是否超时或者被取消，对端超过 write_timeout 一直不接收数据时返回错误。
+ * 打开压缩之后，写入的数据先放在暂存区，刷新或者满一帧时按照 compression_protocol.h 的格式压缩成帧再放入缓存。
  * 看起来直接使用fdopen也可以实现缓存写，不过fdopen会在close时直接关闭fd。
  * @note 在执行close时，描述符fd并不会被关闭
  */
 class BufferedWriter
 {
 public:
+  static constexpr int32_t DEFAULT_HIGH_WATERMARK = 1024 * 1024;
+  static constexpr int64_t DEFAULT_WRITE_TIMEOUT_MS = 30 * 1000;
+
   BufferedWriter(int fd);
-  BufferedWriter(int fd, int32_t size);
+  /**
+   * @param high_watermark 缓存数据量的高水位
+   */
+  BufferedWriter(int fd, int32_t high_watermark);
   ~BufferedWriter();
 
   /**
@@ -20,11 +32,16 @@ public:
    */
   RC close();
 
+  /**
+   * @brief 丢弃缓存中的数据和所有的设置，给新的连接使用，已经分配的内存保留下来
+   */
+  void reset(int fd);
+
   /**
    * @brief 写数据到文件/socket
-   * @details 缓存满会自动刷新缓存
+   * @details 数据总是全部放入缓存，缓存超过高水位时会写出数据
    * @param data 要写入的数据
-   * @param size 要写入的数据大小 
+   * @param size 要写入的数据大小
    * @param write_size 实际写入的数据大小
    */
   RC write(const char *data, int32_t size, int32_t &write_size);
@@ -39,20 +56,76 @@ public:
 
   /**
    * @brief 刷新缓存
-   * @details 将缓存中的数据全部写入文件/socket
+   * @details 将缓存中的数据全部写入文件/socket。
+   * 如果设置了延迟刷新，只写出不需要等待的部分，剩余的数据由调用者通过 flush_pending 写出。
    */
   RC flush();
 
+  /**
+   * @brief 写出缓存中的数据，直到全部写完或者fd不可写，不会等待
+   * @param drained[out] 缓存中的数据是否已经全部写出
+   */
+  RC flush_pending(bool &drained);
+
+  /**
+   * @brief 设置延迟刷新
+   * @details epoll网络层使用，工作线程执行完请求之后不等待慢的客户端，剩余的数据交给reactor在可写时发送
+   */
+  void set_deferred_flush(bool deferred)
+  {
+    deferred_flush_ = deferred;
+  }
+
+  /**
+   * @brief 设置等待对端接收数据的超时时间，一直没有数据写出超过这个时间就返回 IOERR_WRITE
+   */
+  void set_write_timeout(int64_t timeout_ms)
+  {
+    write_timeout_ms_ = timeout_ms;
+  }
+
+  /**
+   * @brief 打开压缩，之后写入的数据都会压缩成帧
+   */
+  void set_compression(bool compress)
+  {
+    compress_ = compress;
+  }
+
+  /**
+   * @brief 缓存中是否还有没有写出的数据
+   */
+  bool has_pending() const
+  {
+    return !buffer_.empty() || !staging_.empty();
+  }
+
 private:
   /**
-   * @brief 刷新缓存
-   * @details 期望缓存可以刷新size大小的数据，实际刷新的数据量可能小于size也可能大于size。
-   * 通常是在缓存满的时候，希望刷新掉一部分数据，然后继续写入。
-   * @param size 期望刷新的数据大小
+   * @brief 把暂存区的数据压缩成帧放入缓存
+   * @param all 为false时只处理完整的帧，不满一帧的数据继续留在暂存区
    */
-  RC flush_internal(int32_t size);
+  void seal_frames(bool all);
+  void append_frame(const char *data, int32_t size);
+
+  /**
+   * @brief 写出数据直到缓存的数据量不超过limit，fd不可写时等待
+   * @return 语句超时或者被取消时返回 QUERY_TIMEOUT/QUERY_CANCELLED，对端长时间不接收数据时返回 IOERR_WRITE
+   */
+  RC drain_to(int64_t limit);
 
 private:
-  int fd_ = -1;
-  RingBuffer buffer_;
-};
\ No newline at end of file
+  static constexpr int POLL_INTERVAL_MS = 100;  ///< 等待fd可写时，每次等待的时间
+
+  int         fd_ = -1;
+  int32_t     high_watermark_ = DEFAULT_HIGH_WATERMARK;
+  int64_t     write_timeout_ms_ = DEFAULT_WRITE_TIMEOUT_MS;
+  bool        deferred_flush_ = false;
+  BufferChain buffer_;
+
+  bool              compress_ = false;
+  std::string       staging_;                 ///< 打开压缩时还没有压缩的数据
+  std::vector<char> compress_buffer_;
+  int               incompressible_count_ = 0;  ///< 连续压缩效果不好的帧数
+  int               skip_compress_count_ = 0;   ///< 接下来不尝试压缩的帧数
+};
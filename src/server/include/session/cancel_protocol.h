@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * @brief 普通文本协议(PlainCommunicator)中取消正在执行的语句的方式
+ * @ingroup Communicator
+ * @details 服务端和客户端(src/client)共用。
+ * 连接建立后，客户端在发送第一个请求之前可以发送 HELLO，服务端回复当前会话的编号(十进制数字，以'\0'结尾)。
+ * 语句执行过程中客户端不能在同一个连接上发送消息来打断执行(消息会被当做下一个请求)，
+ * 需要建立一个新的连接，发送 "KILL QUERY <会话编号>"，然后直接关闭这个连接。
+ * 与压缩一起使用时需要在协商压缩之前获取会话编号。
+ */
+namespace cancel {
+
+constexpr char HELLO[] = "\x01" "session_id";
+
+}  // namespace cancel
@@ -21,6 +21,11 @@ public:
   RC write_state(SqlResult *sql_result, bool &need_disconnect) override;
   RC write_result(const char *data, int32_t size) override;
 
+  CommunicateProtocol protocol() const override
+  {
+    return CommunicateProtocol::CLI;
+  }
+
 private:
   int write_fd_ = -1; ///< 与使用远程通讯模式不同，如果读数据使用标准输入，那么输出应该是标准输出
 };
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/parser/value.h"
+#include "include/session/binary_result_protocol.h"
+
+class Tuple;
+
+namespace binary_result {
+
+/**
+ * @brief 查询计划中列的类型对应的二进制结果集列类型，不知道类型的列当做字符串
+ */
+ColumnType column_type_of(AttrType type);
+
+/**
+ * @brief 按列缓存若干行，编码成一个BATCH帧
+ * @ingroup Communicator
+ * @details 定长类型直接保存本机格式的值，编码时整列拷贝。
+ * 定长列只接受和列类型相同的值(或者NULL)，不做隐式转换；字符串列接受任何类型的值。
+ */
+class ColumnBatch
+{
+public:
+  explicit ColumnBatch(const std::vector<ColumnType> &types);
+
+  int rows() const
+  {
+    return rows_;
+  }
+
+  /**
+   * @brief 追加一行
+   * @return 值的类型和列的类型不一致时返回SCHEMA_FIELD_TYPE_MISMATCH，这一行不会追加
+   */
+  RC append(const Tuple &tuple);
+
+  /**
+   * @brief 把缓存的行编码成一个BATCH帧追加到frames，然后清空
+   */
+  void encode(std::string &frames);
+
+private:
+  struct Column
+  {
+    std::vector<char>     nulls;
+    std::vector<uint32_t> offsets;  ///< 只有字符串使用
+    std::string           data;
+  };
+
+  std::vector<ColumnType>        types_;
+  std::vector<Column>            columns_;
+  int                            rows_ = 0;
+};
+
+}  // namespace binary_result
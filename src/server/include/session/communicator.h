@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <event.h>
 #include "include/common/rc.h"
 #include "include/query_engine/executor/sql_result.h"
@@ -10,6 +11,7 @@
 
 class SessionRequest;
 class Session;
+class ConnectionPool;
 
 
 /**
@@ -18,13 +20,25 @@ class Session;
  * @details 当前有两种通讯协议，一种是普通的文本协议，以'\0'作为结尾，一种是mysql协议。
  */
 
+/**
+ * @brief 当前支持的通讯协议
+ * @ingroup Communicator
+ */
+enum class CommunicateProtocol 
+{
+  PLAIN,  ///< 以'\0'结尾的协议
+  CLI,    ///< 与客户端进行交互的协议
+  MYSQL,  ///< mysql通讯协议。具体实现参考 MysqlCommunicator
+};
+
 /**
  * @brief 负责与客户端通讯
  * @ingroup Communicator
  *
- * @details 在listener接收到一个新的连接(参考 server.cpp::accept), 就创建一个Communicator对象。
+ * @details 在listener接收到一个新的连接(参考 server.cpp::accept), 就从 ConnectionPool 中获取一个Communicator对象。
  * 并调用init进行初始化。
  * 在server中监听到某个连接有新的消息，就通过Communicator::read_event接收消息。
+ * 连接关闭后通过reset清理状态，放回 ConnectionPool 给新的连接使用。
 
  */
 class Communicator 
@@ -37,20 +51,79 @@ public:
    */
   virtual RC init(int fd, Session *session, const std::string &addr);
 
+  /**
+   * @brief 关闭连接并清理所有与连接相关的状态，之后可以再次调用init给新的连接使用
+   * @details 调用之前需要先通过 detach_session 取走会话
+   */
+  virtual void reset();
+
   /**
    * @brief 监听到有新的数据到达，调用此函数进行接收消息
    * 如果需要创建新的任务来处理，那么就创建一个SessionEvent 对象并通过event参数返回。
    */
   virtual RC read_event(SessionRequest *&event) = 0;
 
+  /**
+   * @brief 从网络层已经读取到的数据中解析一个请求
+   * @details epoll网络层使用，数据由网络层负责读取，这里只做解析。
+   * 数据不足一个完整的请求时返回成功，并且event为nullptr。
+   * @param data 已经读取到的数据
+   * @param size 数据的长度
+   * @param consumed[out] 解析出的请求占用的字节数
+   * @param event[out] 解析出的请求
+   */
+  virtual RC parse_event(const char *data, int32_t size, int32_t &consumed, SessionRequest *&event);
+
+  /**
+   * @brief 是否还有已经接收但没有处理的请求
+   * @details 客户端可以连续发送多个请求而不等待回复(pipelining)，一个批量执行的消息也会产生多个请求。
+   * 网络层处理完一个请求之后，需要先处理完这些请求，再等待新的数据。
+   */
+  virtual bool has_pending_request() const
+  {
+    return false;
+  }
+
   /**
    * @brief 关联的会话信息
+   * @details 打开会话复用时，连接只在执行请求期间关联会话，其它时候可能为空，参考 bind_session
    */
   Session *session() const
   {
     return session_;
   }
 
+  /**
+   * @brief 连接的会话编号，不会因为会话复用而改变，KILL QUERY 使用
+   */
+  uint64_t session_id() const
+  {
+    return session_id_;
+  }
+
+  /**
+   * @brief 设置管理当前对象的 ConnectionPool，会话复用时从这里获取会话
+   */
+  void set_pool(ConnectionPool *pool)
+  {
+    pool_ = pool;
+  }
+
+  /**
+   * @brief 确保连接关联了会话，执行请求之前调用
+   */
+  Session *bind_session();
+
+  /**
+   * @brief 请求执行完成。打开会话复用并且会话处于默认状态时，把会话归还给 ConnectionPool
+   */
+  void unbind_session();
+
+  /**
+   * @brief 取走关联的会话，之后由调用者负责释放
+   */
+  Session *detach_session();
+
   /**
    * @brief libevent使用的数据，参考server.cpp
    */
@@ -68,10 +141,33 @@ public:
     return addr_.c_str();
   }
 
+  /**
+   * @brief 使用的通讯协议
+   * @details 不同协议的结果集编码不同，查询结果缓存需要区分
+   */
+  virtual CommunicateProtocol protocol() const = 0;
+
   virtual RC write_state(SqlResult *sql_result, bool &need_disconnect) = 0;
 
   virtual RC write_result(const char *data, int32_t size) = 0;
 
+  /**
+   * @brief 是否由通讯层自己编码结果集
+   * @details 文本协议由执行引擎格式化结果，mysql协议需要按照协议编码列定义和每一行，参考 write_result_set
+   */
+  virtual bool encode_result_set() const
+  {
+    return false;
+  }
+
+  /**
+   * @brief 按照通讯协议发送请求的执行结果，包括结果集和最终状态
+   */
+  virtual RC write_result_set(SessionRequest *request, bool &need_disconnect)
+  {
+    return RC::UNIMPLENMENT;
+  }
+
   RC send_message_delimiter(){
     return writer_->writen(send_message_delimiter_.data(), send_message_delimiter_.size());
   }
@@ -80,25 +176,59 @@ public:
     writer_->flush();
   }
 
+  /**
+   * @brief 设置延迟刷新，参考 BufferedWriter::set_deferred_flush
+   */
+  void set_deferred_flush(bool deferred)
+  {
+    writer_->set_deferred_flush(deferred);
+  }
+
+  /**
+   * @brief 是否还有没有发送给客户端的数据
+   */
+  bool has_pending_output() const
+  {
+    return writer_->has_pending();
+  }
+
+  /**
+   * @brief 发送缓存中的数据，不等待
+   * @param drained[out] 数据是否已经全部发送
+   */
+  RC flush_pending(bool &drained)
+  {
+    return writer_->flush_pending(drained);
+  }
+
+  /**
+   * @brief 设置结果捕获缓冲区，之后通过write_result写出的数据同时会追加到capture中
+   * @details 查询结果缓存通过这种方式拿到序列化之后的结果，传nullptr结束捕获
+   */
+  void set_result_capture(std::string *capture)
+  {
+    result_capture_ = capture;
+  }
+
 protected:
   Session *session_ = nullptr;
+  uint64_t session_id_ = 0;
+  ConnectionPool *pool_ = nullptr;
   struct event read_event_;
   std::string addr_;
   BufferedWriter *writer_ = nullptr;
   std::vector<char> send_message_delimiter_; ///< 发送消息分隔符
   int fd_ = -1;
+  std::string *result_capture_ = nullptr; ///< 结果捕获缓冲区，参考 set_result_capture
 };
 
 /**
- * @brief 当前支持的通讯协议
+ * @brief 按照引号之外的'?'把SQL拆分成若干段
  * @ingroup Communicator
+ * @details 预处理语句和批量执行使用，执行时把参数依次拼接到各段之间
+ * @param fragments[out] 段的个数是参数个数+1
  */
-enum class CommunicateProtocol 
-{
-  PLAIN,  ///< 以'\0'结尾的协议
-  CLI,    ///< 与客户端进行交互的协议
-  MYSQL,  ///< mysql通讯协议。具体实现参考 MysqlCommunicator
-};
+void split_statement_template(const std::string &sql, std::vector<std::string> &fragments);
 
 /**
  * @brief 通讯协议工厂
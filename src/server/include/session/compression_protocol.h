@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief 普通文本协议(PlainCommunicator)发送给客户端的数据的压缩格式
+ * @ingroup Communicator
+ * @details 服务端和客户端(src/client)共用。
+ * 连接建立后，客户端在发送第一个请求之前可以发送 HELLO，服务端回复 HELLO_ACK(以'\0'结尾，不压缩)，
+ * 之后服务端发送的所有数据都被切分成帧，客户端解压之后得到的数据与不压缩时完全相同。
+ * 每一帧是 1字节类型 + u32原始长度 + u32内容长度 + 内容，整数都是小端存储。
+ * 类型是 FRAME_RAW 时内容就是原始数据，是 FRAME_LZ4 时内容是LZ4块格式压缩的数据。
+ * 很小的或者压缩效果不好的数据不压缩。
+ */
+namespace compression {
+
+constexpr char HELLO[] = "\x01" "compress";
+constexpr char HELLO_ACK[] = "compress";
+
+enum FrameType : char
+{
+  FRAME_RAW = 'R',
+  FRAME_LZ4 = 'L',
+};
+
+constexpr int     FRAME_HEADER_SIZE = 9;
+constexpr int32_t MAX_FRAME_RAW_SIZE = 64 * 1024;  ///< 每一帧原始数据的最大长度
+constexpr int32_t MIN_COMPRESS_SIZE = 512;         ///< 小于这个长度的数据不压缩
+
+}  // namespace compression
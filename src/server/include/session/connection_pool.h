@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "communicator.h"
+
+class Session;
+
+/**
+ * @brief 复用连接使用的 Communicator 和 Session 对象
+ * @ingroup Communicator
+ * @details 短连接很多时，每个连接都创建和释放 Communicator(以及它的 BufferedWriter)、Session 和事务对象的开销很明显。
+ * 连接关闭后这些对象清理状态之后放在空闲列表中，新的连接直接拿来使用，已经分配的缓存和事务对象也一起复用。
+ *
+ * 打开会话复用(multiplex)时，连接只在执行请求期间占用一个会话，请求执行完成后如果会话处于默认状态
+ * (参考 Session::is_default_state)就归还到空闲列表，下一个请求再重新获取，这样大量空闲的连接只需要很少的会话。
+ * 执行了 SET 或者处于多语句事务中的会话会一直被连接占用，直到恢复默认状态。
+ * 连接的会话编号(参考 Communicator::session_id)在复用期间不变，获取会话时会话使用连接的编号，KILL QUERY 不受影响。
+ *
+ * 通过配置文件中的 [SESSION_POOL] 设置。
+ */
+class ConnectionPool
+{
+public:
+  struct Options
+  {
+    int  max_idle_communicators = 256;  ///< 最多保留的空闲 Communicator 个数，0表示不复用
+    int  max_idle_sessions = 256;       ///< 最多保留的空闲 Session 个数，0表示不复用
+    bool multiplex = false;             ///< 是否在请求之间归还会话
+  };
+
+public:
+  ConnectionPool() = default;
+  ~ConnectionPool();
+
+  ConnectionPool(const ConnectionPool &) = delete;
+  ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+  void init(CommunicateProtocol protocol, const Options &options);
+
+  /**
+   * @brief 释放所有空闲的对象，服务停止时调用
+   */
+  void clear();
+
+  /**
+   * @brief 为新的连接获取并初始化一个 Communicator
+   * @param communicator[out] 成功时返回，关闭连接时调用 close
+   */
+  RC open(int fd, const std::string &addr, Communicator *&communicator);
+
+  /**
+   * @brief 关闭连接，归还 Communicator 以及它关联的会话
+   */
+  void close(Communicator *communicator);
+
+  /**
+   * @brief 获取一个默认状态的会话
+   * @param session_id 会话使用的编号，0表示分配一个新的编号
+   */
+  Session *acquire_session(uint64_t session_id);
+
+  /**
+   * @brief 归还会话，会话会被重置成默认状态
+   */
+  void release_session(Session *session);
+
+  bool multiplex() const { return options_.multiplex; }
+
+  int     idle_communicators() const;
+  int     idle_sessions() const;
+  uint64_t reused_communicators() const;
+  uint64_t reused_sessions() const;
+
+private:
+  CommunicateProtocol protocol_ = CommunicateProtocol::PLAIN;
+  Options             options_;
+  CommunicatorFactory factory_;
+
+  mutable std::mutex          lock_;
+  std::vector<Communicator *> idle_communicators_;
+  std::vector<Session *>      idle_sessions_;
+  uint64_t                    reused_communicators_ = 0;
+  uint64_t                    reused_sessions_ = 0;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+#include "include/common/rc.h"
+#include "buffer_slab.h"
+#include "communicator.h"
+#include "connection_pool.h"
+#include "worker_pool.h"
+
+class SessionRequest;
+
+/**
+ * @brief 基于epoll的网络事件循环
+ * @ingroup Communicator
+ * @details 每个reactor是一个线程，有自己的epoll实例和监听套接字。使用TCP时每个reactor的监听套接字
+ * 都设置了SO_REUSEPORT，由内核把新连接分散到各个reactor上；使用unix socket时所有reactor共用一个监听套接字，
+ * 通过EPOLLEXCLUSIVE避免惊群。连接建立之后一直由接收它的reactor负责读取。
+ *
+ * 连接使用边缘触发(EPOLLET)和EPOLLONESHOT，读事件到达时读取数据到连接自己的读缓存中，读缓存从 BufferSlab 分配。
+ * 缓存读满之后先解析，已经有完整的请求时就不再读取，只有单个请求超过 MAX_BUFFER_SIZE 时才拒绝。
+ * 解析出一个完整的请求后提交给SQL工作线程执行，执行期间连接不会再收到事件，
+ * 执行完成后如果缓存中还有完整的请求就继续执行，否则重新监听连接的读事件。
+ * 客户端关闭写端后，缓存中已经收到的请求仍然会执行完并发送回复，然后再关闭连接。
+ *
+ * 连接的输出设置了延迟刷新，工作线程执行完请求后不等待客户端接收，没有发送完的数据由reactor在连接可写时
+ * 使用writev发送，发送完之后再监听读事件。
+ */
+class EpollReactor
+{
+public:
+  /**
+   * @brief 执行一个请求，返回是否需要断开连接，由调用者负责释放request
+   */
+  using RequestHandler = std::function<bool(SessionRequest *)>;
+
+  EpollReactor(int index, ConnectionPool &connection_pool, WorkerPool &worker_pool, RequestHandler handler);
+  ~EpollReactor();
+
+  /**
+   * @brief 初始化epoll
+   * @param listen_fd 监听套接字，由调用者负责关闭
+   * @param shared 是否有多个reactor共用这个监听套接字
+   * @param tcp 是否是TCP连接，TCP连接会设置TCP_NODELAY
+   */
+  RC init(int listen_fd, bool shared, bool tcp);
+
+  /**
+   * @brief 启动事件循环线程
+   */
+  void start();
+
+  /**
+   * @brief 通知事件循环退出，不等待
+   */
+  void stop();
+
+  /**
+   * @brief 等待事件循环线程退出
+   */
+  void wait();
+
+private:
+  struct Connection;
+
+  void run();
+  void accept_connections();
+  /**
+   * @brief 连接可读或者可写
+   */
+  void on_event(Connection *conn);
+
+  /**
+   * @brief 读取数据直到EAGAIN、对端关闭或者读缓存满
+   * @details 读缓存满时先整理缓存，缓存开头就是一个不完整的请求时才扩大缓存
+   * @param drained[out] 是否已经读完了套接字中的数据
+   */
+  RC read_data(Connection *conn, bool &drained);
+
+  /**
+   * @brief 解析下一个请求，缓存中没有完整的请求时再读取数据
+   */
+  RC receive_request(Connection *conn, SessionRequest *&request);
+
+  /**
+   * @brief 从连接的读缓存中解析下一个请求，没有完整的请求时request为nullptr
+   */
+  RC next_request(Connection *conn, SessionRequest *&request);
+
+  /**
+   * @brief 在reactor线程中读取数据之后调用，有完整的请求就提交给工作线程，否则重新监听读事件
+   */
+  void dispatch(Connection *conn);
+
+  /**
+   * @brief 在工作线程中执行请求
+   */
+  void process(Connection *conn, SessionRequest *request);
+
+  void rearm(Connection *conn);
+  void close_connection(Connection *conn);
+
+  RC   grow_buffer(Connection *conn);
+  void release_buffer(Connection *conn);
+
+private:
+  static constexpr int32_t BUFFER_CHUNK_SIZE = 16 * 1024;         ///< 连接读缓存的初始大小
+  static constexpr int32_t BUFFER_CHUNKS_PER_SLAB = 64;
+  static constexpr int32_t MAX_BUFFER_SIZE = 16 * 1024 * 1024;    ///< 连接读缓存的上限
+
+  const int           index_;
+  ConnectionPool     &connection_pool_;
+  WorkerPool         &worker_pool_;
+  RequestHandler      handler_;
+
+  int  epoll_fd_ = -1;
+  int  listen_fd_ = -1;
+  int  wakeup_fd_ = -1;   ///< eventfd，用来通知事件循环退出
+  bool tcp_ = false;
+
+  std::thread       thread_;
+  std::atomic<bool> running_{false};
+
+  BufferSlab buffer_slab_;
+
+  std::mutex                       connections_lock_;
+  std::unordered_set<Connection *> connections_;  ///< 当前所有的连接，退出时关闭
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "include/common/rc.h"
+
+/**
+ * @brief 输出运行指标的HTTP服务
+ * @ingroup Communicator
+ * @details 在单独的端口和线程上监听，只支持很简单的 GET 请求，每个请求处理完就关闭连接：
+ * - /metrics  以 Prometheus 文本格式输出 MetricsRegistry 中的所有指标
+ * - /healthz  服务正常时返回 ok
+ * 请求量很小(监控系统定期抓取)，所以逐个处理连接，不与SQL连接共用网络线程。
+ */
+class MetricsHttpServer
+{
+public:
+  MetricsHttpServer() = default;
+  ~MetricsHttpServer();
+
+  /**
+   * @brief 监听指定的地址和端口，并启动服务线程
+   */
+  RC start(const std::string &address, int port);
+
+  /**
+   * @brief 停止服务线程并关闭监听套接字
+   */
+  void stop();
+
+private:
+  void run();
+  void handle_connection(int fd);
+
+private:
+  int               listen_fd_ = -1;
+  std::thread       thread_;
+  std::atomic<bool> running_{false};
+};
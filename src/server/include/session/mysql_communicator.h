@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "communicator.h"
+
+class Tuple;
+class Value;
+
+/**
+ * @brief 与mysql客户端通讯
+ * @ingroup Communicator
+ * @details 实现了mysql客户端/服务端协议(protocol 41)中的常用部分，可以直接使用mysql命令行客户端或者各种驱动连接。
+ * - 连接建立后发送Handshake V10，客户端的认证信息不做校验；
+ * - COM_QUERY，结果集使用文本格式编码；
+ * - COM_STMT_PREPARE/COM_STMT_EXECUTE/COM_STMT_CLOSE/COM_STMT_RESET，参数使用二进制格式解码之后
+ *   替换SQL中的'?'再执行，结果集使用二进制格式编码；
+ * - COM_PING、COM_INIT_DB、COM_QUIT。
+ * 每个消息都有一个4字节的包头：3字节的长度和1字节的序号。客户端每发送一个命令，序号从0开始，服务端的回复从1开始递增。
+ */
+class MysqlCommunicator : public Communicator
+{
+public:
+  MysqlCommunicator() = default;
+  ~MysqlCommunicator() override = default;
+
+  /**
+   * @brief 连接建立时发送Handshake V10
+   */
+  RC init(int fd, Session *session, const std::string &addr) override;
+  void reset() override;
+
+  /**
+   * @brief 读取一个完整的消息并处理
+   * @details 认证、PING等不需要执行SQL的命令直接在这里回复，event返回nullptr。
+   * 还没有收到完整的消息时也返回nullptr，已经收到的数据保存在接收缓存中
+   */
+  RC read_event(SessionRequest *&event) override;
+  RC parse_event(const char *data, int32_t size, int32_t &consumed, SessionRequest *&event) override;
+  bool has_pending_request() const override;
+
+  /**
+   * @brief 执行成功返回OK包，否则返回ERR包
+   */
+  RC write_state(SqlResult *sql_result, bool &need_disconnect) override;
+
+  CommunicateProtocol protocol() const override
+  {
+    return CommunicateProtocol::MYSQL;
+  }
+
+  /**
+   * @brief 直接发送已经编码好的数据，查询缓存命中时使用
+   */
+  RC write_result(const char *data, int32_t size) override;
+
+  bool encode_result_set() const override
+  {
+    return true;
+  }
+  RC write_result_set(SessionRequest *request, bool &need_disconnect) override;
+
+private:
+  /**
+   * @brief 服务端预处理的语句
+   * @details SQL按照'?'拆分成若干段，执行时把参数转换成SQL中的常量拼接起来
+   */
+  struct PreparedStatement
+  {
+    std::vector<std::string> fragments;    ///< 长度是参数个数+1
+    std::vector<uint16_t>    param_types;  ///< 最近一次执行时客户端发送的参数类型
+  };
+
+  RC handle_packet(const char *payload, int32_t size, SessionRequest *&event);
+  RC handle_handshake_response(const char *payload, int32_t size);
+  RC handle_stmt_prepare(const char *payload, int32_t size);
+  RC handle_stmt_execute(const char *payload, int32_t size, SessionRequest *&event);
+
+  /**
+   * @brief 发送一个消息，超过16M时拆分成多个
+   */
+  RC send_packet(const std::string &payload);
+  RC send_ok(const std::string &info = std::string());
+  RC send_error(const std::string &message);
+  RC send_eof();
+
+  RC send_column_definitions(const std::vector<std::string> &names, const std::vector<uint8_t> &types);
+  RC send_text_row(Tuple &tuple, int cell_num);
+  RC send_binary_row(Tuple &tuple, const std::vector<uint8_t> &types);
+
+private:
+  uint8_t     sequence_id_ = 0;     ///< 下一个要发送的消息的序号
+  bool        authed_ = false;      ///< 是否已经收到认证信息
+  uint32_t    connection_id_ = 0;
+  std::string scramble_;            ///< 握手时发送给客户端的随机数
+  uint32_t    client_capabilities_ = 0;
+
+  uint32_t next_stmt_id_ = 1;
+  std::unordered_map<uint32_t, PreparedStatement> statements_;
+
+  std::string recv_buffer_;  ///< read_event 已经读取但还没有解析的数据
+};
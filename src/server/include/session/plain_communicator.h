@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <vector>
 #include <cstring>
 #include "communicator.h"
@@ -7,15 +8,68 @@
 /**
  * @brief 与客户端进行通讯
  * @ingroup Communicator
- * @details 使用简单的文本通讯协议，每个消息使用'\0'结尾
+ * @details 使用简单的文本通讯协议，每个消息使用'\0'结尾。
+ * 客户端连接后可以协商使用二进制结果集和压缩，参考 binary_result_protocol.h 和 compression_protocol.h，
+ * 也可以获取会话编号，用来取消正在执行的语句，参考 cancel_protocol.h
+ *
+ * 客户端可以连续发送多个消息而不等待回复，服务端按顺序执行，每个消息一个回复。
+ * 以 BATCH_PREFIX 开头的消息是批量执行：一个带有'?'的SQL，后面跟着N组参数，
+ * 每组参数以 BATCH_ROW_SEP 开头，组内的参数以 BATCH_PARAM_SEP 分隔，参数是SQL中的常量(比如 1、'abc'、null)。
+ * 服务端把每组参数替换到SQL中，按顺序执行，回复和客户端连续发送N个消息相同。
  */
 class PlainCommunicator : public Communicator 
 {
 public:
   PlainCommunicator();
-  ~PlainCommunicator() override = default;
+  ~PlainCommunicator() override;
+
+  void reset() override;
 
   RC read_event(SessionRequest *&event) override;
+  RC parse_event(const char *data, int32_t size, int32_t &consumed, SessionRequest *&event) override;
+  bool has_pending_request() const override;
+
+  CommunicateProtocol protocol() const override
+  {
+    return CommunicateProtocol::PLAIN;
+  }
+
   RC write_state(SqlResult *sql_result, bool &need_disconnect) override;
   RC write_result(const char *data, int32_t size) override;
+
+  bool encode_result_set() const override
+  {
+    return binary_result_;
+  }
+  RC write_result_set(SessionRequest *request, bool &need_disconnect) override;
+
+  static constexpr int MAX_PACKET_SIZE = 65535 * 2;  ///< 一个请求的最大长度
+
+  static constexpr char BATCH_PREFIX = '\x02';     ///< 批量执行消息的开头
+  static constexpr char BATCH_ROW_SEP = '\x1e';    ///< 每组参数的开头
+  static constexpr char BATCH_PARAM_SEP = '\x1f';  ///< 一组参数中参数之间的分隔符
+
+private:
+  /**
+   * @brief 根据收到的一个完整消息创建请求
+   * @details 协商连接选项的消息直接回复，不创建请求
+   */
+  RC make_request(const char *data, int32_t size, SessionRequest *&event);
+
+  /**
+   * @brief 把批量执行的消息展开成多个请求，放到 pending_requests_ 中
+   */
+  RC expand_batch(const char *data, int32_t size);
+
+  /**
+   * @brief 发送一个包含了若干帧的回复
+   */
+  RC write_frames(const std::string &frames, bool &need_disconnect);
+
+private:
+  bool negotiating_ = true;     ///< 是否还没有收到过请求，这期间可以协商连接的选项
+  bool binary_result_ = false;  ///< 是否使用二进制结果集
+
+  std::string                 recv_buffer_;       ///< read_event 已经读取但还没有解析的数据
+  std::deque<SessionRequest *> pending_requests_;  ///< 批量执行展开之后还没有处理的请求
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <arpa/inet.h>
+#include <atomic>
 #include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
@@ -15,6 +16,8 @@
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <thread>
+#include <vector>
 #include <event2/thread.h>
 
 #include "common/defs.h"
@@ -28,15 +31,23 @@
 #include "session_request.h"
 #include "session.h"
 #include "communicator.h"
+#include "connection_pool.h"
+#include "worker_pool.h"
 
 class Communicator;
 class QueryEngine;
+class EpollReactor;
 
 /**
  * @brief 负责接收客户端消息并创建任务
  * @ingroup Communicator
  * @details 当前支持网络连接，有TCP和Unix Socket两种方式。通过命令行参数来指定使用哪种方式。
  * 启动后监听端口或unix socket，使用libevent来监听事件，当有新的连接到达时，创建一个Communicator对象进行处理。
+ * 连接使用的Communicator和Session对象从 ConnectionPool 获取，连接关闭后归还。
+ * 主线程只负责接收连接，连接轮流分配给若干个IO线程，每个IO线程有自己的event_base，负责读取请求。
+ * 读取到的请求交给SQL工作线程池执行，执行期间连接的读事件不再监听，执行完成后再重新加入IO线程的event_base。
+ * IO线程数和SQL线程数分别由配置文件中的 [IOThreads] 和 [SQLThreads] 指定。
+ * 也可以通过配置 [NET] EVENT_MODEL=epoll 使用 EpollReactor 代替libevent，这时每个IO线程都会接收连接。
  */
 class Server 
 {
@@ -70,6 +81,16 @@ private:
    */
   static void recv(int fd, short ev, void *arg);
 
+  /**
+   * @brief 在SQL工作线程中执行请求，执行完成后重新监听连接的读事件
+   */
+  static void process_request(SessionRequest *request);
+
+  /**
+   * @brief 执行请求并释放request，返回是否需要断开连接
+   */
+  static bool execute_request(SessionRequest *request);
+
 private:
   /**
    * @brief 将socket描述符设置为非阻塞模式
@@ -80,6 +101,24 @@ private:
 
   int start();
 
+  /**
+   * @brief 创建TCP监听套接字
+   * @param reuse_port 是否设置SO_REUSEPORT，多个套接字监听同一个端口
+   * @return 成功返回套接字，失败返回-1
+   */
+  int create_tcp_socket(bool reuse_port);
+
+  /**
+   * @brief 创建Unix Socket监听套接字
+   * @return 成功返回套接字，失败返回-1
+   */
+  int create_unix_socket();
+
+  /**
+   * @brief 在libevent中监听server_socket_上的新连接
+   */
+  int start_listen_event();
+
   /**
    * @brief 启动TCP服务
    */
@@ -95,6 +134,23 @@ private:
    */
   int start_stdin_server();
 
+  /**
+   * @brief 使用epoll网络层启动服务，参考 EpollReactor
+   */
+  int start_epoll_server();
+  void stop_epoll_server();
+
+  /**
+   * @brief 启动IO线程和SQL工作线程
+   */
+  int start_threads();
+  void stop_threads();
+
+  /**
+   * @brief 新连接轮流分配给各个IO线程
+   */
+  struct event_base *next_io_base();
+
 private:
   volatile bool started_ = false;
 
@@ -102,9 +158,18 @@ private:
   struct event_base *event_base_ = nullptr; ///< libevent对象
   struct event *listen_ev_ = nullptr;  ///< libevent监听套接字事件
 
+  std::vector<struct event_base *> io_bases_;  ///< 每个IO线程一个event_base
+  std::vector<std::thread> io_threads_;
+  std::atomic<size_t> next_io_index_{0};
+
+  std::vector<EpollReactor *> reactors_;  ///< 使用epoll网络层时的reactor
+  std::vector<int> listen_fds_;           ///< 使用epoll网络层时的监听套接字
+
   ServerParam server_param_;  ///< 服务启动参数
 
-  CommunicatorFactory communicator_factory_; ///< 通过这个对象创建新的Communicator对象
+  CommunicatorFactory communicator_factory_; ///< 标准输入输出使用的Communicator通过这个对象创建
 
+  static ConnectionPool connection_pool_;  ///< 网络连接的Communicator和Session从这里获取
   static QueryEngine query_engine_;  ///< 通过这个对象处理查询请求
+  static WorkerPool sql_worker_pool_;  ///< 执行SQL请求的线程池
 };
@@ -2,6 +2,7 @@
 
 #include <string>
 #include "communicator.h"
+#include "connection_pool.h"
 
 /**
  * @brief 服务端启动参数
@@ -23,6 +24,12 @@ public:
 
   int port; ///< 监听的端口号
 
+  int io_thread_num = 1;  ///< 读取请求的IO线程数
+
+  int sql_thread_num = 1;  ///< 执行SQL请求的线程数
+
+  bool use_epoll = false;  ///< 使用epoll网络层，否则使用libevent
+
   std::string unix_socket_path; ///< unix socket的路径
 
   bool use_std_io = false;  ///< 是否使用标准输入输出作为通信条件
@@ -32,4 +39,6 @@ public:
   bool use_unix_socket = false;
 
   CommunicateProtocol protocol; ///< 通讯协议，目前支持文本协议和mysql协议
+
+  ConnectionPool::Options connection_pool;  ///< Communicator和Session的复用，参考 ConnectionPool
 };
@@ -1,6 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+
+namespace common {
+class TimeoutInfo;
+}
 
 class Trx;
 class Db;
@@ -8,11 +17,24 @@ class SessionRequest;
 
 /**
  * @brief 表示会话
- * @details 当前一个连接一个会话，没有做特殊的会话管理，这也简化了会话处理
+ * @details 默认一个连接一个会话。连接关闭后会话通过 reset 恢复成默认状态，放回 ConnectionPool 中给新的连接使用。
+ * 打开会话复用(multiplex)时，处于默认状态的会话在两个请求之间归还给 ConnectionPool，多个连接共用较少的会话。
  */
 class Session 
 {
 public:
+  /**
+   * @brief 会话的状态，系统表 sys.sessions 使用
+   */
+  struct SessionInfo
+  {
+    uint64_t    id = 0;
+    std::string db_name;        ///< 最近一条语句开始时的数据库
+    bool        running = false;  ///< 是否正在执行语句
+    int64_t     elapsed_us = 0;   ///< 正在执行的语句已经执行的时间，空闲时是已经空闲的时间
+    std::string sql;            ///< 正在执行或者最近执行的语句
+  };
+
   /**
    * @brief 获取默认的会话数据，新生成的会话都基于默认会话设置参数
    * @note 当前并没有会话参数
@@ -65,6 +87,77 @@ public:
   void set_sql_debug(bool sql_debug) { sql_debug_ = sql_debug; }
   bool sql_debug_on() const { return sql_debug_; }
 
+  void set_trace(bool trace) { trace_ = trace; }
+  bool trace_on() const { return trace_; }
+
+  /**
+   * @brief 会话的编号，KILL QUERY 使用。默认会话以及 ConnectionPool 中空闲的会话的编号是0
+   */
+  uint64_t id() const { return id_; }
+
+  /**
+   * @brief 修改会话的编号，0表示不能通过 KILL QUERY 找到这个会话
+   * @details 复用会话时，会话使用连接的编号，参考 ConnectionPool
+   */
+  void set_id(uint64_t id);
+
+  /**
+   * @brief 分配一个新的会话编号
+   */
+  static uint64_t allocate_id();
+
+  /**
+   * @brief 恢复成默认会话的状态，没有结束的多语句事务会回滚
+   * @details 会话对象被新的连接复用之前调用。已经创建的事务对象会保留下来继续使用
+   */
+  void reset();
+
+  /**
+   * @brief 会话是否处于默认状态：没有进行中的多语句事务，变量和当前数据库都与默认会话相同
+   * @details 只有处于默认状态的会话才能在请求之间归还，被其它连接使用
+   */
+  bool is_default_state() const;
+
+  /**
+   * @brief 语句执行的超时时间，单位毫秒，0表示不限制。通过 SET statement_timeout 设置
+   */
+  void set_statement_timeout(int64_t timeout_ms) { statement_timeout_ms_ = timeout_ms; }
+  int64_t statement_timeout() const { return statement_timeout_ms_; }
+
+  /**
+   * @brief 开始执行一个语句，根据 statement_timeout 设置截止时间
+   */
+  void begin_query(const std::string &sql);
+
+  /**
+   * @brief 语句执行结束
+   */
+  void end_query();
+
+  /**
+   * @brief 检查当前会话正在执行的语句是否超时或者被取消
+   * @details 算子在处理数据的循环中调用，发现被中断之后应该尽快返回错误，由上层关闭算子释放资源。
+   * 为了减少开销，每调用若干次才真正检查一次。没有正在执行的语句时总是返回成功
+   * @return 超时返回 QUERY_TIMEOUT，被取消返回 QUERY_CANCELLED
+   */
+  static RC check_interrupt();
+
+  /**
+   * @brief 和 check_interrupt 一样，但是每次都检查，用在本来就很少调用的地方，比如等待客户端接收数据
+   */
+  static RC check_interrupt_now();
+
+  /**
+   * @brief 取消指定会话正在执行的语句
+   * @return 找不到会话时返回 NOTFOUND，会话当前没有执行语句也返回成功
+   */
+  static RC kill_query(uint64_t session_id);
+
+  /**
+   * @brief 列出所有有编号的会话，按编号排序
+   */
+  static void list_sessions(std::vector<SessionInfo> &sessions);
+
   /**
    * @brief 将指定会话设置到线程变量中
    * 
@@ -83,4 +176,14 @@ private:
   SessionRequest *current_request_ = nullptr; ///< 当前正在处理的请求
   bool trx_multi_operation_mode_ = false;   ///< 当前事务的模式，是否多语句模式. 单语句模式自动提交
   bool sql_debug_ = false;                  ///< 是否输出SQL调试信息
+  bool trace_ = false;                      ///< 是否记录每条语句的执行过程，参考 QueryTrace
+
+  uint64_t id_ = 0;
+  int64_t  statement_timeout_ms_ = 0;
+  std::mutex query_lock_;                   ///< 保护timeout_info_以及语句的信息，KILL QUERY 和系统表从其它线程访问
+  common::TimeoutInfo *timeout_info_ = nullptr;  ///< 当前执行的语句的截止时间和取消标识
+  std::string query_sql_;                   ///< 正在执行或者最近执行的语句
+  std::string query_db_name_;
+  int64_t     state_change_time_us_ = 0;    ///< 开始或者结束执行语句的时间
+  int interrupt_countdown_ = 0;             ///< 参考 check_interrupt
 };
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <string.h>
+#include <memory>
 #include <string>
 
 #include "include/query_engine/executor/sql_result.h"
 
 class Session;
 class Communicator;
+class MemoryReservation;
+class ParsedSqlResult;
 
 /**
  * @brief 表示一个SQL请求
@@ -26,8 +29,33 @@ public:
 
   SqlResult *sql_result() { return &sql_result_; }
 
+  /**
+   * @brief 结果集是否使用二进制格式编码，mysql协议的预处理语句使用
+   */
+  void set_binary_result(bool binary_result) { binary_result_ = binary_result; }
+  bool binary_result() const { return binary_result_; }
+
+  /**
+   * @brief 当前请求的内存预留，需要缓存数据的算子从这里申请内存，没有开启准入控制时为空
+   */
+  void set_memory_reservation(MemoryReservation *reservation) { memory_reservation_ = reservation; }
+  MemoryReservation *memory_reservation() const { return memory_reservation_; }
+
+  /**
+   * @brief 执行之前已经完成的语法解析结果，参考 Parser::preparse
+   */
+  void set_parsed_sql(std::unique_ptr<ParsedSqlResult> parsed_sql);
+
+  /**
+   * @brief 取走提前完成的语法解析结果，没有时返回空
+   */
+  std::unique_ptr<ParsedSqlResult> take_parsed_sql();
+
 private:
   Communicator *communicator_ = nullptr;  ///< 与客户端通讯的对象
   SqlResult     sql_result_;              ///< SQL执行结果
   std::string   query_;                   ///< SQL语句
+  bool          binary_result_ = false;   ///< 参考 set_binary_result
+  MemoryReservation *memory_reservation_ = nullptr;  ///< 参考 set_memory_reservation
+  std::unique_ptr<ParsedSqlResult> parsed_sql_;      ///< 参考 set_parsed_sql
 };
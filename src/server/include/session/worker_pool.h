@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 执行SQL请求的线程池
+ * @ingroup Communicator
+ * @details IO线程读取到完整的请求之后，把处理请求的任务提交到这里，
+ * 由工作线程调用 QueryEngine::process_session_request 执行，避免慢查询阻塞IO线程上的其它连接。
+ */
+class WorkerPool
+{
+public:
+  using Task = std::function<void()>;
+
+  WorkerPool() = default;
+  ~WorkerPool();
+
+  /**
+   * @brief 启动工作线程
+   * @param thread_num 线程数
+   * @param name 线程名字的前缀，方便调试
+   */
+  void start(int thread_num, const std::string &name);
+
+  /**
+   * @brief 等待已经提交的任务执行完成，然后停止所有工作线程
+   */
+  void stop();
+
+  /**
+   * @brief 提交一个任务，线程池已经停止时返回false
+   */
+  bool submit(Task task);
+
+  int thread_num() const
+  {
+    return static_cast<int>(threads_.size());
+  }
+
+private:
+  void run();
+
+private:
+  std::mutex              mutex_;
+  std::condition_variable cond_;
+  std::deque<Task>        tasks_;
+  std::vector<std::thread> threads_;
+  bool                    stopped_ = false;
+};
@@ -19,6 +19,20 @@ class BufferPoolManager;
  * @defgroup BufferPool
  */
 
+/**
+ * @brief 当前线程访问BufferPool的统计
+ * @ingroup BufferPool
+ * @details 只在当前线程内累加，不需要加锁。EXPLAIN ANALYZE 通过前后两次的差值把页面访问归属到具体的算子上
+ */
+struct BufferPoolStat
+{
+  uint64_t hits = 0;    ///< 页面已经在内存中
+  uint64_t misses = 0;  ///< 页面不在内存中，需要分配页帧
+  uint64_t reads = 0;   ///< 从磁盘读取的页面数
+
+  static BufferPoolStat &thread_local_stat();
+};
+
 /**
  * @brief BufferPool的实现，负责实际与磁盘交互
  * 每个 FileBufferPool 对象对应一个物理文件
@@ -57,6 +71,7 @@ public:
   RC evict_all_pages();
 
   int file_desc() const;
+  const std::string &file_name() const { return file_name_; }
 
   RC recover_page(PageNum page_num);
 
@@ -84,7 +99,7 @@ private:
   FileHeader *       file_header_ = nullptr;  // 文件头
   std::set<PageNum>    disposed_pages_;  // 已经释放的页面
 
-  common::Mutex        lock_;
+  common::Mutex        lock_{"buffer_pool.file"};
 private:
   friend class BufferPoolIterator;
 };
@@ -108,6 +123,18 @@ private:
   PageNum current_page_num_ = -1;
 };
 
+/**
+ * @brief 内存中一个页帧的状态
+ * @ingroup BufferPool
+ */
+struct BufferFrameInfo
+{
+  std::string file_name;
+  PageNum     page_num = 0;
+  int         pin_count = 0;
+  bool        dirty = false;
+};
+
 /**
  * @brief BufferPool的管理类，对上层可见的接口
  */
@@ -123,13 +150,18 @@ public:
 
   RC flush_page(Frame &frame);
 
+  /**
+   * @brief 列出内存中所有的页帧，系统表 sys.buffer_pool 使用
+   */
+  void list_frames(std::vector<BufferFrameInfo> &frames);
+
 public:
   static void set_instance(BufferPoolManager *bpm);
   static BufferPoolManager &instance();
 
 private:
   FrameManager frame_manager_{"BufPool"};
-  common::Mutex  lock_;
+  common::Mutex  lock_{"buffer_pool.manager"};
   std::unordered_map<std::string, FileBufferPool *> buffer_pools_;  // 已经打开的文件
   std::unordered_map<int, FileBufferPool *> fd_buffer_pools_;
 };
@@ -5,6 +5,7 @@
 #include "include/storage_engine/buffer/frame.h"
 #include "common/mm/mem_pool.h"
 #include "common/lang/lru_cache.h"
+#include "common/lang/mutex.h"
 
 /**
 * @brief 管理页帧Frame
@@ -59,6 +60,11 @@ public:
   */
  std::list<Frame *> find_list(int file_desc);
 
+ /**
+  * @brief 遍历所有的页帧，遍历期间持有锁，visitor中不能再访问FrameManager
+  */
+ void foreach_frame(std::function<void(const Frame &frame)> visitor);
+
  size_t frame_num() const { return frames_.count(); }
 
  RC free(int file_desc, PageNum page_num, Frame *frame);
@@ -79,7 +85,7 @@ private:
  using FrameLruCache = common::LruCache<FrameId, Frame *, FrameIdHasher>;
  using FrameAllocator = common::MemPoolSimple<Frame>;
 
- std::mutex lock_;  // 对frames_进行操作时需要加锁
+ common::ProfiledMutex lock_{"frame_manager"};  // 对frames_进行操作时需要加锁
  FrameLruCache  frames_;  // 用于存放Frame，但内存有限
  FrameAllocator allocator_;  // 用于分配新的Frame
 };
\ No newline at end of file
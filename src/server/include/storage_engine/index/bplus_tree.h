@@ -4,6 +4,7 @@
 #include <sstream>
 #include <functional>
 #include <memory>
+#include <atomic>
 
 #include "include/storage_engine/recorder/record_manager.h"
 #include "include/storage_engine/buffer/buffer_pool.h"
@@ -446,6 +447,9 @@ class InternalIndexNodeHandler : public IndexNodeHandler
 class BplusTreeHandler
 {
  public:
+  BplusTreeHandler() = default;
+  ~BplusTreeHandler();
+
   /**
    * @details 此函数创建一个名为fileName的索引。
    * @param file_name 索引文件的名字
@@ -489,6 +493,22 @@ class BplusTreeHandler
 
   bool is_empty() const;
 
+  /**
+   * 树的高度，空树是0，只有一个叶子节点时是1。打开索引时计算，之后随着根节点的分裂和合并更新
+   */
+  int height() const { return height_.load(std::memory_order_relaxed); }
+
+  /**
+   * 当前打开的所有索引中最大的高度，作为指标输出
+   */
+  static int max_open_height();
+
+  /**
+   * 叶子节点的页面数，从最左边的叶子节点开始沿着链表遍历所有的叶子节点
+   * @note 不加锁，与并发的修改同时进行时结果只是近似值。系统表 sys.indexes 使用
+   */
+  RC leaf_page_count(int &count);
+
   /**
    * 获取指定值的record对应的RID
    * @param multi_keys 索引字段的属性值数组（之所以是数组，因为可能是多字段索引）
@@ -554,6 +574,8 @@ class BplusTreeHandler
 
   RC adjust_root(Frame *root_frame);
 
+  RC init_height();
+
  private:
   common::MemPoolItem::unique_ptr make_key(const char *multi_keys[], const RID &rid, int multi_keys_num = 1, int left_or_right = 0, bool all_in_one_input_key = false);
   void free_key(char *key);
@@ -568,6 +590,8 @@ class BplusTreeHandler
 
   std::unique_ptr<common::MemPoolItem> mem_pool_item_;
 
+  std::atomic<int> height_{0};
+
  private:
   friend class BplusTreeScanner;
   friend class BplusTreeTester;
@@ -595,7 +619,7 @@ class BplusTreeScanner
   RC open(const char *left_user_key, int left_len, bool left_inclusive,
           const char *right_user_key, int right_len, bool right_inclusive);
 
-  RC next_entry(RID &rid, bool isdelete);
+  RC next_entry(RID &rid);
 
   RC close();
 
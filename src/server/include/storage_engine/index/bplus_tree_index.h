@@ -51,7 +51,7 @@ class BplusTreeIndexScanner : public IndexScanner
   BplusTreeIndexScanner(BplusTreeHandler &tree_handle);
   ~BplusTreeIndexScanner() noexcept override;
 
-  RC next_entry(RID *rid, bool isdelete) override;
+  RC next_entry(RID *rid) override;
   RC destroy() override;
 
   RC open(const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len,
@@ -102,6 +102,17 @@ public:
     }
   }
 
+  Record(Record &&other) noexcept
+  {
+    rid_   = other.rid_;
+    data_  = other.data_;
+    len_   = other.len_;
+    owner_ = other.owner_;
+
+    other.data_  = nullptr;
+    other.owner_ = false;
+  }
+
   Record &operator=(const Record &other)
   {
     if (this == &other) {
@@ -183,6 +183,11 @@ public:
    */
   bool is_full() const;
 
+  /**
+   * @brief 当前页面的记录数
+   */
+  int record_num() const;
+
 protected:
   /**
    * @details 
@@ -220,6 +225,17 @@ private:
   friend class RecordPageIterator;
 };
 
+/**
+ * @brief 记录文件的统计信息
+ * @ingroup RecordManager
+ */
+struct RecordFileStat
+{
+  int     pages = 0;       ///< 已经分配的记录页面数，不包括文件头
+  int64_t records = 0;     ///< 记录数
+  int     free_pages = 0;  ///< 没有填满的页面数
+};
+
 /**
  * @brief 管理整个文件中记录的增删改查
  * @ingroup RecordManager
@@ -249,6 +265,15 @@ public:
    */
   RC delete_record(const RID *rid);
 
+  /**
+   * @brief 批量删除记录
+   * @details 同一个页面上的记录只需要获取一次页面，要求rids已经按照页面号排好序。
+   * 按顺序删除，遇到错误就停止，已经删除的总是rids的前 deleted_count 个
+   * @param rids 待删除记录的标识符，按照(page_num, slot_num)有序
+   * @param deleted_count[out] 删除成功的记录个数
+   */
+  RC delete_records(const std::vector<RID> &rids, size_t &deleted_count);
+
   /**
    * @brief 插入一个新的记录到指定文件中，并返回该记录的标识符
    * 
@@ -258,6 +283,16 @@ public:
    */
   RC insert_record(const char *data, int record_size, RID *rid);
 
+  /**
+   * @brief 批量插入记录，一个页面填满之后再获取下一个页面
+   *
+   * @details 按顺序插入，遇到错误就停止，已经插入的总是records的前 inserted_count 个
+   * @param records     待插入的记录，插入成功后通过每个记录的rid返回标识符
+   * @param record_size 记录大小
+   * @param inserted_count[out] 插入成功的记录个数
+   */
+  RC insert_records(std::vector<Record> &records, int record_size, size_t &inserted_count);
+
    /**
    * @brief 数据库恢复时，在指定文件指定位置插入数据
    * 
@@ -288,7 +323,19 @@ public:
    */
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
 
+  /**
+   * @brief 统计页面数和记录数，需要读取所有的页面
+   * @details 不会阻塞并发的插入和删除，统计的结果只是某个时刻的近似值。系统表 sys.tables 使用
+   */
+  RC get_stat(RecordFileStat &stat);
+
 private:
+  /**
+   * @brief 找到一个没有填满的页面，找不到就分配一个新的页面
+   * @param record_page_handler 返回时已经持有该页面
+   */
+  RC open_free_page(RecordPageHandler &record_page_handler, int record_size);
+
   /**
    * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
    * 遍历当前文件上所有页面，找到没有满的页面 这个效率很低，会降低启动速度
@@ -299,7 +346,19 @@ private:
 private:
   FileBufferPool             *file_buffer_pool_ = nullptr;
   std::unordered_set<PageNum> free_pages_;  // 没有填充满的页面集合
-  common::Mutex               lock_;        // 未满page集合free_pages_的锁。当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
+  common::Mutex               lock_{"record_file.free_pages"};  // 未满page集合free_pages_的锁。当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
+};
+
+/**
+ * @brief 当前线程遍历过的记录数
+ * @ingroup RecordManager
+ * @details 与 BufferPoolStat 一样只在当前线程内累加。慢查询日志通过前后两次的差值统计一条语句检查过的行数
+ */
+struct RecordScanStat
+{
+  uint64_t records = 0;  ///< RecordFileScanner 读取的记录数，包括被过滤掉的记录
+
+  static RecordScanStat &thread_local_stat();
 };
 
 /**
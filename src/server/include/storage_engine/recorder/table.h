@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <vector>
 
@@ -11,6 +12,7 @@
 class RecordFileScanner;
 class RecordFileHandler;
 class Index;
+class SystemTable;
 
 /**
  * @brief 表
@@ -49,6 +51,16 @@ public:
       int attribute_count,
       const AttrInfoSqlNode attributes[]);
 
+  /**
+   * 创建一个系统表，只有元数据，没有数据文件
+   * @param system_table 扫描时由它生成表中的数据
+   */
+  RC create_system_table(int32_t table_id,
+      const char *name,
+      int attribute_count,
+      const AttrInfoSqlNode attributes[],
+      SystemTable *system_table);
+
   /**
    * 删除一个表
    * @param name 表名
@@ -80,7 +92,23 @@ public:
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
    */
   RC insert_record(Record &record);
+
+  /**
+   * @brief 批量插入记录
+   * @details 先把记录连续写入数据页面，一个页面填满后再换下一个，然后再统一维护索引。导入数据时使用。
+   * 写入记录或者索引失败时，撤销这一批已经写入的记录和索引项
+   * @param records[in/out] 插入成功会通过每个记录的rid返回RID
+   */
+  RC insert_records(std::vector<Record> &records);
   RC delete_record(const Record &record);
+
+  /**
+   * @brief 批量删除记录
+   * @details 先按照每个索引的键值顺序删除索引项，再按照RID顺序删除记录，同一个页面只需要获取一次。
+   * 删除索引项失败时插回已经删除的索引项，不删除任何记录；删除记录中途失败时插回没有删除的记录的索引项，
+   * 不会留下没有索引项的记录。会对records按照RID重新排序，失败时records中只保留已经删除的记录
+   */
+  RC delete_records(std::vector<Record> &records);
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
   RC get_record(const RID &rid, Record &record);
 
@@ -106,11 +134,44 @@ public:
   const char *origin_table_name() const { return table_meta_.origin_table_name(); }
   SelectStmt *select_stmt() { return table_meta_.select_stmt(); }
 
+  bool is_system_table() const { return system_table_ != nullptr; }
+  SystemTable *system_table() const { return system_table_; }
+
   RC sync();
 
+  /**
+   * @brief 表数据的版本号
+   * @details 每次插入、删除(更新也是通过删除和插入完成的)记录都会换一个新的版本号，
+   * 版本号在所有表之间全局递增，删除再重建的同名表也不会得到相同的版本号。查询结果缓存用它判断缓存是否失效。
+   */
+  uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+private:
+  void bump_version();
+  static uint64_t next_version();
+
 private:
   RC insert_entry_of_indexes(const char *record, const RID &rid);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
+  void sort_by_index_key(
+      const Index &index, const std::vector<Record> &records, std::vector<const Record *> &ordered_records) const;
+
+  /**
+   * @brief 撤销 insert_records 已经写入的数据
+   * @param inserted_count 已经写入数据页面的记录个数，是records的前缀
+   * @param index_count 已经插入了全部索引项的索引个数
+   * @param partial_index_records 第 index_count 个索引已经插入了索引项的记录
+   */
+  void rollback_insert_records(const std::vector<Record> &records, size_t inserted_count, size_t index_count,
+      const std::vector<const Record *> &partial_index_records);
+
+  /**
+   * @brief 撤销 delete_records 已经删除的索引项
+   * @param index_count 已经删除了records全部索引项的索引个数
+   * @param partial_index_records 第 index_count 个索引已经删除了索引项的记录
+   */
+  void restore_index_entries(const std::vector<const Record *> &records, size_t index_count,
+      const std::vector<const Record *> &partial_index_records);
 
 private:
   RC init_record_handler(const char *base_dir);
@@ -119,6 +180,7 @@ private:
 public:
   Index *find_index(const char *index_name) const;
   Index *find_index_by_field(const char *field_name) const;
+  const std::vector<Index *> &indexes() const { return indexes_; }
 
 private:
   std::string base_dir_;
@@ -126,4 +188,6 @@ private:
   FileBufferPool *data_buffer_pool_ = nullptr;   /// 数据文件关联的buffer pool
   RecordFileHandler *record_handler_ = nullptr;  /// 记录操作
   std::vector<Index *> indexes_;
+  SystemTable *system_table_ = nullptr;          /// 系统表的数据来源，普通的表为空
+  std::atomic<uint64_t> version_{next_version()};  /// 表数据的版本号
 };
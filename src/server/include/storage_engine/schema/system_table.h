@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/parser/parse_defs.h"
+#include "include/storage_engine/recorder/table.h"
+
+class Db;
+
+/**
+ * @brief 系统表
+ * @details 只读的虚拟表，名字都以 sys. 开头，比如 sys.sessions，在任何数据库中都可以查询。
+ * 系统表只有元数据，没有数据文件，每次扫描时通过 fill_rows 生成当时内存状态的一份快照，
+ * 由 SystemTableScanPhysicalOperator 返回给上层算子，过滤、排序、聚合等都与普通的表相同。
+ * 语法上只有 SELECT 的 FROM 子句接受带前缀的表名，所以系统表不会被修改。
+ */
+class SystemTable
+{
+public:
+  SystemTable() = default;
+  virtual ~SystemTable() = default;
+
+  SystemTable(const SystemTable &) = delete;
+  SystemTable &operator=(const SystemTable &) = delete;
+
+  Table *table() { return &table_; }
+
+  /**
+   * @brief 生成表中的数据，每一行的值与表的字段一一对应
+   * @param db 当前会话使用的数据库
+   */
+  virtual RC fill_rows(Db *db, std::vector<std::vector<Value>> &rows) = 0;
+
+  /**
+   * @brief 根据表名查找系统表
+   * @return 不是系统表时返回空
+   */
+  static Table *find(const char *table_name);
+
+protected:
+  RC init(int32_t table_id, const char *name, const std::vector<AttrInfoSqlNode> &attributes);
+
+private:
+  Table table_;
+};
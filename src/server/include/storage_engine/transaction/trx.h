@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include "common/log/log.h"
 #include "common/lang/string.h"
@@ -95,6 +96,10 @@ public:
 
   virtual RC insert_record(Table *table, Record &record) = 0;
   virtual RC delete_record(Table *table, Record &record) = 0;
+  /**
+   * @brief 批量删除记录，默认逐条调用delete_record
+   */
+  virtual RC delete_records(Table *table, std::vector<Record> &records);
   virtual RC visit_record(Table *table, Record &record, bool readonly) = 0;
 
   virtual RC start_if_need() = 0;
@@ -30,6 +30,7 @@ public:
 
  RC insert_record(Table *table, Record &record) override;
  RC delete_record(Table *table, Record &record) override;
+ RC delete_records(Table *table, std::vector<Record> &records) override;
  RC visit_record(Table *table, Record &record, bool readonly) override;
 
  RC start_if_need() override;
@@ -1,9 +1,11 @@
 #include <netinet/in.h>
 #include <unistd.h>
+#include <algorithm>
 #include <iostream>
 
 #include "include/common/init.h"
 #include "include/common/setting.h"
+#include "common/os/os.h"
 #include "common/os/process.h"
 #include "common/os/signal.h"
 #include "common/lang/string.h"
@@ -75,6 +77,45 @@ void parse_parameter(int argc, char **argv)
   }
 }
 
+/**
+ * 从配置文件中读取线程数，没有配置或者配置为0时使用CPU核数
+ */
+int get_thread_num(const char *section)
+{
+  int thread_num = 0;
+  std::map<std::string, std::string> thread_section = get_properties()->get(section);
+  std::map<std::string, std::string>::iterator it = thread_section.find(THREAD_COUNT);
+  if (it != thread_section.end()) {
+    str_to_val(it->second, thread_num);
+  }
+  if (thread_num <= 0) {
+    thread_num = std::max<int>(1, getCpuNum());
+  }
+  return thread_num;
+}
+
+/**
+ * 从配置文件中读取连接和会话复用的参数
+ */
+void get_connection_pool_options(ConnectionPool::Options &options)
+{
+  std::map<std::string, std::string> pool_section = get_properties()->get(SESSION_POOL);
+  std::map<std::string, std::string>::iterator it = pool_section.find("MAX_IDLE_COMMUNICATORS");
+  if (it != pool_section.end()) {
+    str_to_val(it->second, options.max_idle_communicators);
+  }
+  it = pool_section.find("MAX_IDLE_SESSIONS");
+  if (it != pool_section.end()) {
+    str_to_val(it->second, options.max_idle_sessions);
+  }
+  it = pool_section.find("MULTIPLEX");
+  if (it != pool_section.end()) {
+    int multiplex = 0;
+    str_to_val(it->second, multiplex);
+    options.multiplex = (multiplex != 0);
+  }
+}
+
 Server *init_server()
 {
   std::map<std::string, std::string> net_section = get_properties()->get(NET);
@@ -108,10 +149,20 @@ Server *init_server()
     }
   }
 
+  bool use_epoll = false;
+  it = net_section.find(EVENT_MODEL);
+  if (it != net_section.end()) {
+    use_epoll = (0 == strcasecmp(it->second.c_str(), "epoll"));
+  }
+
   ServerParam server_param;
+  server_param.use_epoll = use_epoll;
+  server_param.io_thread_num = get_thread_num(IO_THREADS);
+  server_param.sql_thread_num = get_thread_num(SQL_THREADS);
   server_param.listen_addr = listen_addr;
   server_param.max_connection_num = max_connection_num;
   server_param.port = port;
+  get_connection_pool_options(server_param.connection_pool);
   if (0 == strcasecmp(process_param->get_protocol().c_str(), "mysql")) {
     server_param.protocol = CommunicateProtocol::MYSQL;
   } else if (0 == strcasecmp(process_param->get_protocol().c_str(), "cli")) {
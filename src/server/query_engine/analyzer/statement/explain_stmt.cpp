@@ -2,7 +2,8 @@
 #include "include/query_engine/analyzer/statement/stmt.h"
 #include "common/log/log.h"
 
-ExplainStmt::ExplainStmt(std::unique_ptr<Stmt> child_stmt) : child_stmt_(std::move(child_stmt))
+ExplainStmt::ExplainStmt(std::unique_ptr<Stmt> child_stmt, bool analyze)
+    : child_stmt_(std::move(child_stmt)), analyze_(analyze)
 {}
 
 RC ExplainStmt::create(Db *db, const ExplainSqlNode &explain, Stmt *&stmt)
@@ -15,6 +16,6 @@ RC ExplainStmt::create(Db *db, const ExplainSqlNode &explain, Stmt *&stmt)
   }
 
   std::unique_ptr<Stmt> child_stmt_ptr = std::unique_ptr<Stmt>(child_stmt);
-  stmt = new ExplainStmt(std::move(child_stmt_ptr));
+  stmt = new ExplainStmt(std::move(child_stmt_ptr), explain.analyze);
   return rc;
 }
@@ -0,0 +1,10 @@
+#include "include/query_engine/analyzer/statement/kill_query_stmt.h"
+
+RC KillQueryStmt::create(const KillQuerySqlNode &kill_query, Stmt *&stmt)
+{
+  if (kill_query.session_id <= 0) {
+    return RC::INVALID_ARGUMENT;
+  }
+  stmt = new KillQueryStmt(static_cast<uint64_t>(kill_query.session_id));
+  return RC::SUCCESS;
+}
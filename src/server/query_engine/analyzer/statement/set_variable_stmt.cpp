@@ -0,0 +1,55 @@
+#include "include/query_engine/analyzer/statement/set_variable_stmt.h"
+#include "common/log/log.h"
+
+#include <strings.h>
+
+/**
+ * @brief 开关类变量的取值转换为布尔值，支持 on/off、true/false 以及数字
+ */
+static RC to_switch_value(const char *name, const Value &value, Value &result)
+{
+  if (value.attr_type() == INTS || value.attr_type() == BOOLEANS) {
+    result = Value(value.get_boolean());
+    return RC::SUCCESS;
+  }
+
+  if (value.attr_type() == CHARS) {
+    const std::string str = value.get_string();
+    if (0 == strcasecmp(str.c_str(), "on") || 0 == strcasecmp(str.c_str(), "true")) {
+      result = Value(true);
+      return RC::SUCCESS;
+    }
+    if (0 == strcasecmp(str.c_str(), "off") || 0 == strcasecmp(str.c_str(), "false")) {
+      result = Value(false);
+      return RC::SUCCESS;
+    }
+  }
+
+  LOG_WARN("invalid value of %s: %s", name, value.to_string().c_str());
+  return RC::VARIABLE_NOT_VALID;
+}
+
+RC SetVariableStmt::create(const SetVariableSqlNode &set_variable, Stmt *&stmt)
+{
+  const char *name = set_variable.name.c_str();
+  Value value = set_variable.value;
+  RC rc = RC::SUCCESS;
+  if (0 == strcasecmp(name, "statement_timeout")) {
+    if (value.attr_type() != INTS || value.get_int() < 0) {
+      LOG_WARN("invalid value of statement_timeout: %s", value.to_string().c_str());
+      return RC::VARIABLE_NOT_VALID;
+    }
+  } else if (0 == strcasecmp(name, "sql_debug") || 0 == strcasecmp(name, "lock_profiling")
+             || 0 == strcasecmp(name, "trace")) {
+    rc = to_switch_value(name, set_variable.value, value);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  } else {
+    LOG_WARN("no such variable: %s", name);
+    return RC::VARIABLE_NOT_EXISTS;
+  }
+
+  stmt = new SetVariableStmt(set_variable.name, value);
+  return RC::SUCCESS;
+}
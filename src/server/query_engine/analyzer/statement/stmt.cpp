@@ -11,8 +11,11 @@
 #include "include/query_engine/analyzer/statement/desc_table_stmt.h"
 #include "include/query_engine/analyzer/statement/help_stmt.h"
 #include "include/query_engine/analyzer/statement/show_tables_stmt.h"
+#include "include/query_engine/analyzer/statement/show_metrics_stmt.h"
 #include "include/query_engine/analyzer/statement/exit_stmt.h"
 #include "include/query_engine/analyzer/statement/load_data_stmt.h"
+#include "include/query_engine/analyzer/statement/set_variable_stmt.h"
+#include "include/query_engine/analyzer/statement/kill_query_stmt.h"
 
 RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
 {
@@ -54,6 +57,10 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return ShowTablesStmt::create(db, stmt);
     }
 
+    case SCF_SHOW_METRICS: {
+      return ShowMetricsStmt::create(stmt);
+    }
+
     case SCF_EXIT: {
       return ExitStmt::create(stmt);
     }
@@ -62,6 +69,14 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return LoadDataStmt::create(db, sql_node.load_data, stmt);
     }
 
+    case SCF_SET_VARIABLE: {
+      return SetVariableStmt::create(sql_node.set_variable, stmt);
+    }
+
+    case SCF_KILL_QUERY: {
+      return KillQueryStmt::create(sql_node.kill_query, stmt);
+    }
+
     default: {
       LOG_INFO("Command::type %d doesn't need to create statement.", sql_node.flag);
     } break;
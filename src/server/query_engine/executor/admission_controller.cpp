@@ -0,0 +1,189 @@
+#include "include/query_engine/executor/admission_controller.h"
+#include "include/query_engine/planner/operator/physical_operator.h"
+#include "common/log/log.h"
+
+#include <algorithm>
+#include <chrono>
+
+const char *query_class_name(QueryClass query_class)
+{
+  return query_class == QueryClass::OLTP ? "oltp" : "analytic";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MemoryReservation::MemoryReservation(AdmissionController *controller, size_t limit, size_t granted)
+    : controller_(controller), limit_(limit), granted_(granted)
+{}
+
+bool MemoryReservation::reserve(size_t bytes)
+{
+  if (controller_ != nullptr) {
+    const size_t required = used_ + bytes;
+    if (required > limit_) {
+      return false;
+    }
+
+    if (required > granted_) {
+      // 按块申请，全局预算不够一整块时只申请需要的部分
+      const size_t need = required - granted_;
+      size_t chunk = (need + AdmissionController::GRANT_CHUNK_SIZE - 1) / AdmissionController::GRANT_CHUNK_SIZE *
+                     AdmissionController::GRANT_CHUNK_SIZE;
+      chunk = std::min(chunk, limit_ - granted_);
+      if (!controller_->grow(chunk)) {
+        if (chunk == need || !controller_->grow(need)) {
+          return false;
+        }
+        chunk = need;
+      }
+      granted_ += chunk;
+    }
+  }
+
+  used_ += bytes;
+  peak_ = std::max(peak_, used_);
+  return true;
+}
+
+void MemoryReservation::release(size_t bytes)
+{
+  used_ -= std::min(bytes, used_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AdmissionTicket::~AdmissionTicket()
+{
+  if (controller_ != nullptr) {
+    controller_->leave(query_class_, reservation_->granted());
+  }
+  delete reservation_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AdmissionController::AdmissionController(const Options &options) : options_(options)
+{
+  oltp_.slots = options.oltp_slots;
+  analytic_.slots = options.analytic_slots;
+}
+
+QueryClass AdmissionController::classify(PhysicalOperator *oper)
+{
+  if (oper == nullptr) {
+    return QueryClass::OLTP;
+  }
+
+  switch (oper->type()) {
+    case PhysicalOperatorType::ORDER_BY:
+    case PhysicalOperatorType::GROUP_BY:
+    case PhysicalOperatorType::AGGREGATION:
+    case PhysicalOperatorType::JOIN: {
+      return QueryClass::ANALYTIC;
+    } break;
+    default: {
+    } break;
+  }
+
+  for (auto &child : oper->children()) {
+    if (classify(child.get()) == QueryClass::ANALYTIC) {
+      return QueryClass::ANALYTIC;
+    }
+  }
+  return QueryClass::OLTP;
+}
+
+bool AdmissionController::can_run(const Queue &queue, size_t initial_grant) const
+{
+  if (queue.slots > 0 && queue.running >= queue.slots) {
+    return false;
+  }
+  return initial_grant == 0 || memory_reserved_ + initial_grant <= options_.memory_budget;
+}
+
+RC AdmissionController::admit(QueryClass query_class, AdmissionTicket &ticket)
+{
+  // OLTP查询通常不缓存数据，准入时不需要预留内存，所以不会因为分析型查询占满了内存而排队
+  const size_t initial_grant = query_class == QueryClass::ANALYTIC
+                                   ? std::min(options_.initial_grant, options_.query_memory_limit)
+                                   : 0;
+
+  std::unique_lock<common::ProfiledMutex> guard(lock_);
+  Queue &q = queue(query_class);
+  if (!q.waiters.empty() || !can_run(q, initial_grant)) {
+    if (static_cast<int>(q.waiters.size()) >= options_.max_queue_length) {
+      rejected_++;
+      LOG_INFO("query rejected, too many queries are waiting. class=%s, queued=%d",
+               query_class_name(query_class), (int)q.waiters.size());
+      return RC::QUERY_QUEUE_FULL;
+    }
+
+    const uint64_t waiter_id = next_waiter_id_++;
+    q.waiters.push_back(waiter_id);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.queue_timeout_ms);
+    bool ready = cond_.wait_until(guard, deadline, [&]() {
+      return q.waiters.front() == waiter_id && can_run(q, initial_grant);
+    });
+    if (!ready) {
+      q.waiters.erase(std::find(q.waiters.begin(), q.waiters.end(), waiter_id));
+      rejected_++;
+      // 排在后面的查询可能正在等待当前查询离开队首
+      cond_.notify_all();
+      LOG_INFO("query rejected, waited too long. class=%s, timeout=%ldms",
+               query_class_name(query_class), (long)options_.queue_timeout_ms);
+      return RC::QUERY_QUEUE_TIMEOUT;
+    }
+    q.waiters.pop_front();
+    cond_.notify_all();
+  }
+
+  q.running++;
+  memory_reserved_ += initial_grant;
+
+  ticket.controller_ = this;
+  ticket.query_class_ = query_class;
+  ticket.reservation_ = new MemoryReservation(this, options_.query_memory_limit, initial_grant);
+  return RC::SUCCESS;
+}
+
+bool AdmissionController::grow(size_t bytes)
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  if (memory_reserved_ + bytes > options_.memory_budget) {
+    return false;
+  }
+  memory_reserved_ += bytes;
+  return true;
+}
+
+void AdmissionController::leave(QueryClass query_class, size_t granted)
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  queue(query_class).running--;
+  memory_reserved_ -= granted;
+  cond_.notify_all();
+}
+
+size_t AdmissionController::memory_reserved() const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return memory_reserved_;
+}
+
+int AdmissionController::running(QueryClass query_class) const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return queue(query_class).running;
+}
+
+int AdmissionController::queued(QueryClass query_class) const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return static_cast<int>(queue(query_class).waiters.size());
+}
+
+uint64_t AdmissionController::rejected() const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return rejected_;
+}
@@ -8,7 +8,10 @@
 #include "include/query_engine/executor/drop_table_executor.h"
 #include "include/query_engine/executor/help_executor.h"
 #include "include/query_engine/executor/show_tables_executor.h"
+#include "include/query_engine/executor/show_metrics_executor.h"
 #include "include/query_engine/executor/load_data_executor.h"
+#include "include/query_engine/executor/set_variable_executor.h"
+#include "include/query_engine/executor/kill_query_executor.h"
 
 RC CommandExecutor::execute(QueryInfo *query_info)
 {
@@ -45,11 +48,26 @@ RC CommandExecutor::execute(QueryInfo *query_info)
       return executor.execute(query_info);
     }
 
+    case StmtType::SHOW_METRICS: {
+      ShowMetricsExecutor executor;
+      return executor.execute(query_info);
+    }
+
     case StmtType::LOAD_DATA: {
       LoadDataExecutor executor;
       return executor.execute(query_info);
     }
 
+    case StmtType::SET_VARIABLE: {
+      SetVariableExecutor executor;
+      return executor.execute(query_info);
+    }
+
+    case StmtType::KILL_QUERY: {
+      KillQueryExecutor executor;
+      return executor.execute(query_info);
+    }
+
     case StmtType::EXIT: {
       return RC::SUCCESS;
     }
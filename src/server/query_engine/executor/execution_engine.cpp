@@ -17,10 +17,14 @@ const char NEW_LINE = '\n';
 
 RC write_to_communicator(const char* data, int32_t size, Communicator* communicator, const size_t &min_width){
   if(size < min_width){
-    int diff = min_width - size;
-    char* padding = new char[diff];
-    memset(padding, ' ', diff);
-    RC rc = communicator->write_result(padding, diff);
+    static const std::string SPACES(256, ' ');
+    size_t diff = min_width - size;
+    RC rc = RC::SUCCESS;
+    while (diff > 0 && RC_SUCC(rc)) {
+      const size_t len = std::min(diff, SPACES.size());
+      rc = communicator->write_result(SPACES.data(), len);
+      diff -= len;
+    }
     if(RC_FAIL(rc)){
       LOG_WARN("failed to send data to client. err=%s", strerror(errno));
       return rc;
@@ -51,13 +55,13 @@ void set_operator_schema(QueryInfo *query_info, size_t& min_width)
       for (const auto *expr : select_stmt->projects()) {
         std::string alias_str = expr->alias().empty() ? expr->name() : expr->alias();
         const char* alias = alias_str.c_str();
-        schema.append_cell(alias);
+        schema.append_cell(alias, expr->value_type());
         min_width = min_width < strlen(alias) ? strlen(alias) : min_width;
       }
     } break;
 
     case StmtType::EXPLAIN: {
-      schema.append_cell("Query Plan");
+      schema.append_cell("Query Plan", CHARS);
     } break;
     default: {
     } break;
@@ -132,6 +136,9 @@ RC send_result(SessionRequest *request, bool &need_disconnect, const size_t &min
 
   SqlResult *sql_result = request->sql_result();
   Communicator* communicator = request->get_communicator();
+  if (communicator->encode_result_set()) {
+    return communicator->write_result_set(request, need_disconnect);
+  }
 
   if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
     return communicator->write_state(sql_result, need_disconnect);
@@ -201,8 +208,14 @@ RC send_result(SessionRequest *request, bool &need_disconnect, const size_t &min
     rc = RC::SUCCESS;
   } else if (RC_FAIL(rc)) {
     LOG_TRACE("failed to get next tuple. rc=%s", strrc(rc));
+    // 比如语句超时或者被取消，先关闭算子释放占用的页面和临时文件。
+    // 已经发送了部分结果，错误信息作为结果的最后一行，与结果在同一个消息中，客户端不会把回复错位
+    sql_result->close();
     sql_result->set_return_code(rc);
-    return communicator->write_state(sql_result, need_disconnect);
+    std::string state = std::string("Failure : ") + strrc(rc) + "\n";
+    RC write_rc = communicator->write_result(state.data(), state.size());
+    need_disconnect = RC_FAIL(write_rc);
+    return rc;
   }
 
   if (cell_num == 0) {
@@ -230,7 +243,7 @@ RC send_result(SessionRequest *request, bool &need_disconnect, const size_t &min
 RC Executor::execute(SessionRequest *request, QueryInfo *query_info, bool &need_disconnect)
 {
   RC rc;
-  min_width = 0;
+  size_t min_width = 0;
   if(query_info->physical_operator() != nullptr){
     set_operator_schema(query_info, min_width);
   }else{
@@ -241,6 +254,13 @@ RC Executor::execute(SessionRequest *request, QueryInfo *query_info, bool &need_
         rc = command_executor.execute(query_info);
         query_info->session_event()->sql_result()->set_return_code(rc);
     } else {
+        // 文本协议没有回复也可以结束本次请求，mysql协议的客户端必须收到OK或者ERR
+        Communicator *communicator = request->get_communicator();
+        if (communicator->encode_result_set()) {
+          request->sql_result()->set_return_code(RC::UNIMPLENMENT);
+          communicator->write_state(request->sql_result(), need_disconnect);
+          communicator->flush();
+        }
         return RC::INTERNAL;
     }
   }
@@ -0,0 +1,20 @@
+#include "include/query_engine/executor/kill_query_executor.h"
+
+#include "include/query_engine/structor/query_info.h"
+#include "include/session/session.h"
+#include "include/query_engine/analyzer/statement/kill_query_stmt.h"
+
+RC KillQueryExecutor::execute(QueryInfo *query_info)
+{
+  Stmt *stmt = query_info->stmt();
+  SqlResult *sql_result = query_info->session_event()->sql_result();
+  ASSERT(stmt->type() == StmtType::KILL_QUERY,
+         "kill query executor can not run this command: %d", static_cast<int>(stmt->type()));
+
+  KillQueryStmt *kill_query_stmt = static_cast<KillQueryStmt *>(stmt);
+  RC rc = Session::kill_query(kill_query_stmt->session_id());
+  if (rc == RC::NOTFOUND) {
+    sql_result->set_state_string("no such session");
+  }
+  return rc;
+}
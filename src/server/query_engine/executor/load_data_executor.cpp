@@ -1,9 +1,26 @@
 #include "include/query_engine/executor/load_data_executor.h"
+#include "include/query_engine/executor/separator_scanner.h"
 #include "include/query_engine/structor/query_info.h"
 #include "include/session/session_request.h"
 #include "include/query_engine/executor/sql_result.h"
 #include "common/lang/string.h"
 #include "include/query_engine/analyzer/statement/load_data_stmt.h"
+#include "include/storage_engine/recorder/table.h"
+#include "common/os/os.h"
+#include "common/log/log.h"
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace common;
 
@@ -18,20 +35,50 @@ RC LoadDataExecutor::execute(QueryInfo *query_info)
   return rc;
 }
 
+static std::string_view strip_view(std::string_view value)
+{
+  while (!value.empty() && isspace(static_cast<unsigned char>(value.front()))) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && isspace(static_cast<unsigned char>(value.back()))) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
 /**
- * 从文件中导入数据时使用。尝试向表中插入解析后的一行数据。
+ * @brief 把整个字段解析成数字
+ * @details std::from_chars 不接受开头的'+'，这里去掉一个，与原来使用 stringstream 解析时的行为保持一致
+ */
+template <typename T>
+static bool parse_number(std::string_view text, T &value)
+{
+  if (!text.empty() && text.front() == '+') {
+    text.remove_prefix(1);
+    if (!text.empty() && text.front() == '-') {
+      return false;
+    }
+  }
+  const char *end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  return ec == std::errc() && ptr == end;
+}
+
+/**
+ * 从文件中导入数据时使用。把一行数据的字段值转换成表的一条记录。
  * @param table  要导入的表
- * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值
- * @param record_values Table::insert_record使用的参数，为了防止频繁的申请内存
+ * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值，指向文件映射的内存
+ * @param record_values Table::make_record使用的参数，为了防止频繁的申请内存
+ * @param record 转换成功时返回的记录
  * @param errmsg 如果出现错误，通过这个参数返回错误信息
  * @return 成功返回RC::SUCCESS
  */
-RC insert_record_from_file(Table *table, 
-    std::vector<std::string> &file_values,
+static RC make_record_from_file(Table *table,
+    const std::vector<std::string_view> &file_values,
     std::vector<Value> &record_values,
+    Record &record,
     std::stringstream &errmsg)
 {
-
   const int field_num = record_values.size();
   const int sys_field_num = table->table_meta().sys_field_num();
 
@@ -40,52 +87,44 @@ RC insert_record_from_file(Table *table,
   }
 
   RC rc = RC::SUCCESS;
-
-  std::stringstream deserialize_stream;
   for (int i = 0; i < field_num && RC::SUCCESS == rc; i++) {
     const FieldMeta *field = table->table_meta().field(i + sys_field_num);
-
-    std::string &file_value = file_values[i];
-    if (field->type() != CHARS || field->type() != TEXTS) {
-      common::strip(file_value);
-    }
+    std::string_view file_value = strip_view(file_values[i]);
 
     switch (field->type()) {
       case INTS:
       case DATES: {
-        deserialize_stream.clear();  // 清理stream的状态，防止多次解析出现异常
-        deserialize_stream.str(file_value);
-
         int int_value;
-        deserialize_stream >> int_value;
-        if (!deserialize_stream || !deserialize_stream.eof()) {
+        if (!parse_number(file_value, int_value)) {
           errmsg << "need an integer but got '" << file_values[i] << "' (field index:" << i << ")";
-
           rc = RC::SCHEMA_FIELD_TYPE_MISMATCH;
         } else {
           record_values[i].set_int(int_value);
         }
-      }
-
-      break;
+      } break;
       case FLOATS: {
-        deserialize_stream.clear();
-        deserialize_stream.str(file_value);
-
         float float_value;
-        deserialize_stream >> float_value;
-        if (!deserialize_stream || !deserialize_stream.eof()) {
+        if (!parse_number(file_value, float_value)) {
           errmsg << "need a float number but got '" << file_values[i] << "'(field index:" << i << ")";
           rc = RC::SCHEMA_FIELD_TYPE_MISMATCH;
         } else {
           record_values[i].set_float(float_value);
         }
       } break;
+      // 文件映射的内存不是以'\0'结尾的，空字符串要单独处理
       case CHARS: {
-        record_values[i].set_string(file_value.c_str());
+        if (file_value.empty()) {
+          record_values[i].set_string("");
+        } else {
+          record_values[i].set_string(file_value.data(), file_value.size());
+        }
       } break;
       case TEXTS: {
-        record_values[i].set_text(file_value.c_str(), file_value.size());
+        if (file_value.empty()) {
+          record_values[i].set_text("");
+        } else {
+          record_values[i].set_text(file_value.data(), file_value.size());
+        }
       } break;
       default: {
         errmsg << "Unsupported field type to loading: " << field->type();
@@ -95,62 +134,247 @@ RC insert_record_from_file(Table *table,
   }
 
   if (RC::SUCCESS == rc) {
-    Record record;
     rc = table->make_record(field_num, record_values.data(), record);
     if (rc != RC::SUCCESS) {
       errmsg << "insert failed.";
-    } else if (RC::SUCCESS != (rc = table->insert_record(record))) {
-      errmsg << "insert failed.";
     }
   }
   return rc;
 }
 
+/**
+ * @brief 一块数据解析之后的结果
+ */
+struct LoadBatch
+{
+  int line_count = 0;            ///< 块中的行数
+  std::vector<Record> records;   ///< 解析出来的记录
+  RC rc = RC::SUCCESS;           ///< 解析失败时，records中是出错行之前的记录
+  int error_line = 0;            ///< 出错的行在块中的行号，从1开始
+  std::string errmsg;
+};
+
+/**
+ * @brief 并行导入数据的流水线
+ * @details 文件通过mmap映射到内存，解析线程每次领取一块在行边界切分的数据，
+ * 拆分字段、类型转换并生成记录，字段值直接引用映射的内存，不做复制。
+ * 调用load_data的线程按照块的顺序批量插入记录，每一批记录连续写入数据页面，
+ * 索引在整批写入之后再按照键值顺序维护。
+ * 已经解析但还没有插入的块数有上限，防止插入跟不上时占用过多内存。
+ */
+class LoadDataPipeline
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 4 * 1024 * 1024;
+
+  LoadDataPipeline(Table *table, const char *data, size_t size)
+      : table_(table), cursor_(data), end_(data + size)
+  {
+    parser_num_ = std::clamp<int>(static_cast<int>(common::getCpuNum()) - 1, 1, 8);
+    max_inflight_ = parser_num_ * 2;
+  }
+
+  /**
+   * @brief 执行导入，在第一个错误的地方停止
+   * @param line_num[out]  处理的行数
+   * @param insertion_count[out] 插入的记录数
+   * @param errmsg[out] 出错时的错误信息
+   */
+  RC run(int &line_num, int &insertion_count, std::stringstream &errmsg)
+  {
+    std::vector<std::thread> parsers;
+    for (int i = 0; i < parser_num_; i++) {
+      parsers.emplace_back([this]() { parse_blocks(); });
+    }
+
+    RC rc = insert_batches(line_num, insertion_count, errmsg);
+
+    stop();
+    for (std::thread &parser : parsers) {
+      parser.join();
+    }
+    return rc;
+  }
+
+private:
+  void parse_blocks()
+  {
+    const int sys_field_num = table_->table_meta().sys_field_num();
+    const int null_field_num = table_->table_meta().null_filed_num();
+    const int field_num = table_->table_meta().field_num() - sys_field_num - null_field_num;
+    std::vector<Value> record_values(field_num);
+
+    while (true) {
+      int64_t seq = 0;
+      const char *begin = nullptr;
+      const char *end = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return stopped_ || cursor_ == end_ || next_seq_ - inserted_seq_ < max_inflight_; });
+        if (stopped_ || cursor_ == end_) {
+          return;
+        }
+
+        // 领取一块数据，在块大小之后的第一个换行符处切分
+        begin = cursor_;
+        end = end_;
+        if (static_cast<size_t>(end_ - begin) > BLOCK_SIZE) {
+          const char *newline = static_cast<const char *>(memchr(begin + BLOCK_SIZE, '\n', end_ - begin - BLOCK_SIZE));
+          if (newline != nullptr) {
+            end = newline + 1;
+          }
+        }
+        cursor_ = end;
+        seq = next_seq_++;
+      }
+
+      LoadBatch batch;
+      parse_block(begin, end, record_values, batch);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      batches_.emplace(seq, std::move(batch));
+      cond_.notify_all();
+    }
+  }
+
+  void parse_block(const char *begin, const char *end, std::vector<Value> &record_values, LoadBatch &batch)
+  {
+    SeparatorScanner scanner(begin, end, '|');
+    std::vector<std::string_view> file_values;
+    std::stringstream errmsg;
+    const char *field_begin = begin;
+    while (field_begin < end) {
+      const char *sep = scanner.next();
+      file_values.emplace_back(field_begin, sep - field_begin);
+      field_begin = sep + 1;
+      if (sep != end && *sep != '\n') {
+        continue;
+      }
+
+      // 一行结束
+      batch.line_count++;
+      if (file_values.size() == 1 && strip_view(file_values[0]).empty()) {
+        file_values.clear();
+        continue;
+      }
+
+      Record record;
+      RC rc = make_record_from_file(table_, file_values, record_values, record, errmsg);
+      file_values.clear();
+      if (rc != RC::SUCCESS) {
+        batch.rc = rc;
+        batch.error_line = batch.line_count;
+        batch.errmsg = errmsg.str();
+        return;
+      }
+      batch.records.emplace_back(std::move(record));
+    }
+  }
+
+  RC insert_batches(int &line_num, int &insertion_count, std::stringstream &errmsg)
+  {
+    for (int64_t seq = 0;; seq++) {
+      LoadBatch batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this, seq]() { return batches_.count(seq) > 0 || (cursor_ == end_ && seq >= next_seq_); });
+        auto iter = batches_.find(seq);
+        if (iter == batches_.end()) {
+          return RC::SUCCESS;
+        }
+        batch = std::move(iter->second);
+        batches_.erase(iter);
+      }
+
+      RC rc = RC::SUCCESS;
+      if (!batch.records.empty()) {
+        rc = table_->insert_records(batch.records);
+        if (rc != RC::SUCCESS) {
+          errmsg << "Line:" << line_num + 1 << "-" << line_num + batch.line_count
+                 << " insert records failed. error:" << strrc(rc) << std::endl;
+          return rc;
+        }
+        insertion_count += batch.records.size();
+      }
+
+      if (batch.rc != RC::SUCCESS) {
+        errmsg << "Line:" << line_num + batch.error_line << " insert record failed:" << batch.errmsg
+               << ". error:" << strrc(batch.rc) << std::endl;
+        line_num += batch.error_line;
+        return batch.rc;
+      }
+      line_num += batch.line_count;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      inserted_seq_ = seq + 1;
+      cond_.notify_all();
+    }
+  }
+
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    cond_.notify_all();
+  }
+
+private:
+  Table *table_ = nullptr;
+  int    parser_num_ = 1;
+  int    max_inflight_ = 2;
+
+  std::mutex              mutex_;
+  std::condition_variable cond_;
+  const char             *cursor_;            ///< 还没有被领取的数据的起始位置
+  const char *const       end_;
+  int64_t                 next_seq_ = 0;      ///< 下一个被领取的块的序号
+  int64_t                 inserted_seq_ = 0;  ///< 这个序号之前的块都已经插入
+  std::map<int64_t, LoadBatch> batches_;      ///< 解析完成等待插入的块，按照序号排序
+  bool                    stopped_ = false;
+};
+
 void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult *sql_result)
 {
   std::stringstream result_string;
 
-  std::fstream fs;
-  fs.open(file_name, std::ios_base::in | std::ios_base::binary);
-  if (!fs.is_open()) {
+  int fd = ::open(file_name, O_RDONLY);
+  struct stat file_stat;
+  if (fd < 0 || fstat(fd, &file_stat) != 0) {
     result_string << "Failed to init file: " << file_name << ". system error=" << strerror(errno) << std::endl;
     sql_result->set_return_code(RC::FILE_NOT_EXIST);
     sql_result->set_state_string(result_string.str());
+    if (fd >= 0) {
+      ::close(fd);
+    }
     return;
   }
 
+  const size_t file_size = file_stat.st_size;
+  const char *data = nullptr;
+  if (file_size > 0) {
+    void *addr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      result_string << "Failed to map file: " << file_name << ". system error=" << strerror(errno) << std::endl;
+      sql_result->set_return_code(RC::IOERR_READ);
+      sql_result->set_state_string(result_string.str());
+      ::close(fd);
+      return;
+    }
+    madvise(addr, file_size, MADV_SEQUENTIAL);
+    data = static_cast<const char *>(addr);
+  }
+  ::close(fd);
+
   struct timespec begin_time;
   clock_gettime(CLOCK_MONOTONIC, &begin_time);
-  const int sys_field_num = table->table_meta().sys_field_num();
-  const int null_field_num = table->table_meta().null_filed_num();
-  const int field_num = table->table_meta().field_num() - sys_field_num - null_field_num;
 
-  std::vector<Value> record_values(field_num);
-  std::string line;
-  std::vector<std::string> file_values;
-  const std::string delim("|");
   int line_num = 0;
   int insertion_count = 0;
-  RC rc = RC::SUCCESS;
-  while (!fs.eof() && RC::SUCCESS == rc) {
-    std::getline(fs, line);
-    line_num++;
-    if (common::is_blank(line.c_str())) {
-      continue;
-    }
-
-    file_values.clear();
-    common::split_string(line, delim, file_values);
-    std::stringstream errmsg;
-    rc = insert_record_from_file(table, file_values, record_values, errmsg);
-    if (rc != RC::SUCCESS) {
-      result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
-                    << std::endl;
-    } else {
-      insertion_count++;
-    }
+  LoadDataPipeline pipeline(table, data, file_size);
+  RC rc = pipeline.run(line_num, insertion_count, result_string);
+  if (data != nullptr) {
+    munmap(const_cast<char *>(data), file_size);
   }
-  fs.close();
 
   struct timespec end_time;
   clock_gettime(CLOCK_MONOTONIC, &end_time);
@@ -158,6 +382,9 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
   if (RC::SUCCESS == rc) {
     result_string << strrc(rc) << ". total " << line_num << " line(s) handled and " << insertion_count
                   << " record(s) loaded, total cost " << cost_nano / 1000000000.0 << " second(s)" << std::endl;
+  } else {
+    LOG_WARN("Failed to load data. file=%s, table=%s, loaded=%d, rc=%s",
+             file_name, table->name(), insertion_count, strrc(rc));
   }
   sql_result->set_return_code(RC::SUCCESS);
   sql_result->set_state_string(result_string.str());
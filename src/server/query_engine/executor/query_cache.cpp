@@ -0,0 +1,172 @@
+#include "include/query_engine/executor/query_cache.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/schema/database.h"
+#include "common/metrics/metrics.h"
+#include "common/metrics/metrics_registry.h"
+#include "common/log/log.h"
+
+#include <cctype>
+#include <strings.h>
+
+QueryCache::QueryCache(size_t capacity) : capacity_(capacity)
+{
+  metrics_.emplace_back("query_cache.hits", new common::CallbackGauge([this]() { return (long)hits(); }));
+  metrics_.emplace_back("query_cache.misses", new common::CallbackGauge([this]() { return (long)misses(); }));
+  metrics_.emplace_back("query_cache.invalidations", new common::CallbackGauge([this]() { return (long)invalidations(); }));
+  metrics_.emplace_back("query_cache.evictions", new common::CallbackGauge([this]() { return (long)evictions(); }));
+  metrics_.emplace_back("query_cache.bytes", new common::CallbackGauge([this]() { return (long)size(); }));
+
+  common::MetricsRegistry &registry = common::get_metrics_registry();
+  for (auto &[tag, metric] : metrics_) {
+    registry.register_metric(tag, metric);
+  }
+}
+
+QueryCache::~QueryCache()
+{
+  common::MetricsRegistry &registry = common::get_metrics_registry();
+  for (auto &[tag, metric] : metrics_) {
+    registry.unregister(tag);
+    delete metric;
+  }
+  metrics_.clear();
+}
+
+std::string QueryCache::make_key(const char *db_name, const std::string &sql, const std::string &params)
+{
+  std::string normalized;
+  normalized.reserve(sql.size());
+
+  char quote = 0;
+  bool pending_space = false;
+  for (char c : sql) {
+    if (quote != 0) {
+      normalized.push_back(c);
+      if (c == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+
+    if (isspace(static_cast<unsigned char>(c))) {
+      pending_space = !normalized.empty();
+      continue;
+    }
+
+    if (pending_space) {
+      normalized.push_back(' ');
+      pending_space = false;
+    }
+    if (c == '\'' || c == '"') {
+      quote = c;
+    }
+    normalized.push_back(c);
+  }
+
+  while (!normalized.empty() && (normalized.back() == ';' || normalized.back() == ' ')) {
+    normalized.pop_back();
+  }
+
+  if (normalized.size() < 7 || strncasecmp(normalized.c_str(), "select ", 7) != 0) {
+    return std::string();
+  }
+
+  std::string key(db_name);
+  key.push_back('\n');
+  key.append(normalized);
+  if (!params.empty()) {
+    key.push_back('\n');
+    key.append(params);
+  }
+  return key;
+}
+
+void QueryCache::collect_table_versions(const std::vector<Table *> &tables, Db *db,
+    std::vector<std::pair<std::string, uint64_t>> &table_versions)
+{
+  for (Table *table : tables) {
+    table_versions.emplace_back(table->name(), table->version());
+    if (table->is_view()) {
+      Table *origin_table = db->find_table(table->origin_table_name());
+      if (origin_table != nullptr) {
+        table_versions.emplace_back(origin_table->name(), origin_table->version());
+      }
+    }
+  }
+}
+
+bool QueryCache::valid(const Entry &entry, Db *db) const
+{
+  for (const auto &[table_name, version] : entry.table_versions) {
+    Table *table = db->find_table(table_name.c_str());
+    if (table == nullptr || table->version() != version) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void QueryCache::erase(EntryList::iterator iter)
+{
+  size_ -= iter->result.size();
+  index_.erase(iter->key);
+  entries_.erase(iter);
+}
+
+bool QueryCache::get(const std::string &key, Db *db, std::string &result)
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    misses_++;
+    return false;
+  }
+
+  if (db == nullptr || !valid(*iter->second, db)) {
+    LOG_TRACE("query cache entry is stale. key=%s", key.c_str());
+    erase(iter->second);
+    invalidations_++;
+    misses_++;
+    return false;
+  }
+
+  entries_.splice(entries_.begin(), entries_, iter->second);
+  result = iter->second->result;
+  hits_++;
+  return true;
+}
+
+void QueryCache::put(const std::string &key, std::vector<std::pair<std::string, uint64_t>> table_versions, std::string result)
+{
+  // 单个结果超过容量的1/4就不缓存了，避免一个大结果把其它缓存都挤出去
+  if (result.size() > capacity_ / 4) {
+    return;
+  }
+
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    erase(iter->second);
+  }
+
+  while (!entries_.empty() && size_ + result.size() > capacity_) {
+    erase(std::prev(entries_.end()));
+    evictions_++;
+  }
+
+  size_ += result.size();
+  entries_.push_front(Entry{key, std::move(result), std::move(table_versions)});
+  index_.emplace(key, entries_.begin());
+}
+
+size_t QueryCache::size() const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return size_;
+}
+
+size_t QueryCache::entry_count() const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return entries_.size();
+}
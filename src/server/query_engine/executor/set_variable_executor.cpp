@@ -0,0 +1,34 @@
+#include "include/query_engine/executor/set_variable_executor.h"
+
+#include "include/query_engine/structor/query_info.h"
+#include "include/session/session.h"
+#include "include/query_engine/analyzer/statement/set_variable_stmt.h"
+
+#include "common/lang/mutex.h"
+
+#include <strings.h>
+
+RC SetVariableExecutor::execute(QueryInfo *query_info)
+{
+  Stmt *stmt = query_info->stmt();
+  Session *session = query_info->session_event()->session();
+  ASSERT(stmt->type() == StmtType::SET_VARIABLE,
+         "set variable executor can not run this command: %d", static_cast<int>(stmt->type()));
+
+  SetVariableStmt *set_variable_stmt = static_cast<SetVariableStmt *>(stmt);
+  const char *name = set_variable_stmt->var_name().c_str();
+  const Value &value = set_variable_stmt->var_value();
+  if (0 == strcasecmp(name, "statement_timeout")) {
+    session->set_statement_timeout(value.get_int());
+  } else if (0 == strcasecmp(name, "sql_debug")) {
+    session->set_sql_debug(value.get_boolean());
+  } else if (0 == strcasecmp(name, "lock_profiling")) {
+    // 全局生效，不只是当前会话
+    common::LockProfiler::set_enabled(value.get_boolean());
+  } else if (0 == strcasecmp(name, "trace")) {
+    session->set_trace(value.get_boolean());
+  } else {
+    return RC::VARIABLE_NOT_EXISTS;
+  }
+  return RC::SUCCESS;
+}
@@ -0,0 +1,154 @@
+#include "include/query_engine/executor/slow_query_log.h"
+#include "common/log/async_log.h"
+#include "common/log/log.h"
+#include "common/metrics/metrics.h"
+#include "common/metrics/metrics_registry.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+static const size_t SLOW_LOG_BUFFER_SIZE = 1024 * 1024;  ///< 每个线程的缓存大小
+static const int    SLOW_LOG_FLUSH_INTERVAL_MS = 200;
+
+static void append_ms(std::string &out, const char *name, int64_t ns)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%s%s: %.3fms", out.back() == '#' ? " " : "  ", name, ns / 1000000.0);
+  out.append(buf);
+}
+
+std::string SlowQueryLog::Entry::to_string() const
+{
+  std::string out;
+  char buf[128];
+
+  const time_t seconds = start_time_us / 1000000;
+  struct tm tm;
+  localtime_r(&seconds, &tm);
+  strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+  out.append("# Time: ").append(buf);
+  snprintf(buf, sizeof(buf), ".%06ld\n", static_cast<long>(start_time_us % 1000000));
+  out.append(buf);
+
+  snprintf(buf, sizeof(buf), "# Session: %lu  Db: ", static_cast<unsigned long>(session_id));
+  out.append(buf).append(db_name).append("  Result: ").append(strrc(rc)).append("\n");
+
+  out.append("#");
+  append_ms(out, "Query_time", profile.total_ns);
+  append_ms(out, "Parse", profile.parse_ns);
+  append_ms(out, "Analyze", profile.analyze_ns);
+  append_ms(out, "Plan", profile.plan_ns);
+  append_ms(out, "Optimize", profile.optimize_ns);
+  append_ms(out, "Execute", profile.execute_ns);
+  out.append("\n");
+
+  snprintf(buf, sizeof(buf), "# Rows_examined: %lu  Rows_returned: %lu  Pages_hit: %lu  Pages_missed: %lu  Pages_read: %lu\n",
+      static_cast<unsigned long>(profile.rows_examined), static_cast<unsigned long>(profile.rows_returned),
+      static_cast<unsigned long>(profile.page_hits), static_cast<unsigned long>(profile.page_misses),
+      static_cast<unsigned long>(profile.page_reads));
+  out.append(buf);
+
+  if (!plan.empty()) {
+    out.append("# Plan:\n");
+    size_t begin = 0;
+    while (begin < plan.size()) {
+      size_t end = plan.find('\n', begin);
+      if (end == std::string::npos) {
+        end = plan.size();
+      }
+      out.append("#   ").append(plan, begin, end - begin).append("\n");
+      begin = end + 1;
+    }
+  }
+
+  out.append(sql);
+  if (sql.empty() || sql.back() != ';') {
+    out.append(";");
+  }
+  out.append("\n");
+  return out;
+}
+
+SlowQueryLog::SlowQueryLog(const Options &options) : options_(options)
+{
+  metrics_.emplace_back("slow_query.logged", new common::CallbackGauge([this]() { return (long)logged_count(); }));
+
+  common::MetricsRegistry &registry = common::get_metrics_registry();
+  for (auto &[tag, metric] : metrics_) {
+    registry.register_metric(tag, metric);
+  }
+}
+
+SlowQueryLog::~SlowQueryLog()
+{
+  stop();
+
+  common::MetricsRegistry &registry = common::get_metrics_registry();
+  for (auto &[tag, metric] : metrics_) {
+    registry.unregister(tag);
+    delete metric;
+  }
+}
+
+RC SlowQueryLog::start()
+{
+  if (options_.file_name.empty()) {
+    return RC::SUCCESS;
+  }
+
+  file_ = fopen(options_.file_name.c_str(), "a");
+  if (file_ == nullptr) {
+    LOG_ERROR("failed to open slow query log file. file=%s, error=%s", options_.file_name.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  writer_ = std::make_unique<common::AsyncLogWriter>(SLOW_LOG_BUFFER_SIZE,
+      common::LOG_OVERFLOW_DROP,
+      SLOW_LOG_FLUSH_INTERVAL_MS,
+      [this](const std::string &batch) { write_batch(batch); });
+  writer_->start();
+  return RC::SUCCESS;
+}
+
+void SlowQueryLog::stop()
+{
+  if (writer_) {
+    writer_->stop();
+    writer_.reset();
+  }
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+void SlowQueryLog::write_batch(const std::string &batch)
+{
+  fwrite(batch.data(), 1, batch.size(), file_);
+  fflush(file_);
+}
+
+void SlowQueryLog::record(Entry entry)
+{
+  logged_count_.fetch_add(1, std::memory_order_relaxed);
+  if (writer_) {
+    const std::string text = entry.to_string();
+    writer_->append(text.data(), text.size());
+  }
+
+  if (options_.max_entries == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  entries_.emplace_back(std::move(entry));
+  while (entries_.size() > options_.max_entries) {
+    entries_.pop_front();
+  }
+}
+
+std::vector<SlowQueryLog::Entry> SlowQueryLog::recent_entries() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return std::vector<Entry>(entries_.begin(), entries_.end());
+}
@@ -38,7 +38,11 @@ RC SqlResult::close()
     LOG_WARN("failed to close operator. rc=%s", strrc(rc));
   }
 
-  operator_.reset();
+  if (retain_operator_) {
+    retained_operator_ = std::move(operator_);
+  } else {
+    operator_.reset();
+  }
 
   if (session_ && !session_->is_trx_multi_operation_mode()) {
     if (rc == RC::SUCCESS) {
@@ -61,6 +65,7 @@ RC SqlResult::next_tuple(Tuple *&tuple)
   }
 
   tuple = operator_->current_tuple();
+  rows_returned_++;
   return rc;
 }
 
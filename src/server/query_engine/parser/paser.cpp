@@ -21,6 +21,18 @@ void ParsedSqlResult::add_sql_node(std::unique_ptr<ParsedSqlNode> sql_node)
 
 int sql_parse(const char *st, ParsedSqlResult *sql_result);
 
+SqlCommandFlag Parser::preparse(SessionRequest *request)
+{
+  auto parsed_sql_result = std::make_unique<ParsedSqlResult>();
+  sql_parse(request->query().c_str(), parsed_sql_result.get());
+  SqlCommandFlag flag = SCF_ERROR;
+  if (!parsed_sql_result->sql_nodes().empty()) {
+    flag = parsed_sql_result->sql_nodes().front()->flag;
+  }
+  request->set_parsed_sql(std::move(parsed_sql_result));
+  return flag;
+}
+
 RC Parser::parse(QueryInfo *query_info)
 {
   RC rc = RC::SUCCESS;
@@ -28,9 +40,13 @@ RC Parser::parse(QueryInfo *query_info)
   SqlResult *sql_result = query_info->session_event()->sql_result();
   const std::string &sql = query_info->sql();
 
+  std::unique_ptr<ParsedSqlResult> preparsed_sql_result = query_info->session_event()->take_parsed_sql();
   ParsedSqlResult parsed_sql_result;
-
-  sql_parse(sql.c_str(), &parsed_sql_result);
+  if (preparsed_sql_result != nullptr) {
+    parsed_sql_result = std::move(*preparsed_sql_result);
+  } else {
+    sql_parse(sql.c_str(), &parsed_sql_result);
+  }
   if (parsed_sql_result.sql_nodes().empty()) {
     sql_result->set_return_code(RC::SUCCESS);
     sql_result->set_state_string("");
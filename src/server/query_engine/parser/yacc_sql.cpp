@@ -270,18 +270,20 @@ enum yysymbol_kind_t
   YYSYMBOL_expression_list = 122,          /* expression_list  */
   YYSYMBOL_rel_attr = 123,                 /* rel_attr  */
   YYSYMBOL_rel_attr_list = 124,            /* rel_attr_list  */
-  YYSYMBOL_relation_list = 125,            /* relation_list  */
-  YYSYMBOL_rel_list = 126,                 /* rel_list  */
-  YYSYMBOL_join_list = 127,                /* join_list  */
-  YYSYMBOL_join_conditions = 128,          /* join_conditions  */
-  YYSYMBOL_where_conditions = 129,         /* where_conditions  */
-  YYSYMBOL_condition_list = 130,           /* condition_list  */
-  YYSYMBOL_condition = 131,                /* condition  */
-  YYSYMBOL_comp_op = 132,                  /* comp_op  */
-  YYSYMBOL_load_data_stmt = 133,           /* load_data_stmt  */
-  YYSYMBOL_explain_stmt = 134,             /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 135,        /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 136             /* opt_semicolon  */
+  YYSYMBOL_relation_name = 125,            /* relation_name  */
+  YYSYMBOL_relation_list = 126,            /* relation_list  */
+  YYSYMBOL_rel_list = 127,                 /* rel_list  */
+  YYSYMBOL_join_list = 128,                /* join_list  */
+  YYSYMBOL_join_conditions = 129,          /* join_conditions  */
+  YYSYMBOL_where_conditions = 130,         /* where_conditions  */
+  YYSYMBOL_condition_list = 131,           /* condition_list  */
+  YYSYMBOL_condition = 132,                /* condition  */
+  YYSYMBOL_comp_op = 133,                  /* comp_op  */
+  YYSYMBOL_load_data_stmt = 134,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 135,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 136,        /* set_variable_stmt  */
+  YYSYMBOL_kill_query_stmt = 137,          /* kill_query_stmt  */
+  YYSYMBOL_opt_semicolon = 138             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -610,18 +612,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  80
+#define YYFINAL  85
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   337
+#define YYLAST   385
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  79
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  58
+#define YYNNTS  60
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  157
+#define YYNRULES  165
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  300
+#define YYNSTATES  313
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   329
@@ -677,22 +679,23 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   230,   230,   238,   239,   240,   241,   242,   243,   244,
-     245,   246,   247,   248,   249,   250,   251,   252,   253,   254,
-     255,   256,   257,   258,   262,   268,   273,   279,   285,   291,
-     297,   304,   310,   318,   334,   354,   357,   369,   380,   399,
-     406,   417,   420,   433,   442,   451,   460,   469,   478,   490,
-     494,   495,   496,   497,   498,   503,   504,   505,   506,   507,
-     511,   527,   530,   543,   558,   561,   574,   577,   580,   583,
-     586,   590,   594,   602,   615,   637,   640,   653,   663,   705,
-     708,   713,   716,   723,   726,   733,   738,   750,   756,   763,
-     772,   782,   788,   791,   802,   806,   810,   813,   816,   827,
-     829,   831,   833,   839,   841,   843,   849,   860,   871,   878,
-     891,   893,   903,   914,   921,   930,   939,   953,   958,   968,
-     972,   983,   994,  1006,  1021,  1023,  1034,  1046,  1063,  1066,
-    1090,  1093,  1101,  1104,  1110,  1112,  1116,  1121,  1131,  1136,
-    1142,  1146,  1151,  1157,  1162,  1170,  1171,  1172,  1173,  1174,
-    1175,  1176,  1177,  1181,  1194,  1202,  1212,  1213
+       0,   232,   232,   240,   241,   242,   243,   244,   245,   246,
+     247,   248,   249,   250,   251,   252,   253,   254,   255,   256,
+     257,   258,   259,   260,   261,   265,   271,   276,   282,   288,
+     294,   300,   307,   310,   323,   331,   347,   367,   370,   382,
+     393,   412,   419,   430,   433,   446,   455,   464,   473,   482,
+     491,   503,   507,   508,   509,   510,   511,   516,   517,   518,
+     519,   520,   524,   540,   543,   556,   571,   574,   587,   590,
+     593,   596,   599,   603,   607,   615,   628,   650,   653,   666,
+     676,   718,   721,   726,   729,   736,   739,   746,   751,   763,
+     769,   776,   785,   795,   801,   804,   815,   819,   823,   826,
+     829,   840,   842,   844,   846,   852,   854,   856,   862,   873,
+     884,   891,   904,   906,   916,   927,   934,   943,   952,   966,
+     971,   981,   985,   996,   999,  1009,  1020,  1032,  1047,  1049,
+    1060,  1072,  1089,  1092,  1116,  1119,  1127,  1130,  1136,  1138,
+    1142,  1147,  1157,  1162,  1168,  1172,  1177,  1183,  1188,  1196,
+    1197,  1198,  1199,  1200,  1201,  1202,  1203,  1207,  1220,  1225,
+    1242,  1250,  1258,  1269,  1285,  1286
 };
 #endif
 
@@ -728,10 +731,11 @@ static const char *const yytname[] =
   "update_def_list", "update_def", "select_stmt", "opt_group_by",
   "opt_having", "opt_order_by", "sort_def_list", "sort_def", "calc_stmt",
   "aggr_expr", "base_expr", "mul_expr", "add_expr", "select_attr",
-  "expression_list", "rel_attr", "rel_attr_list", "relation_list",
-  "rel_list", "join_list", "join_conditions", "where_conditions",
-  "condition_list", "condition", "comp_op", "load_data_stmt",
-  "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
+  "expression_list", "rel_attr", "rel_attr_list", "relation_name",
+  "relation_list", "rel_list", "join_list", "join_conditions",
+  "where_conditions", "condition_list", "condition", "comp_op",
+  "load_data_stmt", "explain_stmt", "set_variable_stmt", "kill_query_stmt",
+  "opt_semicolon", YY_NULLPTR
 };
 
 static const char *
@@ -741,12 +745,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-205)
+#define YYPACT_NINF (-194)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-65)
+#define YYTABLE_NINF (-67)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -755,36 +759,38 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     279,   102,    16,    11,    11,   -58,    24,  -205,   -11,    26,
-     -18,  -205,  -205,  -205,  -205,  -205,     5,    50,   279,   121,
-      77,  -205,  -205,  -205,  -205,  -205,  -205,  -205,  -205,  -205,
-    -205,  -205,  -205,  -205,  -205,  -205,  -205,  -205,  -205,  -205,
-    -205,  -205,    71,    91,    92,   145,    94,    95,  -205,   190,
-    -205,  -205,  -205,  -205,  -205,  -205,  -205,    86,  -205,  -205,
-     201,   139,   147,  -205,  -205,  -205,  -205,    36,    75,  -205,
-    -205,   122,  -205,  -205,    98,   105,   124,   114,   123,  -205,
-    -205,  -205,  -205,    -2,   155,   127,   110,  -205,   129,   140,
-      93,   -15,   -56,  -205,  -205,    64,  -205,    52,  -205,   -32,
-     241,   241,   120,   190,   190,  -205,   125,   149,   138,   126,
-      29,   128,   130,   181,   131,   132,   142,   134,   135,    29,
-     175,  -205,  -205,   139,  -205,  -205,   165,   139,   -19,   186,
-     187,   191,  -205,  -205,   139,    36,    36,    -6,   163,   194,
-     150,  -205,   168,   207,  -205,   189,   209,   211,  -205,   107,
-     217,   213,   172,  -205,   219,  -205,  -205,   -36,  -205,   -44,
-     139,  -205,  -205,  -205,  -205,  -205,   174,   177,   221,  -205,
-     197,   138,    29,   225,   192,   190,    80,  -205,   103,   190,
-     126,   138,   245,   130,   193,  -205,  -205,  -205,  -205,  -205,
-      -5,   131,   228,   184,   233,  -205,   139,   139,   139,  -205,
-       7,   221,  -205,   195,   199,   219,   194,  -205,   190,    82,
-       8,   -25,  -205,   190,  -205,  -205,  -205,  -205,  -205,  -205,
-     190,   150,   150,    82,   207,  -205,   196,  -205,   181,  -205,
-     200,   251,   217,  -205,   250,   214,  -205,  -205,  -205,   215,
-     221,  -205,  -205,   231,   272,   229,   225,    82,  -205,   274,
-    -205,   190,    82,    82,  -205,  -205,  -205,  -205,  -205,  -205,
-     269,  -205,  -205,   223,   271,   250,   221,  -205,   150,   163,
-     130,   150,   282,  -205,  -205,    82,     9,   250,  -205,   278,
-    -205,  -205,  -205,  -205,  -205,   288,  -205,  -205,   287,  -205,
-    -205,   130,  -205,  -205,   283,   146,   130,  -205,  -205,  -205
+      16,   176,   114,   155,   155,   -47,     1,  -194,    34,   -14,
+      22,  -194,  -194,  -194,  -194,  -194,    30,    49,   106,    50,
+     130,   134,  -194,  -194,  -194,  -194,  -194,  -194,  -194,  -194,
+    -194,  -194,  -194,  -194,  -194,  -194,  -194,  -194,  -194,  -194,
+    -194,  -194,  -194,  -194,    68,    84,    86,   154,    93,    94,
+    -194,   248,  -194,  -194,  -194,  -194,  -194,  -194,  -194,   128,
+    -194,  -194,   258,   161,   150,  -194,  -194,  -194,  -194,   -21,
+      37,  -194,  -194,   133,  -194,  -194,  -194,   117,   125,   149,
+     140,   144,   148,  -194,   135,  -194,  -194,  -194,    -9,   189,
+     160,   147,  -194,   168,   180,    83,   -15,   -58,  -194,  -194,
+      61,  -194,   197,  -194,   -30,   299,   299,   167,   248,   248,
+    -194,   169,   187,   192,   170,   272,   171,    66,  -194,  -194,
+     179,   241,   182,   183,   198,   188,   190,    13,   234,  -194,
+    -194,   161,  -194,  -194,   219,   161,   -10,   259,   266,   267,
+    -194,  -194,   161,   -21,   -21,   221,    20,   231,   269,   240,
+    -194,   230,   274,  -194,  -194,  -194,   256,   276,   279,  -194,
+     178,   280,   281,   235,  -194,   282,  -194,  -194,    42,  -194,
+      35,   161,  -194,  -194,  -194,  -194,  -194,   237,   169,   243,
+     301,  -194,   288,   192,    13,   307,   262,   248,   181,  -194,
+      95,   248,   170,   192,   328,   179,   286,  -194,  -194,  -194,
+    -194,  -194,    -1,   182,   324,   278,   327,  -194,   161,   161,
+     161,  -194,  -194,    29,   301,  -194,   169,   293,   282,   269,
+    -194,   248,    71,    -6,   -12,  -194,   248,  -194,  -194,  -194,
+    -194,  -194,  -194,   248,   240,   240,    71,   274,  -194,   283,
+    -194,   241,  -194,   284,   335,   280,  -194,   330,   285,  -194,
+    -194,  -194,   287,   301,  -194,  -194,   304,   344,   302,   307,
+      71,  -194,   343,  -194,   248,    71,    71,  -194,  -194,  -194,
+    -194,  -194,  -194,   338,  -194,  -194,   292,   340,   330,   301,
+    -194,   240,   231,   179,   240,   351,  -194,  -194,    71,    60,
+     330,  -194,   342,  -194,  -194,  -194,  -194,  -194,   352,  -194,
+    -194,   356,  -194,  -194,   179,  -194,  -194,   350,   137,   179,
+    -194,  -194,  -194
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -792,58 +798,60 @@ static const yytype_int16 yypact[] =
    means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,    26,     0,     0,
-       0,    27,    28,    29,    25,    24,     0,     0,     0,     0,
-     156,    23,    22,    15,    16,    17,    18,    10,    11,    12,
-      13,    14,     8,     9,     5,     7,     6,     4,     3,    19,
-      20,    21,     0,     0,     0,     0,     0,     0,    72,     0,
-      55,    56,    57,    58,    59,    66,    68,   117,    70,    71,
-       0,   110,     0,    98,    94,    97,    99,   103,   110,    90,
-      95,     0,    32,    31,     0,     0,     0,     0,     0,   154,
-       1,   157,     2,     0,     0,     0,     0,    30,     0,   117,
-      94,     0,     0,    66,    68,     0,   100,     0,   106,     0,
-       0,     0,     0,     0,     0,   108,     0,     0,   132,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    96,   118,   110,    67,    69,   117,   110,   110,     0,
-       0,     0,   101,   102,   110,   104,   105,   124,   128,     0,
-     134,    73,     0,    75,   155,     0,   119,     0,    39,     0,
-      41,     0,     0,    37,    64,    63,   107,     0,   111,     0,
-     110,   113,    93,    91,    92,   109,     0,     0,   124,   121,
-       0,   132,     0,    61,     0,     0,     0,   133,   135,     0,
-       0,   132,     0,     0,     0,    50,    51,    52,    53,    54,
-      44,     0,     0,     0,     0,    65,   110,   110,   110,   114,
-     124,   124,   122,     0,    79,    64,     0,    60,     0,   143,
-       0,     0,   151,     0,   145,   146,   147,   148,   149,   150,
-       0,   134,   134,    77,    75,    74,     0,   120,     0,    48,
-       0,     0,    41,    38,    35,     0,   112,   116,   115,     0,
-     124,   125,   123,   130,     0,    81,    61,   144,   139,     0,
-     152,     0,   141,   138,   136,   137,    76,   153,    40,    49,
-       0,    46,    42,     0,     0,    35,   124,   126,   134,   128,
-       0,   134,    83,    62,   140,   142,    43,    35,    34,     0,
-     127,   131,   129,    80,    82,     0,    78,    47,     0,    36,
-      33,     0,    45,    84,    85,    87,     0,    89,    88,    86
+       0,     0,     0,     0,     0,     0,     0,    27,     0,     0,
+       0,    28,    29,    30,    26,    25,     0,     0,     0,     0,
+       0,   164,    24,    23,    15,    16,    17,    18,    10,    11,
+      12,    13,    14,     8,     9,     5,     7,     6,     4,     3,
+      19,    20,    21,    22,     0,     0,     0,     0,     0,     0,
+      74,     0,    57,    58,    59,    60,    61,    68,    70,   119,
+      72,    73,     0,   112,     0,   100,    96,    99,   101,   105,
+     112,    92,    97,     0,    34,    32,    33,     0,     0,     0,
+       0,     0,     0,   158,     0,     1,   165,     2,     0,     0,
+       0,     0,    31,     0,   119,    96,     0,     0,    68,    70,
+       0,   102,     0,   108,     0,     0,     0,     0,     0,     0,
+     110,     0,     0,   136,     0,     0,     0,     0,   159,   163,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    98,
+     120,   112,    69,    71,   119,   112,   112,     0,     0,     0,
+     103,   104,   112,   106,   107,   123,   128,   132,     0,   138,
+      75,     0,    77,   161,   162,   160,     0,   121,     0,    41,
+       0,    43,     0,     0,    39,    66,    65,   109,     0,   113,
+       0,   112,   115,    95,    93,    94,   111,     0,     0,     0,
+     128,   125,     0,   136,     0,    63,     0,     0,     0,   137,
+     139,     0,     0,   136,     0,     0,     0,    52,    53,    54,
+      55,    56,    46,     0,     0,     0,     0,    67,   112,   112,
+     112,   116,   124,   128,   128,   126,     0,    81,    66,     0,
+      62,     0,   147,     0,     0,   155,     0,   149,   150,   151,
+     152,   153,   154,     0,   138,   138,    79,    77,    76,     0,
+     122,     0,    50,     0,     0,    43,    40,    37,     0,   114,
+     118,   117,     0,   128,   129,   127,   134,     0,    83,    63,
+     148,   143,     0,   156,     0,   145,   142,   140,   141,    78,
+     157,    42,    51,     0,    48,    44,     0,     0,    37,   128,
+     130,   138,   132,     0,   138,    85,    64,   144,   146,    45,
+      37,    36,     0,   131,   135,   133,    82,    84,     0,    80,
+      49,     0,    38,    35,     0,    47,    86,    87,    89,     0,
+      91,    90,    88
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -205,  -205,   292,  -205,  -205,  -205,  -205,  -205,  -205,  -205,
-    -205,  -205,  -205,  -167,  -205,  -205,  -205,    84,   133,  -205,
-    -205,  -205,  -205,    72,  -131,   166,   -45,  -205,  -205,    99,
-     148,  -108,  -205,  -205,  -205,    23,  -205,  -205,  -205,   -29,
-      58,    -3,   321,   -65,   -97,  -174,  -205,  -162,    57,  -205,
-     -64,  -204,  -205,  -205,  -205,  -205,  -205,  -205
+    -194,  -194,    -5,  -194,  -194,  -194,  -194,  -194,  -194,  -194,
+    -194,  -194,  -194,  -193,  -194,  -194,  -194,   132,   175,  -194,
+    -194,  -194,  -194,   120,  -143,   215,   -45,  -194,  -194,   145,
+     191,  -117,  -194,  -194,  -194,    72,  -194,  -194,  -194,    10,
+      46,    -3,   380,   -67,  -102,  -187,  -167,  -194,  -173,   103,
+    -194,  -161,  -181,  -194,  -194,  -194,  -194,  -194,  -194,  -194
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-       0,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,   264,    31,    32,    33,   192,   150,   260,
-     190,    62,    34,   207,    63,   120,    64,    35,    36,   181,
-     143,    37,   245,   272,   286,   293,   294,    38,    65,    66,
-      67,   176,    69,    98,    70,   147,   138,   169,   171,   269,
-     141,   177,   178,   220,    39,    40,    41,    82
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,   277,    32,    33,    34,   204,   161,   273,
+     202,    64,    35,   220,    65,   128,    66,    36,    37,   193,
+     152,    38,   258,   285,   299,   306,   307,    39,    67,    68,
+      69,   188,    71,   103,    72,   158,   146,   147,   181,   183,
+     282,   150,   189,   190,   233,    40,    41,    42,    43,    87
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -851,78 +859,88 @@ static const yytype_int16 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      68,    68,   131,   105,    90,   148,   202,    97,   173,   227,
-     121,   250,   197,   229,    72,   146,   122,   254,   255,   230,
-     166,   123,   112,    46,   129,    47,   248,   287,   198,    48,
-     231,    96,    73,   166,    74,    49,   122,   251,   241,   242,
-      89,   196,   159,   249,   288,   130,    91,    48,    50,    51,
-      52,    53,    54,   160,    76,   167,   103,   104,   156,   113,
-     103,   104,   158,   161,   281,   144,   168,   284,   239,   165,
-      48,   132,   133,    75,   154,   246,    49,    77,   267,   240,
-      81,    55,    56,    57,    58,    59,   146,    60,    61,    50,
-      51,    52,    53,    54,   128,   199,   283,   210,   279,    55,
-      56,    97,    58,    59,   280,    95,    78,   204,    42,    43,
-     289,    44,    45,   100,   101,   211,   212,   225,   -64,   119,
-     258,    80,    55,    56,   126,    58,    59,   205,    60,   127,
-      92,   236,   237,   238,   124,   125,   102,   185,   186,   187,
-     188,   189,   213,    83,   214,   215,   216,   217,   218,   219,
-     103,   104,   221,   222,    86,   103,   104,   103,   104,   297,
-     298,   135,   136,    84,    85,    97,    87,    88,    48,   106,
-     107,    99,   209,   146,    49,   109,   223,   108,   110,   114,
-     111,   115,   116,   117,   118,   174,   140,    50,    51,    52,
-      53,    54,   134,     4,   295,   139,   152,   137,   142,   295,
-     155,   145,    89,   149,   151,   247,   153,   122,    48,   157,
-     252,   162,   163,   175,    49,   170,   164,   253,   172,    48,
-      55,    56,    89,    58,    59,    49,    60,    50,    51,    52,
-      53,    54,   179,   180,   182,   183,   184,   193,    50,    51,
-      52,    53,    54,   191,   194,   119,   200,   166,   275,   201,
-     203,   206,   226,   233,   228,   208,   234,   235,   244,    48,
-      55,    56,    89,    58,    59,    49,    60,   243,   257,   261,
-     259,    93,    94,    89,    58,    59,   263,    95,    50,    51,
-      52,    53,    54,     1,     2,   268,   265,   266,   270,   271,
-       3,     4,   274,     5,   276,   277,   278,   285,     6,     7,
-       8,     9,    10,   290,   291,   292,    11,    12,    13,   296,
-      79,    55,    56,    89,    58,    59,   262,    95,   273,   299,
-     195,    14,    15,   256,   232,    71,   282,     0,   224,     0,
-      16,     0,     0,     0,    17,     0,     0,    18
+      70,    70,   139,   110,   159,   185,    95,   215,   240,    75,
+     129,   213,   261,    83,   130,   120,   102,   242,   157,   131,
+       1,     2,   217,   243,   263,    74,   137,     3,     4,   262,
+       5,    50,   238,    78,   244,     6,     7,     8,     9,    10,
+     254,   255,    94,    11,    12,    13,   178,   138,    96,   256,
+     264,   170,   121,   267,   268,   178,   105,   106,    14,    15,
+     108,   109,   171,   102,   167,   108,   109,    16,   169,   172,
+     155,    17,   101,    76,    18,   176,   259,   118,   300,    77,
+     280,   179,   165,    57,    58,   292,    60,    61,    19,   100,
+     252,   209,   180,   157,    79,   301,   296,   302,   107,   136,
+     294,   253,    80,   297,   211,    81,   293,   210,   -66,   127,
+       1,     2,   108,   109,   130,   140,   141,     3,     4,   208,
+       5,    48,    84,    49,   271,     6,     7,     8,     9,    10,
+      85,   132,   133,    11,    12,    13,   119,    86,    84,   218,
+      88,   249,   250,   251,   234,   235,   108,   109,    14,    15,
+     310,   311,     1,     2,   143,   144,    89,    16,    90,     3,
+       4,    17,     5,    91,    18,    92,    93,     6,     7,     8,
+       9,    10,    97,    50,   104,    11,    12,    13,    82,    51,
+     111,   157,    44,    45,   222,    46,    47,   102,   236,   112,
+      14,    15,    52,    53,    54,    55,    56,   113,   223,    16,
+     114,   116,   308,    17,   115,   119,    18,   308,   197,   198,
+     199,   200,   201,   122,   123,    50,   224,   225,   260,   124,
+     117,    51,   125,   265,   126,    57,    58,    59,    60,    61,
+     266,    62,    63,   148,    52,    53,    54,    55,    56,   142,
+     149,   145,   151,   226,   156,   227,   228,   229,   230,   231,
+     232,    94,   163,     4,   160,   162,   108,   109,    50,   166,
+     164,   288,   130,   168,    51,   177,    50,    57,    58,   134,
+      60,    61,    51,    62,   135,   186,    50,    52,    53,    54,
+      55,    56,    51,   182,   173,    52,    53,    54,    55,    56,
+      50,   174,   175,   184,   191,    52,    53,    54,    55,    56,
+     192,   194,   195,   187,   196,   205,   203,   206,   127,   212,
+      57,    58,    94,    60,    61,   214,    62,    50,    57,    58,
+      94,    60,    61,    51,    62,   221,   153,   178,    98,    99,
+      94,    60,    61,   219,   100,   239,    52,    53,    54,    55,
+      56,   216,    57,    58,   154,    60,    61,   241,   100,   246,
+     247,   248,   257,   274,   272,   270,   276,   278,   281,   279,
+     283,   287,   284,   289,   290,   291,   298,   303,   304,    57,
+      58,    94,    60,    61,   305,   100,   309,   275,   245,   286,
+     207,   312,   269,   237,    73,   295
 };
 
 static const yytype_int16 yycheck[] =
 {
-       3,     4,    99,    68,    49,   113,   168,    26,   139,   183,
-      25,    36,    56,    18,    72,   112,    72,   221,   222,    24,
-      26,    77,    24,     7,    56,     9,    18,    18,    72,    18,
-      35,    60,     8,    26,    45,    24,    72,    62,   200,   201,
-      72,    77,    61,    35,    35,    77,    49,    18,    37,    38,
-      39,    40,    41,    72,    72,    61,    75,    76,   123,    61,
-      75,    76,   127,   128,   268,   110,    72,   271,    61,   134,
-      18,   100,   101,    47,   119,   206,    24,    72,   240,    72,
-       3,    70,    71,    72,    73,    74,   183,    76,    77,    37,
-      38,    39,    40,    41,    97,   160,   270,    17,   265,    70,
-      71,    26,    73,    74,   266,    76,    56,   171,     6,     7,
-     277,     9,    10,    77,    78,    35,    36,   181,    25,    26,
-     228,     0,    70,    71,    72,    73,    74,   172,    76,    77,
-      44,   196,   197,   198,    70,    71,    61,    30,    31,    32,
-      33,    34,    62,    72,    64,    65,    66,    67,    68,    69,
-      75,    76,    49,    50,     9,    75,    76,    75,    76,    13,
-      14,   103,   104,    72,    72,    26,    72,    72,    18,    47,
-      72,    24,   175,   270,    24,    51,   179,    72,    64,    24,
-      57,    54,    72,    54,    44,    35,    48,    37,    38,    39,
-      40,    41,    72,    12,   291,    46,    54,    72,    72,   296,
-      25,    73,    72,    72,    72,   208,    72,    72,    18,    44,
-     213,    25,    25,    63,    24,    52,    25,   220,    24,    18,
-      70,    71,    72,    73,    74,    24,    76,    37,    38,    39,
-      40,    41,    64,    26,    45,    26,    25,    24,    37,    38,
-      39,    40,    41,    26,    72,    26,    72,    26,   251,    72,
-      53,    26,     7,    25,    61,    63,    72,    24,    59,    18,
-      70,    71,    72,    73,    74,    24,    76,    72,    72,    18,
-      70,    70,    71,    72,    73,    74,    26,    76,    37,    38,
-      39,    40,    41,     4,     5,    54,    72,    72,    16,    60,
-      11,    12,    18,    14,    25,    72,    25,    15,    19,    20,
-      21,    22,    23,    25,    16,    18,    27,    28,    29,    26,
-      18,    70,    71,    72,    73,    74,   232,    76,   246,   296,
-     154,    42,    43,   224,   191,     4,   269,    -1,   180,    -1,
-      51,    -1,    -1,    -1,    55,    -1,    -1,    58
+       3,     4,   104,    70,   121,   148,    51,   180,   195,     8,
+      25,   178,    18,    18,    72,    24,    26,    18,   120,    77,
+       4,     5,   183,    24,    36,    72,    56,    11,    12,    35,
+      14,    18,   193,    47,    35,    19,    20,    21,    22,    23,
+     213,   214,    72,    27,    28,    29,    26,    77,    51,   216,
+      62,    61,    61,   234,   235,    26,    77,    78,    42,    43,
+      75,    76,    72,    26,   131,    75,    76,    51,   135,   136,
+     115,    55,    62,    72,    58,   142,   219,    82,    18,    45,
+     253,    61,   127,    70,    71,   278,    73,    74,    72,    76,
+      61,    56,    72,   195,    72,    35,   283,   290,    61,   102,
+     281,    72,    72,   284,   171,    56,   279,    72,    25,    26,
+       4,     5,    75,    76,    72,   105,   106,    11,    12,    77,
+      14,     7,    72,     9,   241,    19,    20,    21,    22,    23,
+       0,    70,    71,    27,    28,    29,    70,     3,    72,   184,
+      72,   208,   209,   210,    49,    50,    75,    76,    42,    43,
+      13,    14,     4,     5,   108,   109,    72,    51,    72,    11,
+      12,    55,    14,     9,    58,    72,    72,    19,    20,    21,
+      22,    23,    44,    18,    24,    27,    28,    29,    72,    24,
+      47,   283,     6,     7,   187,     9,    10,    26,   191,    72,
+      42,    43,    37,    38,    39,    40,    41,    72,    17,    51,
+      51,    57,   304,    55,    64,    70,    58,   309,    30,    31,
+      32,    33,    34,    24,    54,    18,    35,    36,   221,    72,
+      72,    24,    54,   226,    44,    70,    71,    72,    73,    74,
+     233,    76,    77,    46,    37,    38,    39,    40,    41,    72,
+      48,    72,    72,    62,    73,    64,    65,    66,    67,    68,
+      69,    72,    54,    12,    72,    72,    75,    76,    18,    25,
+      72,   264,    72,    44,    24,    44,    18,    70,    71,    72,
+      73,    74,    24,    76,    77,    35,    18,    37,    38,    39,
+      40,    41,    24,    52,    25,    37,    38,    39,    40,    41,
+      18,    25,    25,    24,    64,    37,    38,    39,    40,    41,
+      26,    45,    26,    63,    25,    24,    26,    72,    26,    72,
+      70,    71,    72,    73,    74,    72,    76,    18,    70,    71,
+      72,    73,    74,    24,    76,    63,    54,    26,    70,    71,
+      72,    73,    74,    26,    76,     7,    37,    38,    39,    40,
+      41,    53,    70,    71,    72,    73,    74,    61,    76,    25,
+      72,    24,    59,    18,    70,    72,    26,    72,    54,    72,
+      16,    18,    60,    25,    72,    25,    15,    25,    16,    70,
+      71,    72,    73,    74,    18,    76,    26,   245,   203,   259,
+     165,   309,   237,   192,     4,   282
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -930,35 +948,37 @@ static const yytype_int16 yycheck[] =
 static const yytype_uint8 yystos[] =
 {
        0,     4,     5,    11,    12,    14,    19,    20,    21,    22,
-      23,    27,    28,    29,    42,    43,    51,    55,    58,    80,
-      81,    82,    83,    84,    85,    86,    87,    88,    89,    90,
-      91,    93,    94,    95,   101,   106,   107,   110,   116,   133,
-     134,   135,     6,     7,     9,    10,     7,     9,    18,    24,
-      37,    38,    39,    40,    41,    70,    71,    72,    73,    74,
-      76,    77,   100,   103,   105,   117,   118,   119,   120,   121,
-     123,   121,    72,     8,    45,    47,    72,    72,    56,    81,
-       0,     3,   136,    72,    72,    72,     9,    72,    72,    72,
-     105,   120,    44,    70,    71,    76,   118,    26,   122,    24,
-      77,    78,    61,    75,    76,   122,    47,    72,    72,    51,
-      64,    57,    24,    61,    24,    54,    72,    54,    44,    26,
-     104,    25,    72,    77,    70,    71,    72,    77,   120,    56,
-      77,   123,   118,   118,    72,   119,   119,    72,   125,    46,
-      48,   129,    72,   109,   105,    73,   123,   124,   110,    72,
-      97,    72,    54,    72,   105,    25,   122,    44,   122,    61,
-      72,   122,    25,    25,    25,   122,    26,    61,    72,   126,
-      52,   127,    24,   103,    35,    63,   120,   130,   131,    64,
-      26,   108,    45,    26,    25,    30,    31,    32,    33,    34,
-      99,    26,    96,    24,    72,   104,    77,    56,    72,   122,
-      72,    72,   126,    53,   129,   105,    26,   102,    63,   120,
-      17,    35,    36,    62,    64,    65,    66,    67,    68,    69,
-     132,    49,    50,   120,   109,   129,     7,   124,    61,    18,
-      24,    35,    97,    25,    72,    24,   122,   122,   122,    61,
-      72,   126,   126,    72,    59,   111,   103,   120,    18,    35,
-      36,    62,   120,   120,   130,   130,   108,    72,   110,    70,
-      98,    18,    96,    26,    92,    72,    72,   126,    54,   128,
-      16,    60,   112,   102,    18,   120,    25,    72,    25,    92,
-     126,   130,   127,   124,   130,    15,   113,    18,    35,    92,
-      25,    16,    18,   114,   115,   123,    26,    13,    14,   114
+      23,    27,    28,    29,    42,    43,    51,    55,    58,    72,
+      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    93,    94,    95,   101,   106,   107,   110,   116,
+     134,   135,   136,   137,     6,     7,     9,    10,     7,     9,
+      18,    24,    37,    38,    39,    40,    41,    70,    71,    72,
+      73,    74,    76,    77,   100,   103,   105,   117,   118,   119,
+     120,   121,   123,   121,    72,     8,    72,    45,    47,    72,
+      72,    56,    72,    81,    72,     0,     3,   138,    72,    72,
+      72,     9,    72,    72,    72,   105,   120,    44,    70,    71,
+      76,   118,    26,   122,    24,    77,    78,    61,    75,    76,
+     122,    47,    72,    72,    51,    64,    57,    72,    81,    70,
+      24,    61,    24,    54,    72,    54,    44,    26,   104,    25,
+      72,    77,    70,    71,    72,    77,   120,    56,    77,   123,
+     118,   118,    72,   119,   119,    72,   125,   126,    46,    48,
+     130,    72,   109,    54,    72,   105,    73,   123,   124,   110,
+      72,    97,    72,    54,    72,   105,    25,   122,    44,   122,
+      61,    72,   122,    25,    25,    25,   122,    44,    26,    61,
+      72,   127,    52,   128,    24,   103,    35,    63,   120,   131,
+     132,    64,    26,   108,    45,    26,    25,    30,    31,    32,
+      33,    34,    99,    26,    96,    24,    72,   104,    77,    56,
+      72,   122,    72,   125,    72,   127,    53,   130,   105,    26,
+     102,    63,   120,    17,    35,    36,    62,    64,    65,    66,
+      67,    68,    69,   133,    49,    50,   120,   109,   130,     7,
+     124,    61,    18,    24,    35,    97,    25,    72,    24,   122,
+     122,   122,    61,    72,   127,   127,   125,    59,   111,   103,
+     120,    18,    35,    36,    62,   120,   120,   131,   131,   108,
+      72,   110,    70,    98,    18,    96,    26,    92,    72,    72,
+     127,    54,   129,    16,    60,   112,   102,    18,   120,    25,
+      72,    25,    92,   127,   131,   128,   124,   131,    15,   113,
+      18,    35,    92,    25,    16,    18,   114,   115,   123,    26,
+      13,    14,   114
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
@@ -966,20 +986,21 @@ static const yytype_uint8 yyr1[] =
 {
        0,    79,    80,    81,    81,    81,    81,    81,    81,    81,
       81,    81,    81,    81,    81,    81,    81,    81,    81,    81,
-      81,    81,    81,    81,    82,    83,    84,    85,    86,    87,
-      88,    89,    90,    91,    91,    92,    92,    93,    94,    95,
-      95,    96,    96,    97,    97,    97,    97,    97,    97,    98,
-      99,    99,    99,    99,    99,   100,   100,   100,   100,   100,
-     101,   102,   102,   103,   104,   104,   105,   105,   105,   105,
-     105,   105,   105,   106,   107,   108,   108,   109,   110,   111,
-     111,   112,   112,   113,   113,   114,   114,   115,   115,   115,
-     116,   117,   117,   117,   118,   118,   118,   118,   118,   119,
-     119,   119,   119,   120,   120,   120,   121,   121,   121,   121,
-     122,   122,   122,   122,   122,   122,   122,   123,   123,   124,
-     124,   125,   125,   125,   126,   126,   126,   126,   127,   127,
-     128,   128,   129,   129,   130,   130,   130,   130,   131,   131,
-     131,   131,   131,   131,   131,   132,   132,   132,   132,   132,
-     132,   132,   132,   133,   134,   135,   136,   136
+      81,    81,    81,    81,    81,    82,    83,    84,    85,    86,
+      87,    88,    89,    89,    90,    91,    91,    92,    92,    93,
+      94,    95,    95,    96,    96,    97,    97,    97,    97,    97,
+      97,    98,    99,    99,    99,    99,    99,   100,   100,   100,
+     100,   100,   101,   102,   102,   103,   104,   104,   105,   105,
+     105,   105,   105,   105,   105,   106,   107,   108,   108,   109,
+     110,   111,   111,   112,   112,   113,   113,   114,   114,   115,
+     115,   115,   116,   117,   117,   117,   118,   118,   118,   118,
+     118,   119,   119,   119,   119,   120,   120,   120,   121,   121,
+     121,   121,   122,   122,   122,   122,   122,   122,   122,   123,
+     123,   124,   124,   125,   125,   126,   126,   126,   127,   127,
+     127,   127,   128,   128,   129,   129,   130,   130,   131,   131,
+     131,   131,   132,   132,   132,   132,   132,   132,   132,   133,
+     133,   133,   133,   133,   133,   133,   133,   134,   135,   135,
+     136,   136,   136,   137,   138,   138
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -988,19 +1009,20 @@ static const yytype_int8 yyr2[] =
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       3,     2,     2,    10,     9,     0,     3,     5,     7,     5,
-       8,     0,     3,     5,     2,     7,     4,     6,     3,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       6,     0,     3,     4,     0,     3,     1,     2,     1,     2,
-       1,     1,     1,     4,     6,     0,     3,     3,     9,     0,
-       3,     0,     2,     0,     3,     1,     3,     1,     2,     2,
-       2,     4,     4,     4,     1,     1,     3,     1,     1,     1,
-       2,     3,     3,     1,     3,     3,     2,     4,     2,     4,
-       0,     3,     5,     3,     4,     5,     5,     1,     3,     1,
-       3,     2,     3,     4,     0,     3,     4,     5,     0,     5,
-       0,     2,     0,     2,     0,     1,     3,     3,     3,     3,
-       4,     3,     4,     2,     3,     1,     1,     1,     1,     1,
-       1,     1,     2,     7,     2,     4,     0,     1
+       1,     3,     2,     2,     2,    10,     9,     0,     3,     5,
+       7,     5,     8,     0,     3,     5,     2,     7,     4,     6,
+       3,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     6,     0,     3,     4,     0,     3,     1,     2,
+       1,     2,     1,     1,     1,     4,     6,     0,     3,     3,
+       9,     0,     3,     0,     2,     0,     3,     1,     3,     1,
+       2,     2,     2,     4,     4,     4,     1,     1,     3,     1,
+       1,     1,     2,     3,     3,     1,     3,     3,     2,     4,
+       2,     4,     0,     3,     5,     3,     4,     5,     5,     1,
+       3,     1,     3,     1,     3,     2,     3,     4,     0,     3,
+       4,     5,     0,     5,     0,     2,     0,     2,     0,     1,
+       3,     3,     3,     3,     4,     3,     4,     2,     3,     1,
+       1,     1,     1,     1,     1,     1,     2,     7,     2,     3,
+       4,     4,     4,     3,     0,     1
 };
 
 
@@ -1862,93 +1884,108 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 231 "yacc_sql.y"
+#line 233 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1871 "yacc_sql.cpp"
+#line 1893 "yacc_sql.cpp"
     break;
 
-  case 24: /* exit_stmt: EXIT  */
-#line 262 "yacc_sql.y"
+  case 25: /* exit_stmt: EXIT  */
+#line 265 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1880 "yacc_sql.cpp"
+#line 1902 "yacc_sql.cpp"
     break;
 
-  case 25: /* help_stmt: HELP  */
-#line 268 "yacc_sql.y"
+  case 26: /* help_stmt: HELP  */
+#line 271 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1888 "yacc_sql.cpp"
+#line 1910 "yacc_sql.cpp"
     break;
 
-  case 26: /* sync_stmt: SYNC  */
-#line 273 "yacc_sql.y"
+  case 27: /* sync_stmt: SYNC  */
+#line 276 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1896 "yacc_sql.cpp"
+#line 1918 "yacc_sql.cpp"
     break;
 
-  case 27: /* begin_stmt: TRX_BEGIN  */
-#line 279 "yacc_sql.y"
+  case 28: /* begin_stmt: TRX_BEGIN  */
+#line 282 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1904 "yacc_sql.cpp"
+#line 1926 "yacc_sql.cpp"
     break;
 
-  case 28: /* commit_stmt: TRX_COMMIT  */
-#line 285 "yacc_sql.y"
+  case 29: /* commit_stmt: TRX_COMMIT  */
+#line 288 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1912 "yacc_sql.cpp"
+#line 1934 "yacc_sql.cpp"
     break;
 
-  case 29: /* rollback_stmt: TRX_ROLLBACK  */
-#line 291 "yacc_sql.y"
+  case 30: /* rollback_stmt: TRX_ROLLBACK  */
+#line 294 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1920 "yacc_sql.cpp"
+#line 1942 "yacc_sql.cpp"
     break;
 
-  case 30: /* drop_table_stmt: DROP TABLE ID  */
-#line 297 "yacc_sql.y"
+  case 31: /* drop_table_stmt: DROP TABLE ID  */
+#line 300 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1930 "yacc_sql.cpp"
+#line 1952 "yacc_sql.cpp"
     break;
 
-  case 31: /* show_tables_stmt: SHOW TABLES  */
-#line 304 "yacc_sql.y"
+  case 32: /* show_tables_stmt: SHOW TABLES  */
+#line 307 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1938 "yacc_sql.cpp"
+#line 1960 "yacc_sql.cpp"
     break;
 
-  case 32: /* desc_table_stmt: DESC ID  */
+  case 33: /* show_tables_stmt: SHOW ID  */
 #line 310 "yacc_sql.y"
+              {
+      // METRICS 不是保留字，按标识符解析
+      if (0 != strcasecmp((yyvsp[0].string), "METRICS")) {
+        free((yyvsp[0].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      free((yyvsp[0].string));
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_METRICS);
+    }
+#line 1975 "yacc_sql.cpp"
+    break;
+
+  case 34: /* desc_table_stmt: DESC ID  */
+#line 323 "yacc_sql.y"
              {
 	(yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
 	(yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
 	free((yyvsp[0].string));
     }
-#line 1948 "yacc_sql.cpp"
+#line 1985 "yacc_sql.cpp"
     break;
 
-  case 33: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
-#line 319 "yacc_sql.y"
+  case 35: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
+#line 332 "yacc_sql.y"
   {
 	(yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
 	CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1964,11 +2001,11 @@ yyreduce:
 	free((yyvsp[-4].string));
 	free((yyvsp[-2].string));
   }
-#line 1968 "yacc_sql.cpp"
+#line 2005 "yacc_sql.cpp"
     break;
 
-  case 34: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
-#line 335 "yacc_sql.y"
+  case 36: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
+#line 348 "yacc_sql.y"
   {
 	(yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
 	CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1984,19 +2021,19 @@ yyreduce:
 	free((yyvsp[-4].string));
 	free((yyvsp[-2].string));
   }
-#line 1988 "yacc_sql.cpp"
+#line 2025 "yacc_sql.cpp"
     break;
 
-  case 35: /* multi_attribute_names: %empty  */
-#line 354 "yacc_sql.y"
+  case 37: /* multi_attribute_names: %empty  */
+#line 367 "yacc_sql.y"
   {
 	(yyval.multi_attribute_names) = nullptr;
   }
-#line 1996 "yacc_sql.cpp"
+#line 2033 "yacc_sql.cpp"
     break;
 
-  case 36: /* multi_attribute_names: COMMA ID multi_attribute_names  */
-#line 357 "yacc_sql.y"
+  case 38: /* multi_attribute_names: COMMA ID multi_attribute_names  */
+#line 370 "yacc_sql.y"
                                     {
 	if ((yyvsp[0].multi_attribute_names) != nullptr) {
 		(yyval.multi_attribute_names) = (yyvsp[0].multi_attribute_names);
@@ -2006,11 +2043,11 @@ yyreduce:
 	(yyval.multi_attribute_names)->emplace_back((yyvsp[-1].string));
 	delete (yyvsp[-1].string);
   }
-#line 2010 "yacc_sql.cpp"
+#line 2047 "yacc_sql.cpp"
     break;
 
-  case 37: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 370 "yacc_sql.y"
+  case 39: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 383 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -2018,11 +2055,11 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2022 "yacc_sql.cpp"
+#line 2059 "yacc_sql.cpp"
     break;
 
-  case 38: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
-#line 381 "yacc_sql.y"
+  case 40: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
+#line 394 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
@@ -2038,11 +2075,11 @@ yyreduce:
       std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
       delete (yyvsp[-2].attr_info);
     }
-#line 2042 "yacc_sql.cpp"
+#line 2079 "yacc_sql.cpp"
     break;
 
-  case 39: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
-#line 399 "yacc_sql.y"
+  case 41: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
+#line 412 "yacc_sql.y"
                                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
       CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
@@ -2051,11 +2088,11 @@ yyreduce:
       free((yyvsp[-2].string));
 
     }
-#line 2055 "yacc_sql.cpp"
+#line 2092 "yacc_sql.cpp"
     break;
 
-  case 40: /* create_view_stmt: CREATE VIEW ID LBRACE rel_attr_list RBRACE AS select_stmt  */
-#line 406 "yacc_sql.y"
+  case 42: /* create_view_stmt: CREATE VIEW ID LBRACE rel_attr_list RBRACE AS select_stmt  */
+#line 419 "yacc_sql.y"
                                                                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
       CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
@@ -2063,19 +2100,19 @@ yyreduce:
       create_view.select_sql_node = (yyvsp[0].sql_node)->selection;
       free((yyvsp[-5].string));
     }
-#line 2067 "yacc_sql.cpp"
+#line 2104 "yacc_sql.cpp"
     break;
 
-  case 41: /* attr_def_list: %empty  */
-#line 417 "yacc_sql.y"
+  case 43: /* attr_def_list: %empty  */
+#line 430 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 2075 "yacc_sql.cpp"
+#line 2112 "yacc_sql.cpp"
     break;
 
-  case 42: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 421 "yacc_sql.y"
+  case 44: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 434 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -2085,11 +2122,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 2089 "yacc_sql.cpp"
+#line 2126 "yacc_sql.cpp"
     break;
 
-  case 43: /* attr_def: ID type LBRACE number RBRACE  */
-#line 434 "yacc_sql.y"
+  case 45: /* attr_def: ID type LBRACE number RBRACE  */
+#line 447 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
@@ -2098,11 +2135,11 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-4].string));
     }
-#line 2102 "yacc_sql.cpp"
+#line 2139 "yacc_sql.cpp"
     break;
 
-  case 44: /* attr_def: ID type  */
-#line 443 "yacc_sql.y"
+  case 46: /* attr_def: ID type  */
+#line 456 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
@@ -2111,11 +2148,11 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-1].string));
     }
-#line 2115 "yacc_sql.cpp"
+#line 2152 "yacc_sql.cpp"
     break;
 
-  case 45: /* attr_def: ID type LBRACE number RBRACE NOT_T NULL_T  */
-#line 452 "yacc_sql.y"
+  case 47: /* attr_def: ID type LBRACE number RBRACE NOT_T NULL_T  */
+#line 465 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-5].number);
@@ -2124,11 +2161,11 @@ yyreduce:
       (yyval.attr_info)->nullable = false;
       free((yyvsp[-6].string));
     }
-#line 2128 "yacc_sql.cpp"
+#line 2165 "yacc_sql.cpp"
     break;
 
-  case 46: /* attr_def: ID type NOT_T NULL_T  */
-#line 461 "yacc_sql.y"
+  case 48: /* attr_def: ID type NOT_T NULL_T  */
+#line 474 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-2].number);
@@ -2137,11 +2174,11 @@ yyreduce:
       (yyval.attr_info)->nullable = false;
       free((yyvsp[-3].string));
     }
-#line 2141 "yacc_sql.cpp"
+#line 2178 "yacc_sql.cpp"
     break;
 
-  case 47: /* attr_def: ID type LBRACE number RBRACE NULL_T  */
-#line 470 "yacc_sql.y"
+  case 49: /* attr_def: ID type LBRACE number RBRACE NULL_T  */
+#line 483 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
@@ -2150,11 +2187,11 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-5].string));
     }
-#line 2154 "yacc_sql.cpp"
+#line 2191 "yacc_sql.cpp"
     break;
 
-  case 48: /* attr_def: ID type NULL_T  */
-#line 479 "yacc_sql.y"
+  case 50: /* attr_def: ID type NULL_T  */
+#line 492 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
@@ -2163,77 +2200,77 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-2].string));
     }
-#line 2167 "yacc_sql.cpp"
+#line 2204 "yacc_sql.cpp"
     break;
 
-  case 49: /* number: NUMBER  */
-#line 490 "yacc_sql.y"
+  case 51: /* number: NUMBER  */
+#line 503 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 2173 "yacc_sql.cpp"
+#line 2210 "yacc_sql.cpp"
     break;
 
-  case 50: /* type: INT_T  */
-#line 494 "yacc_sql.y"
+  case 52: /* type: INT_T  */
+#line 507 "yacc_sql.y"
                { (yyval.number)=INTS; }
-#line 2179 "yacc_sql.cpp"
+#line 2216 "yacc_sql.cpp"
     break;
 
-  case 51: /* type: STRING_T  */
-#line 495 "yacc_sql.y"
+  case 53: /* type: STRING_T  */
+#line 508 "yacc_sql.y"
                { (yyval.number)=CHARS; }
-#line 2185 "yacc_sql.cpp"
+#line 2222 "yacc_sql.cpp"
     break;
 
-  case 52: /* type: FLOAT_T  */
-#line 496 "yacc_sql.y"
+  case 54: /* type: FLOAT_T  */
+#line 509 "yacc_sql.y"
                { (yyval.number)=FLOATS; }
-#line 2191 "yacc_sql.cpp"
+#line 2228 "yacc_sql.cpp"
     break;
 
-  case 53: /* type: DATE_T  */
-#line 497 "yacc_sql.y"
+  case 55: /* type: DATE_T  */
+#line 510 "yacc_sql.y"
                { (yyval.number)=DATES; }
-#line 2197 "yacc_sql.cpp"
+#line 2234 "yacc_sql.cpp"
     break;
 
-  case 54: /* type: TEXT_T  */
-#line 498 "yacc_sql.y"
+  case 56: /* type: TEXT_T  */
+#line 511 "yacc_sql.y"
                { (yyval.number)=TEXTS; }
-#line 2203 "yacc_sql.cpp"
+#line 2240 "yacc_sql.cpp"
     break;
 
-  case 55: /* aggr_type: COUNT_T  */
-#line 503 "yacc_sql.y"
+  case 57: /* aggr_type: COUNT_T  */
+#line 516 "yacc_sql.y"
                { (yyval.number)=AGGR_COUNT; }
-#line 2209 "yacc_sql.cpp"
+#line 2246 "yacc_sql.cpp"
     break;
 
-  case 56: /* aggr_type: MIN_T  */
-#line 504 "yacc_sql.y"
+  case 58: /* aggr_type: MIN_T  */
+#line 517 "yacc_sql.y"
                { (yyval.number)=AGGR_MIN;   }
-#line 2215 "yacc_sql.cpp"
+#line 2252 "yacc_sql.cpp"
     break;
 
-  case 57: /* aggr_type: MAX_T  */
-#line 505 "yacc_sql.y"
+  case 59: /* aggr_type: MAX_T  */
+#line 518 "yacc_sql.y"
                { (yyval.number)=AGGR_MAX;   }
-#line 2221 "yacc_sql.cpp"
+#line 2258 "yacc_sql.cpp"
     break;
 
-  case 58: /* aggr_type: AVG_T  */
-#line 506 "yacc_sql.y"
+  case 60: /* aggr_type: AVG_T  */
+#line 519 "yacc_sql.y"
                { (yyval.number)=AGGR_AVG;   }
-#line 2227 "yacc_sql.cpp"
+#line 2264 "yacc_sql.cpp"
     break;
 
-  case 59: /* aggr_type: SUM_T  */
-#line 507 "yacc_sql.y"
+  case 61: /* aggr_type: SUM_T  */
+#line 520 "yacc_sql.y"
                { (yyval.number)=AGGR_SUM;   }
-#line 2233 "yacc_sql.cpp"
+#line 2270 "yacc_sql.cpp"
     break;
 
-  case 60: /* insert_stmt: INSERT INTO ID VALUES value_list multi_value_list  */
-#line 512 "yacc_sql.y"
+  case 62: /* insert_stmt: INSERT INTO ID VALUES value_list multi_value_list  */
+#line 525 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-3].string);
@@ -2245,19 +2282,19 @@ yyreduce:
       delete (yyvsp[-1].value_list);
       free((yyvsp[-3].string));
     }
-#line 2249 "yacc_sql.cpp"
+#line 2286 "yacc_sql.cpp"
     break;
 
-  case 61: /* multi_value_list: %empty  */
-#line 527 "yacc_sql.y"
+  case 63: /* multi_value_list: %empty  */
+#line 540 "yacc_sql.y"
     {
       (yyval.multi_value_list) = nullptr;
     }
-#line 2257 "yacc_sql.cpp"
+#line 2294 "yacc_sql.cpp"
     break;
 
-  case 62: /* multi_value_list: COMMA value_list multi_value_list  */
-#line 531 "yacc_sql.y"
+  case 64: /* multi_value_list: COMMA value_list multi_value_list  */
+#line 544 "yacc_sql.y"
     {
       if ((yyvsp[0].multi_value_list) != nullptr) {
         (yyval.multi_value_list) = (yyvsp[0].multi_value_list);
@@ -2267,11 +2304,11 @@ yyreduce:
       (yyval.multi_value_list)->emplace_back(*(yyvsp[-1].value_list));
       delete (yyvsp[-1].value_list);
     }
-#line 2271 "yacc_sql.cpp"
+#line 2308 "yacc_sql.cpp"
     break;
 
-  case 63: /* value_list: LBRACE value value_list_body RBRACE  */
-#line 544 "yacc_sql.y"
+  case 65: /* value_list: LBRACE value value_list_body RBRACE  */
+#line 557 "yacc_sql.y"
     {
       if ((yyvsp[-1].value_list_body) != nullptr) {
         (yyval.value_list) = (yyvsp[-1].value_list_body);
@@ -2282,19 +2319,19 @@ yyreduce:
       std::reverse((yyval.value_list)->begin(), (yyval.value_list)->end());
       delete (yyvsp[-2].value);
     }
-#line 2286 "yacc_sql.cpp"
+#line 2323 "yacc_sql.cpp"
     break;
 
-  case 64: /* value_list_body: %empty  */
-#line 558 "yacc_sql.y"
+  case 66: /* value_list_body: %empty  */
+#line 571 "yacc_sql.y"
     {
       (yyval.value_list_body) = nullptr;
     }
-#line 2294 "yacc_sql.cpp"
+#line 2331 "yacc_sql.cpp"
     break;
 
-  case 65: /* value_list_body: COMMA value value_list_body  */
-#line 562 "yacc_sql.y"
+  case 67: /* value_list_body: COMMA value value_list_body  */
+#line 575 "yacc_sql.y"
     {
       if ((yyvsp[0].value_list_body) != nullptr) {
         (yyval.value_list_body) = (yyvsp[0].value_list_body);
@@ -2304,77 +2341,77 @@ yyreduce:
       (yyval.value_list_body)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 2308 "yacc_sql.cpp"
+#line 2345 "yacc_sql.cpp"
     break;
 
-  case 66: /* value: NUMBER  */
-#line 574 "yacc_sql.y"
+  case 68: /* value: NUMBER  */
+#line 587 "yacc_sql.y"
            {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2317 "yacc_sql.cpp"
+#line 2354 "yacc_sql.cpp"
     break;
 
-  case 67: /* value: '-' NUMBER  */
-#line 577 "yacc_sql.y"
+  case 69: /* value: '-' NUMBER  */
+#line 590 "yacc_sql.y"
                    {
       (yyval.value) = new Value(-(int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2326 "yacc_sql.cpp"
+#line 2363 "yacc_sql.cpp"
     break;
 
-  case 68: /* value: FLOAT  */
-#line 580 "yacc_sql.y"
+  case 70: /* value: FLOAT  */
+#line 593 "yacc_sql.y"
               {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2335 "yacc_sql.cpp"
+#line 2372 "yacc_sql.cpp"
     break;
 
-  case 69: /* value: '-' FLOAT  */
-#line 583 "yacc_sql.y"
+  case 71: /* value: '-' FLOAT  */
+#line 596 "yacc_sql.y"
                   {
       (yyval.value) = new Value(-(float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2344 "yacc_sql.cpp"
+#line 2381 "yacc_sql.cpp"
     break;
 
-  case 70: /* value: SSS  */
-#line 586 "yacc_sql.y"
+  case 72: /* value: SSS  */
+#line 599 "yacc_sql.y"
             {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
     }
-#line 2354 "yacc_sql.cpp"
+#line 2391 "yacc_sql.cpp"
     break;
 
-  case 71: /* value: DATE_STR  */
-#line 590 "yacc_sql.y"
+  case 73: /* value: DATE_STR  */
+#line 603 "yacc_sql.y"
                  {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(DATES, tmp, 4, true);
       free(tmp);
     }
-#line 2364 "yacc_sql.cpp"
+#line 2401 "yacc_sql.cpp"
     break;
 
-  case 72: /* value: NULL_T  */
-#line 594 "yacc_sql.y"
+  case 74: /* value: NULL_T  */
+#line 607 "yacc_sql.y"
                {
       (yyval.value) = new Value(0);
       (yyval.value)->set_null();
       (yyloc) = (yylsp[0]);
     }
-#line 2374 "yacc_sql.cpp"
+#line 2411 "yacc_sql.cpp"
     break;
 
-  case 73: /* delete_stmt: DELETE FROM ID where_conditions  */
-#line 603 "yacc_sql.y"
+  case 75: /* delete_stmt: DELETE FROM ID where_conditions  */
+#line 616 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2384,11 +2421,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2388 "yacc_sql.cpp"
+#line 2425 "yacc_sql.cpp"
     break;
 
-  case 74: /* update_stmt: UPDATE ID SET update_def update_def_list where_conditions  */
-#line 616 "yacc_sql.y"
+  case 76: /* update_stmt: UPDATE ID SET update_def update_def_list where_conditions  */
+#line 629 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-4].string);
@@ -2406,19 +2443,19 @@ yyreduce:
       }
       free((yyvsp[-4].string));
     }
-#line 2410 "yacc_sql.cpp"
+#line 2447 "yacc_sql.cpp"
     break;
 
-  case 75: /* update_def_list: %empty  */
-#line 637 "yacc_sql.y"
+  case 77: /* update_def_list: %empty  */
+#line 650 "yacc_sql.y"
     {
       (yyval.update_infos) = nullptr;
     }
-#line 2418 "yacc_sql.cpp"
+#line 2455 "yacc_sql.cpp"
     break;
 
-  case 76: /* update_def_list: COMMA update_def update_def_list  */
-#line 641 "yacc_sql.y"
+  case 78: /* update_def_list: COMMA update_def update_def_list  */
+#line 654 "yacc_sql.y"
     {
       if ((yyvsp[0].update_infos) != nullptr) {
         (yyval.update_infos) = (yyvsp[0].update_infos);
@@ -2428,22 +2465,22 @@ yyreduce:
       (yyval.update_infos)->emplace_back(*(yyvsp[-1].update_info));
       delete (yyvsp[-1].update_info);
     }
-#line 2432 "yacc_sql.cpp"
+#line 2469 "yacc_sql.cpp"
     break;
 
-  case 77: /* update_def: ID EQ add_expr  */
-#line 654 "yacc_sql.y"
+  case 79: /* update_def: ID EQ add_expr  */
+#line 667 "yacc_sql.y"
     {
       (yyval.update_info) = new UpdateUnit;
       (yyval.update_info)->attribute_name = (yyvsp[-2].string);
       (yyval.update_info)->value = (yyvsp[0].expression);
       free((yyvsp[-2].string));
     }
-#line 2443 "yacc_sql.cpp"
+#line 2480 "yacc_sql.cpp"
     break;
 
-  case 78: /* select_stmt: SELECT select_attr FROM relation_list join_list where_conditions opt_group_by opt_having opt_order_by  */
-#line 663 "yacc_sql.y"
+  case 80: /* select_stmt: SELECT select_attr FROM relation_list join_list where_conditions opt_group_by opt_having opt_order_by  */
+#line 676 "yacc_sql.y"
                                                                                                           {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
 
@@ -2483,70 +2520,70 @@ yyreduce:
         delete (yyvsp[0].order_infos);
       }
     }
-#line 2487 "yacc_sql.cpp"
+#line 2524 "yacc_sql.cpp"
     break;
 
-  case 79: /* opt_group_by: %empty  */
-#line 705 "yacc_sql.y"
+  case 81: /* opt_group_by: %empty  */
+#line 718 "yacc_sql.y"
                 {
       (yyval.rel_attr_list) = nullptr;
 
     }
-#line 2496 "yacc_sql.cpp"
+#line 2533 "yacc_sql.cpp"
     break;
 
-  case 80: /* opt_group_by: GROUP BY rel_attr_list  */
-#line 708 "yacc_sql.y"
+  case 82: /* opt_group_by: GROUP BY rel_attr_list  */
+#line 721 "yacc_sql.y"
                                {
       (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
     }
-#line 2504 "yacc_sql.cpp"
+#line 2541 "yacc_sql.cpp"
     break;
 
-  case 81: /* opt_having: %empty  */
-#line 713 "yacc_sql.y"
+  case 83: /* opt_having: %empty  */
+#line 726 "yacc_sql.y"
                 {
       (yyval.condition_list) = nullptr;
 
     }
-#line 2513 "yacc_sql.cpp"
+#line 2550 "yacc_sql.cpp"
     break;
 
-  case 82: /* opt_having: HAVING condition_list  */
-#line 716 "yacc_sql.y"
+  case 84: /* opt_having: HAVING condition_list  */
+#line 729 "yacc_sql.y"
                               {
       (yyval.condition_list) = (yyvsp[0].condition_list);
     }
-#line 2521 "yacc_sql.cpp"
+#line 2558 "yacc_sql.cpp"
     break;
 
-  case 83: /* opt_order_by: %empty  */
-#line 723 "yacc_sql.y"
+  case 85: /* opt_order_by: %empty  */
+#line 736 "yacc_sql.y"
         {
       (yyval.order_infos) = nullptr;
     }
-#line 2529 "yacc_sql.cpp"
+#line 2566 "yacc_sql.cpp"
     break;
 
-  case 84: /* opt_order_by: ORDER BY sort_def_list  */
-#line 727 "yacc_sql.y"
+  case 86: /* opt_order_by: ORDER BY sort_def_list  */
+#line 740 "yacc_sql.y"
         {
       (yyval.order_infos) = (yyvsp[0].order_infos);
 	}
-#line 2537 "yacc_sql.cpp"
+#line 2574 "yacc_sql.cpp"
     break;
 
-  case 85: /* sort_def_list: sort_def  */
-#line 734 "yacc_sql.y"
+  case 87: /* sort_def_list: sort_def  */
+#line 747 "yacc_sql.y"
         {
       (yyval.order_infos) = new std::vector<OrderByNode>;
       (yyval.order_infos)->emplace_back(*(yyvsp[0].order_info));
 	}
-#line 2546 "yacc_sql.cpp"
+#line 2583 "yacc_sql.cpp"
     break;
 
-  case 86: /* sort_def_list: sort_def COMMA sort_def_list  */
-#line 739 "yacc_sql.y"
+  case 88: /* sort_def_list: sort_def COMMA sort_def_list  */
+#line 752 "yacc_sql.y"
         {
       if ((yyvsp[0].order_infos) != nullptr) {
         (yyval.order_infos) = (yyvsp[0].order_infos);
@@ -2555,53 +2592,53 @@ yyreduce:
       }
       (yyval.order_infos)->emplace_back(*(yyvsp[-2].order_info));
 	}
-#line 2559 "yacc_sql.cpp"
+#line 2596 "yacc_sql.cpp"
     break;
 
-  case 87: /* sort_def: rel_attr  */
-#line 751 "yacc_sql.y"
+  case 89: /* sort_def: rel_attr  */
+#line 764 "yacc_sql.y"
     {
       (yyval.order_info) = new OrderByNode;
       (yyval.order_info)->sort_attr = *(yyvsp[0].rel_attr);
       delete((yyvsp[0].rel_attr));
     }
-#line 2569 "yacc_sql.cpp"
+#line 2606 "yacc_sql.cpp"
     break;
 
-  case 88: /* sort_def: rel_attr DESC  */
-#line 757 "yacc_sql.y"
+  case 90: /* sort_def: rel_attr DESC  */
+#line 770 "yacc_sql.y"
     {
       (yyval.order_info) = new OrderByNode;
       (yyval.order_info)->sort_attr = *(yyvsp[-1].rel_attr);
       (yyval.order_info)->is_asc = 0;
       delete((yyvsp[-1].rel_attr));
     }
-#line 2580 "yacc_sql.cpp"
+#line 2617 "yacc_sql.cpp"
     break;
 
-  case 89: /* sort_def: rel_attr ASC  */
-#line 764 "yacc_sql.y"
+  case 91: /* sort_def: rel_attr ASC  */
+#line 777 "yacc_sql.y"
     {
       (yyval.order_info) = new OrderByNode;
       (yyval.order_info)->sort_attr = *(yyvsp[-1].rel_attr);
       delete((yyvsp[-1].rel_attr));
     }
-#line 2590 "yacc_sql.cpp"
+#line 2627 "yacc_sql.cpp"
     break;
 
-  case 90: /* calc_stmt: CALC select_attr  */
-#line 773 "yacc_sql.y"
+  case 92: /* calc_stmt: CALC select_attr  */
+#line 786 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       std::reverse((yyvsp[0].expression_list)->begin(), (yyvsp[0].expression_list)->end());
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2601 "yacc_sql.cpp"
+#line 2638 "yacc_sql.cpp"
     break;
 
-  case 91: /* aggr_expr: aggr_type LBRACE '*' RBRACE  */
-#line 782 "yacc_sql.y"
+  case 93: /* aggr_expr: aggr_type LBRACE '*' RBRACE  */
+#line 795 "yacc_sql.y"
                                 {
       RelAttrSqlNode *rel_attr_sql_node = new RelAttrSqlNode;
       rel_attr_sql_node->relation_name = "";
@@ -2609,20 +2646,20 @@ yyreduce:
       RelAttrExpr *relExpr = new RelAttrExpr(*rel_attr_sql_node);
       (yyval.expression) = new AggrExpr((AggrType)(yyvsp[-3].number), relExpr);
     }
-#line 2613 "yacc_sql.cpp"
+#line 2650 "yacc_sql.cpp"
     break;
 
-  case 92: /* aggr_expr: aggr_type LBRACE rel_attr RBRACE  */
-#line 788 "yacc_sql.y"
+  case 94: /* aggr_expr: aggr_type LBRACE rel_attr RBRACE  */
+#line 801 "yacc_sql.y"
                                          {
       RelAttrExpr *relExpr = new RelAttrExpr(*(yyvsp[-1].rel_attr));
       (yyval.expression) = new AggrExpr((AggrType)(yyvsp[-3].number), relExpr);
     }
-#line 2622 "yacc_sql.cpp"
+#line 2659 "yacc_sql.cpp"
     break;
 
-  case 93: /* aggr_expr: aggr_type LBRACE DATA RBRACE  */
-#line 791 "yacc_sql.y"
+  case 95: /* aggr_expr: aggr_type LBRACE DATA RBRACE  */
+#line 804 "yacc_sql.y"
                                      {
       // These shit is added due to a fucking test case
       RelAttrSqlNode *rel_attr_sql_node = new RelAttrSqlNode;
@@ -2631,49 +2668,49 @@ yyreduce:
       RelAttrExpr *relExpr = new RelAttrExpr(*rel_attr_sql_node);
       (yyval.expression) = new AggrExpr((AggrType)(yyvsp[-3].number), relExpr);
     }
-#line 2635 "yacc_sql.cpp"
+#line 2672 "yacc_sql.cpp"
     break;
 
-  case 94: /* base_expr: value  */
-#line 802 "yacc_sql.y"
+  case 96: /* base_expr: value  */
+#line 815 "yacc_sql.y"
           {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2645 "yacc_sql.cpp"
+#line 2682 "yacc_sql.cpp"
     break;
 
-  case 95: /* base_expr: rel_attr  */
-#line 806 "yacc_sql.y"
+  case 97: /* base_expr: rel_attr  */
+#line 819 "yacc_sql.y"
                  {
       (yyval.expression) = new RelAttrExpr(*(yyvsp[0].rel_attr));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].rel_attr);
     }
-#line 2655 "yacc_sql.cpp"
+#line 2692 "yacc_sql.cpp"
     break;
 
-  case 96: /* base_expr: LBRACE add_expr RBRACE  */
-#line 810 "yacc_sql.y"
+  case 98: /* base_expr: LBRACE add_expr RBRACE  */
+#line 823 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2664 "yacc_sql.cpp"
+#line 2701 "yacc_sql.cpp"
     break;
 
-  case 97: /* base_expr: aggr_expr  */
-#line 813 "yacc_sql.y"
+  case 99: /* base_expr: aggr_expr  */
+#line 826 "yacc_sql.y"
                   {
       (yyval.expression) = (yyvsp[0].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2673 "yacc_sql.cpp"
+#line 2710 "yacc_sql.cpp"
     break;
 
-  case 98: /* base_expr: value_list  */
-#line 816 "yacc_sql.y"
+  case 100: /* base_expr: value_list  */
+#line 829 "yacc_sql.y"
                    {
       (yyval.expression) = new ValuesExpr();
       for (auto &value : *(yyvsp[0].value_list)) {
@@ -2682,67 +2719,67 @@ yyreduce:
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value_list);
     }
-#line 2686 "yacc_sql.cpp"
+#line 2723 "yacc_sql.cpp"
     break;
 
-  case 99: /* mul_expr: base_expr  */
-#line 827 "yacc_sql.y"
+  case 101: /* mul_expr: base_expr  */
+#line 840 "yacc_sql.y"
               {
       (yyval.expression) = (yyvsp[0].expression);
     }
-#line 2694 "yacc_sql.cpp"
+#line 2731 "yacc_sql.cpp"
     break;
 
-  case 100: /* mul_expr: '-' base_expr  */
-#line 829 "yacc_sql.y"
+  case 102: /* mul_expr: '-' base_expr  */
+#line 842 "yacc_sql.y"
                       {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2702 "yacc_sql.cpp"
+#line 2739 "yacc_sql.cpp"
     break;
 
-  case 101: /* mul_expr: mul_expr '*' base_expr  */
-#line 831 "yacc_sql.y"
+  case 103: /* mul_expr: mul_expr '*' base_expr  */
+#line 844 "yacc_sql.y"
                                {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2710 "yacc_sql.cpp"
+#line 2747 "yacc_sql.cpp"
     break;
 
-  case 102: /* mul_expr: mul_expr '/' base_expr  */
-#line 833 "yacc_sql.y"
+  case 104: /* mul_expr: mul_expr '/' base_expr  */
+#line 846 "yacc_sql.y"
                                {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2718 "yacc_sql.cpp"
+#line 2755 "yacc_sql.cpp"
     break;
 
-  case 103: /* add_expr: mul_expr  */
-#line 839 "yacc_sql.y"
+  case 105: /* add_expr: mul_expr  */
+#line 852 "yacc_sql.y"
              {
       (yyval.expression) = (yyvsp[0].expression);
     }
-#line 2726 "yacc_sql.cpp"
+#line 2763 "yacc_sql.cpp"
     break;
 
-  case 104: /* add_expr: add_expr '+' mul_expr  */
-#line 841 "yacc_sql.y"
+  case 106: /* add_expr: add_expr '+' mul_expr  */
+#line 854 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2734 "yacc_sql.cpp"
+#line 2771 "yacc_sql.cpp"
     break;
 
-  case 105: /* add_expr: add_expr '-' mul_expr  */
-#line 843 "yacc_sql.y"
+  case 107: /* add_expr: add_expr '-' mul_expr  */
+#line 856 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2742 "yacc_sql.cpp"
+#line 2779 "yacc_sql.cpp"
     break;
 
-  case 106: /* select_attr: '*' expression_list  */
-#line 849 "yacc_sql.y"
+  case 108: /* select_attr: '*' expression_list  */
+#line 862 "yacc_sql.y"
                         {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2754,11 +2791,11 @@ yyreduce:
       relAttrSqlNode->attribute_name = "*";
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
     }
-#line 2758 "yacc_sql.cpp"
+#line 2795 "yacc_sql.cpp"
     break;
 
-  case 107: /* select_attr: ID DOT '*' expression_list  */
-#line 860 "yacc_sql.y"
+  case 109: /* select_attr: ID DOT '*' expression_list  */
+#line 873 "yacc_sql.y"
                                  {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2771,11 +2808,11 @@ yyreduce:
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
       delete (yyvsp[-3].string);
     }
-#line 2775 "yacc_sql.cpp"
+#line 2812 "yacc_sql.cpp"
     break;
 
-  case 108: /* select_attr: add_expr expression_list  */
-#line 871 "yacc_sql.y"
+  case 110: /* select_attr: add_expr expression_list  */
+#line 884 "yacc_sql.y"
                                  {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2784,11 +2821,11 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
     }
-#line 2788 "yacc_sql.cpp"
+#line 2825 "yacc_sql.cpp"
     break;
 
-  case 109: /* select_attr: add_expr AS ID expression_list  */
-#line 878 "yacc_sql.y"
+  case 111: /* select_attr: add_expr AS ID expression_list  */
+#line 891 "yacc_sql.y"
                                        {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2799,19 +2836,19 @@ yyreduce:
       expr->set_alias((yyvsp[-1].string));
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2803 "yacc_sql.cpp"
+#line 2840 "yacc_sql.cpp"
     break;
 
-  case 110: /* expression_list: %empty  */
-#line 891 "yacc_sql.y"
+  case 112: /* expression_list: %empty  */
+#line 904 "yacc_sql.y"
                 {
       (yyval.expression_list) = nullptr;
     }
-#line 2811 "yacc_sql.cpp"
+#line 2848 "yacc_sql.cpp"
     break;
 
-  case 111: /* expression_list: COMMA '*' expression_list  */
-#line 893 "yacc_sql.y"
+  case 113: /* expression_list: COMMA '*' expression_list  */
+#line 906 "yacc_sql.y"
                                   {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2823,11 +2860,11 @@ yyreduce:
       relAttrSqlNode->attribute_name = "*";
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
     }
-#line 2827 "yacc_sql.cpp"
+#line 2864 "yacc_sql.cpp"
     break;
 
-  case 112: /* expression_list: COMMA ID DOT '*' expression_list  */
-#line 903 "yacc_sql.y"
+  case 114: /* expression_list: COMMA ID DOT '*' expression_list  */
+#line 916 "yacc_sql.y"
                                          {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2840,11 +2877,11 @@ yyreduce:
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
       delete (yyvsp[-3].string);
     }
-#line 2844 "yacc_sql.cpp"
+#line 2881 "yacc_sql.cpp"
     break;
 
-  case 113: /* expression_list: COMMA add_expr expression_list  */
-#line 914 "yacc_sql.y"
+  case 115: /* expression_list: COMMA add_expr expression_list  */
+#line 927 "yacc_sql.y"
                                        {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2853,11 +2890,11 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
     }
-#line 2857 "yacc_sql.cpp"
+#line 2894 "yacc_sql.cpp"
     break;
 
-  case 114: /* expression_list: COMMA add_expr ID expression_list  */
-#line 921 "yacc_sql.y"
+  case 116: /* expression_list: COMMA add_expr ID expression_list  */
+#line 934 "yacc_sql.y"
                                           {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2868,11 +2905,11 @@ yyreduce:
       expr->set_alias((yyvsp[-1].string));
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2872 "yacc_sql.cpp"
+#line 2909 "yacc_sql.cpp"
     break;
 
-  case 115: /* expression_list: COMMA add_expr AS ID expression_list  */
-#line 930 "yacc_sql.y"
+  case 117: /* expression_list: COMMA add_expr AS ID expression_list  */
+#line 943 "yacc_sql.y"
                                              {
       if ((yyvsp[0].expression_list) != nullptr) {
 	(yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2883,11 +2920,11 @@ yyreduce:
       expr->set_alias((yyvsp[-1].string));
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2887 "yacc_sql.cpp"
+#line 2924 "yacc_sql.cpp"
     break;
 
-  case 116: /* expression_list: COMMA add_expr AS DATA expression_list  */
-#line 939 "yacc_sql.y"
+  case 118: /* expression_list: COMMA add_expr AS DATA expression_list  */
+#line 952 "yacc_sql.y"
                                                {
       // These shit is added due to a fucking test case
       if ((yyvsp[0].expression_list) != nullptr) {
@@ -2899,22 +2936,22 @@ yyreduce:
       expr->set_alias("data");
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2903 "yacc_sql.cpp"
+#line 2940 "yacc_sql.cpp"
     break;
 
-  case 117: /* rel_attr: ID  */
-#line 953 "yacc_sql.y"
+  case 119: /* rel_attr: ID  */
+#line 966 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name = "";
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       delete (yyvsp[0].string);
     }
-#line 2914 "yacc_sql.cpp"
+#line 2951 "yacc_sql.cpp"
     break;
 
-  case 118: /* rel_attr: ID DOT ID  */
-#line 958 "yacc_sql.y"
+  case 120: /* rel_attr: ID DOT ID  */
+#line 971 "yacc_sql.y"
                   {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2922,21 +2959,21 @@ yyreduce:
       delete (yyvsp[-2].string);
       delete (yyvsp[0].string);
     }
-#line 2926 "yacc_sql.cpp"
+#line 2963 "yacc_sql.cpp"
     break;
 
-  case 119: /* rel_attr_list: rel_attr  */
-#line 968 "yacc_sql.y"
+  case 121: /* rel_attr_list: rel_attr  */
+#line 981 "yacc_sql.y"
              {
       (yyval.rel_attr_list) = new std::vector<RelAttrSqlNode>;
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[0].rel_attr));
       delete (yyvsp[0].rel_attr);
     }
-#line 2936 "yacc_sql.cpp"
+#line 2973 "yacc_sql.cpp"
     break;
 
-  case 120: /* rel_attr_list: rel_attr COMMA rel_attr_list  */
-#line 972 "yacc_sql.y"
+  case 122: /* rel_attr_list: rel_attr COMMA rel_attr_list  */
+#line 985 "yacc_sql.y"
                                      {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
 	(yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2946,12 +2983,32 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-2].rel_attr));
       delete (yyvsp[-2].rel_attr);
     }
-#line 2950 "yacc_sql.cpp"
+#line 2987 "yacc_sql.cpp"
     break;
 
-  case 121: /* relation_list: ID rel_list  */
-#line 983 "yacc_sql.y"
+  case 123: /* relation_name: ID  */
+#line 996 "yacc_sql.y"
+       {
+      (yyval.string) = (yyvsp[0].string);
+    }
+#line 2995 "yacc_sql.cpp"
+    break;
+
+  case 124: /* relation_name: ID DOT ID  */
+#line 999 "yacc_sql.y"
                 {
+      // 系统表的名字带有前缀，比如 sys.sessions
+      std::string name = std::string((yyvsp[-2].string)) + "." + (yyvsp[0].string);
+      (yyval.string) = strdup(name.c_str());
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
+    }
+#line 3007 "yacc_sql.cpp"
+    break;
+
+  case 125: /* relation_list: relation_name rel_list  */
+#line 1009 "yacc_sql.y"
+                           {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
       } else {
@@ -2963,12 +3020,12 @@ yyreduce:
       (yyval.relation_list)->push_back(*relationSqlNode);
       free((yyvsp[-1].string));
     }
-#line 2967 "yacc_sql.cpp"
+#line 3024 "yacc_sql.cpp"
     break;
 
-  case 122: /* relation_list: ID ID rel_list  */
-#line 994 "yacc_sql.y"
-                       {
+  case 126: /* relation_list: relation_name ID rel_list  */
+#line 1020 "yacc_sql.y"
+                                  {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
       } else {
@@ -2981,12 +3038,12 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[-1].string));
     }
-#line 2985 "yacc_sql.cpp"
+#line 3042 "yacc_sql.cpp"
     break;
 
-  case 123: /* relation_list: ID AS ID rel_list  */
-#line 1006 "yacc_sql.y"
-                          {
+  case 127: /* relation_list: relation_name AS ID rel_list  */
+#line 1032 "yacc_sql.y"
+                                     {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
       } else {
@@ -2999,20 +3056,20 @@ yyreduce:
       free((yyvsp[-3].string));
       free((yyvsp[-1].string));
     }
-#line 3003 "yacc_sql.cpp"
+#line 3060 "yacc_sql.cpp"
     break;
 
-  case 124: /* rel_list: %empty  */
-#line 1021 "yacc_sql.y"
+  case 128: /* rel_list: %empty  */
+#line 1047 "yacc_sql.y"
                 {
       (yyval.relation_list) = nullptr;
     }
-#line 3011 "yacc_sql.cpp"
+#line 3068 "yacc_sql.cpp"
     break;
 
-  case 125: /* rel_list: COMMA ID rel_list  */
-#line 1023 "yacc_sql.y"
-                          {
+  case 129: /* rel_list: COMMA relation_name rel_list  */
+#line 1049 "yacc_sql.y"
+                                     {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
       } else {
@@ -3024,12 +3081,12 @@ yyreduce:
       (yyval.relation_list)->push_back(*relationSqlNode);
       free((yyvsp[-1].string));
     }
-#line 3028 "yacc_sql.cpp"
+#line 3085 "yacc_sql.cpp"
     break;
 
-  case 126: /* rel_list: COMMA ID ID rel_list  */
-#line 1034 "yacc_sql.y"
-                             {
+  case 130: /* rel_list: COMMA relation_name ID rel_list  */
+#line 1060 "yacc_sql.y"
+                                        {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
       } else {
@@ -3042,12 +3099,12 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].relation_list));
     }
-#line 3046 "yacc_sql.cpp"
+#line 3103 "yacc_sql.cpp"
     break;
 
-  case 127: /* rel_list: COMMA ID AS ID rel_list  */
-#line 1046 "yacc_sql.y"
-                                {
+  case 131: /* rel_list: COMMA relation_name AS ID rel_list  */
+#line 1072 "yacc_sql.y"
+                                           {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
       } else {
@@ -3060,20 +3117,20 @@ yyreduce:
       free((yyvsp[-3].string));
       free((yyvsp[-1].string));
     }
-#line 3064 "yacc_sql.cpp"
+#line 3121 "yacc_sql.cpp"
     break;
 
-  case 128: /* join_list: %empty  */
-#line 1063 "yacc_sql.y"
+  case 132: /* join_list: %empty  */
+#line 1089 "yacc_sql.y"
     {
       (yyval.join_list) = nullptr;
     }
-#line 3072 "yacc_sql.cpp"
+#line 3129 "yacc_sql.cpp"
     break;
 
-  case 129: /* join_list: INNER JOIN ID join_conditions join_list  */
-#line 1066 "yacc_sql.y"
-                                             {
+  case 133: /* join_list: INNER JOIN relation_name join_conditions join_list  */
+#line 1092 "yacc_sql.y"
+                                                        {
       if ((yyvsp[0].join_list) != nullptr) {
         (yyval.join_list) = (yyvsp[0].join_list);
       } else {
@@ -3093,72 +3150,72 @@ yyreduce:
       delete joinSqlNode;
       free((yyvsp[-2].string));
     }
-#line 3097 "yacc_sql.cpp"
+#line 3154 "yacc_sql.cpp"
     break;
 
-  case 130: /* join_conditions: %empty  */
-#line 1090 "yacc_sql.y"
+  case 134: /* join_conditions: %empty  */
+#line 1116 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 3105 "yacc_sql.cpp"
+#line 3162 "yacc_sql.cpp"
     break;
 
-  case 131: /* join_conditions: ON condition_list  */
-#line 1094 "yacc_sql.y"
+  case 135: /* join_conditions: ON condition_list  */
+#line 1120 "yacc_sql.y"
         {
 	  (yyval.condition_list) = (yyvsp[0].condition_list);
 	}
-#line 3113 "yacc_sql.cpp"
+#line 3170 "yacc_sql.cpp"
     break;
 
-  case 132: /* where_conditions: %empty  */
-#line 1101 "yacc_sql.y"
+  case 136: /* where_conditions: %empty  */
+#line 1127 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 3121 "yacc_sql.cpp"
+#line 3178 "yacc_sql.cpp"
     break;
 
-  case 133: /* where_conditions: WHERE condition_list  */
-#line 1104 "yacc_sql.y"
+  case 137: /* where_conditions: WHERE condition_list  */
+#line 1130 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 3129 "yacc_sql.cpp"
+#line 3186 "yacc_sql.cpp"
     break;
 
-  case 134: /* condition_list: %empty  */
-#line 1110 "yacc_sql.y"
+  case 138: /* condition_list: %empty  */
+#line 1136 "yacc_sql.y"
                 {
       (yyval.condition_list) = nullptr;
     }
-#line 3137 "yacc_sql.cpp"
+#line 3194 "yacc_sql.cpp"
     break;
 
-  case 135: /* condition_list: condition  */
-#line 1112 "yacc_sql.y"
+  case 139: /* condition_list: condition  */
+#line 1138 "yacc_sql.y"
                   {
       (yyval.condition_list) = new WhereConditions;
       (yyval.condition_list)->conditions.emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 3147 "yacc_sql.cpp"
+#line 3204 "yacc_sql.cpp"
     break;
 
-  case 136: /* condition_list: condition AND condition_list  */
-#line 1116 "yacc_sql.y"
+  case 140: /* condition_list: condition AND condition_list  */
+#line 1142 "yacc_sql.y"
                                      {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->type = ConjunctionType::AND;
       (yyval.condition_list)->conditions.emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 3158 "yacc_sql.cpp"
+#line 3215 "yacc_sql.cpp"
     break;
 
-  case 137: /* condition_list: condition OR condition_list  */
-#line 1121 "yacc_sql.y"
+  case 141: /* condition_list: condition OR condition_list  */
+#line 1147 "yacc_sql.y"
                                     {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->type = ConjunctionType::OR;
@@ -3166,132 +3223,132 @@ yyreduce:
       delete (yyvsp[-2].condition);
 
     }
-#line 3170 "yacc_sql.cpp"
+#line 3227 "yacc_sql.cpp"
     break;
 
-  case 138: /* condition: add_expr comp_op add_expr  */
-#line 1131 "yacc_sql.y"
+  case 142: /* condition: add_expr comp_op add_expr  */
+#line 1157 "yacc_sql.y"
                               {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-2].expression);
       (yyval.condition)->right_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = (yyvsp[-1].comp);
     }
-#line 3181 "yacc_sql.cpp"
+#line 3238 "yacc_sql.cpp"
     break;
 
-  case 139: /* condition: add_expr IS NULL_T  */
-#line 1136 "yacc_sql.y"
+  case 143: /* condition: add_expr IS NULL_T  */
+#line 1162 "yacc_sql.y"
                            {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-2].expression);
       (yyval.condition)->comp = IS_NULL;
     }
-#line 3191 "yacc_sql.cpp"
+#line 3248 "yacc_sql.cpp"
     break;
 
-  case 140: /* condition: add_expr IS NOT_T NULL_T  */
-#line 1142 "yacc_sql.y"
+  case 144: /* condition: add_expr IS NOT_T NULL_T  */
+#line 1168 "yacc_sql.y"
                              {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-3].expression);
       (yyval.condition)->comp = IS_NOT_NULL;
     }
-#line 3201 "yacc_sql.cpp"
+#line 3258 "yacc_sql.cpp"
     break;
 
-  case 141: /* condition: add_expr IN_T add_expr  */
-#line 1146 "yacc_sql.y"
+  case 145: /* condition: add_expr IN_T add_expr  */
+#line 1172 "yacc_sql.y"
                                {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-2].expression);
       (yyval.condition)->right_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = IN;
     }
-#line 3212 "yacc_sql.cpp"
+#line 3269 "yacc_sql.cpp"
     break;
 
-  case 142: /* condition: add_expr NOT_T IN_T add_expr  */
-#line 1151 "yacc_sql.y"
+  case 146: /* condition: add_expr NOT_T IN_T add_expr  */
+#line 1177 "yacc_sql.y"
                                      {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-3].expression);
       (yyval.condition)->right_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = NOT_IN;
     }
-#line 3223 "yacc_sql.cpp"
+#line 3280 "yacc_sql.cpp"
     break;
 
-  case 143: /* condition: EXISTS_T add_expr  */
-#line 1157 "yacc_sql.y"
+  case 147: /* condition: EXISTS_T add_expr  */
+#line 1183 "yacc_sql.y"
                         {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = EXISTS;
     }
-#line 3233 "yacc_sql.cpp"
+#line 3290 "yacc_sql.cpp"
     break;
 
-  case 144: /* condition: NOT_T EXISTS_T add_expr  */
-#line 1162 "yacc_sql.y"
+  case 148: /* condition: NOT_T EXISTS_T add_expr  */
+#line 1188 "yacc_sql.y"
                               {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = NOT_EXISTS;
     }
-#line 3243 "yacc_sql.cpp"
+#line 3300 "yacc_sql.cpp"
     break;
 
-  case 145: /* comp_op: EQ  */
-#line 1170 "yacc_sql.y"
+  case 149: /* comp_op: EQ  */
+#line 1196 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 3249 "yacc_sql.cpp"
+#line 3306 "yacc_sql.cpp"
     break;
 
-  case 146: /* comp_op: LT  */
-#line 1171 "yacc_sql.y"
+  case 150: /* comp_op: LT  */
+#line 1197 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 3255 "yacc_sql.cpp"
+#line 3312 "yacc_sql.cpp"
     break;
 
-  case 147: /* comp_op: GT  */
-#line 1172 "yacc_sql.y"
+  case 151: /* comp_op: GT  */
+#line 1198 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 3261 "yacc_sql.cpp"
+#line 3318 "yacc_sql.cpp"
     break;
 
-  case 148: /* comp_op: LE  */
-#line 1173 "yacc_sql.y"
+  case 152: /* comp_op: LE  */
+#line 1199 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 3267 "yacc_sql.cpp"
+#line 3324 "yacc_sql.cpp"
     break;
 
-  case 149: /* comp_op: GE  */
-#line 1174 "yacc_sql.y"
+  case 153: /* comp_op: GE  */
+#line 1200 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 3273 "yacc_sql.cpp"
+#line 3330 "yacc_sql.cpp"
     break;
 
-  case 150: /* comp_op: NE  */
-#line 1175 "yacc_sql.y"
+  case 154: /* comp_op: NE  */
+#line 1201 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 3279 "yacc_sql.cpp"
+#line 3336 "yacc_sql.cpp"
     break;
 
-  case 151: /* comp_op: LIKE_T  */
-#line 1176 "yacc_sql.y"
+  case 155: /* comp_op: LIKE_T  */
+#line 1202 "yacc_sql.y"
              { (yyval.comp) = LIKE_OP; }
-#line 3285 "yacc_sql.cpp"
+#line 3342 "yacc_sql.cpp"
     break;
 
-  case 152: /* comp_op: NOT_T LIKE_T  */
-#line 1177 "yacc_sql.y"
+  case 156: /* comp_op: NOT_T LIKE_T  */
+#line 1203 "yacc_sql.y"
                    { (yyval.comp) = NOT_LIKE_OP; }
-#line 3291 "yacc_sql.cpp"
+#line 3348 "yacc_sql.cpp"
     break;
 
-  case 153: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
-#line 1182 "yacc_sql.y"
+  case 157: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 1208 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -3301,20 +3358,38 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 3305 "yacc_sql.cpp"
+#line 3362 "yacc_sql.cpp"
     break;
 
-  case 154: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 1195 "yacc_sql.y"
+  case 158: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1221 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 3314 "yacc_sql.cpp"
+#line 3371 "yacc_sql.cpp"
     break;
 
-  case 155: /* set_variable_stmt: SET ID EQ value  */
-#line 1203 "yacc_sql.y"
+  case 159: /* explain_stmt: EXPLAIN ID command_wrapper  */
+#line 1226 "yacc_sql.y"
+    {
+      // ANALYZE 不是保留字，按标识符解析
+      if (0 != strcasecmp((yyvsp[-1].string), "ANALYZE")) {
+        free((yyvsp[-1].string));
+        delete (yyvsp[0].sql_node);
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      free((yyvsp[-1].string));
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
+      (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+      (yyval.sql_node)->explain.analyze = true;
+    }
+#line 3389 "yacc_sql.cpp"
+    break;
+
+  case 160: /* set_variable_stmt: SET ID EQ value  */
+#line 1243 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -3322,11 +3397,53 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 3326 "yacc_sql.cpp"
+#line 3401 "yacc_sql.cpp"
     break;
 
+  case 161: /* set_variable_stmt: SET ID EQ ON  */
+#line 1251 "yacc_sql.y"
+    {
+      // ON 是关键字，单独处理，OFF 等其它取值按标识符解析
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+      (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
+      (yyval.sql_node)->set_variable.value = Value("on");
+      free((yyvsp[-2].string));
+    }
+#line 3413 "yacc_sql.cpp"
+    break;
 
-#line 3330 "yacc_sql.cpp"
+  case 162: /* set_variable_stmt: SET ID EQ ID  */
+#line 1259 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+      (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
+      (yyval.sql_node)->set_variable.value = Value((yyvsp[0].string));
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
+    }
+#line 3425 "yacc_sql.cpp"
+    break;
+
+  case 163: /* kill_query_stmt: ID ID NUMBER  */
+#line 1270 "yacc_sql.y"
+    {
+      // KILL 和 QUERY 不是保留字，按标识符解析，避免影响同名的表和列
+      if (0 != strcasecmp((yyvsp[-2].string), "KILL") || 0 != strcasecmp((yyvsp[-1].string), "QUERY")) {
+        free((yyvsp[-2].string));
+        free((yyvsp[-1].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      free((yyvsp[-2].string));
+      free((yyvsp[-1].string));
+      (yyval.sql_node) = new ParsedSqlNode(SCF_KILL_QUERY);
+      (yyval.sql_node)->kill_query.session_id = (yyvsp[0].number);
+    }
+#line 3443 "yacc_sql.cpp"
+    break;
+
+
+#line 3447 "yacc_sql.cpp"
 
       default: break;
     }
@@ -3555,7 +3672,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 1215 "yacc_sql.y"
+#line 1288 "yacc_sql.y"
 
 
 //_____________________________________________________________________
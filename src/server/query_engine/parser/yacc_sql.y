@@ -192,6 +192,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <expression_list>     select_attr
 %type <relation_list>       rel_list
 %type <relation_list>       relation_list
+%type <string>              relation_name
 %type <expression>	    aggr_expr
 %type <expression>          base_expr
 %type <expression>          mul_expr
@@ -216,6 +217,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <sql_node>            load_data_stmt
 %type <sql_node>            explain_stmt
 %type <sql_node>            set_variable_stmt
+%type <sql_node>            kill_query_stmt
 %type <sql_node>            help_stmt
 %type <sql_node>            exit_stmt
 %type <sql_node>            command_wrapper
@@ -254,6 +256,7 @@ command_wrapper:
   | load_data_stmt
   | explain_stmt
   | set_variable_stmt
+  | kill_query_stmt
   | help_stmt
   | exit_stmt
     ;
@@ -304,6 +307,16 @@ show_tables_stmt:
     SHOW TABLES {
       $$ = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
+    | SHOW ID {
+      // METRICS 不是保留字，按标识符解析
+      if (0 != strcasecmp($2, "METRICS")) {
+        free($2);
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      free($2);
+      $$ = new ParsedSqlNode(SCF_SHOW_METRICS);
+    }
     ;
 
 desc_table_stmt:
@@ -979,8 +992,21 @@ rel_attr_list:
       delete $1;
     }
 
+relation_name:
+    ID {
+      $$ = $1;
+    }
+    | ID DOT ID {
+      // 系统表的名字带有前缀，比如 sys.sessions
+      std::string name = std::string($1) + "." + $3;
+      $$ = strdup(name.c_str());
+      free($1);
+      free($3);
+    }
+    ;
+
 relation_list:
-    ID rel_list {
+    relation_name rel_list {
       if ($2 != nullptr) {
         $$ = $2;
       } else {
@@ -991,7 +1017,7 @@ relation_list:
       relationSqlNode->alias = "";
       $$->push_back(*relationSqlNode);
       free($1);
-    } | ID ID rel_list {
+    } | relation_name ID rel_list {
       if ($3 != nullptr) {
         $$ = $3;
       } else {
@@ -1003,7 +1029,7 @@ relation_list:
       $$->push_back(*relationSqlNode);
       free($1);
       free($2);
-    } | ID AS ID rel_list {
+    } | relation_name AS ID rel_list {
       if ($4 != nullptr) {
         $$ = $4;
       } else {
@@ -1020,7 +1046,7 @@ relation_list:
 rel_list:
     /* empty */ {
       $$ = nullptr;
-    } | COMMA ID rel_list {
+    } | COMMA relation_name rel_list {
       if ($3 != nullptr) {
         $$ = $3;
       } else {
@@ -1031,7 +1057,7 @@ rel_list:
       relationSqlNode->alias = "";
       $$->push_back(*relationSqlNode);
       free($2);
-    } | COMMA ID ID rel_list {
+    } | COMMA relation_name ID rel_list {
       if ($4 != nullptr) {
         $$ = $4;
       } else {
@@ -1043,7 +1069,7 @@ rel_list:
       $$->push_back(*relationSqlNode);
       free($2);
       free($4);
-    } | COMMA ID AS ID rel_list {
+    } | COMMA relation_name AS ID rel_list {
       if ($5 != nullptr) {
         $$ = $5;
       } else {
@@ -1063,7 +1089,7 @@ join_list:
     {
       $$ = nullptr;
     }
-    | INNER JOIN ID join_conditions join_list{
+    | INNER JOIN relation_name join_conditions join_list{
       if ($5 != nullptr) {
         $$ = $5;
       } else {
@@ -1196,6 +1222,20 @@ explain_stmt:
       $$ = new ParsedSqlNode(SCF_EXPLAIN);
       $$->explain.sql_node = std::unique_ptr<ParsedSqlNode>($2);
     }
+    | EXPLAIN ID command_wrapper
+    {
+      // ANALYZE 不是保留字，按标识符解析
+      if (0 != strcasecmp($2, "ANALYZE")) {
+        free($2);
+        delete $3;
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      free($2);
+      $$ = new ParsedSqlNode(SCF_EXPLAIN);
+      $$->explain.sql_node = std::unique_ptr<ParsedSqlNode>($3);
+      $$->explain.analyze = true;
+    }
     ;
 
 set_variable_stmt:
@@ -1207,6 +1247,39 @@ set_variable_stmt:
       free($2);
       delete $4;
     }
+    | SET ID EQ ON
+    {
+      // ON 是关键字，单独处理，OFF 等其它取值按标识符解析
+      $$ = new ParsedSqlNode(SCF_SET_VARIABLE);
+      $$->set_variable.name  = $2;
+      $$->set_variable.value = Value("on");
+      free($2);
+    }
+    | SET ID EQ ID
+    {
+      $$ = new ParsedSqlNode(SCF_SET_VARIABLE);
+      $$->set_variable.name  = $2;
+      $$->set_variable.value = Value($4);
+      free($2);
+      free($4);
+    }
+    ;
+
+kill_query_stmt:
+    ID ID NUMBER
+    {
+      // KILL 和 QUERY 不是保留字，按标识符解析，避免影响同名的表和列
+      if (0 != strcasecmp($1, "KILL") || 0 != strcasecmp($2, "QUERY")) {
+        free($1);
+        free($2);
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error");
+        YYERROR;
+      }
+      free($1);
+      free($2);
+      $$ = new ParsedSqlNode(SCF_KILL_QUERY);
+      $$->kill_query.session_id = $3;
+    }
     ;
 
 opt_semicolon: /*empty*/
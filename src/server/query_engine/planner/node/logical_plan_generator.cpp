@@ -283,7 +283,7 @@ RC LogicalPlanGenerator::plan_node(
     return rc;
   }
 
-  logical_node = unique_ptr<LogicalNode>(new ExplainLogicalNode);
+  logical_node = unique_ptr<LogicalNode>(new ExplainLogicalNode(explain_stmt->analyze()));
   logical_node->add_child(std::move(child_node));
   return rc;
 }
\ No newline at end of file
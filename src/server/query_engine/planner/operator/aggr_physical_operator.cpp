@@ -1,6 +1,7 @@
 #include "common/log/log.h"
 #include "include/query_engine/planner/operator/aggr_physical_operator.h"
 #include "include/storage_engine/recorder/table.h"
+#include "include/session/session.h"
 
 RC AggrPhysicalOperator::open(Trx *trx)
 {
@@ -30,6 +31,11 @@ RC AggrPhysicalOperator::next()
   PhysicalOperator *child = children_[0].get();
   bool aggr_flag = false;
   while (RC::SUCCESS == (rc = child->next())) {
+    rc = Session::check_interrupt();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
     aggr_flag = true;
     Tuple *tuple = child->current_tuple();
     if (nullptr == tuple) {
@@ -4,6 +4,23 @@
 #include "include/storage_engine/recorder/record.h"
 #include "include/query_engine/analyzer/statement/delete_stmt.h"
 #include "include/query_engine/structor/tuple/row_tuple.h"
+#include "include/session/session.h"
+
+/**
+ * @brief 算子树中是否有索引扫描
+ */
+static bool has_index_scan(PhysicalOperator *oper)
+{
+  if (oper->type() == PhysicalOperatorType::INDEX_SCAN) {
+    return true;
+  }
+  for (auto &child : oper->children()) {
+    if (has_index_scan(child.get())) {
+      return true;
+    }
+  }
+  return false;
+}
 
 RC DeletePhysicalOperator::open(Trx *trx)
 {
@@ -19,6 +36,7 @@ RC DeletePhysicalOperator::open(Trx *trx)
   }
 
   trx_ = trx;
+  scan_index_ = has_index_scan(child.get());
 
   return RC::SUCCESS;
 }
@@ -32,24 +50,68 @@ RC DeletePhysicalOperator::next()
 
   PhysicalOperator *child = children_[0].get();
   while (RC::SUCCESS == (rc = child->next())) {
+    rc = Session::check_interrupt();
+    if (rc != RC::SUCCESS) {
+      records_.clear();
+      return rc;
+    }
+
     Tuple *tuple = child->current_tuple();
     if (nullptr == tuple) {
       LOG_WARN("failed to get current record: %s", strrc(rc));
+      records_.clear();
       return rc;
     }
 
+    // 扫描出来的记录指向页面中的数据，需要复制一份
     RowTuple *row_tuple = static_cast<RowTuple *>(tuple);
     Record &record = row_tuple->record();
-    rc = trx_->delete_record(table_, record);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to delete record: %s", strrc(rc));
-      return rc;
+    char *data = static_cast<char *>(malloc(record.len()));
+    if (data == nullptr) {
+      LOG_WARN("failed to allocate memory for record. size=%d", record.len());
+      records_.clear();
+      return RC::NOMEM;
+    }
+    memcpy(data, record.data(), record.len());
+    records_.emplace_back();
+    records_.back().set_rid(record.rid());
+    records_.back().set_data_owner(data, record.len());
+
+    if (!scan_index_ && records_.size() >= BATCH_SIZE) {
+      rc = flush_records();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
     }
   }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next record from child: %s", strrc(rc));
+    records_.clear();
+    return rc;
+  }
+
+  rc = flush_records();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
 
   return RC::RECORD_EOF;
 }
 
+RC DeletePhysicalOperator::flush_records()
+{
+  if (records_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = trx_->delete_records(table_, records_);
+  records_.clear();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to delete records: %s", strrc(rc));
+  }
+  return rc;
+}
+
 RC DeletePhysicalOperator::close()
 {
   if (!children_.empty()) {
@@ -1,5 +1,6 @@
 #include <sstream>
 #include "include/query_engine/planner/operator/explain_physical_operator.h"
+#include "include/query_engine/planner/operator/instrumented_physical_operator.h"
 #include "common/log/log.h"
 
 using namespace std;
@@ -7,6 +8,10 @@ using namespace std;
 RC ExplainPhysicalOperator::open(Trx *trx)
 {
   ASSERT(children_.size() == 1, "explain must has 1 child");
+  if (analyze_) {
+    start_time_ = std::chrono::steady_clock::now();
+    InstrumentedPhysicalOperator::instrument(children_[0]);
+  }
   return children_[0]->open(trx);
 }
 
@@ -24,6 +29,14 @@ RC ExplainPhysicalOperator::next()
     return RC::RECORD_EOF;
   }
 
+  int64_t elapsed_ns = 0;
+  if (analyze_) {
+    RC rc = execute_child(elapsed_ns);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
   stringstream ss;
   ss << "OPERATOR(NAME)\n";
 
@@ -37,6 +50,11 @@ RC ExplainPhysicalOperator::next()
   if (children_size > 0) {
     to_string(ss, children_[children_size - 1].get(), level, true /*last_child*/, ends);
   }
+  if (analyze_) {
+    ss.setf(std::ios::fixed);
+    ss.precision(3);
+    ss << "Execution Time: " << elapsed_ns / 1000000.0 << "ms\n";
+  }
 
   physical_plan_ = ss.str();
 
@@ -48,11 +66,35 @@ RC ExplainPhysicalOperator::next()
   return RC::SUCCESS;
 }
 
+RC ExplainPhysicalOperator::execute_child(int64_t &elapsed_ns)
+{
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = children_[0]->next())) {
+  }
+  elapsed_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time_).count();
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to execute explain analyze's child. rc=%s", strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
 Tuple *ExplainPhysicalOperator::current_tuple()
 {
   return &tuple_;
 }
 
+std::string ExplainPhysicalOperator::plan_to_string(PhysicalOperator *oper)
+{
+  stringstream ss;
+  std::vector<bool> ends;
+  ends.push_back(true);
+  to_string(ss, oper, 0 /*level*/, true /*last_child*/, ends);
+  return ss.str();
+}
+
 void ExplainPhysicalOperator::to_string(
     std::ostream &os, PhysicalOperator *oper, int level, bool last_child, std::vector<bool> &ends)
 {
@@ -72,11 +114,27 @@ void ExplainPhysicalOperator::to_string(
     }
   }
 
+  // EXPLAIN ANALYZE 时每个算子都被包装了一层，输出被包装的算子以及它的运行统计
+  auto *instrumented = dynamic_cast<InstrumentedPhysicalOperator *>(oper);
+  if (instrumented != nullptr) {
+    oper = instrumented->target();
+  }
+
   os << oper->name();
   std::string param = oper->param();
   if (!param.empty()) {
     os << "(" << param << ")";
   }
+  if (instrumented != nullptr) {
+    os << " [" << instrumented->stats().to_string();
+    if (oper->peak_memory() > 0) {
+      os << " peak_mem=" << oper->peak_memory() << "B";
+    }
+    if (oper->spilled_bytes() > 0) {
+      os << " spilled=" << oper->spilled_bytes() << "B";
+    }
+    os << "]";
+  }
   os << '\n';
 
   if (static_cast<int>(ends.size()) < level + 2) {
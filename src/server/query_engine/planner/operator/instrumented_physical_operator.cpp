@@ -0,0 +1,116 @@
+#include <chrono>
+#include <sstream>
+#include <time.h>
+
+#include "include/query_engine/planner/operator/instrumented_physical_operator.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/common/query_trace.h"
+
+static int64_t thread_cpu_time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000L + ts.tv_nsec;
+}
+
+/**
+ * @brief 在构造和析构之间统计时间和buffer pool访问，累加到算子的统计上
+ */
+class InstrumentedPhysicalOperator::StatGuard
+{
+public:
+  explicit StatGuard(OperatorRuntimeStats &stats)
+      : stats_(stats),
+        wall_start_(std::chrono::steady_clock::now()),
+        cpu_start_(thread_cpu_time_ns()),
+        bp_start_(BufferPoolStat::thread_local_stat())
+  {}
+
+  ~StatGuard()
+  {
+    const BufferPoolStat &bp_end = BufferPoolStat::thread_local_stat();
+    stats_.page_hits += bp_end.hits - bp_start_.hits;
+    stats_.page_misses += bp_end.misses - bp_start_.misses;
+    stats_.page_reads += bp_end.reads - bp_start_.reads;
+    stats_.cpu_ns += thread_cpu_time_ns() - cpu_start_;
+    stats_.wall_ns +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall_start_).count();
+  }
+
+private:
+  OperatorRuntimeStats &stats_;
+  std::chrono::steady_clock::time_point wall_start_;
+  int64_t cpu_start_;
+  BufferPoolStat bp_start_;
+};
+
+std::string OperatorRuntimeStats::to_string() const
+{
+  std::stringstream ss;
+  ss.setf(std::ios::fixed);
+  ss.precision(3);
+  ss << "rows=" << rows << " next=" << next_calls << " time=" << wall_ns / 1000000.0 << "ms"
+     << " cpu=" << cpu_ns / 1000000.0 << "ms"
+     << " pages(hit=" << page_hits << " miss=" << page_misses << " read=" << page_reads << ")";
+  return ss.str();
+}
+
+InstrumentedPhysicalOperator::InstrumentedPhysicalOperator(std::unique_ptr<PhysicalOperator> oper)
+{
+  add_child(std::move(oper));
+}
+
+void InstrumentedPhysicalOperator::instrument(std::unique_ptr<PhysicalOperator> &oper)
+{
+  for (std::unique_ptr<PhysicalOperator> &child : oper->children()) {
+    instrument(child);
+  }
+  oper = std::make_unique<InstrumentedPhysicalOperator>(std::move(oper));
+}
+
+std::string InstrumentedPhysicalOperator::trace_name(const char *action)
+{
+  if (trace_label_.empty()) {
+    trace_label_ = target()->name();
+    const std::string param = target()->param();
+    if (!param.empty()) {
+      trace_label_.append("(").append(param).append(")");
+    }
+  }
+  return trace_label_ + " " + action;
+}
+
+RC InstrumentedPhysicalOperator::open(Trx *trx)
+{
+  TraceSpan span("operator", "open");
+  if (span.active()) {
+    span.set_name(trace_name("open"));
+  }
+  StatGuard guard(stats_);
+  return target()->open(trx);
+}
+
+RC InstrumentedPhysicalOperator::next()
+{
+  TraceSpan span("operator", "next");
+  if (span.active()) {
+    span.set_name(trace_name("next"));
+  }
+  StatGuard guard(stats_);
+  stats_.next_calls++;
+  RC rc = target()->next();
+  if (rc == RC::SUCCESS) {
+    stats_.rows++;
+  }
+  return rc;
+}
+
+RC InstrumentedPhysicalOperator::close()
+{
+  TraceSpan span("operator", "close");
+  if (span.active()) {
+    span.set_name(trace_name("close"));
+  }
+  StatGuard guard(stats_);
+  return target()->close();
+}
@@ -1,10 +1,210 @@
 #include "common/log/log.h"
 #include "include/query_engine/planner/operator/order_physical_operator.h"
-#include "include/storage_engine/recorder/record.h"
+#include "include/query_engine/executor/admission_controller.h"
 #include "include/query_engine/analyzer/statement/filter_stmt.h"
+#include "include/session/session.h"
+#include "include/session/session_request.h"
 #include "include/storage_engine/recorder/field.h"
+
+#include <algorithm>
+#include <cstdio>
+
+/**
+ * @brief 溢出到磁盘的一个有序段
+ * @details 每一行依次写入排序键和记录，整数按照本机字节序存储，临时文件关闭时自动删除。
+ * 归并时每个有序段只在内存中保留当前的一行。
+ */
+class OrderPhysicalOperator::SortRun
+{
+public:
+  explicit SortRun(int level) : level_(level) {}
+  ~SortRun()
+  {
+    if (file_ != nullptr) {
+      fclose(file_);
+    }
+  }
+
+  RC init()
+  {
+    file_ = tmpfile();
+    if (file_ == nullptr) {
+      LOG_WARN("failed to create temporary file for sort. err=%s", strerror(errno));
+      return RC::IOERR_OPEN;
+    }
+    return RC::SUCCESS;
+  }
+
+  RC write(const SortRow &row)
+  {
+    buffer_.clear();
+    put_int((int)row.keys.size());
+    for (const Value &value : row.keys) {
+      put_int(value.attr_type());
+      switch (value.attr_type()) {
+        case CHARS:
+        case TEXTS: {
+          put_int(value.length());
+          buffer_.append(value.data(), value.length());
+        } break;
+        case BOOLEANS: {
+          put_int(value.get_boolean() ? 1 : 0);
+        } break;
+        case INTS:
+        case FLOATS:
+        case DATES: {
+          buffer_.append(value.data(), sizeof(int));
+        } break;
+        default: {
+        } break;
+      }
+    }
+
+    put_int((int)row.records.size());
+    for (const Record &record : row.records) {
+      put_int(record.rid().page_num);
+      put_int(record.rid().slot_num);
+      put_int(record.len());
+      buffer_.append(record.data(), record.len());
+    }
+
+    if (fwrite(buffer_.data(), buffer_.size(), 1, file_) != 1) {
+      LOG_WARN("failed to write sort run. err=%s", strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    size_ += buffer_.size();
+    return RC::SUCCESS;
+  }
+
+  /**
+   * @brief 写完之后调用，之后就可以从头开始读取
+   */
+  RC finish()
+  {
+    if (fflush(file_) != 0 || fseek(file_, 0, SEEK_SET) != 0) {
+      LOG_WARN("failed to rewind sort run. err=%s", strerror(errno));
+      return RC::IOERR_SEEK;
+    }
+    return RC::SUCCESS;
+  }
+
+  /**
+   * @brief 读取下一行到current
+   * @return 读完了返回 RECORD_EOF
+   */
+  RC read_next()
+  {
+    int key_num = 0;
+    if (fread(&key_num, sizeof(key_num), 1, file_) != 1) {
+      return feof(file_) ? RC::RECORD_EOF : RC::IOERR_READ;
+    }
+
+    current.keys.clear();
+    current.records.clear();
+    RC rc = RC::SUCCESS;
+    for (int i = 0; i < key_num && RC_SUCC(rc); i++) {
+      int type = 0;
+      int len = 0;
+      rc = get_int(type);
+      if (RC_FAIL(rc)) {
+        break;
+      }
+
+      Value value(static_cast<AttrType>(type));
+      switch (type) {
+        case CHARS:
+        case TEXTS: {
+          rc = get_int(len);
+          if (RC_SUCC(rc)) {
+            rc = get_bytes(len);
+          }
+          if (RC_SUCC(rc)) {
+            value.set_data(buffer_.data(), len);
+          }
+        } break;
+        case BOOLEANS:
+        case INTS:
+        case FLOATS:
+        case DATES: {
+          rc = get_bytes(sizeof(int));
+          if (RC_SUCC(rc)) {
+            value.set_data(buffer_.data(), sizeof(int));
+          }
+        } break;
+        default: {
+        } break;
+      }
+      current.keys.emplace_back(std::move(value));
+    }
+
+    int record_num = 0;
+    if (RC_SUCC(rc)) {
+      rc = get_int(record_num);
+    }
+    for (int i = 0; i < record_num && RC_SUCC(rc); i++) {
+      int page_num = 0;
+      int slot_num = 0;
+      int len = 0;
+      if (RC_FAIL(rc = get_int(page_num)) || RC_FAIL(rc = get_int(slot_num)) || RC_FAIL(rc = get_int(len)) ||
+          RC_FAIL(rc = get_bytes(len))) {
+        break;
+      }
+
+      char *data = (char *)malloc(len);
+      if (data == nullptr) {
+        rc = RC::NOMEM;
+        break;
+      }
+      memcpy(data, buffer_.data(), len);
+      Record &record = current.records.emplace_back();
+      record.set_data_owner(data, len);
+      record.set_rid(page_num, slot_num);
+    }
+
+    if (RC_FAIL(rc)) {
+      LOG_WARN("failed to read sort run. rc=%s", strrc(rc));
+    }
+    return rc;
+  }
+
+  size_t size() const { return size_; }
+  int level() const { return level_; }
+
+public:
+  SortRow current;  ///< 归并时当前的一行
+
+private:
+  void put_int(int v) { buffer_.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+
+  RC get_int(int &v)
+  {
+    return fread(&v, sizeof(v), 1, file_) == 1 ? RC::SUCCESS : RC::IOERR_READ;
+  }
+
+  RC get_bytes(int len)
+  {
+    buffer_.resize(len);
+    if (len > 0 && fread(buffer_.data(), len, 1, file_) != 1) {
+      return RC::IOERR_READ;
+    }
+    return RC::SUCCESS;
+  }
+
+private:
+  FILE *file_ = nullptr;
+  std::string buffer_;
+  size_t size_ = 0;
+  int level_ = 0;  ///< 直接由内存中的数据生成的是0，由若干个第n层的有序段归并生成的是n+1
+};
+
 OrderPhysicalOperator::OrderPhysicalOperator(std::vector<OrderByUnit *> order_units) : order_units_(std::move(order_units))
-{}
+{
+  for (const OrderByUnit *unit : order_units_) {
+    is_asc_.push_back(unit->sort_type());
+  }
+}
+
+OrderPhysicalOperator::~OrderPhysicalOperator() = default;
 
 RC OrderPhysicalOperator::open(Trx *trx)
 {
@@ -13,6 +213,10 @@ RC OrderPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
+  Session *session = Session::current_session();
+  if (session != nullptr && session->current_request() != nullptr) {
+    reservation_ = session->current_request()->memory_reservation();
+  }
   return children_[0]->open(trx);
 }
 
@@ -27,16 +231,43 @@ RC OrderPhysicalOperator::next()
     }
   }
 
-  if (it_ != st_idx_.end()) {
-    children_[0]->current_tuple()->set_record(st_[*it_]);
-    it_ ++;
-    return RC::SUCCESS;
+  SortRow *row = nullptr;
+  if (runs_.empty()) {
+    if (next_row_ >= rows_.size()) {
+      return RC::RECORD_EOF;
+    }
+    row = &rows_[next_row_++];
+  } else {
+    // 归并需要读临时文件，同样要能被中断
+    rc = Session::check_interrupt();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    rc = next_merged(row);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
   }
-  return RC::RECORD_EOF;
+
+  current_records_.clear();
+  for (Record &record : row->records) {
+    current_records_.push_back(&record);
+  }
+  children_[0]->current_tuple()->set_record(current_records_);
+  return RC::SUCCESS;
 }
 
 RC OrderPhysicalOperator::close()
 {
+  rows_.clear();
+  runs_.clear();
+  merge_heap_.clear();
+  if (reservation_ != nullptr) {
+    reservation_->release(reserved_memory_);
+    reservation_ = nullptr;
+  }
+  rows_memory_ = 0;
+  reserved_memory_ = 0;
   children_[0]->close();
   return RC::SUCCESS;
 }
@@ -46,67 +277,280 @@ Tuple *OrderPhysicalOperator::current_tuple()
   return children_[0]->current_tuple();
 }
 
-RC OrderPhysicalOperator::sort_table() {
-  RC rc = RC::SUCCESS;
+bool OrderPhysicalOperator::less(const SortRow &a, const SortRow &b) const
+{
+  auto &cells_a = a.keys;
+  auto &cells_b = b.keys;
+  assert(cells_a.size() == cells_b.size());
+  for (size_t i = 0; i < cells_a.size(); i++) {
+    auto &cell_a = cells_a[i];
+    auto &cell_b = cells_b[i];
+    if (cell_a.is_null() && cell_b.is_null()) {
+      continue;
+    }
+    if (cell_a.is_null()) {
+      return is_asc_[i];
+    }
+    if (cell_b.is_null()) {
+      return !is_asc_[i];
+    }
+    int cmp = cell_a.compare(cell_b);
+    if (cmp != 0) {
+      return is_asc_[i] ? cmp < 0 : cmp > 0;
+    }
+  }
+  return false;  // completely same
+}
+
+size_t OrderPhysicalOperator::row_memory(const SortRow &row)
+{
+  size_t size = sizeof(SortRow);
+  for (const Value &value : row.keys) {
+    size += sizeof(Value);
+    if (value.attr_type() == CHARS || value.attr_type() == TEXTS) {
+      size += value.length();
+    }
+  }
+  for (const Record &record : row.records) {
+    size += sizeof(Record) + record.len();
+  }
+  return size;
+}
 
-  std::vector<std::pair<std::vector<Value>, int>> tuple_table;
-  std::vector<Value> tuple_values;
+RC OrderPhysicalOperator::sort_table()
+{
+  RC rc = RC::SUCCESS;
 
-  int index = 0;
+  std::vector<Record *> records;
   while (RC::SUCCESS == (rc = children_[0]->next())) {
-    tuple_values.clear();
+    rc = Session::check_interrupt();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    Tuple *tuple = children_[0]->current_tuple();
+    SortRow row;
     for (const OrderByUnit *unit : order_units_) {
-      Expression *expr = unit->expr();
       Value value;
-      expr->get_value(*children_[0]->current_tuple(), value);
-      tuple_values.emplace_back(value);
+      rc = unit->expr()->get_value(*tuple, value);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to get value of order by expression. rc=%s", strrc(rc));
+        return rc;
+      }
+      row.keys.emplace_back(std::move(value));
     }
-    tuple_table.emplace_back(tuple_values, index ++);
-    std::vector<Record *> records;
-    children_[0]->current_tuple()->get_record(records);
-    for (auto &rcd_ptr : records) {
-      rcd_ptr = new Record(*rcd_ptr);
+
+    // 子算子返回的记录指向缓冲池中的页面，需要复制出来
+    records.clear();
+    tuple->get_record(records);
+    for (Record *rcd_ptr : records) {
+      char *data = (char *)malloc(rcd_ptr->len());
+      if (data == nullptr) {
+        return RC::NOMEM;
+      }
+      memcpy(data, rcd_ptr->data(), rcd_ptr->len());
+      Record &record = row.records.emplace_back();
+      record.set_data_owner(data, rcd_ptr->len());
+      record.set_rid(rcd_ptr->rid());
     }
-    st_.emplace_back(records);
+
+    const size_t memory = row_memory(row);
+    if (reservation_ != nullptr) {
+      if (reservation_->reserve(memory)) {
+        reserved_memory_ += memory;
+      } else if (rows_memory_ >= min_run_memory()) {
+        // 预留的内存用完了，把已经缓存的数据写到磁盘，然后重新申请
+        rc = spill();
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+        if (reservation_->reserve(memory)) {
+          reserved_memory_ += memory;
+        }
+      }
+      // 申请不到内存时也先缓存在内存中，直到攒够一个有序段，否则预算很紧张时每一行都会变成一个有序段
+    }
+
+    rows_.emplace_back(std::move(row));
+    rows_memory_ += memory;
+    peak_memory_ = std::max(peak_memory_, rows_memory_);
   }
   if (RC::RECORD_EOF != rc) {
     LOG_ERROR("Fetch Table Error In SortOperator. RC: %d", rc);
     return rc;
   }
 
-  bool is_asc[order_units_.size()];
-  for (int i = 0; i < order_units_.size(); ++i) {
-    is_asc[i] = order_units_[i]->sort_type();
+  if (runs_.empty()) {
+    std::stable_sort(rows_.begin(), rows_.end(), [this](const SortRow &a, const SortRow &b) { return less(a, b); });
+    next_row_ = 0;
+    return RC::SUCCESS;
   }
 
-  auto cmp = [&is_asc](const std::pair<std::vector<Value>, int> &a, const std::pair<std::vector<Value>, int> &b) {
-    auto &cells_a = a.first;
-    auto &cells_b = b.first;
-    assert(cells_a.size() == cells_b.size());
-    for (int i = 0; i < cells_a.size(); i ++) {
-      auto &cell_a = cells_a[i];
-      auto &cell_b = cells_b[i];
-      if (cell_a.is_null() && cell_b.is_null()) {
-        continue;
-      }
-      if (cell_a.is_null()) {
-        return is_asc[i];
-      }
-      if (cell_b.is_null()) {
-        return !is_asc[i];
-      }
-      int cmp = cell_a.compare(cell_b);
-      if (cmp != 0) {
-        return is_asc[i] ? cmp < 0: cmp > 0;
-      }
+  if (!rows_.empty()) {
+    rc = spill();
+    if (rc != RC::SUCCESS) {
+      return rc;
     }
-    return false;  // completely same
-  };
-  std::sort(tuple_table.begin(), tuple_table.end(), cmp);
+  }
 
-  for (auto & i : tuple_table) {
-    st_idx_.emplace_back(i.second);
+  LOG_INFO("sort spilled to disk. runs=%d, bytes=%zu", (int)runs_.size(), spilled_bytes_);
+  for (int i = 0; i < static_cast<int>(runs_.size()); i++) {
+    rc = runs_[i]->read_next();
+    if (rc == RC::SUCCESS) {
+      merge_heap_.push_back(i);
+    } else if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+  std::make_heap(merge_heap_.begin(), merge_heap_.end(), [this](int a, int b) { return run_greater(a, b); });
+  last_run_ = -1;
+  return RC::SUCCESS;
+}
+
+RC OrderPhysicalOperator::spill()
+{
+  std::stable_sort(rows_.begin(), rows_.end(), [this](const SortRow &a, const SortRow &b) { return less(a, b); });
+
+  auto run = std::make_unique<SortRun>(0);
+  RC rc = run->init();
+  for (size_t i = 0; i < rows_.size() && RC_SUCC(rc); i++) {
+    rc = run->write(rows_[i]);
+  }
+  if (RC_SUCC(rc)) {
+    rc = run->finish();
+  }
+  if (RC_FAIL(rc)) {
+    return rc;
+  }
+
+  spilled_bytes_ += run->size();
+  runs_.emplace_back(std::move(run));
+  rows_.clear();
+  if (reservation_ != nullptr) {
+    reservation_->release(reserved_memory_);
   }
-  it_ = st_idx_.begin();
+  rows_memory_ = 0;
+  reserved_memory_ = 0;
+  return compact_runs();
+}
+
+RC OrderPhysicalOperator::compact_runs()
+{
+  // 最后的MERGE_WAYS个有序段在同一层时归并成上一层的一个有序段，每一行最多被重写log(有序段个数)次。
+  // 同时打开的有序段不超过 MAX_OPEN_RUNS，每个有序段都占用一个文件描述符
+  while (runs_.size() >= static_cast<size_t>(MERGE_WAYS)) {
+    const size_t first = runs_.size() - MERGE_WAYS;
+    const int level = runs_[first]->level();
+    const bool same_level = std::all_of(runs_.begin() + first, runs_.end(),
+        [level](const std::unique_ptr<SortRun> &run) { return run->level() == level; });
+    if (!same_level && runs_.size() < static_cast<size_t>(MAX_OPEN_RUNS)) {
+      break;
+    }
+
+    RC rc = merge_runs(first);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC OrderPhysicalOperator::merge_runs(size_t first)
+{
+  // 归并的是相邻的有序段，结果放在原来的位置，排序键相同的行仍然保持输入的顺序
+  auto greater = [this](int a, int b) { return run_greater(a, b); };
+  std::vector<int> heap;
+  int level = 0;
+  RC rc = RC::SUCCESS;
+  for (size_t i = first; i < runs_.size(); i++) {
+    level = std::max(level, runs_[i]->level() + 1);
+    rc = runs_[i]->read_next();
+    if (rc == RC::SUCCESS) {
+      heap.push_back(static_cast<int>(i));
+    } else if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+  std::make_heap(heap.begin(), heap.end(), greater);
+
+  auto merged = std::make_unique<SortRun>(level);
+  rc = merged->init();
+  while (RC_SUCC(rc) && !heap.empty()) {
+    rc = Session::check_interrupt();
+    if (RC_FAIL(rc)) {
+      break;
+    }
+
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    const int run = heap.back();
+    heap.pop_back();
+    rc = merged->write(runs_[run]->current);
+    if (RC_FAIL(rc)) {
+      break;
+    }
+
+    rc = runs_[run]->read_next();
+    if (rc == RC::SUCCESS) {
+      heap.push_back(run);
+      std::push_heap(heap.begin(), heap.end(), greater);
+    } else if (rc == RC::RECORD_EOF) {
+      rc = RC::SUCCESS;
+    }
+  }
+  if (RC_SUCC(rc)) {
+    rc = merged->finish();
+  }
+  if (RC_FAIL(rc)) {
+    return rc;
+  }
+
+  spilled_bytes_ += merged->size();
+  runs_.resize(first);
+  runs_.emplace_back(std::move(merged));
+  return RC::SUCCESS;
+}
+
+size_t OrderPhysicalOperator::min_run_memory() const
+{
+  // 不小于已经申请到的内存，单个查询的内存上限很小时以上限为准
+  return std::max(std::min(MIN_RUN_MEMORY, reservation_->limit()), reservation_->granted());
+}
+
+bool OrderPhysicalOperator::run_greater(int a, int b) const
+{
+  // 堆顶是最小的行，排序键相同时先输出前面的有序段，这样和全部在内存中排序的结果一致
+  if (less(runs_[b]->current, runs_[a]->current)) {
+    return true;
+  }
+  if (less(runs_[a]->current, runs_[b]->current)) {
+    return false;
+  }
+  return a > b;
+}
+
+RC OrderPhysicalOperator::next_merged(SortRow *&row)
+{
+  auto greater = [this](int a, int b) { return run_greater(a, b); };
+
+  // 上一次输出的行还在被上层算子使用，直到这次调用才读取它所在有序段的下一行
+  if (last_run_ >= 0) {
+    RC rc = runs_[last_run_]->read_next();
+    if (rc == RC::SUCCESS) {
+      merge_heap_.push_back(last_run_);
+      std::push_heap(merge_heap_.begin(), merge_heap_.end(), greater);
+    } else if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+    last_run_ = -1;
+  }
+
+  if (merge_heap_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  std::pop_heap(merge_heap_.begin(), merge_heap_.end(), greater);
+  last_run_ = merge_heap_.back();
+  merge_heap_.pop_back();
+  row = &runs_[last_run_]->current;
   return RC::SUCCESS;
 }
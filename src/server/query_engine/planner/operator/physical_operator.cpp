@@ -5,6 +5,8 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
   switch (type) {
     case PhysicalOperatorType::TABLE_SCAN:
       return "TABLE_SCAN";
+    case PhysicalOperatorType::SYSTEM_TABLE_SCAN:
+      return "SYSTEM_TABLE_SCAN";
     case PhysicalOperatorType::INDEX_SCAN:
       return "INDEX_SCAN";
     case PhysicalOperatorType::JOIN:
@@ -6,6 +6,7 @@
 #include "include/query_engine/planner/operator/physical_operator.h"
 #include "include/query_engine/planner/node/table_get_logical_node.h"
 #include "include/query_engine/planner/operator/table_scan_physical_operator.h"
+#include "include/query_engine/planner/operator/system_table_scan_physical_operator.h"
 #include "include/query_engine/planner/node/predicate_logical_node.h"
 #include "include/query_engine/planner/operator/predicate_physical_operator.h"
 #include "include/query_engine/planner/node/order_by_logical_node.h"
@@ -29,15 +30,15 @@
 
 using namespace std;
 
-RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<PhysicalOperator> &oper)
 {
   switch (logical_operator.type()) {
     case LogicalNodeType::TABLE_GET: {
-      return create_plan(static_cast<TableGetLogicalNode &>(logical_operator), oper, is_delete);
+      return create_plan(static_cast<TableGetLogicalNode &>(logical_operator), oper);
     }
 
     case LogicalNodeType::PREDICATE: {
-      return create_plan(static_cast<PredicateLogicalNode &>(logical_operator), oper, is_delete);
+      return create_plan(static_cast<PredicateLogicalNode &>(logical_operator), oper);
     }
 
     case LogicalNodeType::ORDER: {
@@ -45,7 +46,7 @@ RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<P
     }
 
     case LogicalNodeType::PROJECTION: {
-      return create_plan(static_cast<ProjectLogicalNode &>(logical_operator), oper, is_delete);
+      return create_plan(static_cast<ProjectLogicalNode &>(logical_operator), oper);
     }
 
     case LogicalNodeType::AGGR: {
@@ -65,7 +66,7 @@ RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<P
     }
 
     case LogicalNodeType::EXPLAIN: {
-      return create_plan(static_cast<ExplainLogicalNode &>(logical_operator), oper, is_delete);
+      return create_plan(static_cast<ExplainLogicalNode &>(logical_operator), oper);
     }
     // TODO [Lab3] 实现JoinNode到JoinOperator的转换
     case LogicalNodeType::JOIN:
@@ -83,9 +84,17 @@ RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<P
 // 在原有的实现中，会直接生成TableScanOperator对所需的数据进行全表扫描，但其实在生成执行计划时，我们可以进行简单的优化：
 // 首先检查扫描的table是否存在索引，如果存在可以使用的索引，那么我们可以直接生成IndexScanOperator来减少磁盘的扫描
 RC PhysicalOperatorGenerator::create_plan(
-    TableGetLogicalNode &table_get_oper, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+    TableGetLogicalNode &table_get_oper, unique_ptr<PhysicalOperator> &oper)
 {
   vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
+  if (table_get_oper.table()->is_system_table()) {
+    auto system_table_scan_oper = new SystemTableScanPhysicalOperator(table_get_oper.table(), table_get_oper.table_alias());
+    system_table_scan_oper->set_predicates(std::move(predicates));
+    oper = unique_ptr<PhysicalOperator>(system_table_scan_oper);
+    LOG_TRACE("use system table scan");
+    return RC::SUCCESS;
+  }
+
   Index *index = nullptr;
   // TODO [Lab2] 生成IndexScanOperator的准备工作,主要包含:
   // 1. 通过predicates获取具体的值表达式， 目前应该只支持等值表达式的索引查找
@@ -101,7 +110,6 @@ RC PhysicalOperatorGenerator::create_plan(
   if(index == nullptr){
     Table *table = table_get_oper.table();
     auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.table_alias(), table_get_oper.readonly());
-    table_scan_oper->isdelete_ = is_delete;
     table_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(table_scan_oper);
     LOG_TRACE("use table scan");
@@ -118,7 +126,7 @@ RC PhysicalOperatorGenerator::create_plan(
 }
 
 RC PhysicalOperatorGenerator::create_plan(
-    PredicateLogicalNode &pred_oper, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+    PredicateLogicalNode &pred_oper, unique_ptr<PhysicalOperator> &oper)
 {
   vector<unique_ptr<LogicalNode>> &children_opers = pred_oper.children();
   ASSERT(children_opers.size() == 1, "predicate logical operator's sub oper number should be 1");
@@ -126,7 +134,7 @@ RC PhysicalOperatorGenerator::create_plan(
   LogicalNode &child_oper = *children_opers.front();
 
   unique_ptr<PhysicalOperator> child_phy_oper;
-  RC rc = create(child_oper, child_phy_oper, is_delete);
+  RC rc = create(child_oper, child_phy_oper);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to create child operator of predicate operator. rc=%s", strrc(rc));
     return rc;
@@ -139,7 +147,6 @@ RC PhysicalOperatorGenerator::create_plan(
 
   oper = unique_ptr<PhysicalOperator>(new PredicatePhysicalOperator(std::move(expression)));
   oper->add_child(std::move(child_phy_oper));
-  oper->isdelete_ = is_delete;
   return rc;
 }
 
@@ -200,7 +207,7 @@ RC PhysicalOperatorGenerator::create_plan(OrderByLogicalNode &order_oper, unique
 }
 
 RC PhysicalOperatorGenerator::create_plan(
-    ProjectLogicalNode &project_oper, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+    ProjectLogicalNode &project_oper, unique_ptr<PhysicalOperator> &oper)
 {
   vector<unique_ptr<LogicalNode>> &child_opers = project_oper.children();
 
@@ -209,7 +216,7 @@ RC PhysicalOperatorGenerator::create_plan(
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalNode *child_oper = child_opers.front().get();
-    rc = create(*child_oper, child_phy_oper, is_delete);
+    rc = create(*child_oper, child_phy_oper);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create project logical operator's child physical operator. rc=%s", strrc(rc));
       return rc;
@@ -226,7 +233,6 @@ RC PhysicalOperatorGenerator::create_plan(
   }
 
   oper = unique_ptr<PhysicalOperator>(project_operator);
-  oper->isdelete_ = is_delete;
 
   LOG_TRACE("create a project physical operator");
   return rc;
@@ -254,7 +260,7 @@ RC PhysicalOperatorGenerator::create_plan(DeleteLogicalNode &delete_oper, unique
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalNode *child_oper = child_opers.front().get();
-    rc = create(*child_oper, child_physical_oper, true);
+    rc = create(*child_oper, child_physical_oper);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create physical operator. rc=%s", strrc(rc));
       return rc;
@@ -262,7 +268,6 @@ RC PhysicalOperatorGenerator::create_plan(DeleteLogicalNode &delete_oper, unique
   }
 
   oper = unique_ptr<PhysicalOperator>(new DeletePhysicalOperator(delete_oper.table()));
-  oper->isdelete_ = true;
   if (child_physical_oper) {
     oper->add_child(std::move(child_physical_oper));
   }
@@ -294,15 +299,15 @@ RC PhysicalOperatorGenerator::create_plan(UpdateLogicalNode &update_oper, unique
 }
 
 RC PhysicalOperatorGenerator::create_plan(
-    ExplainLogicalNode &explain_oper, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+    ExplainLogicalNode &explain_oper, unique_ptr<PhysicalOperator> &oper)
 {
   vector<unique_ptr<LogicalNode>> &child_opers = explain_oper.children();
 
   RC rc = RC::SUCCESS;
-  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator);
+  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator(explain_oper.analyze()));
   for (unique_ptr<LogicalNode> &child_oper : child_opers) {
     unique_ptr<PhysicalOperator> child_physical_oper;
-    rc = create(*child_oper, child_physical_oper, is_delete);
+    rc = create(*child_oper, child_physical_oper);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create child physical operator. rc=%s", strrc(rc));
       return rc;
@@ -312,7 +317,6 @@ RC PhysicalOperatorGenerator::create_plan(
   }
 
   oper = std::move(explain_physical_oper);
-  oper->isdelete_ = is_delete;
   return rc;
 }
 
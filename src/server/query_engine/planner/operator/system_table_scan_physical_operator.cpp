@@ -0,0 +1,114 @@
+#include "include/query_engine/planner/operator/system_table_scan_physical_operator.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/schema/system_table.h"
+#include "include/session/session.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+RC SystemTableScanPhysicalOperator::open(Trx *)
+{
+  Session *session = Session::current_session();
+  Db *db = session == nullptr ? nullptr : session->get_current_db();
+  if (db == nullptr) {
+    LOG_WARN("no current db to fill system table. table=%s", table_->name());
+    return RC::SCHEMA_DB_NOT_EXIST;
+  }
+
+  vector<vector<Value>> rows;
+  RC rc = table_->system_table()->fill_rows(db, rows);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to fill system table. table=%s, rc=%s", table_->name(), strrc(rc));
+    return rc;
+  }
+
+  records_.clear();
+  records_.reserve(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    Record record;
+    rc = table_->make_record(static_cast<int>(rows[i].size()), rows[i].data(), record);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to make record of system table. table=%s, rc=%s", table_->name(), strrc(rc));
+      return rc;
+    }
+    // 系统表的记录不在任何页面上，用行号作为RID
+    record.set_rid(0, static_cast<SlotNum>(i));
+    records_.push_back(std::move(record));
+  }
+
+  next_index_ = 0;
+  current_record_ = nullptr;
+  tuple_.set_schema(table_, table_alias_, table_->table_meta().field_metas());
+  return RC::SUCCESS;
+}
+
+RC SystemTableScanPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  bool filter_result = false;
+  while (next_index_ < records_.size()) {
+    rc = Session::check_interrupt();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    current_record_ = &records_[next_index_++];
+    tuple_._set_record(current_record_);
+    rc = filter(tuple_, filter_result);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    if (filter_result) {
+      return RC::SUCCESS;
+    }
+  }
+  return RC::RECORD_EOF;
+}
+
+RC SystemTableScanPhysicalOperator::close()
+{
+  records_.clear();
+  current_record_ = nullptr;
+  return RC::SUCCESS;
+}
+
+Tuple *SystemTableScanPhysicalOperator::current_tuple()
+{
+  if (tuple_.order_set()) {
+    tuple_.remove_order_set();
+    return &tuple_;
+  }
+  tuple_._set_record(current_record_);
+  return &tuple_;
+}
+
+string SystemTableScanPhysicalOperator::param() const
+{
+  return table_->name();
+}
+
+void SystemTableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&exprs)
+{
+  predicates_ = std::move(exprs);
+}
+
+RC SystemTableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
+{
+  RC rc = RC::SUCCESS;
+  Value value;
+  for (unique_ptr<Expression> &expr : predicates_) {
+    rc = expr->get_value(tuple, value);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    if (!value.get_boolean()) {
+      result = false;
+      return rc;
+    }
+  }
+
+  result = true;
+  return rc;
+}
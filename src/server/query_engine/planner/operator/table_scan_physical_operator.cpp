@@ -1,5 +1,6 @@
 #include "include/query_engine/planner/operator/table_scan_physical_operator.h"
 #include "include/storage_engine/recorder/table.h"
+#include "include/session/session.h"
 
 using namespace std;
 
@@ -22,6 +23,12 @@ RC TableScanPhysicalOperator::next()
   RC rc = RC::SUCCESS;
   bool filter_result = false;
   while (record_scanner_.has_next()) {
+    // 过滤条件很严格时可能扫描很多记录都不返回，需要在循环内检查语句是否超时或被取消
+    rc = Session::check_interrupt();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
     rc = record_scanner_.next(current_record_);
     if (rc != RC::SUCCESS) {
       return rc;
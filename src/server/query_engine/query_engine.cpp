@@ -4,10 +4,94 @@
 #include "include/query_engine/parser/parser.h"
 #include "include/query_engine/analyzer/analyzer.h"
 #include "include/session/communicator.h"
+#include "include/common/global_context.h"
+#include "include/query_engine/executor/query_cache.h"
+#include "include/query_engine/executor/admission_controller.h"
+#include "include/query_engine/analyzer/statement/select_stmt.h"
+#include "include/common/server_metrics.h"
+#include "include/query_engine/executor/slow_query_log.h"
+#include "include/query_engine/planner/operator/explain_physical_operator.h"
+#include "include/query_engine/planner/operator/instrumented_physical_operator.h"
+#include "include/storage_engine/recorder/record_manager.h"
+#include "include/common/query_trace.h"
+#include "common/lang/defer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 
+/**
+ * @brief 返回从begin到现在的纳秒数，并把begin设置为现在，用来统计连续的各个阶段的耗时
+ * @param phase 阶段的名字，开启了跟踪时记录为一个事件
+ */
+static int64_t lap_ns(std::chrono::steady_clock::time_point &begin, const char *phase)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - begin).count();
+  QueryTrace::complete("phase", phase, begin, now);
+  begin = now;
+  return ns;
+}
+
+/**
+ * @brief 语句结束时把跟踪的事件写到文件中
+ */
+static void finish_trace(QueryTrace *trace, Session *session)
+{
+  trace->detach();
+  std::string file_name;
+  RC rc = trace->dump(session->id(), file_name);
+  if (RC_SUCC(rc)) {
+    LOG_INFO("query trace written. session=%lu, file=%s, events=%lu, dropped=%lu",
+        static_cast<unsigned long>(session->id()), file_name.c_str(),
+        static_cast<unsigned long>(trace->event_count()), static_cast<unsigned long>(trace->dropped_count()));
+  }
+}
+
+/**
+ * @brief 结果集的编码格式，作为查询结果缓存键的一部分
+ * @details 缓存中保存的是发送给客户端的原始字节，只有协议和文本、二进制格式都相同的请求才能复用
+ */
+static std::string result_format(CommunicateProtocol protocol, bool binary_result)
+{
+  std::string format;
+  switch (protocol) {
+    case CommunicateProtocol::PLAIN: format = "plain"; break;
+    case CommunicateProtocol::CLI: format = "cli"; break;
+    case CommunicateProtocol::MYSQL: format = "mysql"; break;
+  }
+  format += binary_result ? ":binary" : ":text";
+  return format;
+}
+
+/**
+ * @brief 执行时间超过阈值时记录慢查询日志
+ */
+static void log_slow_query(SlowQueryLog *slow_query_log, SessionRequest *request, QueryInfo &query_info,
+    int64_t start_time_us, const BufferPoolStat &bp_start, uint64_t records_start)
+{
+  QueryProfile &profile = query_info.profile();
+  const BufferPoolStat &bp_end = BufferPoolStat::thread_local_stat();
+  profile.page_hits = bp_end.hits - bp_start.hits;
+  profile.page_misses = bp_end.misses - bp_start.misses;
+  profile.page_reads = bp_end.reads - bp_start.reads;
+  profile.rows_examined = RecordScanStat::thread_local_stat().records - records_start;
+  profile.rows_returned = request->sql_result()->rows_returned();
+
+  SlowQueryLog::Entry entry;
+  entry.start_time_us = start_time_us;
+  entry.session_id = request->session()->id();
+  entry.db_name = request->session()->get_current_db_name();
+  entry.sql = query_info.sql();
+  entry.rc = request->sql_result()->return_code();
+  entry.profile = profile;
+  PhysicalOperator *oper = request->sql_result()->retained_operator();
+  if (oper != nullptr) {
+    entry.plan = ExplainPhysicalOperator::plan_to_string(oper);
+  }
+  slow_query_log->record(std::move(entry));
+}
+
 // 处理从session传来的请求, 包含sql执行与结果写回
 bool QueryEngine::process_session_request(SessionRequest *request) {
   RC rc;
@@ -21,26 +105,152 @@ bool QueryEngine::process_session_request(SessionRequest *request) {
 
   Session::set_current_session(request->session());
   request->session()->set_current_request(request);
+  // 超时时间从语句开始处理时计算，包括在准入控制中排队的时间
+  request->session()->begin_query(sql);
+
+  // SET trace = on 的会话，每条语句的执行过程写到一个跟踪文件中
+  Session *session = request->session();
+  std::unique_ptr<QueryTrace> trace;
+  if (session->trace_on()) {
+    trace = std::make_unique<QueryTrace>();
+    trace->attach();
+  }
+  DEFER(([&trace, session]() {
+    if (trace != nullptr) {
+      finish_trace(trace.get(), session);
+    }
+  }));
+  TraceSpan query_span("query", "query");
+  if (query_span.active()) {
+    query_span.set_args("\"sql\":" + QueryTrace::json_string(sql));
+  }
 
   QueryInfo query_info(request, sql);
 
+  // 慢查询日志需要的统计，页面访问和遍历的记录数都是当前线程的累计值，取前后两次的差值
+  SlowQueryLog *slow_query_log = GCTX.slow_query_log_;
+  BufferPoolStat bp_start;
+  uint64_t records_start = 0;
+  int64_t start_time_us = 0;
+  if (slow_query_log != nullptr) {
+    bp_start = BufferPoolStat::thread_local_stat();
+    records_start = RecordScanStat::thread_local_stat().records;
+    start_time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+
   auto start_time = std::chrono::high_resolution_clock::now();
-  rc = planQuery(&query_info);
-  if(RC_FAIL(rc) && rc != RC::UNIMPLENMENT){
-    request->get_communicator()->write_state(request->sql_result(), need_disconnect);
-    request->get_communicator()->flush();
-    return need_disconnect;
-  }else{
+  Communicator *communicator = request->get_communicator();
+  QueryCache *query_cache = GCTX.query_cache_;
+  std::string cache_key;
+  std::string cached_result;
+  if (query_cache != nullptr) {
+    // 缓存的是编码之后的结果，不同协议或者文本、二进制格式的结果集不能共用
+    cache_key = QueryCache::make_key(request->session()->get_current_db_name(), sql,
+        result_format(communicator->protocol(), request->binary_result()));
+  }
+
+  const bool cache_hit =
+      !cache_key.empty() && query_cache->get(cache_key, request->session()->get_current_db(), cached_result);
+  if (cache_hit) {
+    // 命中查询缓存，直接把缓存的结果发给客户端
+    communicator->write_result(cached_result.data(), cached_result.size());
+    need_disconnect = false;
+  } else {
+    rc = planQuery(&query_info);
+    if(RC_FAIL(rc) && rc != RC::UNIMPLENMENT){
+      communicator->write_state(request->sql_result(), need_disconnect);
+      communicator->flush();
+      request->session()->end_query();
+      request->session()->set_current_request(nullptr);
+      Session::set_current_session(nullptr);
+      delete[] time_str;
+      return need_disconnect;
+    }
+
+    // 只缓存SELECT的结果，表的版本号要在执行之前获取，执行过程中表如果被修改，缓存项会被当做过期
+    bool cacheable = !cache_key.empty() && query_info.stmt() != nullptr
+                     && query_info.stmt()->type() == StmtType::SELECT;
+    if (cacheable) {
+      // 系统表的内容随时在变化，没有版本号，查询系统表的语句不缓存
+      const std::vector<Table *> &tables = static_cast<SelectStmt *>(query_info.stmt())->tables();
+      cacheable = std::none_of(tables.begin(), tables.end(), [](Table *table) { return table->is_system_table(); });
+    }
+    std::vector<std::pair<std::string, uint64_t>> table_versions;
+    std::string result_capture;
+    if (cacheable) {
+      auto *select_stmt = static_cast<SelectStmt *>(query_info.stmt());
+      QueryCache::collect_table_versions(select_stmt->tables(), request->session()->get_current_db(), table_versions);
+      communicator->set_result_capture(&result_capture);
+    }
+
+    // 准入控制，系统过载时排队或者直接拒绝，凭证在执行结束时释放
+    AdmissionTicket admission_ticket;
+    AdmissionController *admission_controller = GCTX.admission_controller_;
+    if (admission_controller != nullptr) {
+      QueryClass query_class = AdmissionController::classify(query_info.physical_operator().get());
+      auto admit_start = std::chrono::steady_clock::now();
+      rc = admission_controller->admit(query_class, admission_ticket);
+      QueryTrace::complete("wait", "admission", admit_start);
+      if (RC_FAIL(rc)) {
+        communicator->set_result_capture(nullptr);
+        request->sql_result()->set_return_code(rc);
+        request->sql_result()->set_state_string("server is busy, try again later");
+        communicator->write_state(request->sql_result(), need_disconnect);
+        communicator->flush();
+        request->session()->end_query();
+        request->session()->set_current_request(nullptr);
+        Session::set_current_session(nullptr);
+        delete[] time_str;
+        return need_disconnect;
+      }
+      request->set_memory_reservation(admission_ticket.memory_reservation());
+    }
+
+    // 统计每个算子的运行信息或者跟踪算子的执行时需要包装算子树。EXPLAIN ANALYZE 自己会包装算子
+    std::unique_ptr<PhysicalOperator> &physical_operator = query_info.physical_operator();
+    const bool operator_stats = slow_query_log != nullptr && slow_query_log->options().operator_stats;
+    if ((operator_stats || trace != nullptr) && physical_operator != nullptr
+        && physical_operator->type() != PhysicalOperatorType::EXPLAIN) {
+      InstrumentedPhysicalOperator::instrument(physical_operator);
+    }
+    if (slow_query_log != nullptr) {
+      // 执行结束之后才知道是不是慢查询，所以先保留执行计划
+      request->sql_result()->set_retain_operator(true);
+    }
+
     //执行引擎入口
-    executor_.execute(request, &query_info, need_disconnect);
+    auto execute_start = std::chrono::steady_clock::now();
+    rc = executor_.execute(request, &query_info, need_disconnect);
+    query_info.profile().execute_ns = lap_ns(execute_start, "execute");
+    request->set_memory_reservation(nullptr);
+
+    if (cacheable) {
+      communicator->set_result_capture(nullptr);
+      if (RC_SUCC(rc) && !need_disconnect && request->sql_result()->return_code() == RC::SUCCESS) {
+        query_cache->put(cache_key, std::move(table_versions), std::move(result_capture));
+      }
+    }
   }
   auto end_time = std::chrono::high_resolution_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
-  snprintf(time_str, 64, "Cost time: %ld ns\n", duration.count());
-  
-  request->get_communicator()->write_result(time_str, strlen(time_str));
-  request->get_communicator()->send_message_delimiter();
-  request->get_communicator()->flush();
+  if (cache_hit) {
+    ServerMetrics::instance().query_cached_latency_ms.update(duration.count() / 1000000.0);
+  } else if (query_info.stmt() != nullptr) {
+    ServerMetrics::instance().record_query(query_info.stmt()->type(), duration.count() / 1000000.0);
+  }
+  query_info.profile().total_ns = duration.count();
+  if (slow_query_log != nullptr && slow_query_log->is_slow(duration.count())) {
+    log_slow_query(slow_query_log, request, query_info, start_time_us, bp_start, records_start);
+  }
+  // 自己编码结果集的协议在结果中已经包含了结束标记
+  if (!communicator->encode_result_set()) {
+    snprintf(time_str, 64, "Cost time: %ld ns\n", duration.count());
+    communicator->write_result(time_str, strlen(time_str));
+    communicator->send_message_delimiter();
+  }
+  communicator->flush();
+  request->session()->end_query();
   request->session()->set_current_request(nullptr);
 
   Session::set_current_session(nullptr);
@@ -50,9 +260,12 @@ bool QueryEngine::process_session_request(SessionRequest *request) {
 
 // 查询的前端解析阶段，对输入的sql进行解析，并构建QueryInfo
 RC QueryEngine::planQuery(QueryInfo *query_info) {
+  QueryProfile &profile = query_info->profile();
+  auto phase_start = std::chrono::steady_clock::now();
 
   // 1. 语法解析：将sql转为语法树
   RC rc = Parser::parse(query_info);
+  profile.parse_ns = lap_ns(phase_start, "parse");
   if (RC_FAIL(rc)) {
     LOG_TRACE("failed to do parse. rc=%s", strrc(rc));
     return rc;
@@ -60,6 +273,7 @@ RC QueryEngine::planQuery(QueryInfo *query_info) {
 
   // 2. 分析预处理：解析抽象语法树并进行预处理，生成statement结构
   rc = Analyzer::analyze(query_info);
+  profile.analyze_ns = lap_ns(phase_start, "analyze");
   if (RC_FAIL(rc)) {
     LOG_TRACE("failed to do resolve. rc=%s", strrc(rc));
     return rc;
@@ -68,6 +282,7 @@ RC QueryEngine::planQuery(QueryInfo *query_info) {
   // 3. 逻辑计划生成：参照statement结构生成逻辑计划树
   std::unique_ptr<LogicalNode> logical_nodes;
   rc = planner_.plan_logical_tree(query_info, logical_nodes);
+  profile.plan_ns = lap_ns(phase_start, "logical plan");
   if (rc != RC::SUCCESS) {
     LOG_TRACE("failed to create logical nodes. rc=%s", strrc(rc));
     return rc;
@@ -75,6 +290,7 @@ RC QueryEngine::planQuery(QueryInfo *query_info) {
 
   // 4. 查询优化：对逻辑计划树进行优化，生成优化后的逻辑计划树，目前仅基于RBO进行优化
   rc = optimizer_.rewrite(logical_nodes);
+  profile.optimize_ns = lap_ns(phase_start, "optimize");
   if (rc != RC::UNIMPLENMENT && rc != RC::SUCCESS) {
     LOG_TRACE("failed to do optimize. rc=%s", strrc(rc));
     return rc;
@@ -82,6 +298,7 @@ RC QueryEngine::planQuery(QueryInfo *query_info) {
 
   // 5. 物理计划生成：根据优化后的逻辑计划树生成物理计划树，描述了查询的具体执行逻辑
   rc = planner_.plan_physical_operator(logical_nodes, query_info);
+  profile.plan_ns += lap_ns(phase_start, "physical plan");
   if(RC_FAIL(rc)) {
     LOG_TRACE("failed to create physical operator. rc=%s", strrc(rc));
     return rc;
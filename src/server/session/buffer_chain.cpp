@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "include/session/buffer_chain.h"
+#include "common/log/log.h"
+
+// 一次writev最多写出的块数
+static constexpr int MAX_IOV_NUM = 64;
+
+BufferChain::BufferChain(int32_t block_size) : block_size_(block_size)
+{}
+
+BufferChain::~BufferChain()
+{
+  clear();
+  release_block(spare_);
+}
+
+BufferChain::Block BufferChain::new_block()
+{
+  Block block;
+  if (spare_.data != nullptr) {
+    block.data = spare_.data;
+    spare_.data = nullptr;
+  } else {
+    block.data = static_cast<char *>(malloc(block_size_));
+    ASSERT(block.data != nullptr, "failed to allocate buffer block. size=%d", block_size_);
+  }
+  return block;
+}
+
+void BufferChain::release_block(Block &block)
+{
+  if (block.data == nullptr) {
+    return;
+  }
+  if (spare_.data == nullptr && &block != &spare_) {
+    spare_.data = block.data;
+  } else {
+    free(block.data);
+  }
+  block.data = nullptr;
+}
+
+void BufferChain::append(const char *data, int32_t size)
+{
+  while (size > 0) {
+    if (blocks_.empty() || blocks_.back().end == block_size_) {
+      blocks_.push_back(new_block());
+    }
+
+    Block &block = blocks_.back();
+    const int32_t len = std::min(size, block_size_ - block.end);
+    memcpy(block.data + block.end, data, len);
+    block.end += len;
+    data += len;
+    size -= len;
+    size_ += len;
+  }
+}
+
+RC BufferChain::write_to(int fd, int64_t &write_size)
+{
+  write_size = 0;
+  while (!blocks_.empty()) {
+    struct iovec iov[MAX_IOV_NUM];
+    int iov_num = 0;
+    for (auto iter = blocks_.begin(); iter != blocks_.end() && iov_num < MAX_IOV_NUM; ++iter) {
+      iov[iov_num].iov_base = iter->data + iter->begin;
+      iov[iov_num].iov_len = iter->end - iter->begin;
+      iov_num++;
+    }
+
+    ssize_t len = ::writev(fd, iov, iov_num);
+    if (len < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return RC::SUCCESS;
+      }
+      LOG_WARN("failed to write data. fd=%d, err=%s", fd, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+
+    consume(len);
+    write_size += len;
+  }
+  return RC::SUCCESS;
+}
+
+void BufferChain::consume(int64_t size)
+{
+  size_ -= size;
+  while (size > 0) {
+    Block &block = blocks_.front();
+    const int64_t len = std::min<int64_t>(size, block.end - block.begin);
+    block.begin += len;
+    size -= len;
+    if (block.begin == block.end) {
+      release_block(block);
+      blocks_.pop_front();
+    }
+  }
+}
+
+void BufferChain::clear()
+{
+  for (Block &block : blocks_) {
+    release_block(block);
+  }
+  blocks_.clear();
+  size_ = 0;
+}
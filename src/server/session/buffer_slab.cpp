@@ -0,0 +1,57 @@
+#include <stdlib.h>
+
+#include "include/session/buffer_slab.h"
+#include "common/log/log.h"
+
+BufferSlab::BufferSlab(int32_t chunk_size, int32_t chunks_per_slab)
+    : chunk_size_(chunk_size), chunks_per_slab_(chunks_per_slab)
+{}
+
+BufferSlab::~BufferSlab()
+{
+  if (used_ != 0) {
+    LOG_WARN("buffer slab is destroyed with %d chunk(s) in use", used_);
+  }
+  for (char *slab : slabs_) {
+    ::free(slab);
+  }
+  slabs_.clear();
+  free_chunks_.clear();
+}
+
+char *BufferSlab::alloc()
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  if (free_chunks_.empty()) {
+    char *slab = static_cast<char *>(malloc(static_cast<size_t>(chunk_size_) * chunks_per_slab_));
+    if (slab == nullptr) {
+      LOG_ERROR("failed to allocate slab. chunk size=%d, chunks=%d", chunk_size_, chunks_per_slab_);
+      return nullptr;
+    }
+    slabs_.push_back(slab);
+    for (int32_t i = chunks_per_slab_ - 1; i >= 0; i--) {
+      free_chunks_.push_back(slab + static_cast<size_t>(i) * chunk_size_);
+    }
+  }
+
+  char *chunk = free_chunks_.back();
+  free_chunks_.pop_back();
+  used_++;
+  return chunk;
+}
+
+void BufferSlab::free(char *chunk)
+{
+  if (chunk == nullptr) {
+    return;
+  }
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  free_chunks_.push_back(chunk);
+  used_--;
+}
+
+int32_t BufferSlab::used() const
+{
+  std::lock_guard<common::ProfiledMutex> guard(lock_);
+  return used_;
+}
@@ -1,17 +1,24 @@
 #include <sys/errno.h>
+#include <poll.h>
 #include <unistd.h>
 #include <algorithm>
+#include <chrono>
 
 #include "include/session/buffered_writer.h"
+#include "include/session/binary_result_protocol.h"
+#include "include/session/compression_protocol.h"
+#include "include/session/session.h"
+#include "common/compress/lz4_block.h"
+#include "common/log/log.h"
 
 using namespace std;
 
 BufferedWriter::BufferedWriter(int fd)
-  : fd_(fd), buffer_()
+  : fd_(fd)
 {}
 
-BufferedWriter::BufferedWriter(int fd, int32_t size)
-  : fd_(fd), buffer_(size)
+BufferedWriter::BufferedWriter(int fd, int32_t high_watermark)
+  : fd_(fd), high_watermark_(high_watermark)
 {}
 
 BufferedWriter::~BufferedWriter()
@@ -25,6 +32,8 @@ RC BufferedWriter::close()
     return RC::SUCCESS;
   }
 
+  // 关闭时不再延迟，尽量把数据发送完
+  deferred_flush_ = false;
   RC rc = flush();
   if (RC_FAIL(rc)) {
     return rc;
@@ -35,87 +44,159 @@ RC BufferedWriter::close()
   return RC::SUCCESS;
 }
 
+void BufferedWriter::reset(int fd)
+{
+  fd_ = fd;
+  deferred_flush_ = false;
+  buffer_.clear();
+  compress_ = false;
+  staging_.clear();
+  incompressible_count_ = 0;
+  skip_compress_count_ = 0;
+}
+
 RC BufferedWriter::write(const char *data, int32_t size, int32_t &write_size)
 {
   if (fd_ < 0) {
     return RC::INVALID_ARGUMENT;
   }
 
-  if (buffer_.remain() == 0) {
-    RC rc = flush_internal(size);
-    if (RC_FAIL(rc)) {
-      return rc;
-    }
+  if (compress_) {
+    staging_.append(data, size);
+    seal_frames(false);
+  } else {
+    buffer_.append(data, size);
+  }
+  write_size = size;
+  if (buffer_.size() < high_watermark_) {
+    return RC::SUCCESS;
   }
 
-  return buffer_.write(data, size, write_size);
+  // 超过高水位时写出一部分，对端接收得慢时在这里等待，结果的生产也随之暂停
+  return drain_to(high_watermark_ / 2);
 }
 
 RC BufferedWriter::writen(const char *data, int32_t size)
+{
+  int32_t write_size = 0;
+  return write(data, size, write_size);
+}
+
+RC BufferedWriter::flush()
 {
   if (fd_ < 0) {
     return RC::INVALID_ARGUMENT;
   }
 
-  int32_t write_size = 0;
-  while (write_size < size) {
-    int32_t tmp_write_size = 0;
-    RC rc = write(data + write_size, size - write_size, tmp_write_size);
-    if (RC_FAIL(rc)) {
-      return rc;
-    }
-
-    write_size += tmp_write_size;
+  seal_frames(true);
+  if (deferred_flush_) {
+    bool drained = false;
+    return flush_pending(drained);
   }
-
-  return RC::SUCCESS;
+  return drain_to(0);
 }
 
-RC BufferedWriter::flush()
+RC BufferedWriter::flush_pending(bool &drained)
 {
   if (fd_ < 0) {
     return RC::INVALID_ARGUMENT;
   }
 
-  RC rc = RC::SUCCESS;
-  while (RC_SUCC(rc) && buffer_.size() > 0) {
-    rc = flush_internal(buffer_.size());
-  }
+  seal_frames(true);
+  int64_t write_size = 0;
+  RC rc = buffer_.write_to(fd_, write_size);
+  drained = buffer_.empty();
   return rc;
 }
 
-RC BufferedWriter::flush_internal(int32_t size)
+void BufferedWriter::seal_frames(bool all)
 {
-  if (fd_ < 0) {
-    return RC::INVALID_ARGUMENT;
+  size_t offset = 0;
+  while (staging_.size() - offset >= static_cast<size_t>(compression::MAX_FRAME_RAW_SIZE) ||
+         (all && offset < staging_.size())) {
+    const int32_t size = std::min<size_t>(staging_.size() - offset, compression::MAX_FRAME_RAW_SIZE);
+    append_frame(staging_.data() + offset, size);
+    offset += size;
   }
+  staging_.erase(0, offset);
+}
 
-  RC rc = RC::SUCCESS;
-  int32_t write_size = 0;
-  while (RC_SUCC(rc) && buffer_.size() > 0 && size > write_size) {
-    const char *buf = nullptr;
-    int32_t read_size = 0;
-    rc = buffer_.buffer(buf, read_size);
+void BufferedWriter::append_frame(const char *data, int32_t size)
+{
+  using namespace compression;
+
+  // 很小的数据压缩不划算；连续几帧压缩效果都不好时(比如已经压缩过的数据)，暂时不再尝试压缩
+  int compressed_size = 0;
+  if (size >= MIN_COMPRESS_SIZE && skip_compress_count_ == 0) {
+    compress_buffer_.resize(common::lz4_compress_bound(size));
+    compressed_size = common::lz4_compress(data, size, compress_buffer_.data(), compress_buffer_.size());
+    if (compressed_size <= 0 || compressed_size > size - size / 8) {
+      compressed_size = 0;
+      if (++incompressible_count_ >= 4) {
+        skip_compress_count_ = 16;
+        incompressible_count_ = 0;
+      }
+    } else {
+      incompressible_count_ = 0;
+    }
+  } else if (skip_compress_count_ > 0 && size >= MIN_COMPRESS_SIZE) {
+    skip_compress_count_--;
+  }
+
+  std::string header;
+  header.push_back(compressed_size > 0 ? FRAME_LZ4 : FRAME_RAW);
+  binary_result::put_u32(header, size);
+  binary_result::put_u32(header, compressed_size > 0 ? compressed_size : size);
+  buffer_.append(header.data(), header.size());
+  if (compressed_size > 0) {
+    buffer_.append(compress_buffer_.data(), compressed_size);
+  } else {
+    buffer_.append(data, size);
+  }
+}
+
+RC BufferedWriter::drain_to(int64_t limit)
+{
+  auto last_progress = chrono::steady_clock::now();
+  while (buffer_.size() > limit) {
+    int64_t write_size = 0;
+    RC rc = buffer_.write_to(fd_, write_size);
     if (RC_FAIL(rc)) {
       return rc;
     }
+    if (buffer_.size() <= limit) {
+      break;
+    }
 
-    ssize_t tmp_write_size = 0;
-    while (tmp_write_size == 0) {
-      tmp_write_size = ::write(fd_, buf, read_size);
-      if (tmp_write_size < 0) {
-        if (errno == EAGAIN || errno == EINTR) {
-          tmp_write_size = 0;
-          continue;
-        } else {
-          return RC::IOERR_WRITE;
-        }
-      }
+    const auto now = chrono::steady_clock::now();
+    if (write_size > 0) {
+      last_progress = now;
+    } else if (now - last_progress >= chrono::milliseconds(write_timeout_ms_)) {
+      // 客户端一直不接收数据，不能无限等待，否则执行语句时持有的锁也不会释放
+      LOG_WARN("client stopped receiving data. fd=%d, pending=%ld, timeout=%ldms",
+          fd_, buffer_.size(), write_timeout_ms_);
+      return RC::IOERR_WRITE;
     }
 
-    write_size += tmp_write_size;
-    buffer_.forward(tmp_write_size);
-  }
+    // 每次只等待一小段时间，语句超时或者被取消时及时返回
+    rc = Session::check_interrupt_now();
+    if (RC_FAIL(rc)) {
+      LOG_WARN("statement interrupted while waiting for client to receive data. fd=%d, rc=%s", fd_, strrc(rc));
+      return rc;
+    }
 
-  return rc;
+    struct pollfd pfd;
+    pfd.fd = fd_;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    int ret = ::poll(&pfd, 1, POLL_INTERVAL_MS);
+    if (ret < 0 && errno != EINTR) {
+      LOG_WARN("failed to wait for fd to be writable. fd=%d, err=%s", fd_, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    if (ret > 0 && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+      return RC::IOERR_WRITE;
+    }
+  }
+  return RC::SUCCESS;
 }
@@ -130,6 +130,9 @@ RC CliCommunicator::read_event(SessionRequest *&event)
 
 RC CliCommunicator::write_result(const char *data, int32_t size)
 {
+  if (result_capture_ != nullptr) {
+    result_capture_->append(data, size);
+  }
   return writer_->writen(data, size);
 }
 
@@ -0,0 +1,105 @@
+#include "include/session/column_batch.h"
+#include "include/query_engine/executor/execution_engine.h"
+#include "include/query_engine/structor/tuple/tuple.h"
+#include "common/log/log.h"
+
+namespace binary_result {
+
+ColumnType column_type_of(AttrType type)
+{
+  switch (type) {
+    case INTS: return COLUMN_INT32;
+    case FLOATS: return COLUMN_FLOAT32;
+    case BOOLEANS: return COLUMN_BOOL;
+    case DATES: return COLUMN_DATE;
+    default: return COLUMN_STRING;
+  }
+}
+
+ColumnBatch::ColumnBatch(const std::vector<ColumnType> &types) : types_(types), columns_(types.size())
+{}
+
+RC ColumnBatch::append(const Tuple &tuple)
+{
+  // 先检查整行，避免追加到一半的行
+  std::vector<Value> values(columns_.size());
+  std::vector<std::string> strings(columns_.size());
+  for (size_t i = 0; i < columns_.size(); i++) {
+    RC rc = tuple.cell_at(i, values[i]);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    const AttrType value_type = values[i].attr_type();
+    if (value_type == NULLS) {
+      continue;
+    }
+    if (types_[i] == COLUMN_STRING) {
+      rc = value_to_string(values[i], strings[i]);
+      if (RC_FAIL(rc)) {
+        return rc;
+      }
+    } else if (types_[i] != column_type_of(value_type)) {
+      LOG_WARN("value type mismatch with column. column=%d, column type=%d, value type=%s",
+          (int)i, types_[i], attr_type_to_string(value_type));
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
+  }
+
+  const size_t null_bytes = rows_ / 8 + 1;
+  for (size_t i = 0; i < columns_.size(); i++) {
+    Column &column = columns_[i];
+    column.nulls.resize(null_bytes, 0);
+
+    Value &value = values[i];
+    const bool is_null = value.attr_type() == NULLS;
+    if (is_null) {
+      column.nulls[rows_ / 8] |= 1 << (rows_ % 8);
+    }
+
+    switch (types_[i]) {
+      case COLUMN_INT32:
+      case COLUMN_DATE: {
+        int32_t v = is_null ? 0 : value.get_int();
+        column.data.append(reinterpret_cast<const char *>(&v), sizeof(v));
+      } break;
+      case COLUMN_FLOAT32: {
+        float v = is_null ? 0 : value.get_float();
+        column.data.append(reinterpret_cast<const char *>(&v), sizeof(v));
+      } break;
+      case COLUMN_BOOL: {
+        column.data.push_back(!is_null && value.get_boolean() ? 1 : 0);
+      } break;
+      case COLUMN_STRING: {
+        if (column.offsets.empty()) {
+          column.offsets.push_back(0);
+        }
+        column.data.append(strings[i]);
+        column.offsets.push_back(column.data.size());
+      } break;
+    }
+  }
+  rows_++;
+  return RC::SUCCESS;
+}
+
+void ColumnBatch::encode(std::string &frames)
+{
+  size_t frame = begin_frame(frames, FRAME_BATCH);
+  put_u32(frames, rows_);
+  for (Column &column : columns_) {
+    column.nulls.resize((rows_ + 7) / 8, 0);
+    frames.append(column.nulls.data(), column.nulls.size());
+    if (!column.offsets.empty()) {
+      frames.append(reinterpret_cast<const char *>(column.offsets.data()), column.offsets.size() * sizeof(uint32_t));
+    }
+    frames.append(column.data);
+
+    column.nulls.clear();
+    column.offsets.clear();
+    column.data.clear();
+  }
+  finish_frame(frames, frame);
+  rows_ = 0;
+}
+
+}  // namespace binary_result
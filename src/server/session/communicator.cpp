@@ -1,8 +1,10 @@
 #include "include/session/communicator.h"
 #include "include/session/plain_communicator.h"
 #include "include/session/cli_communicator.h"
+#include "include/session/mysql_communicator.h"
 #include "include/session/buffered_writer.h"
 #include "include/session/session.h"
+#include "include/session/connection_pool.h"
 
 #include "common/lang/mutex.h"
 
@@ -10,11 +12,62 @@ RC Communicator::init(int fd, Session *session, const std::string &addr)
 {
   fd_ = fd;
   session_ = session;
+  session_id_ = session->id();
   addr_ = addr;
-  writer_ = new BufferedWriter(fd_);
+  if (writer_ != nullptr) {
+    writer_->reset(fd_);
+  } else {
+    writer_ = new BufferedWriter(fd_);
+  }
   return RC::SUCCESS;
 }
 
+void Communicator::reset()
+{
+  ASSERT(session_ == nullptr, "session should be detached before reset");
+  if (writer_ != nullptr) {
+    writer_->close();
+    writer_->reset(-1);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  session_id_ = 0;
+  addr_.clear();
+  result_capture_ = nullptr;
+}
+
+Session *Communicator::bind_session()
+{
+  if (session_ == nullptr && pool_ != nullptr) {
+    session_ = pool_->acquire_session(session_id_);
+  }
+  return session_;
+}
+
+void Communicator::unbind_session()
+{
+  if (session_ != nullptr && pool_ != nullptr && pool_->multiplex() && session_->is_default_state()) {
+    pool_->release_session(session_);
+    session_ = nullptr;
+  }
+}
+
+Session *Communicator::detach_session()
+{
+  Session *session = session_;
+  session_ = nullptr;
+  return session;
+}
+
+RC Communicator::parse_event(const char *data, int32_t size, int32_t &consumed, SessionRequest *&event)
+{
+  consumed = 0;
+  event = nullptr;
+  return RC::UNIMPLENMENT;
+}
+
 Communicator::~Communicator()
 {
   if (fd_ >= 0) {
@@ -34,6 +87,28 @@ Communicator::~Communicator()
 
 /////////////////////////////////////////////////////////////////////////////////
 
+void split_statement_template(const std::string &sql, std::vector<std::string> &fragments)
+{
+  fragments.clear();
+  std::string fragment;
+  char quote = 0;
+  for (char c : sql) {
+    if (quote != 0) {
+      if (c == quote) {
+        quote = 0;
+      }
+    } else if (c == '\'' || c == '"') {
+      quote = c;
+    } else if (c == '?') {
+      fragments.push_back(std::move(fragment));
+      fragment.clear();
+      continue;
+    }
+    fragment.push_back(c);
+  }
+  fragments.push_back(std::move(fragment));
+}
+
 Communicator *CommunicatorFactory::create(CommunicateProtocol protocol)
 {
   switch (protocol) {
@@ -43,6 +118,9 @@ Communicator *CommunicatorFactory::create(CommunicateProtocol protocol)
     case CommunicateProtocol::CLI: {
       return new CliCommunicator;
     } break;
+    case CommunicateProtocol::MYSQL: {
+      return new MysqlCommunicator;
+    } break;
     default: {
       return nullptr;
     }
@@ -0,0 +1,140 @@
+#include "include/session/connection_pool.h"
+#include "include/session/session.h"
+#include "common/log/log.h"
+
+#include <unistd.h>
+
+ConnectionPool::~ConnectionPool()
+{
+  clear();
+}
+
+void ConnectionPool::clear()
+{
+  std::vector<Communicator *> communicators;
+  std::vector<Session *> sessions;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    communicators.swap(idle_communicators_);
+    sessions.swap(idle_sessions_);
+  }
+  for (Communicator *communicator : communicators) {
+    delete communicator;
+  }
+  for (Session *session : sessions) {
+    delete session;
+  }
+}
+
+void ConnectionPool::init(CommunicateProtocol protocol, const Options &options)
+{
+  protocol_ = protocol;
+  options_ = options;
+  LOG_INFO("connection pool: max idle communicators=%d, max idle sessions=%d, multiplex=%d",
+           options_.max_idle_communicators, options_.max_idle_sessions, options_.multiplex);
+}
+
+RC ConnectionPool::open(int fd, const std::string &addr, Communicator *&communicator)
+{
+  communicator = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!idle_communicators_.empty()) {
+      communicator = idle_communicators_.back();
+      idle_communicators_.pop_back();
+      reused_communicators_++;
+    }
+  }
+  if (communicator == nullptr) {
+    communicator = factory_.create(protocol_);
+    if (communicator == nullptr) {
+      ::close(fd);
+      return RC::INTERNAL;
+    }
+  }
+
+  communicator->set_pool(this);
+  RC rc = communicator->init(fd, acquire_session(0), addr);
+  if (RC_FAIL(rc)) {
+    LOG_WARN("failed to init communicator. rc=%s", strrc(rc));
+    close(communicator);
+    communicator = nullptr;
+  }
+  return rc;
+}
+
+void ConnectionPool::close(Communicator *communicator)
+{
+  Session *session = communicator->detach_session();
+  if (session != nullptr) {
+    release_session(session);
+  }
+  communicator->reset();
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (static_cast<int>(idle_communicators_.size()) < options_.max_idle_communicators) {
+      idle_communicators_.push_back(communicator);
+      return;
+    }
+  }
+  delete communicator;
+}
+
+Session *ConnectionPool::acquire_session(uint64_t session_id)
+{
+  Session *session = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!idle_sessions_.empty()) {
+      session = idle_sessions_.back();
+      idle_sessions_.pop_back();
+      reused_sessions_++;
+    }
+  }
+
+  if (session == nullptr) {
+    session = new Session(Session::default_session());
+  }
+  session->set_id(session_id != 0 ? session_id : Session::allocate_id());
+  return session;
+}
+
+void ConnectionPool::release_session(Session *session)
+{
+  session->reset();
+  session->set_id(0);
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (static_cast<int>(idle_sessions_.size()) < options_.max_idle_sessions) {
+      idle_sessions_.push_back(session);
+      return;
+    }
+  }
+  delete session;
+}
+
+int ConnectionPool::idle_communicators() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return static_cast<int>(idle_communicators_.size());
+}
+
+int ConnectionPool::idle_sessions() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return static_cast<int>(idle_sessions_.size());
+}
+
+uint64_t ConnectionPool::reused_communicators() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return reused_communicators_;
+}
+
+uint64_t ConnectionPool::reused_sessions() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return reused_sessions_;
+}
@@ -0,0 +1,461 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "include/session/epoll_reactor.h"
+#include "include/session/session_request.h"
+#include "common/log/log.h"
+
+/**
+ * @brief epoll网络层中的一个连接
+ */
+struct EpollReactor::Connection
+{
+  Communicator *communicator = nullptr;
+  int           fd = -1;
+  char         *buffer = nullptr;  ///< 读缓存，默认从BufferSlab分配，请求太大时改用malloc
+  int32_t       capacity = 0;
+  int32_t       start = 0;         ///< 读缓存中还没有解析的数据的起始位置，读取数据前才整理到缓存开头
+  int32_t       size = 0;          ///< 读缓存中还没有解析的数据量
+  bool          from_slab = false;
+  bool          peer_closed = false;  ///< 客户端已经关闭了写端，缓存中的请求执行完之后关闭连接
+};
+
+EpollReactor::EpollReactor(int index, ConnectionPool &connection_pool, WorkerPool &worker_pool, RequestHandler handler)
+    : index_(index),
+      connection_pool_(connection_pool),
+      worker_pool_(worker_pool),
+      handler_(std::move(handler)),
+      buffer_slab_(BUFFER_CHUNK_SIZE, BUFFER_CHUNKS_PER_SLAB)
+{}
+
+EpollReactor::~EpollReactor()
+{
+  stop();
+  wait();
+
+  std::unordered_set<Connection *> connections;
+  {
+    std::lock_guard<std::mutex> guard(connections_lock_);
+    connections.swap(connections_);
+  }
+  for (Connection *conn : connections) {
+    release_buffer(conn);
+    delete conn->communicator;
+    delete conn;
+  }
+
+  if (wakeup_fd_ >= 0) {
+    ::close(wakeup_fd_);
+    wakeup_fd_ = -1;
+  }
+  if (epoll_fd_ >= 0) {
+    ::close(epoll_fd_);
+    epoll_fd_ = -1;
+  }
+}
+
+RC EpollReactor::init(int listen_fd, bool shared, bool tcp)
+{
+  listen_fd_ = listen_fd;
+  tcp_ = tcp;
+
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    LOG_ERROR("Failed to create epoll. reactor=%d, %s", index_, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    LOG_ERROR("Failed to create eventfd. reactor=%d, %s", index_, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.ptr = &wakeup_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) < 0) {
+    LOG_ERROR("Failed to add eventfd into epoll. reactor=%d, %s", index_, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  // 监听套接字使用水平触发，每次尽量多接收一些连接
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN | (shared ? EPOLLEXCLUSIVE : 0);
+  ev.data.ptr = &listen_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev) < 0) {
+    LOG_ERROR("Failed to add listen socket into epoll. reactor=%d, %s", index_, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  return RC::SUCCESS;
+}
+
+void EpollReactor::start()
+{
+  running_ = true;
+  thread_ = std::thread([this]() { run(); });
+  std::string thread_name = "EpollReactor" + std::to_string(index_);
+  pthread_setname_np(thread_.native_handle(), thread_name.substr(0, 15).c_str());
+}
+
+void EpollReactor::stop()
+{
+  if (!running_.exchange(false)) {
+    return;
+  }
+  uint64_t one = 1;
+  if (::write(wakeup_fd_, &one, sizeof(one)) < 0) {
+    LOG_WARN("Failed to wakeup reactor %d, %s", index_, strerror(errno));
+  }
+}
+
+void EpollReactor::wait()
+{
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void EpollReactor::run()
+{
+  const int max_events = 128;
+  struct epoll_event events[max_events];
+  LOG_INFO("Epoll reactor %d started", index_);
+
+  while (running_) {
+    int event_num = epoll_wait(epoll_fd_, events, max_events, -1);
+    if (event_num < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_ERROR("epoll_wait failed. reactor=%d, %s", index_, strerror(errno));
+      break;
+    }
+
+    for (int i = 0; i < event_num; i++) {
+      void *ptr = events[i].data.ptr;
+      if (ptr == &wakeup_fd_) {
+        uint64_t value = 0;
+        (void)::read(wakeup_fd_, &value, sizeof(value));
+      } else if (ptr == &listen_fd_) {
+        accept_connections();
+      } else {
+        on_event(static_cast<Connection *>(ptr));
+      }
+    }
+  }
+  LOG_INFO("Epoll reactor %d quit", index_);
+}
+
+void EpollReactor::accept_connections()
+{
+  while (true) {
+    struct sockaddr_storage addr;
+    socklen_t addrlen = sizeof(addr);
+    int client_fd = accept4(listen_fd_, (struct sockaddr *)&addr, &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (client_fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        LOG_ERROR("Failed to accept client's connection, %s", strerror(errno));
+      }
+      return;
+    }
+
+    std::string addr_str = "unix socket";
+    if (addr.ss_family == AF_INET) {
+      struct sockaddr_in *addr_in = (struct sockaddr_in *)&addr;
+      char ip_addr[INET_ADDRSTRLEN];
+      if (inet_ntop(AF_INET, &addr_in->sin_addr, ip_addr, sizeof(ip_addr)) != nullptr) {
+        addr_str = std::string(ip_addr) + ":" + std::to_string(ntohs(addr_in->sin_port));
+      }
+    }
+
+    if (tcp_) {
+      int yes = 1;
+      if (setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)) < 0) {
+        LOG_ERROR("Failed to set socket of %s option as : TCP_NODELAY %s", addr_str.c_str(), strerror(errno));
+        ::close(client_fd);
+        continue;
+      }
+    }
+
+    Communicator *communicator = nullptr;
+    RC rc = connection_pool_.open(client_fd, addr_str, communicator);
+    if (RC_FAIL(rc)) {
+      LOG_WARN("failed to init communicator. rc=%s", strrc(rc));
+      continue;
+    }
+
+    // 工作线程不等待慢的客户端，没有发送完的数据由reactor发送
+    communicator->set_deferred_flush(true);
+
+    Connection *conn = new Connection;
+    conn->communicator = communicator;
+    conn->fd = client_fd;
+    {
+      std::lock_guard<std::mutex> guard(connections_lock_);
+      connections_.insert(conn);
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET | EPOLLONESHOT;
+    ev.data.ptr = conn;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_fd, &ev) < 0) {
+      LOG_ERROR("Failed to add connection of %s into epoll, %s", addr_str.c_str(), strerror(errno));
+      close_connection(conn);
+      continue;
+    }
+
+    LOG_INFO("Accepted connection from %s by reactor %d", communicator->addr(), index_);
+  }
+}
+
+void EpollReactor::on_event(Connection *conn)
+{
+  Communicator *communicator = conn->communicator;
+  if (communicator->has_pending_output()) {
+    // 先把上一个请求的回复发送完，再处理新的请求
+    bool drained = false;
+    RC rc = communicator->flush_pending(drained);
+    if (RC_FAIL(rc)) {
+      close_connection(conn);
+      return;
+    }
+    if (!drained) {
+      rearm(conn);
+      return;
+    }
+  }
+
+  dispatch(conn);
+}
+
+RC EpollReactor::read_data(Connection *conn, bool &drained)
+{
+  drained = false;
+  if (conn->start + conn->size == conn->capacity) {
+    if (conn->start > 0) {
+      // 前面的请求已经解析完，把剩下的数据整理到缓存开头
+      memmove(conn->buffer, conn->buffer + conn->start, conn->size);
+      conn->start = 0;
+    } else {
+      // 缓存中只有一个不完整的请求
+      RC rc = grow_buffer(conn);
+      if (RC_FAIL(rc)) {
+        return rc;
+      }
+    }
+  }
+
+  while (conn->start + conn->size < conn->capacity) {
+    char *end = conn->buffer + conn->start + conn->size;
+    ssize_t read_len = ::read(conn->fd, end, conn->capacity - conn->start - conn->size);
+    if (read_len > 0) {
+      conn->size += static_cast<int32_t>(read_len);
+      continue;
+    }
+    if (read_len == 0) {
+      LOG_INFO("The peer has been closed %s", conn->communicator->addr());
+      conn->peer_closed = true;
+      drained = true;
+      return RC::SUCCESS;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      drained = true;
+      return RC::SUCCESS;
+    }
+    LOG_ERROR("Failed to read socket of %s, %s", conn->communicator->addr(), strerror(errno));
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
+
+RC EpollReactor::receive_request(Connection *conn, SessionRequest *&request)
+{
+  while (true) {
+    RC rc = next_request(conn, request);
+    if (RC_FAIL(rc) || request != nullptr || conn->peer_closed) {
+      return rc;
+    }
+
+    bool drained = false;
+    rc = read_data(conn, drained);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    if (drained) {
+      return next_request(conn, request);
+    }
+  }
+}
+
+RC EpollReactor::next_request(Connection *conn, SessionRequest *&request)
+{
+  request = nullptr;
+  if (conn->size == 0 && !conn->communicator->has_pending_request()) {
+    return RC::SUCCESS;
+  }
+
+  // 有些消息由通讯层直接处理，不产生请求(比如mysql协议的PING)，继续解析后面的消息
+  int32_t consumed = 0;
+  do {
+    RC rc = conn->communicator->parse_event(conn->buffer + conn->start, conn->size, consumed, request);
+    if (RC_FAIL(rc)) {
+      LOG_WARN("Failed to parse request of %s. rc=%s", conn->communicator->addr(), strrc(rc));
+      return rc;
+    }
+
+    // 解析出的请求只移动起始位置，剩下的数据等到读取新数据时再整理，连续的小请求不需要反复拷贝
+    conn->start += consumed;
+    conn->size -= consumed;
+  } while (request == nullptr && consumed > 0 && conn->size > 0);
+
+  if (conn->size == 0) {
+    conn->start = 0;
+    if (!conn->from_slab) {
+      // 大请求处理完之后把大的缓存还回去
+      release_buffer(conn);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void EpollReactor::dispatch(Connection *conn)
+{
+  SessionRequest *request = nullptr;
+  RC rc = receive_request(conn, request);
+  if (RC_FAIL(rc)) {
+    close_connection(conn);
+    return;
+  }
+
+  if (request == nullptr) {
+    rearm(conn);
+    return;
+  }
+
+  // 提交之后连接由工作线程负责，reactor不会再收到这个连接的事件
+  if (!worker_pool_.submit([this, conn, request]() { process(conn, request); })) {
+    LOG_WARN("failed to submit request, server is stopping. addr=%s", conn->communicator->addr());
+    delete request;
+    close_connection(conn);
+  }
+}
+
+void EpollReactor::process(Connection *conn, SessionRequest *request)
+{
+  while (request != nullptr) {
+    bool need_disconnect = handler_(request);
+    if (need_disconnect) {
+      close_connection(conn);
+      return;
+    }
+
+    // 客户端可能一次发送了多个请求，已经读到缓存中的请求直接执行
+    RC rc = next_request(conn, request);
+    if (RC_FAIL(rc)) {
+      close_connection(conn);
+      return;
+    }
+  }
+  rearm(conn);
+}
+
+void EpollReactor::rearm(Connection *conn)
+{
+  const bool pending_output = conn->communicator->has_pending_output();
+  if (conn->peer_closed && !pending_output) {
+    // 客户端已经关闭，缓存中的请求都执行完了，回复也发送完了
+    close_connection(conn);
+    return;
+  }
+
+  // EPOLL_CTL_MOD 会重新检查套接字的状态，执行期间到达的数据也会触发事件。
+  // 还有没发送完的回复时只监听可写事件，发送完之后再读取新的请求，客户端接收得慢时也不会积压请求。
+  // 客户端关闭写端之后不再监听EPOLLRDHUP，否则发送回复期间会一直触发
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = (pending_output ? EPOLLOUT : EPOLLIN) | (conn->peer_closed ? 0 : EPOLLRDHUP) | EPOLLET | EPOLLONESHOT;
+  ev.data.ptr = conn;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, conn->fd, &ev) < 0) {
+    LOG_ERROR("Failed to rearm connection of %s, %s", conn->communicator->addr(), strerror(errno));
+    close_connection(conn);
+  }
+}
+
+void EpollReactor::close_connection(Connection *conn)
+{
+  LOG_INFO("Close connection of %s.", conn->communicator->addr());
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, conn->fd, nullptr);
+  {
+    std::lock_guard<std::mutex> guard(connections_lock_);
+    connections_.erase(conn);
+  }
+  release_buffer(conn);
+  connection_pool_.close(conn->communicator);  // 会关闭fd
+  delete conn;
+}
+
+RC EpollReactor::grow_buffer(Connection *conn)
+{
+  if (conn->buffer == nullptr) {
+    conn->buffer = buffer_slab_.alloc();
+    if (conn->buffer == nullptr) {
+      return RC::NOMEM;
+    }
+    conn->capacity = buffer_slab_.chunk_size();
+    conn->from_slab = true;
+    return RC::SUCCESS;
+  }
+
+  if (conn->capacity >= MAX_BUFFER_SIZE) {
+    LOG_WARN("The request of %s exceeds the limitation %d", conn->communicator->addr(), MAX_BUFFER_SIZE);
+    return RC::IOERR_TOO_LONG;
+  }
+
+  int32_t new_capacity = conn->capacity * 2;
+  char *new_buffer = static_cast<char *>(malloc(new_capacity));
+  if (new_buffer == nullptr) {
+    return RC::NOMEM;
+  }
+  memcpy(new_buffer, conn->buffer + conn->start, conn->size);
+  int32_t size = conn->size;
+  release_buffer(conn);
+  conn->buffer = new_buffer;
+  conn->capacity = new_capacity;
+  conn->size = size;
+  conn->from_slab = false;
+  return RC::SUCCESS;
+}
+
+void EpollReactor::release_buffer(Connection *conn)
+{
+  if (conn->buffer != nullptr) {
+    if (conn->from_slab) {
+      buffer_slab_.free(conn->buffer);
+    } else {
+      free(conn->buffer);
+    }
+  }
+  conn->buffer = nullptr;
+  conn->capacity = 0;
+  conn->start = 0;
+  conn->size = 0;
+  conn->from_slab = false;
+}
@@ -0,0 +1,161 @@
+#include "include/session/metrics_http_server.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "common/log/log.h"
+#include "common/metrics/metrics_registry.h"
+#include "common/metrics/prometheus_reporter.h"
+
+/// 请求头最多读取这么多字节，只关心第一行
+static const size_t MAX_REQUEST_SIZE = 8192;
+/// 等待客户端发送请求的时间
+static const int REQUEST_TIMEOUT_MS = 1000;
+/// 服务线程检查是否需要退出的间隔
+static const int POLL_INTERVAL_MS = 200;
+
+MetricsHttpServer::~MetricsHttpServer()
+{
+  stop();
+}
+
+RC MetricsHttpServer::start(const std::string &address, int port)
+{
+  struct sockaddr_in sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  if (inet_pton(AF_INET, address.c_str(), &sa.sin_addr) != 1) {
+    LOG_ERROR("invalid metrics http address: %s", address.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    LOG_ERROR("failed to create metrics http socket: %s", strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int yes = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  if (bind(listen_fd_, (struct sockaddr *)&sa, sizeof(sa)) < 0 || listen(listen_fd_, SOMAXCONN) < 0) {
+    LOG_ERROR("failed to listen metrics http on %s:%d: %s", address.c_str(), port, strerror(errno));
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return RC::IOERR_OPEN;
+  }
+
+  running_ = true;
+  thread_ = std::thread(&MetricsHttpServer::run, this);
+  LOG_INFO("metrics http server listening on %s:%d", address.c_str(), port);
+  return RC::SUCCESS;
+}
+
+void MetricsHttpServer::stop()
+{
+  if (!running_.exchange(false)) {
+    return;
+  }
+
+  thread_.join();
+  close(listen_fd_);
+  listen_fd_ = -1;
+  LOG_INFO("metrics http server stopped");
+}
+
+void MetricsHttpServer::run()
+{
+  while (running_.load()) {
+    struct pollfd pfd = {listen_fd_, POLLIN, 0};
+    int ret = poll(&pfd, 1, POLL_INTERVAL_MS);
+    if (ret <= 0) {
+      continue;
+    }
+
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno != EINTR && errno != EAGAIN) {
+        LOG_WARN("failed to accept metrics http connection: %s", strerror(errno));
+      }
+      continue;
+    }
+
+    handle_connection(fd);
+    close(fd);
+  }
+}
+
+static void send_response(int fd, const char *status, const char *content_type, const std::string &body)
+{
+  std::string response = std::string("HTTP/1.1 ") + status + "\r\n";
+  response.append("Content-Type: ").append(content_type).append("\r\n");
+  response.append("Content-Length: ").append(std::to_string(body.size())).append("\r\n");
+  response.append("Connection: close\r\n\r\n");
+  response.append(body);
+
+  // 客户端可能提前关闭连接，使用MSG_NOSIGNAL避免SIGPIPE
+  size_t sent = 0;
+  while (sent < response.size()) {
+    ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      LOG_TRACE("failed to send metrics http response: %s", strerror(errno));
+      return;
+    }
+    sent += n;
+  }
+}
+
+void MetricsHttpServer::handle_connection(int fd)
+{
+  // 读取到请求头结束，没有请求体需要处理
+  std::string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    if (poll(&pfd, 1, REQUEST_TIMEOUT_MS) <= 0) {
+      return;
+    }
+    ssize_t n = read(fd, buf, sizeof(buf));
+    if (n <= 0) {
+      return;
+    }
+    request.append(buf, n);
+  }
+
+  // 请求行: METHOD PATH VERSION
+  const size_t line_end = request.find("\r\n");
+  const std::string line = request.substr(0, line_end);
+  const size_t method_end = line.find(' ');
+  const size_t path_end = line.find(' ', method_end + 1);
+  if (method_end == std::string::npos || path_end == std::string::npos) {
+    send_response(fd, "400 Bad Request", "text/plain", "bad request\n");
+    return;
+  }
+
+  const std::string method = line.substr(0, method_end);
+  std::string path = line.substr(method_end + 1, path_end - method_end - 1);
+  const size_t query = path.find('?');
+  if (query != std::string::npos) {
+    path.resize(query);
+  }
+
+  if (method != "GET") {
+    send_response(fd, "405 Method Not Allowed", "text/plain", "method not allowed\n");
+  } else if (path == "/metrics") {
+    common::PrometheusReporter reporter("tdb_");
+    common::get_metrics_registry().report(reporter);
+    send_response(fd, "200 OK", "text/plain; version=0.0.4; charset=utf-8", reporter.text());
+  } else if (path == "/healthz") {
+    send_response(fd, "200 OK", "text/plain", "ok\n");
+  } else {
+    send_response(fd, "404 Not Found", "text/plain", "not found\n");
+  }
+}
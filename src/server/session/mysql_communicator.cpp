@@ -0,0 +1,988 @@
+#include <errno.h>
+#include <random>
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "include/session/mysql_communicator.h"
+#include "include/session/buffered_writer.h"
+#include "include/session/session.h"
+#include "include/session/session_request.h"
+#include "include/query_engine/executor/execution_engine.h"
+#include "include/query_engine/structor/tuple/tuple.h"
+#include "common/log/log.h"
+
+// 参考 https://dev.mysql.com/doc/dev/mysql-server/latest/PAGE_PROTOCOL.html
+
+// Capability Flags
+static const uint32_t CLIENT_LONG_PASSWORD = 1;
+static const uint32_t CLIENT_FOUND_ROWS = 2;
+static const uint32_t CLIENT_LONG_FLAG = 4;
+static const uint32_t CLIENT_CONNECT_WITH_DB = 8;
+static const uint32_t CLIENT_PROTOCOL_41 = 512;
+static const uint32_t CLIENT_TRANSACTIONS = 8192;
+static const uint32_t CLIENT_SECURE_CONNECTION = 32768;
+static const uint32_t CLIENT_MULTI_RESULTS = 1UL << 17;
+static const uint32_t CLIENT_PLUGIN_AUTH = 1UL << 19;
+static const uint32_t CLIENT_CONNECT_ATTRS = 1UL << 20;
+static const uint32_t CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA = 1UL << 21;
+
+static const uint32_t SERVER_CAPABILITIES = CLIENT_LONG_PASSWORD | CLIENT_FOUND_ROWS | CLIENT_LONG_FLAG |
+                                            CLIENT_CONNECT_WITH_DB | CLIENT_PROTOCOL_41 | CLIENT_TRANSACTIONS |
+                                            CLIENT_SECURE_CONNECTION | CLIENT_MULTI_RESULTS | CLIENT_PLUGIN_AUTH |
+                                            CLIENT_CONNECT_ATTRS | CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA;
+
+static const uint16_t SERVER_STATUS_AUTOCOMMIT = 0x0002;
+static const uint8_t  CHARSET_UTF8 = 33;   // utf8_general_ci
+static const uint8_t  CHARSET_BINARY = 63;
+static const uint16_t ER_UNKNOWN_ERROR = 1105;
+static const uint16_t NUM_FLAG = 32768;
+
+// Command
+enum : uint8_t
+{
+  COM_QUIT = 0x01,
+  COM_INIT_DB = 0x02,
+  COM_QUERY = 0x03,
+  COM_PING = 0x0e,
+  COM_STMT_PREPARE = 0x16,
+  COM_STMT_EXECUTE = 0x17,
+  COM_STMT_CLOSE = 0x19,
+  COM_STMT_RESET = 0x1a,
+};
+
+// Column Types
+enum : uint8_t
+{
+  MYSQL_TYPE_DECIMAL = 0,
+  MYSQL_TYPE_TINY = 1,
+  MYSQL_TYPE_SHORT = 2,
+  MYSQL_TYPE_LONG = 3,
+  MYSQL_TYPE_FLOAT = 4,
+  MYSQL_TYPE_DOUBLE = 5,
+  MYSQL_TYPE_NULL = 6,
+  MYSQL_TYPE_TIMESTAMP = 7,
+  MYSQL_TYPE_LONGLONG = 8,
+  MYSQL_TYPE_INT24 = 9,
+  MYSQL_TYPE_DATE = 10,
+  MYSQL_TYPE_DATETIME = 12,
+  MYSQL_TYPE_YEAR = 13,
+  MYSQL_TYPE_VAR_STRING = 253,
+};
+
+static const int32_t MAX_PACKET_PAYLOAD = 0xffffff;
+
+static void store_int1(std::string &buf, uint8_t v)
+{
+  buf.push_back(static_cast<char>(v));
+}
+
+static void store_int2(std::string &buf, uint16_t v)
+{
+  store_int1(buf, v & 0xff);
+  store_int1(buf, (v >> 8) & 0xff);
+}
+
+static void store_int3(std::string &buf, uint32_t v)
+{
+  store_int2(buf, v & 0xffff);
+  store_int1(buf, (v >> 16) & 0xff);
+}
+
+static void store_int4(std::string &buf, uint32_t v)
+{
+  store_int2(buf, v & 0xffff);
+  store_int2(buf, (v >> 16) & 0xffff);
+}
+
+static void store_int8(std::string &buf, uint64_t v)
+{
+  store_int4(buf, v & 0xffffffff);
+  store_int4(buf, (v >> 32) & 0xffffffff);
+}
+
+static void store_lenenc_int(std::string &buf, uint64_t v)
+{
+  if (v < 251) {
+    store_int1(buf, v);
+  } else if (v < (1 << 16)) {
+    store_int1(buf, 0xfc);
+    store_int2(buf, v);
+  } else if (v < (1 << 24)) {
+    store_int1(buf, 0xfd);
+    store_int3(buf, v);
+  } else {
+    store_int1(buf, 0xfe);
+    store_int8(buf, v);
+  }
+}
+
+static void store_lenenc_str(std::string &buf, const char *s, size_t len)
+{
+  store_lenenc_int(buf, len);
+  buf.append(s, len);
+}
+
+static void store_lenenc_str(std::string &buf, const std::string &s)
+{
+  store_lenenc_str(buf, s.data(), s.size());
+}
+
+/**
+ * @brief 从消息中按顺序读取数据，越界时返回false
+ */
+class PacketReader
+{
+public:
+  PacketReader(const char *data, int32_t size) : pos_(data), end_(data + size)
+  {}
+
+  bool read_int(int bytes, uint64_t &v)
+  {
+    if (end_ - pos_ < bytes) {
+      return false;
+    }
+    v = 0;
+    for (int i = 0; i < bytes; i++) {
+      v |= static_cast<uint64_t>(static_cast<uint8_t>(pos_[i])) << (8 * i);
+    }
+    pos_ += bytes;
+    return true;
+  }
+
+  bool read_lenenc_int(uint64_t &v)
+  {
+    uint64_t first = 0;
+    if (!read_int(1, first)) {
+      return false;
+    }
+    switch (first) {
+      case 0xfc: return read_int(2, v);
+      case 0xfd: return read_int(3, v);
+      case 0xfe: return read_int(8, v);
+      default: v = first; return first < 0xfb;
+    }
+  }
+
+  bool read_bytes(uint64_t len, const char *&data)
+  {
+    if (static_cast<uint64_t>(end_ - pos_) < len) {
+      return false;
+    }
+    data = pos_;
+    pos_ += len;
+    return true;
+  }
+
+  bool read_lenenc_str(std::string &s)
+  {
+    uint64_t len = 0;
+    const char *data = nullptr;
+    if (!read_lenenc_int(len) || !read_bytes(len, data)) {
+      return false;
+    }
+    s.assign(data, len);
+    return true;
+  }
+
+  bool read_null_str(std::string &s)
+  {
+    const char *nul = static_cast<const char *>(memchr(pos_, 0, end_ - pos_));
+    if (nul == nullptr) {
+      return false;
+    }
+    s.assign(pos_, nul - pos_);
+    pos_ = nul + 1;
+    return true;
+  }
+
+  bool skip(int bytes)
+  {
+    const char *data = nullptr;
+    return read_bytes(bytes, data);
+  }
+
+  bool eof() const
+  {
+    return pos_ >= end_;
+  }
+
+  const char *pos() const
+  {
+    return pos_;
+  }
+
+private:
+  const char *pos_;
+  const char *end_;
+};
+
+/**
+ * @brief 把二进制格式的参数转换成SQL中的常量
+ */
+static RC param_to_literal(uint16_t param_type, PacketReader &reader, std::string &literal)
+{
+  const bool is_unsigned = (param_type & 0x8000) != 0;
+  const uint8_t type = param_type & 0xff;
+  uint64_t v = 0;
+  switch (type) {
+    case MYSQL_TYPE_TINY: {
+      if (!reader.read_int(1, v)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      literal = is_unsigned ? std::to_string(static_cast<uint8_t>(v)) : std::to_string(static_cast<int8_t>(v));
+    } break;
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_YEAR: {
+      if (!reader.read_int(2, v)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      literal = is_unsigned ? std::to_string(static_cast<uint16_t>(v)) : std::to_string(static_cast<int16_t>(v));
+    } break;
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_INT24: {
+      if (!reader.read_int(4, v)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      literal = is_unsigned ? std::to_string(static_cast<uint32_t>(v)) : std::to_string(static_cast<int32_t>(v));
+    } break;
+    case MYSQL_TYPE_LONGLONG: {
+      if (!reader.read_int(8, v)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      literal = is_unsigned ? std::to_string(v) : std::to_string(static_cast<int64_t>(v));
+    } break;
+    case MYSQL_TYPE_FLOAT: {
+      if (!reader.read_int(4, v)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      uint32_t bits = static_cast<uint32_t>(v);
+      float f;
+      memcpy(&f, &bits, sizeof(f));
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.9g", f);
+      literal = buf;
+    } break;
+    case MYSQL_TYPE_DOUBLE: {
+      if (!reader.read_int(8, v)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      double d;
+      memcpy(&d, &v, sizeof(d));
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.17g", d);
+      literal = buf;
+    } break;
+    case MYSQL_TYPE_NULL: {
+      literal = "null";
+    } break;
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_TIMESTAMP: {
+      // 只使用年月日
+      uint64_t len = 0, year = 0, month = 0, day = 0;
+      if (!reader.read_int(1, len)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      if (len >= 4 && (!reader.read_int(2, year) || !reader.read_int(1, month) || !reader.read_int(1, day) ||
+                          !reader.skip(len - 4))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      char buf[32];
+      snprintf(buf, sizeof(buf), "'%04d-%02d-%02d'", (int)year, (int)month, (int)day);
+      literal = buf;
+    } break;
+    default: {
+      // 其它类型都按照字符串处理，比如VARCHAR、BLOB、DECIMAL
+      std::string s;
+      if (!reader.read_lenenc_str(s)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      // 词法分析不支持转义，使用另一种引号
+      char quote = s.find('\'') == std::string::npos ? '\'' : '"';
+      if (quote == '"' && s.find('"') != std::string::npos) {
+        LOG_WARN("string parameter contains both quotes. %s", s.c_str());
+        return RC::INVALID_ARGUMENT;
+      }
+      literal.clear();
+      literal.push_back(quote);
+      literal.append(s);
+      literal.push_back(quote);
+    } break;
+  }
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 驱动连接时设置字符集、自动提交等会话变量的语句
+ * @details 引擎不支持这些会话变量，由通讯层直接回复OK
+ */
+static bool is_session_setup_statement(const char *sql, int32_t size)
+{
+  static const char *prefixes[] = {
+      "set names", "set character set", "set character_set_", "set autocommit", "set session ", "set sql_mode",
+      "set @@session.", "set time_zone", "set transaction "};
+
+  while (size > 0 && isspace(static_cast<unsigned char>(*sql))) {
+    sql++;
+    size--;
+  }
+  for (const char *prefix : prefixes) {
+    const int32_t len = strlen(prefix);
+    if (size >= len && 0 == strncasecmp(sql, prefix, len)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 结果集中每一列的类型，由查询计划中这一列的类型确定，不知道类型的列当做字符串
+ */
+static uint8_t column_type_of(AttrType type)
+{
+  switch (type) {
+    case INTS: return MYSQL_TYPE_LONG;
+    case FLOATS: return MYSQL_TYPE_FLOAT;
+    case BOOLEANS: return MYSQL_TYPE_TINY;
+    case DATES: return MYSQL_TYPE_DATE;
+    default: return MYSQL_TYPE_VAR_STRING;
+  }
+}
+
+void MysqlCommunicator::reset()
+{
+  Communicator::reset();
+  sequence_id_ = 0;
+  authed_ = false;
+  connection_id_ = 0;
+  scramble_.clear();
+  client_capabilities_ = 0;
+  next_stmt_id_ = 1;
+  statements_.clear();
+  recv_buffer_.clear();
+}
+
+RC MysqlCommunicator::init(int fd, Session *session, const std::string &addr)
+{
+  RC rc = Communicator::init(fd, session, addr);
+  if (RC_FAIL(rc)) {
+    return rc;
+  }
+
+  // 连接编号就是会话编号，客户端可以用它执行 KILL QUERY
+  connection_id_ = static_cast<uint32_t>(session_id_);
+
+  // 认证数据不能包含'\0'
+  std::random_device rd;
+  std::mt19937 generator(rd());
+  std::uniform_int_distribution<int> distribution(1, 127);
+  scramble_.clear();
+  for (int i = 0; i < 20; i++) {
+    scramble_.push_back(static_cast<char>(distribution(generator)));
+  }
+
+  std::string payload;
+  store_int1(payload, 10);  // protocol version
+  payload.append("8.0.30-TDB");
+  payload.push_back('\0');
+  store_int4(payload, connection_id_);
+  payload.append(scramble_, 0, 8);
+  store_int1(payload, 0);
+  store_int2(payload, SERVER_CAPABILITIES & 0xffff);
+  store_int1(payload, CHARSET_UTF8);
+  store_int2(payload, SERVER_STATUS_AUTOCOMMIT);
+  store_int2(payload, (SERVER_CAPABILITIES >> 16) & 0xffff);
+  store_int1(payload, scramble_.size() + 1);
+  payload.append(10, '\0');
+  payload.append(scramble_, 8, std::string::npos);
+  payload.push_back('\0');
+  payload.append("mysql_native_password");
+  payload.push_back('\0');
+
+  sequence_id_ = 0;
+  rc = send_packet(payload);
+  if (RC_FAIL(rc)) {
+    LOG_WARN("failed to send handshake to %s. rc=%s", addr.c_str(), strrc(rc));
+    return rc;
+  }
+  flush();
+  return RC::SUCCESS;
+}
+
+RC MysqlCommunicator::read_event(SessionRequest *&event)
+{
+  event = nullptr;
+
+  // 只处理已经完整接收的消息，不完整的数据留在接收缓存中，等待下次可读时继续读取，不能在这里等待，
+  // 否则一个只发送了半个消息的客户端会占住网络线程，同一个线程上的其它连接都得不到处理
+  char buf[16 * 1024];
+  while (true) {
+    int32_t consumed = 0;
+    RC rc = parse_event(recv_buffer_.data(), recv_buffer_.size(), consumed, event);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    recv_buffer_.erase(0, consumed);
+    if (event != nullptr) {
+      return RC::SUCCESS;
+    }
+    if (consumed > 0) {
+      // 消息已经处理，比如认证和PING
+      continue;
+    }
+
+    ssize_t read_len = ::read(fd_, buf, sizeof(buf));
+    if (read_len < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // 还没有收到完整的消息，等待下次可读
+        return RC::SUCCESS;
+      }
+      LOG_ERROR("Failed to read socket of %s, %s", addr(), strerror(errno));
+      return RC::IOERR_READ;
+    }
+    if (read_len == 0) {
+      LOG_INFO("The peer has been closed %s", addr());
+      return RC::IOERR_CLOSE;
+    }
+    recv_buffer_.append(buf, read_len);
+  }
+}
+
+bool MysqlCommunicator::has_pending_request() const
+{
+  if (recv_buffer_.size() < 4) {
+    return false;
+  }
+  const int32_t payload_len = static_cast<uint8_t>(recv_buffer_[0]) | (static_cast<uint8_t>(recv_buffer_[1]) << 8) |
+                              (static_cast<uint8_t>(recv_buffer_[2]) << 16);
+  return recv_buffer_.size() >= static_cast<size_t>(4 + payload_len);
+}
+
+RC MysqlCommunicator::parse_event(const char *data, int32_t size, int32_t &consumed, SessionRequest *&event)
+{
+  consumed = 0;
+  event = nullptr;
+  if (size < 4) {
+    return RC::SUCCESS;
+  }
+
+  const int32_t payload_len = static_cast<uint8_t>(data[0]) | (static_cast<uint8_t>(data[1]) << 8) |
+                              (static_cast<uint8_t>(data[2]) << 16);
+  if (payload_len == MAX_PACKET_PAYLOAD) {
+    // 客户端发送的请求很少会超过16M，暂时不支持拆分的消息
+    LOG_WARN("The length of packet exceeds the limitation %d", MAX_PACKET_PAYLOAD);
+    return RC::IOERR_TOO_LONG;
+  }
+  if (size < 4 + payload_len) {
+    return RC::SUCCESS;
+  }
+
+  consumed = 4 + payload_len;
+  sequence_id_ = static_cast<uint8_t>(data[3]) + 1;
+  RC rc = handle_packet(data + 4, payload_len, event);
+  flush();
+  return rc;
+}
+
+RC MysqlCommunicator::handle_packet(const char *payload, int32_t size, SessionRequest *&event)
+{
+  if (!authed_) {
+    return handle_handshake_response(payload, size);
+  }
+
+  if (size < 1) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const uint8_t command = static_cast<uint8_t>(payload[0]);
+  switch (command) {
+    case COM_QUIT: {
+      LOG_INFO("client %s quit", addr());
+      return RC::IOERR_CLOSE;
+    }
+    case COM_PING: {
+      return send_ok();
+    }
+    case COM_INIT_DB: {
+      bind_session()->set_current_db(std::string(payload + 1, size - 1));
+      return send_ok();
+    }
+    case COM_QUERY: {
+      if (is_session_setup_statement(payload + 1, size - 1)) {
+        LOG_TRACE("ignore session setup statement: %.*s", size - 1, payload + 1);
+        return send_ok();
+      }
+      LOG_INFO("receive command(size=%d): %.*s", size - 1, size - 1, payload + 1);
+      event = new SessionRequest(this);
+      event->set_query(std::string(payload + 1, size - 1));
+      return RC::SUCCESS;
+    }
+    case COM_STMT_PREPARE: {
+      return handle_stmt_prepare(payload + 1, size - 1);
+    }
+    case COM_STMT_EXECUTE: {
+      return handle_stmt_execute(payload + 1, size - 1, event);
+    }
+    case COM_STMT_CLOSE: {
+      // 这个命令没有回复
+      PacketReader reader(payload + 1, size - 1);
+      uint64_t stmt_id = 0;
+      if (reader.read_int(4, stmt_id)) {
+        statements_.erase(static_cast<uint32_t>(stmt_id));
+      }
+      return RC::SUCCESS;
+    }
+    case COM_STMT_RESET: {
+      return send_ok();
+    }
+    default: {
+      LOG_WARN("unsupported command from %s: %d", addr(), command);
+      return send_error("Unsupported command " + std::to_string(command));
+    }
+  }
+}
+
+RC MysqlCommunicator::handle_handshake_response(const char *payload, int32_t size)
+{
+  PacketReader reader(payload, size);
+  uint64_t capabilities = 0;
+  std::string user;
+  if (!reader.read_int(4, capabilities) || !reader.skip(4 + 1 + 23) || !reader.read_null_str(user)) {
+    LOG_WARN("invalid handshake response from %s", addr());
+    return RC::INVALID_ARGUMENT;
+  }
+  client_capabilities_ = static_cast<uint32_t>(capabilities);
+  if (!(client_capabilities_ & CLIENT_PROTOCOL_41)) {
+    LOG_WARN("client %s doesn't support protocol 41", addr());
+    send_error("Client does not support protocol 41");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 没有用户管理，不校验认证信息
+  std::string auth_response;
+  bool ok = true;
+  if (client_capabilities_ & CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA) {
+    ok = reader.read_lenenc_str(auth_response);
+  } else {
+    uint64_t len = 0;
+    const char *data = nullptr;
+    ok = reader.read_int(1, len) && reader.read_bytes(len, data);
+  }
+
+  std::string db_name;
+  if (ok && (client_capabilities_ & CLIENT_CONNECT_WITH_DB) && !reader.eof()) {
+    ok = reader.read_null_str(db_name);
+  }
+  if (!ok) {
+    LOG_WARN("invalid handshake response from %s", addr());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (!db_name.empty()) {
+    session_->set_current_db(db_name);
+  }
+
+  LOG_INFO("mysql client %s connected. user=%s, connection id=%u", addr(), user.c_str(), connection_id_);
+  authed_ = true;
+  return send_ok();
+}
+
+RC MysqlCommunicator::handle_stmt_prepare(const char *payload, int32_t size)
+{
+  PreparedStatement stmt;
+  split_statement_template(std::string(payload, size), stmt.fragments);
+
+  const uint32_t stmt_id = next_stmt_id_++;
+  const uint16_t param_count = stmt.fragments.size() - 1;
+  statements_[stmt_id] = std::move(stmt);
+
+  // 执行之前不知道结果集的列，返回0列，客户端使用执行时返回的列信息
+  std::string ok;
+  store_int1(ok, 0);
+  store_int4(ok, stmt_id);
+  store_int2(ok, 0);  // column count
+  store_int2(ok, param_count);
+  store_int1(ok, 0);
+  store_int2(ok, 0);  // warning count
+  RC rc = send_packet(ok);
+  if (RC_FAIL(rc) || param_count == 0) {
+    return rc;
+  }
+
+  for (uint16_t i = 0; i < param_count; i++) {
+    std::string def;
+    store_lenenc_str(def, "def");
+    store_lenenc_str(def, "");
+    store_lenenc_str(def, "");
+    store_lenenc_str(def, "");
+    store_lenenc_str(def, "?");
+    store_lenenc_str(def, "");
+    store_int1(def, 0x0c);
+    store_int2(def, CHARSET_BINARY);
+    store_int4(def, 0);
+    store_int1(def, MYSQL_TYPE_VAR_STRING);
+    store_int2(def, 0);
+    store_int1(def, 0);
+    store_int2(def, 0);
+    rc = send_packet(def);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return send_eof();
+}
+
+RC MysqlCommunicator::handle_stmt_execute(const char *payload, int32_t size, SessionRequest *&event)
+{
+  PacketReader reader(payload, size);
+  uint64_t stmt_id = 0;
+  if (!reader.read_int(4, stmt_id) || !reader.skip(1 + 4)) {
+    return send_error("Malformed COM_STMT_EXECUTE");
+  }
+
+  auto iter = statements_.find(static_cast<uint32_t>(stmt_id));
+  if (iter == statements_.end()) {
+    return send_error("Unknown prepared statement handler " + std::to_string(stmt_id));
+  }
+
+  PreparedStatement &stmt = iter->second;
+  const size_t param_count = stmt.fragments.size() - 1;
+  std::string sql = stmt.fragments[0];
+  if (param_count > 0) {
+    const char *null_bitmap = nullptr;
+    uint64_t new_params_bound = 0;
+    if (!reader.read_bytes((param_count + 7) / 8, null_bitmap) || !reader.read_int(1, new_params_bound)) {
+      return send_error("Malformed COM_STMT_EXECUTE");
+    }
+
+    if (new_params_bound == 1) {
+      stmt.param_types.resize(param_count);
+      for (size_t i = 0; i < param_count; i++) {
+        uint64_t type = 0;
+        if (!reader.read_int(2, type)) {
+          return send_error("Malformed COM_STMT_EXECUTE");
+        }
+        stmt.param_types[i] = static_cast<uint16_t>(type);
+      }
+    } else if (stmt.param_types.size() != param_count) {
+      return send_error("Parameters of prepared statement are not bound");
+    }
+
+    for (size_t i = 0; i < param_count; i++) {
+      std::string literal;
+      if (null_bitmap[i / 8] & (1 << (i % 8))) {
+        literal = "null";
+      } else if (RC_FAIL(param_to_literal(stmt.param_types[i], reader, literal))) {
+        return send_error("Malformed parameter " + std::to_string(i));
+      }
+      sql.append(literal);
+      sql.append(stmt.fragments[i + 1]);
+    }
+  }
+
+  LOG_INFO("execute prepared statement %u: %s", static_cast<uint32_t>(stmt_id), sql.c_str());
+  event = new SessionRequest(this);
+  event->set_query(sql);
+  event->set_binary_result(true);
+  return RC::SUCCESS;
+}
+
+RC MysqlCommunicator::send_packet(const std::string &payload)
+{
+  size_t offset = 0;
+  while (true) {
+    const int32_t len = std::min<size_t>(payload.size() - offset, MAX_PACKET_PAYLOAD);
+    std::string header;
+    store_int3(header, len);
+    store_int1(header, sequence_id_++);
+
+    RC rc = write_result(header.data(), header.size());
+    if (RC_SUCC(rc)) {
+      rc = write_result(payload.data() + offset, len);
+    }
+    if (RC_FAIL(rc)) {
+      LOG_WARN("failed to send packet to %s. rc=%s", addr(), strrc(rc));
+      return rc;
+    }
+
+    offset += len;
+    // 长度正好是16M时需要再发送一个空的消息表示结束
+    if (len < MAX_PACKET_PAYLOAD) {
+      return RC::SUCCESS;
+    }
+  }
+}
+
+RC MysqlCommunicator::send_ok(const std::string &info)
+{
+  std::string ok;
+  store_int1(ok, 0x00);
+  store_lenenc_int(ok, 0);  // affected rows
+  store_lenenc_int(ok, 0);  // last insert id
+  store_int2(ok, SERVER_STATUS_AUTOCOMMIT);
+  store_int2(ok, 0);  // warnings
+  ok.append(info);
+  return send_packet(ok);
+}
+
+RC MysqlCommunicator::send_error(const std::string &message)
+{
+  std::string err;
+  store_int1(err, 0xff);
+  store_int2(err, ER_UNKNOWN_ERROR);
+  err.append("#HY000");
+  err.append(message);
+  return send_packet(err);
+}
+
+RC MysqlCommunicator::send_eof()
+{
+  std::string eof;
+  store_int1(eof, 0xfe);
+  store_int2(eof, 0);  // warnings
+  store_int2(eof, SERVER_STATUS_AUTOCOMMIT);
+  return send_packet(eof);
+}
+
+RC MysqlCommunicator::write_state(SqlResult *sql_result, bool &need_disconnect)
+{
+  RC rc = RC::SUCCESS;
+  if (sql_result->return_code() == RC::SUCCESS) {
+    rc = send_ok(sql_result->state_string());
+  } else {
+    std::string message = sql_result->state_string();
+    if (message.empty()) {
+      message = strrc(sql_result->return_code());
+    }
+    rc = send_error(message);
+  }
+
+  need_disconnect = RC_FAIL(rc);
+  return RC_FAIL(rc) ? RC::IOERR_WRITE : RC::SUCCESS;
+}
+
+RC MysqlCommunicator::write_result(const char *data, int32_t size)
+{
+  if (result_capture_ != nullptr) {
+    result_capture_->append(data, size);
+  }
+  return writer_->writen(data, size);
+}
+
+RC MysqlCommunicator::send_column_definitions(const std::vector<std::string> &names, const std::vector<uint8_t> &types)
+{
+  std::string count;
+  store_lenenc_int(count, names.size());
+  RC rc = send_packet(count);
+  if (RC_FAIL(rc)) {
+    return rc;
+  }
+
+  for (size_t i = 0; i < names.size(); i++) {
+    const uint8_t type = types[i];
+    const bool is_string = (type == MYSQL_TYPE_VAR_STRING || type == MYSQL_TYPE_DATE);
+    uint32_t column_length = 65535;
+    switch (type) {
+      case MYSQL_TYPE_TINY: column_length = 1; break;
+      case MYSQL_TYPE_LONG: column_length = 11; break;
+      case MYSQL_TYPE_FLOAT: column_length = 12; break;
+      case MYSQL_TYPE_DATE: column_length = 10; break;
+      default: break;
+    }
+
+    std::string def;
+    store_lenenc_str(def, "def");  // catalog
+    store_lenenc_str(def, "");     // schema
+    store_lenenc_str(def, "");     // table
+    store_lenenc_str(def, "");     // org_table
+    store_lenenc_str(def, names[i]);
+    store_lenenc_str(def, names[i]);
+    store_int1(def, 0x0c);
+    store_int2(def, is_string ? CHARSET_UTF8 : CHARSET_BINARY);
+    store_int4(def, column_length);
+    store_int1(def, type);
+    store_int2(def, is_string ? 0 : NUM_FLAG);
+    store_int1(def, type == MYSQL_TYPE_FLOAT ? 0x1f : 0);  // decimals
+    store_int2(def, 0);
+    rc = send_packet(def);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return send_eof();
+}
+
+RC MysqlCommunicator::send_text_row(Tuple &tuple, int cell_num)
+{
+  std::string row;
+  for (int i = 0; i < cell_num; i++) {
+    Value value;
+    RC rc = tuple.cell_at(i, value);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    if (value.attr_type() == NULLS) {
+      store_int1(row, 0xfb);
+      continue;
+    }
+
+    std::string value_str;
+    rc = value_to_string(value, value_str);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    store_lenenc_str(row, value_str);
+  }
+  return send_packet(row);
+}
+
+RC MysqlCommunicator::send_binary_row(Tuple &tuple, const std::vector<uint8_t> &types)
+{
+  const int cell_num = types.size();
+  std::string row;
+  store_int1(row, 0x00);
+  // 二进制格式的NULL位图，前两位保留
+  const size_t bitmap_offset = row.size();
+  row.append((cell_num + 7 + 2) / 8, '\0');
+
+  for (int i = 0; i < cell_num; i++) {
+    Value value;
+    RC rc = tuple.cell_at(i, value);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    if (value.attr_type() == NULLS) {
+      row[bitmap_offset + (i + 2) / 8] |= static_cast<char>(1 << ((i + 2) % 8));
+      continue;
+    }
+
+    if (types[i] != MYSQL_TYPE_VAR_STRING && types[i] != column_type_of(value.attr_type())) {
+      // 定长类型按照列的类型编码，不能把其他类型的值转换之后发送
+      LOG_WARN("value type mismatch with column. column=%d, value type=%s", i, attr_type_to_string(value.attr_type()));
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
+
+    switch (types[i]) {
+      case MYSQL_TYPE_TINY: {
+        store_int1(row, value.get_boolean() ? 1 : 0);
+      } break;
+      case MYSQL_TYPE_LONG: {
+        store_int4(row, static_cast<uint32_t>(value.get_int()));
+      } break;
+      case MYSQL_TYPE_FLOAT: {
+        float f = value.get_float();
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        store_int4(row, bits);
+      } break;
+      case MYSQL_TYPE_DATE: {
+        int date = value.get_int();
+        store_int1(row, 4);
+        store_int2(row, date / 10000);
+        store_int1(row, (date % 10000) / 100);
+        store_int1(row, date % 100);
+      } break;
+      default: {
+        std::string value_str;
+        rc = value_to_string(value, value_str);
+        if (RC_FAIL(rc)) {
+          return rc;
+        }
+        store_lenenc_str(row, value_str);
+      } break;
+    }
+  }
+  return send_packet(row);
+}
+
+RC MysqlCommunicator::write_result_set(SessionRequest *request, bool &need_disconnect)
+{
+  need_disconnect = true;
+  SqlResult *sql_result = request->sql_result();
+  if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
+    return write_state(sql_result, need_disconnect);
+  }
+
+  RC rc = sql_result->init();
+  if (RC_FAIL(rc)) {
+    sql_result->close();
+    sql_result->set_return_code(rc);
+    return write_state(sql_result, need_disconnect);
+  }
+
+  const TupleSchema &schema = sql_result->tuple_schema();
+  const int cell_num = schema.cell_num();
+  Tuple *tuple = nullptr;
+  if (cell_num == 0) {
+    // 没有表头的是insert/delete等操作，执行完成之后返回OK或者ERR
+    while (RC::SUCCESS == (rc = sql_result->next_tuple(tuple))) {}
+    if (rc == RC::RECORD_EOF) {
+      rc = RC::SUCCESS;
+    }
+    RC rc_close = sql_result->close();
+    if (RC_SUCC(rc)) {
+      rc = rc_close;
+    }
+    sql_result->set_return_code(rc);
+    return write_state(sql_result, need_disconnect);
+  }
+
+  // 列的类型来自schema，不依赖第一行的值，第一行是NULL时类型也不会变
+  std::vector<std::string> names;
+  std::vector<uint8_t> types;
+  for (int i = 0; i < cell_num; i++) {
+    const TupleCellSpec &cell = schema.cell_at(i);
+    names.emplace_back(cell.alias() == nullptr ? "" : cell.alias());
+    types.push_back(column_type_of(cell.type()));
+  }
+
+  // 先取第一行，出错时还没有发送任何数据
+  rc = sql_result->next_tuple(tuple);
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    // 还没有发送任何数据，直接返回错误
+    sql_result->close();
+    sql_result->set_return_code(rc);
+    return write_state(sql_result, need_disconnect);
+  }
+
+  RC send_rc = send_column_definitions(names, types);
+  const bool binary = request->binary_result();
+  while (RC_SUCC(send_rc) && rc == RC::SUCCESS) {
+    send_rc = binary ? send_binary_row(*tuple, types) : send_text_row(*tuple, cell_num);
+    if (send_rc == RC::SCHEMA_FIELD_TYPE_MISMATCH) {
+      // 这一行还没有发送，当做查询出错返回ERR包
+      rc = send_rc;
+      send_rc = RC::SUCCESS;
+      break;
+    }
+    if (RC_SUCC(send_rc)) {
+      rc = sql_result->next_tuple(tuple);
+    }
+  }
+
+  if (RC_FAIL(send_rc)) {
+    LOG_WARN("failed to send result set to %s. rc=%s", addr(), strrc(send_rc));
+    sql_result->close();
+    return send_rc;
+  }
+
+  RC rc_close = sql_result->close();
+  if (rc == RC::RECORD_EOF) {
+    rc = rc_close;
+  }
+  if (RC_FAIL(rc)) {
+    // 结果集发送到一半出错，可以直接发送ERR包
+    send_error(strrc(rc));
+    need_disconnect = false;
+    return rc;
+  }
+
+  rc = send_eof();
+  need_disconnect = RC_FAIL(rc);
+  return rc;
+}
@@ -3,74 +3,221 @@
 #include "include/session/session_request.h"
 #include "include/session/session.h"
 #include "common/io/io.h"
+#include "include/session/binary_result_protocol.h"
+#include "include/session/column_batch.h"
+#include "include/session/compression_protocol.h"
+#include "include/session/cancel_protocol.h"
+#include "include/query_engine/executor/execution_engine.h"
+#include "include/query_engine/structor/tuple/tuple.h"
 #include "common/log/log.h"
 
-RC PlainCommunicator::read_event(SessionRequest *&event)
+using namespace binary_result;
+
+static void append_end_frame(std::string &frames, RC rc, const std::string &state)
 {
-  RC rc = RC::SUCCESS;
+  size_t frame = begin_frame(frames, FRAME_END);
+  const char *rc_name = strrc(rc);
+  put_u32(frames, static_cast<uint32_t>(rc));
+  put_u16(frames, strlen(rc_name));
+  frames.append(rc_name);
+  put_u32(frames, state.size());
+  frames.append(state);
+  finish_frame(frames, frame);
+}
 
+RC PlainCommunicator::read_event(SessionRequest *&event)
+{
   event = nullptr;
 
-  int data_len = 0;
-  int read_len = 0;
-
-  const int max_packet_size = 65535*2;
-  std::vector<char> buf(max_packet_size);
-
-  // 持续接收消息，直到遇到'\0'。将'\0'遇到的后续数据直接丢弃没有处理，因为目前仅支持一收一发的模式
+  // 客户端可能连续发送了多个消息，一次读取到的数据可能包含多个消息，剩余的数据留给下次处理
+  char buf[16 * 1024];
   while (true) {
-    read_len = ::read(fd_, buf.data() + data_len, max_packet_size - data_len);
+    int32_t consumed = 0;
+    RC rc = parse_event(recv_buffer_.data(), recv_buffer_.size(), consumed, event);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    recv_buffer_.erase(0, consumed);
+    if (event != nullptr) {
+      return RC::SUCCESS;
+    }
+    if (consumed > 0) {
+      // 消息已经处理，比如协商二进制结果集
+      continue;
+    }
+
+    ssize_t read_len = ::read(fd_, buf, sizeof(buf));
     if (read_len < 0) {
-      if (errno == EAGAIN) {
+      if (errno == EINTR) {
         continue;
       }
-      break;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // 还没有收到完整的消息，等待下次可读
+        return RC::SUCCESS;
+      }
+      LOG_ERROR("Failed to read socket of %s, %s", addr(), strerror(errno));
+      return RC::IOERR_READ;
     }
     if (read_len == 0) {
-      break;
+      LOG_INFO("The peer has been closed %s", addr());
+      return RC::IOERR_CLOSE;
     }
+    recv_buffer_.append(buf, read_len);
+  }
+}
 
-    if (read_len + data_len > max_packet_size) {
-      data_len += read_len;
-      break;
-    }
+RC PlainCommunicator::parse_event(const char *data, int32_t size, int32_t &consumed, SessionRequest *&event)
+{
+  consumed = 0;
+  event = nullptr;
 
-    bool msg_end = false;
-    for (int i = 0; i < read_len; i++) {
-      if (buf[data_len + i] == 0) {
-        data_len += i + 1;
-        msg_end = true;
-        break;
-      }
+  if (!pending_requests_.empty()) {
+    event = pending_requests_.front();
+    pending_requests_.pop_front();
+    return RC::SUCCESS;
+  }
+
+  const char *msg_end = size > 0 ? static_cast<const char *>(memchr(data, 0, size)) : nullptr;
+  if (msg_end == nullptr) {
+    if (size > MAX_PACKET_SIZE) {
+      LOG_WARN("The length of sql exceeds the limitation %d", MAX_PACKET_SIZE);
+      return RC::IOERR_TOO_LONG;
     }
+    return RC::SUCCESS;
+  }
 
-    if (msg_end) {
-      break;
+  consumed = static_cast<int32_t>(msg_end - data) + 1;
+  LOG_INFO("receive command(size=%d): %s", consumed, data);
+  return make_request(data, msg_end - data, event);
+}
+
+bool PlainCommunicator::has_pending_request() const
+{
+  return !pending_requests_.empty() || memchr(recv_buffer_.data(), 0, recv_buffer_.size()) != nullptr;
+}
+
+RC PlainCommunicator::make_request(const char *data, int32_t size, SessionRequest *&event)
+{
+  event = nullptr;
+
+  // 连接建立之后、第一个请求之前，客户端可以协商二进制结果集和压缩
+  if (negotiating_) {
+    auto is_hello = [data, size](const char *hello, size_t hello_size) {
+      return static_cast<size_t>(size) == hello_size - 1 && 0 == memcmp(data, hello, size);
+    };
+    if (is_hello(binary_result::HELLO, sizeof(binary_result::HELLO))) {
+      LOG_INFO("client %s uses binary result set", addr());
+      binary_result_ = true;
+      RC rc = writer_->writen(binary_result::HELLO_ACK, sizeof(binary_result::HELLO_ACK));
+      writer_->flush();
+      return rc;
+    }
+    if (is_hello(compression::HELLO, sizeof(compression::HELLO))) {
+      LOG_INFO("client %s uses compression", addr());
+      RC rc = writer_->writen(compression::HELLO_ACK, sizeof(compression::HELLO_ACK));
+      writer_->flush();
+      writer_->set_compression(true);
+      return rc;
+    }
+    if (is_hello(cancel::HELLO, sizeof(cancel::HELLO))) {
+      std::string session_id = std::to_string(session_id_);
+      RC rc = writer_->writen(session_id.c_str(), session_id.size() + 1);
+      writer_->flush();
+      return rc;
     }
+    negotiating_ = false;
+  }
 
-    data_len += read_len;
+  if (size > 0 && data[0] == BATCH_PREFIX) {
+    RC rc = expand_batch(data + 1, size - 1);
+    if (RC_FAIL(rc)) {
+      // 参数不正确时回复一个错误，不影响后面的消息
+      SqlResult sql_result(session_);
+      sql_result.set_return_code(rc);
+      sql_result.set_state_string("invalid batch message");
+      bool need_disconnect = false;
+      rc = write_state(&sql_result, need_disconnect);
+      writer_->flush();
+      return rc;
+    }
+    if (!pending_requests_.empty()) {
+      event = pending_requests_.front();
+      pending_requests_.pop_front();
+    }
+    return RC::SUCCESS;
   }
 
-  if (data_len > max_packet_size) {
-    LOG_WARN("The length of sql exceeds the limitation %d", max_packet_size);
-    return RC::IOERR_TOO_LONG;
+  event = new SessionRequest(this);
+  event->set_query(std::string(data, size));
+  event->set_binary_result(binary_result_);
+  return RC::SUCCESS;
+}
+
+RC PlainCommunicator::expand_batch(const char *data, int32_t size)
+{
+  const char *end = data + size;
+  const char *row_begin = static_cast<const char *>(memchr(data, BATCH_ROW_SEP, size));
+  if (row_begin == nullptr) {
+    LOG_WARN("batch message without parameters from %s", addr());
+    return RC::INVALID_ARGUMENT;
   }
-  if (read_len == 0) {
-    LOG_INFO("The peer has been closed %s", addr());
-    return RC::IOERR_CLOSE;
-  } else if (read_len < 0) {
-    LOG_ERROR("Failed to read socket of %s, %s", addr(), strerror(errno));
-    return RC::IOERR_READ;
+
+  std::vector<std::string> fragments;
+  split_statement_template(std::string(data, row_begin), fragments);
+  const size_t param_count = fragments.size() - 1;
+
+  std::vector<SessionRequest *> requests;
+  while (row_begin < end) {
+    const char *row_end = static_cast<const char *>(memchr(row_begin + 1, BATCH_ROW_SEP, end - row_begin - 1));
+    if (row_end == nullptr) {
+      row_end = end;
+    }
+
+    // 逐个参数替换SQL中的'?'
+    std::string sql = fragments[0];
+    const char *param = row_begin + 1;
+    size_t param_index = 0;
+    while (param_count > 0 && param <= row_end) {
+      const char *param_end = static_cast<const char *>(memchr(param, BATCH_PARAM_SEP, row_end - param));
+      if (param_end == nullptr) {
+        param_end = row_end;
+      }
+      if (++param_index > param_count) {
+        break;
+      }
+      sql.append(param, param_end);
+      sql.append(fragments[param_index]);
+      param = param_end + 1;
+    }
+
+    if (param_index != param_count) {
+      LOG_WARN("batch parameters mismatch. expect %d, got %d. addr=%s", (int)param_count, (int)param_index, addr());
+      for (SessionRequest *request : requests) {
+        delete request;
+      }
+      return RC::INVALID_ARGUMENT;
+    }
+
+    SessionRequest *request = new SessionRequest(this);
+    request->set_query(sql);
+    request->set_binary_result(binary_result_);
+    requests.push_back(request);
+    row_begin = row_end;
   }
 
-  LOG_INFO("receive command(size=%d): %s", data_len, buf.data());
-  event = new SessionRequest(this);
-  event->set_query(std::string(buf.data()));
-  return rc;
+  LOG_INFO("expand batch message into %d requests. addr=%s", (int)requests.size(), addr());
+  pending_requests_.insert(pending_requests_.end(), requests.begin(), requests.end());
+  return RC::SUCCESS;
 }
 
 RC PlainCommunicator::write_state(SqlResult *sql_result, bool &need_disconnect)
 {
+  if (binary_result_) {
+    std::string frames;
+    append_end_frame(frames, sql_result->return_code(), sql_result->state_string());
+    return write_frames(frames, need_disconnect);
+  }
+
   const int buf_size = 2048;
   char *buf = new char[buf_size];
   const std::string &state_string = sql_result->state_string();
@@ -102,8 +249,121 @@ RC PlainCommunicator::write_state(SqlResult *sql_result, bool &need_disconnect)
 
 RC PlainCommunicator::write_result(const char *data, int32_t size)
 {
+  if (result_capture_ != nullptr) {
+    result_capture_->append(data, size);
+  }
   return writer_->writen(data, size);
 }
+RC PlainCommunicator::write_frames(const std::string &frames, bool &need_disconnect)
+{
+  RC rc = write_result(frames.data(), frames.size());
+  if (RC_FAIL(rc)) {
+    LOG_WARN("failed to send data to client. err=%s", strerror(errno));
+    need_disconnect = true;
+    return RC::IOERR_WRITE;
+  }
+  need_disconnect = false;
+  return RC::SUCCESS;
+}
+
+RC PlainCommunicator::write_result_set(SessionRequest *request, bool &need_disconnect)
+{
+  need_disconnect = true;
+  SqlResult *sql_result = request->sql_result();
+  if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
+    return write_state(sql_result, need_disconnect);
+  }
+
+  RC rc = sql_result->init();
+  if (RC_FAIL(rc)) {
+    sql_result->close();
+    sql_result->set_return_code(rc);
+    return write_state(sql_result, need_disconnect);
+  }
+
+  const TupleSchema &schema = sql_result->tuple_schema();
+  const int cell_num = schema.cell_num();
+  Tuple *tuple = nullptr;
+  std::string frames;
+  if (cell_num == 0) {
+    // insert/delete等操作没有结果集，只返回处理结果
+    while (RC::SUCCESS == (rc = sql_result->next_tuple(tuple))) {}
+    if (rc == RC::RECORD_EOF) {
+      rc = RC::SUCCESS;
+    }
+    RC rc_close = sql_result->close();
+    if (RC_SUCC(rc)) {
+      rc = rc_close;
+    }
+    sql_result->set_return_code(rc);
+    return write_state(sql_result, need_disconnect);
+  }
+
+  // 列的类型由schema决定，和第一行的值无关
+  std::vector<ColumnType> types;
+  size_t frame = begin_frame(frames, FRAME_SCHEMA);
+  put_u16(frames, cell_num);
+  for (int i = 0; i < cell_num; i++) {
+    types.push_back(column_type_of(schema.cell_at(i).type()));
+    const char *alias = schema.cell_at(i).alias();
+    const size_t alias_len = alias == nullptr ? 0 : strlen(alias);
+    frames.push_back(types[i]);
+    put_u16(frames, alias_len);
+    frames.append(alias == nullptr ? "" : alias, alias_len);
+  }
+  finish_frame(frames, frame);
+
+  ColumnBatch batch(types);
+  RC send_rc = RC::SUCCESS;
+  rc = sql_result->next_tuple(tuple);
+  while (rc == RC::SUCCESS) {
+    rc = batch.append(*tuple);
+    if (RC_FAIL(rc)) {
+      break;
+    }
+    if (batch.rows() >= BATCH_ROWS) {
+      batch.encode(frames);
+      send_rc = write_frames(frames, need_disconnect);
+      frames.clear();
+      if (RC_FAIL(send_rc)) {
+        sql_result->close();
+        return send_rc;
+      }
+    }
+    rc = sql_result->next_tuple(tuple);
+  }
+
+  if (batch.rows() > 0) {
+    batch.encode(frames);
+  }
+
+  RC rc_close = sql_result->close();
+  if (rc == RC::RECORD_EOF) {
+    rc = rc_close;
+  }
+  append_end_frame(frames, rc, RC_SUCC(rc) ? std::string() : sql_result->state_string());
+  return write_frames(frames, need_disconnect);
+}
+
 PlainCommunicator::PlainCommunicator() {
   send_message_delimiter_.assign(1, '\0');
 }
+
+PlainCommunicator::~PlainCommunicator()
+{
+  for (SessionRequest *request : pending_requests_) {
+    delete request;
+  }
+}
+
+void PlainCommunicator::reset()
+{
+  Communicator::reset();
+  for (SessionRequest *request : pending_requests_) {
+    delete request;
+  }
+  pending_requests_.clear();
+  recv_buffer_.clear();
+  negotiating_ = true;
+  binary_result_ = false;
+}
@@ -1,7 +1,15 @@
+#include <mutex>
+#include <pthread.h>
+
 #include "include/session/server.h"
+#include "include/session/epoll_reactor.h"
 #include "include/query_engine/query_engine.h"
+#include "include/query_engine/parser/parser.h"
+#include "common/lang/mutex.h"
 
 QueryEngine Server::query_engine_ = QueryEngine();
+WorkerPool Server::sql_worker_pool_;
+ConnectionPool Server::connection_pool_;
 
 ServerParam::ServerParam()
 {
@@ -12,6 +20,7 @@ ServerParam::ServerParam()
 
 Server::Server(ServerParam input_server_param) : server_param_(input_server_param)
 {
+  connection_pool_.init(server_param_.protocol, server_param_.connection_pool);
 }
 
 Server::~Server()
@@ -46,7 +55,7 @@ void Server::close_connection(Communicator *communicator)
 {
   LOG_INFO("Close connection of %s.", communicator->addr());
   event_del(&communicator->read_event());
-  delete communicator;
+  connection_pool_.close(communicator);
 }
 
 void Server::recv(int fd, short ev, void *arg)
@@ -61,14 +70,72 @@ void Server::recv(int fd, short ev, void *arg)
   }
 
   if (event == nullptr) {
-    LOG_WARN("event is null while read event return success");
+    // 消息已经由通讯层处理，比如mysql协议的认证和PING
+    LOG_TRACE("no request to execute. addr=%s", comm->addr());
+    event_add(&comm->read_event(), nullptr);
     return;
   }
-  bool need_disconnect = query_engine_.process_session_request(event);
-  if(need_disconnect){
+
+  // 提交之后请求可能已经执行完成，连接也可能已经关闭，不能再访问comm
+  if (!sql_worker_pool_.submit([event]() { process_request(event); })) {
+    LOG_WARN("failed to submit request, server is stopping. addr=%s", comm->addr());
+    delete event;
+    close_connection(comm);
+  }
+}
+
+bool Server::execute_request(SessionRequest *request)
+{
+  bool need_disconnect = true;
+  {
+#ifndef CONCURRENCY
+    // 没有打开CONCURRENCY编译选项时存储引擎没有并发保护，同一时刻只执行一个请求。
+    // KILL QUERY 不访问存储引擎，不需要等待正在执行的请求(往往就是要取消的语句)结束。
+    // 语法解析不访问存储引擎，在加锁之前完成，解析结果留给执行时使用
+    static common::ProfiledMutex engine_lock("server.engine");
+    std::unique_lock<common::ProfiledMutex> guard(engine_lock, std::defer_lock);
+    if (Parser::preparse(request) != SCF_KILL_QUERY) {
+      guard.lock();
+    }
+#endif
+    // 打开会话复用时连接在两个请求之间可能没有会话
+    Communicator *communicator = request->get_communicator();
+    request->sql_result()->set_session(communicator->bind_session());
+    need_disconnect = query_engine_.process_session_request(request);
+    if (!need_disconnect && !communicator->has_pending_request()) {
+      communicator->unbind_session();
+    }
+  }
+  delete request;
+  return need_disconnect;
+}
+
+void Server::process_request(SessionRequest *request)
+{
+  Communicator *comm = request->get_communicator();
+
+  bool need_disconnect = execute_request(request);
+  // 已经接收到的请求不会再触发可读事件，需要在这里处理完
+  while (!need_disconnect && comm->has_pending_request()) {
+    request = nullptr;
+    RC rc = comm->read_event(request);
+    if (RC_FAIL(rc)) {
+      need_disconnect = true;
+    } else if (request != nullptr) {
+      need_disconnect = execute_request(request);
+    }
+  }
+
+  if (need_disconnect) {
     close_connection(comm);
     return;
   }
+
+  int ret = event_add(&comm->read_event(), nullptr);
+  if (ret < 0) {
+    LOG_ERROR("Failed to event_add for read event of %s into libevent, %s", comm->addr(), strerror(errno));
+    close_connection(comm);
+  }
 }
 
 void Server::accept(int fd, short ev, void *arg)
@@ -113,28 +180,28 @@ void Server::accept(int fd, short ev, void *arg)
     }
   }
 
-  Communicator *communicator = instance->communicator_factory_.create(instance->server_param_.protocol);
-  RC rc = communicator->init(client_fd, new Session(Session::default_session()), addr_str);
+  Communicator *communicator = nullptr;
+  RC rc = connection_pool_.open(client_fd, addr_str, communicator);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init communicator. rc=%s", strrc(rc));
-    delete communicator;
     return;
   }
 
-  event_set(&communicator->read_event(), client_fd, EV_READ | EV_PERSIST, recv, communicator);
+  // 不使用EV_PERSIST，每次读取到请求之后读事件就不再监听，请求执行完成后再重新加入
+  event_set(&communicator->read_event(), client_fd, EV_READ, recv, communicator);
 
-  ret = event_base_set(instance->event_base_, &communicator->read_event());
+  ret = event_base_set(instance->next_io_base(), &communicator->read_event());
   if (ret < 0) {
     LOG_ERROR("Failed to do event_base_set for read event of %s into libevent, %s", 
               communicator->addr(), strerror(errno));
-    delete communicator;
+    connection_pool_.close(communicator);
     return;
   }
 
   ret = event_add(&communicator->read_event(), nullptr);
   if (ret < 0) {
     LOG_ERROR("Failed to event_add for read event of %s into libevent, %s", communicator->addr(), strerror(errno));
-    delete communicator;
+    connection_pool_.close(communicator);
     return;
   }
 
@@ -152,31 +219,40 @@ int Server::start()
   }
 }
 
-int Server::start_tcp_server()
+int Server::create_tcp_socket(bool reuse_port)
 {
   int ret = 0;
   struct sockaddr_in sa;
 
-  server_socket_ = socket(AF_INET, SOCK_STREAM, 0);
-  if (server_socket_ < 0) {
+  int server_socket = socket(AF_INET, SOCK_STREAM, 0);
+  if (server_socket < 0) {
     LOG_ERROR("socket(): can not create server socket: %s.", strerror(errno));
     return -1;
   }
 
   int yes = 1;
   int recvBufferSize = 65535*2;
-  ret = setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
-  ret = setsockopt(server_socket_, SOL_SOCKET, SO_RCVBUF, &recvBufferSize, sizeof(recvBufferSize));
+  ret = setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  ret = setsockopt(server_socket, SOL_SOCKET, SO_RCVBUF, &recvBufferSize, sizeof(recvBufferSize));
   if (ret < 0) {
     LOG_ERROR("Failed to set socket option of reuse address: %s.", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
-  ret = set_non_block(server_socket_);
+  if (reuse_port) {
+    ret = setsockopt(server_socket, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes));
+    if (ret < 0) {
+      LOG_ERROR("Failed to set socket option of reuse port: %s.", strerror(errno));
+      ::close(server_socket);
+      return -1;
+    }
+  }
+
+  ret = set_non_block(server_socket);
   if (ret < 0) {
     LOG_ERROR("Failed to set socket option non-blocking:%s. ", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
@@ -185,53 +261,36 @@ int Server::start_tcp_server()
   sa.sin_port = htons(server_param_.port);
   sa.sin_addr.s_addr = htonl(server_param_.listen_addr);
 
-  ret = ::bind(server_socket_, (struct sockaddr *)&sa, sizeof(sa));
+  ret = ::bind(server_socket, (struct sockaddr *)&sa, sizeof(sa));
   if (ret < 0) {
     LOG_ERROR("bind(): can not bind server socket, %s", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
-  ret = listen(server_socket_, server_param_.max_connection_num);
+  ret = listen(server_socket, server_param_.max_connection_num);
   if (ret < 0) {
     LOG_ERROR("listen(): can not listen server socket, %s", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
   LOG_INFO("Listen on port %d", server_param_.port);
-
-  listen_ev_ = event_new(event_base_, server_socket_, EV_READ | EV_PERSIST, accept, this);
-  if (listen_ev_ == nullptr) {
-    LOG_ERROR("Failed to create listen event, %s.", strerror(errno));
-    ::close(server_socket_);
-    return -1;
-  }
-
-  ret = event_add(listen_ev_, nullptr);
-  if (ret < 0) {
-    LOG_ERROR("event_add(): can not add accept event into libevent, %s", strerror(errno));
-    ::close(server_socket_);
-    return -1;
-  }
-
-  started_ = true;
-  LOG_INFO("Observer start success");
-  return 0;
+  return server_socket;
 }
 
-int Server::start_unix_socket_server()
+int Server::create_unix_socket()
 {
   int ret = 0;
-  server_socket_ = socket(PF_UNIX, SOCK_STREAM, 0);
-  if (server_socket_ < 0) {
+  int server_socket = socket(PF_UNIX, SOCK_STREAM, 0);
+  if (server_socket < 0) {
     LOG_ERROR("socket(): can not create unix socket: %s.", strerror(errno));
     return -1;
   }
 
-  ret = set_non_block(server_socket_);
+  ret = set_non_block(server_socket);
   if (ret < 0) {
     LOG_ERROR("Failed to set socket option non-blocking:%s. ", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
@@ -242,21 +301,43 @@ int Server::start_unix_socket_server()
   sockaddr.sun_family = PF_UNIX;
   snprintf(sockaddr.sun_path, sizeof(sockaddr.sun_path), "%s", server_param_.unix_socket_path.c_str());
 
-  ret = ::bind(server_socket_, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
+  ret = ::bind(server_socket, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
   if (ret < 0) {
     LOG_ERROR("bind(): can not bind server socket(path=%s), %s", sockaddr.sun_path, strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
-  ret = listen(server_socket_, server_param_.max_connection_num);
+  ret = listen(server_socket, server_param_.max_connection_num);
   if (ret < 0) {
     LOG_ERROR("listen(): can not listen server socket, %s", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
   LOG_INFO("Listen on unix socket: %s", sockaddr.sun_path);
+  return server_socket;
+}
+
+int Server::start_tcp_server()
+{
+  server_socket_ = create_tcp_socket(false /*reuse_port*/);
+  if (server_socket_ < 0) {
+    return -1;
+  }
+  return start_listen_event();
+}
 
+int Server::start_unix_socket_server()
+{
+  server_socket_ = create_unix_socket();
+  if (server_socket_ < 0) {
+    return -1;
+  }
+  return start_listen_event();
+}
+
+int Server::start_listen_event()
+{
   listen_ev_ = event_new(event_base_, server_socket_, EV_READ | EV_PERSIST, accept, this);
   if (listen_ev_ == nullptr) {
     LOG_ERROR("Failed to create listen event, %s.", strerror(errno));
@@ -264,7 +345,7 @@ int Server::start_unix_socket_server()
     return -1;
   }
 
-  ret = event_add(listen_ev_, nullptr);
+  int ret = event_add(listen_ev_, nullptr);
   if (ret < 0) {
     LOG_ERROR("event_add(): can not add accept event into libevent, %s", strerror(errno));
     ::close(server_socket_);
@@ -301,8 +382,9 @@ int Server::start_stdin_server()
 
     /// 在当前线程立即处理对应的事件
     bool need_disconnect = query_engine_.process_session_request(event);
+    delete event;
     if(need_disconnect){
-      Server::close_connection(communicator);
+      break;
     }
   }
 
@@ -311,8 +393,131 @@ int Server::start_stdin_server()
   return 0;
 }
 
+struct event_base *Server::next_io_base()
+{
+  size_t index = next_io_index_.fetch_add(1) % io_bases_.size();
+  return io_bases_[index];
+}
+
+int Server::start_threads()
+{
+  for (int i = 0; i < server_param_.io_thread_num; i++) {
+    struct event_base *io_base = event_base_new();
+    if (io_base == nullptr) {
+      LOG_ERROR("Failed to create event base for io thread, %s.", strerror(errno));
+      return -1;
+    }
+    io_bases_.push_back(io_base);
+  }
+
+  for (size_t i = 0; i < io_bases_.size(); i++) {
+    struct event_base *io_base = io_bases_[i];
+    io_threads_.emplace_back([io_base]() {
+      // 连接都还没有分配过来时event_base也不能退出
+      event_base_loop(io_base, EVLOOP_NO_EXIT_ON_EMPTY);
+    });
+    std::string thread_name = "IOThread" + std::to_string(i);
+    pthread_setname_np(io_threads_.back().native_handle(), thread_name.c_str());
+  }
+
+  sql_worker_pool_.start(server_param_.sql_thread_num, "SQLThread");
+  LOG_INFO("Started %d io thread(s) and %d sql thread(s)", server_param_.io_thread_num, server_param_.sql_thread_num);
+  return 0;
+}
+
+void Server::stop_threads()
+{
+  for (struct event_base *io_base : io_bases_) {
+    event_base_loopbreak(io_base);
+  }
+  for (std::thread &thread : io_threads_) {
+    thread.join();
+  }
+  io_threads_.clear();
+
+  sql_worker_pool_.stop();
+
+  for (struct event_base *io_base : io_bases_) {
+    event_base_free(io_base);
+  }
+  io_bases_.clear();
+}
+
+int Server::start_epoll_server()
+{
+  const bool tcp = !server_param_.use_unix_socket;
+  const int reactor_num = server_param_.io_thread_num;
+
+  // TCP每个reactor一个监听套接字，由内核通过SO_REUSEPORT分配连接。unix socket不支持，所有reactor共用一个
+  for (int i = 0; i < (tcp ? reactor_num : 1); i++) {
+    int listen_fd = tcp ? create_tcp_socket(true /*reuse_port*/) : create_unix_socket();
+    if (listen_fd < 0) {
+      return -1;
+    }
+    listen_fds_.push_back(listen_fd);
+  }
+
+  sql_worker_pool_.start(server_param_.sql_thread_num, "SQLThread");
+
+  for (int i = 0; i < reactor_num; i++) {
+    EpollReactor *reactor = new EpollReactor(i, connection_pool_, sql_worker_pool_, execute_request);
+    reactors_.push_back(reactor);
+    int listen_fd = tcp ? listen_fds_[i] : listen_fds_[0];
+    RC rc = reactor->init(listen_fd, !tcp /*shared*/, tcp);
+    if (RC_FAIL(rc)) {
+      LOG_ERROR("Failed to init epoll reactor %d. rc=%s", i, strrc(rc));
+      return -1;
+    }
+  }
+
+  for (EpollReactor *reactor : reactors_) {
+    reactor->start();
+  }
+
+  started_ = true;
+  LOG_INFO("Started %d epoll reactor(s) and %d sql thread(s)", reactor_num, server_param_.sql_thread_num);
+  return 0;
+}
+
+void Server::stop_epoll_server()
+{
+  // 先停止事件循环，再等待正在执行的请求结束，最后关闭所有连接
+  for (EpollReactor *reactor : reactors_) {
+    reactor->stop();
+    reactor->wait();
+  }
+  sql_worker_pool_.stop();
+
+  for (EpollReactor *reactor : reactors_) {
+    delete reactor;
+  }
+  reactors_.clear();
+
+  for (int listen_fd : listen_fds_) {
+    ::close(listen_fd);
+  }
+  listen_fds_.clear();
+}
+
 int Server::serve()
 {
+  if (server_param_.use_epoll && !server_param_.use_std_io) {
+    if (start_epoll_server() != 0) {
+      LOG_PANIC("Failed to start network");
+      exit(-1);
+    }
+
+    for (EpollReactor *reactor : reactors_) {
+      reactor->wait();
+    }
+    stop_epoll_server();
+    connection_pool_.clear();
+
+    started_ = false;
+    LOG_INFO("Server quit");
+    return 0;
+  }
+
   evthread_use_pthreads();
   event_base_ = event_base_new();
   if (event_base_ == nullptr) {
@@ -320,6 +525,11 @@ int Server::serve()
     exit(-1);
   }
 
+  if (!server_param_.use_std_io && start_threads() != 0) {
+    LOG_PANIC("Failed to start io and sql threads");
+    exit(-1);
+  }
+
   int retval = start();
   if (retval == -1) {
     LOG_PANIC("Failed to start network");
@@ -328,6 +538,8 @@ int Server::serve()
 
   if (!server_param_.use_std_io) {
     event_base_dispatch(event_base_);
+    stop_threads();
+    connection_pool_.clear();
   }
 
   if (listen_ev_ != nullptr) {
@@ -351,8 +563,13 @@ void Server::shutdown()
   LOG_INFO("Server shutting down");
 
   // cleanup
-  if (event_base_ != nullptr && started_) {
+  if (started_) {
     started_ = false;
-    event_base_loopexit(event_base_, nullptr);
+    if (event_base_ != nullptr) {
+      event_base_loopexit(event_base_, nullptr);
+    }
+    for (EpollReactor *reactor : reactors_) {
+      reactor->stop();
+    }
   }
 }
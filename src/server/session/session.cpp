@@ -3,6 +3,35 @@
 #include "include/storage_engine/schema/database.h"
 #include "include/storage_engine/schema/default_handler.h"
 #include "include/common/global_context.h"
+#include "common/time/timeout_info.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sys/time.h>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * @brief 所有的会话，KILL QUERY 根据编号查找会话
+ */
+std::mutex                              session_registry_lock;
+std::unordered_map<uint64_t, Session *> session_registry;
+std::atomic<uint64_t>                   next_session_id{1};
+
+/**
+ * @brief 每调用多少次 check_interrupt 真正检查一次
+ */
+constexpr int INTERRUPT_CHECK_INTERVAL = 256;
+
+int64_t now_us()
+{
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  return now.tv_sec * 1000000L + now.tv_usec;
+}
+
+}  // namespace
 
 Session &Session::default_session()
 {
@@ -10,17 +39,85 @@ Session &Session::default_session()
   return session;
 }
 
-Session::Session(const Session &other) : db_(other.db_)
-{}
+Session::Session(const Session &other)
+    : db_(other.db_),
+      sql_debug_(other.sql_debug_),
+      trace_(other.trace_),
+      statement_timeout_ms_(other.statement_timeout_ms_)
+{
+  set_id(allocate_id());
+}
 
 Session::~Session()
 {
+  set_id(0);
+  end_query();
+
   if (nullptr != trx_) {
     GCTX.trx_manager_->destroy_trx(trx_);
     trx_ = nullptr;
   }
 }
 
+uint64_t Session::allocate_id()
+{
+  return next_session_id.fetch_add(1);
+}
+
+void Session::set_id(uint64_t id)
+{
+  if (id == id_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(session_registry_lock);
+  if (id_ != 0) {
+    session_registry.erase(id_);
+  }
+  id_ = id;
+  if (id_ != 0) {
+    session_registry[id_] = this;
+  }
+}
+
+void Session::reset()
+{
+  end_query();
+  current_request_ = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(query_lock_);
+    query_sql_.clear();
+    query_db_name_.clear();
+    state_change_time_us_ = 0;
+  }
+
+  const Session &default_session = Session::default_session();
+  if (trx_ != nullptr && (trx_multi_operation_mode_ || db_ != default_session.db_)) {
+    // 未提交的事务回滚；事务对象与数据库关联，数据库变了就不能再用
+    if (trx_multi_operation_mode_) {
+      trx_->rollback();
+    }
+    if (db_ != default_session.db_) {
+      GCTX.trx_manager_->destroy_trx(trx_);
+      trx_ = nullptr;
+    }
+  }
+  trx_multi_operation_mode_ = false;
+
+  db_ = default_session.db_;
+  sql_debug_ = default_session.sql_debug_;
+  trace_ = default_session.trace_;
+  statement_timeout_ms_ = default_session.statement_timeout_ms_;
+}
+
+bool Session::is_default_state() const
+{
+  const Session &default_session = Session::default_session();
+  return !trx_multi_operation_mode_ && db_ == default_session.db_ && sql_debug_ == default_session.sql_debug_ &&
+         trace_ == default_session.trace_ &&
+         statement_timeout_ms_ == default_session.statement_timeout_ms_;
+}
+
 const char *Session::get_current_db_name() const
 {
   if (db_ != nullptr)
@@ -86,3 +183,112 @@ SessionRequest *Session::current_request() const
 {
   return current_request_;
 }
+
+void Session::begin_query(const std::string &sql)
+{
+  end_query();
+
+  // 没有设置超时时间时截止时间设置得足够远，这样仍然可以被 KILL QUERY 取消
+  struct timeval deadline;
+  gettimeofday(&deadline, nullptr);
+  if (statement_timeout_ms_ > 0) {
+    deadline.tv_sec += statement_timeout_ms_ / 1000;
+    deadline.tv_usec += (statement_timeout_ms_ % 1000) * 1000;
+    if (deadline.tv_usec >= 1000000) {
+      deadline.tv_sec += 1;
+      deadline.tv_usec -= 1000000;
+    }
+  } else {
+    deadline.tv_sec += 10L * 365 * 24 * 3600;
+  }
+
+  common::TimeoutInfo *timeout_info = new common::TimeoutInfo(deadline.tv_sec, deadline.tv_usec);
+  timeout_info->attach();
+  interrupt_countdown_ = 0;
+
+  std::lock_guard<std::mutex> guard(query_lock_);
+  timeout_info_ = timeout_info;
+  query_sql_ = sql;
+  query_db_name_ = get_current_db_name();
+  state_change_time_us_ = now_us();
+}
+
+void Session::end_query()
+{
+  common::TimeoutInfo *timeout_info = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(query_lock_);
+    timeout_info = timeout_info_;
+    timeout_info_ = nullptr;
+    if (timeout_info != nullptr) {
+      state_change_time_us_ = now_us();
+    }
+  }
+  if (timeout_info != nullptr) {
+    timeout_info->detach();
+  }
+}
+
+RC Session::check_interrupt()
+{
+  Session *session = current_session();
+  // timeout_info_ 只会在执行语句的线程中修改，这里读取不需要加锁
+  if (session == nullptr || session->timeout_info_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  if (--session->interrupt_countdown_ > 0) {
+    return RC::SUCCESS;
+  }
+  session->interrupt_countdown_ = INTERRUPT_CHECK_INTERVAL;
+  return check_interrupt_now();
+}
+
+RC Session::check_interrupt_now()
+{
+  Session *session = current_session();
+  if (session == nullptr || session->timeout_info_ == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  common::TimeoutInfo *timeout_info = session->timeout_info_;
+  if (!timeout_info->has_timed_out()) {
+    return RC::SUCCESS;
+  }
+  return timeout_info->is_cancelled() ? RC::QUERY_CANCELLED : RC::QUERY_TIMEOUT;
+}
+
+RC Session::kill_query(uint64_t session_id)
+{
+  std::lock_guard<std::mutex> registry_guard(session_registry_lock);
+  auto iter = session_registry.find(session_id);
+  if (iter == session_registry.end()) {
+    return RC::NOTFOUND;
+  }
+
+  Session *session = iter->second;
+  std::lock_guard<std::mutex> guard(session->query_lock_);
+  if (session->timeout_info_ != nullptr) {
+    session->timeout_info_->cancel();
+    LOG_INFO("query of session %lu is cancelled", (unsigned long)session_id);
+  }
+  return RC::SUCCESS;
+}
+
+void Session::list_sessions(std::vector<SessionInfo> &sessions)
+{
+  const int64_t now = now_us();
+  std::lock_guard<std::mutex> registry_guard(session_registry_lock);
+  for (auto &[id, session] : session_registry) {
+    SessionInfo info;
+    info.id = id;
+
+    std::lock_guard<std::mutex> guard(session->query_lock_);
+    info.db_name = session->query_db_name_;
+    info.running = session->timeout_info_ != nullptr;
+    info.elapsed_us = session->state_change_time_us_ == 0 ? 0 : now - session->state_change_time_us_;
+    info.sql = session->query_sql_;
+    sessions.emplace_back(std::move(info));
+  }
+
+  std::sort(sessions.begin(), sessions.end(), [](const SessionInfo &a, const SessionInfo &b) { return a.id < b.id; });
+}
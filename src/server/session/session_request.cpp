@@ -1,5 +1,6 @@
 #include "include/session/session_request.h"
 #include "include/session/communicator.h"
+#include "include/query_engine/parser/parse_defs.h"
 
 SessionRequest::SessionRequest(Communicator *comm)
     : communicator_(comm),
@@ -19,3 +20,13 @@ Session *SessionRequest::session() const
 {
   return communicator_->session();
 }
+
+void SessionRequest::set_parsed_sql(std::unique_ptr<ParsedSqlResult> parsed_sql)
+{
+  parsed_sql_ = std::move(parsed_sql);
+}
+
+std::unique_ptr<ParsedSqlResult> SessionRequest::take_parsed_sql()
+{
+  return std::move(parsed_sql_);
+}
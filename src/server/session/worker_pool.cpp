@@ -0,0 +1,67 @@
+#include <pthread.h>
+
+#include "include/session/worker_pool.h"
+#include "common/log/log.h"
+
+WorkerPool::~WorkerPool()
+{
+  stop();
+}
+
+void WorkerPool::start(int thread_num, const std::string &name)
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  stopped_ = false;
+  for (int i = 0; i < thread_num; i++) {
+    threads_.emplace_back([this]() { run(); });
+    // linux中线程名字最长15个字符
+    std::string thread_name = (name + std::to_string(i)).substr(0, 15);
+    pthread_setname_np(threads_.back().native_handle(), thread_name.c_str());
+  }
+  LOG_INFO("worker pool %s started. thread num=%d", name.c_str(), thread_num);
+}
+
+void WorkerPool::stop()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopped_ = true;
+    cond_.notify_all();
+  }
+
+  for (std::thread &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads_.clear();
+}
+
+bool WorkerPool::submit(Task task)
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (stopped_) {
+    return false;
+  }
+  tasks_.push_back(std::move(task));
+  cond_.notify_one();
+  return true;
+}
+
+void WorkerPool::run()
+{
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
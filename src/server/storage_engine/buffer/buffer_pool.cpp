@@ -1,10 +1,26 @@
 #include "include/storage_engine/buffer/buffer_pool.h"
 
+#include <chrono>
+
+#include "include/common/server_metrics.h"
+#include "include/common/query_trace.h"
+
 using namespace common;
 using namespace std;
 
 static const int MEM_POOL_ITEM_NUM = 20;
 
+static long elapsed_us(std::chrono::steady_clock::time_point begin)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+BufferPoolStat &BufferPoolStat::thread_local_stat()
+{
+  static thread_local BufferPoolStat stat;
+  return stat;
+}
+
 
 FileBufferPool::FileBufferPool(BufferPoolManager &bp_manager, FrameManager &frame_manager)
     : bp_manager_(bp_manager), frame_manager_(frame_manager)
@@ -107,9 +123,17 @@ RC FileBufferPool::get_this_page(PageNum page_num, Frame **frame)
   if (used_match_frame != nullptr) {
     used_match_frame->access();
     *frame = used_match_frame;
+    BufferPoolStat::thread_local_stat().hits++;
+    ServerMetrics::instance().buffer_pool_hits.inc();
     return RC::SUCCESS;
   }
 
+  BufferPoolStat::thread_local_stat().misses++;
+  ServerMetrics::instance().buffer_pool_misses.inc();
+  TraceSpan span("buffer_pool", "page miss");
+  if (span.active()) {
+    span.set_args("\"file\":" + QueryTrace::json_string(file_name_) + ",\"page\":" + std::to_string(page_num));
+  }
   std::scoped_lock lock_guard(lock_); // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
 
   // Allocate one page and load the data into this page
@@ -246,6 +270,7 @@ RC FileBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
       return RC::SUCCESS;
     }
     RC rc = RC::SUCCESS;
+    const auto begin = std::chrono::steady_clock::now();
     if (frame->file_desc() == file_desc_) {
       rc = this->flush_page_internal(*frame);
     } else {
@@ -253,6 +278,10 @@ RC FileBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
     }
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to aclloc block due to failed to flush old block. rc=%s", strrc(rc));
+    } else {
+      ServerMetrics &metrics = ServerMetrics::instance();
+      metrics.buffer_pool_dirty_flushes.inc();
+      metrics.buffer_pool_write_latency_us.update(elapsed_us(begin));
     }
     return rc;
   };
@@ -264,7 +293,10 @@ RC FileBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
       return RC::SUCCESS;
     }
     LOG_TRACE("frames are all allocated, so we should evict some frames to get one free frame");
-    (void)frame_manager_.evict_frames(1, evict_action);
+    const int evicted = frame_manager_.evict_frames(1, evict_action);
+    if (evicted > 0) {
+      ServerMetrics::instance().buffer_pool_evictions.inc(evicted);
+    }
   }
   return RC::BUFFERPOOL_NOBUF;
 }
@@ -284,12 +316,15 @@ RC FileBufferPool::load_page(PageNum page_num, Frame *frame)
   }
 
   Page &page = frame->page();
+  const auto begin = std::chrono::steady_clock::now();
   int ret = readn(file_desc_, &page, BP_PAGE_SIZE);
   if (ret != 0) {
     LOG_ERROR("Failed to load page %s, file_desc:%d, page num:%d, due to failed to read data:%s, ret=%d, page count=%d",
               file_name_.c_str(), file_desc_, page_num, strerror(errno), ret, file_header_->allocated_pages);
     return RC::IOERR_READ;
   }
+  BufferPoolStat::thread_local_stat().reads++;
+  ServerMetrics::instance().buffer_pool_read_latency_us.update(elapsed_us(begin));
   return RC::SUCCESS;
 }
 
@@ -484,6 +519,29 @@ RC BufferPoolManager::close_file(const char *_file_name)
 /**
  * TODO [Lab1] 需要同学们实现页面刷盘
  */
+void BufferPoolManager::list_frames(std::vector<BufferFrameInfo> &frames)
+{
+  // 先复制一份文件名再遍历页帧，不同时持有两把锁
+  std::unordered_map<int, std::string> file_names;
+  lock_.lock();
+  for (auto &[fd, bp] : fd_buffer_pools_) {
+    file_names[fd] = bp->file_name();
+  }
+  lock_.unlock();
+
+  frame_manager_.foreach_frame([&frames, &file_names](const Frame &frame) {
+    BufferFrameInfo info;
+    auto iter = file_names.find(frame.file_desc());
+    if (iter != file_names.end()) {
+      info.file_name = iter->second;
+    }
+    info.page_num = frame.page_num();
+    info.pin_count = frame.pin_count();
+    info.dirty = frame.dirty();
+    frames.emplace_back(std::move(info));
+  });
+}
+
 RC BufferPoolManager::flush_page(Frame &frame)
 {
   return RC::SUCCESS;
@@ -24,7 +24,7 @@ RC FrameManager::cleanup()
 Frame *FrameManager::alloc(int file_desc, PageNum page_num)
 {
   FrameId frame_id(file_desc, page_num);
-  std::lock_guard<std::mutex> lock_guard(lock_);
+  std::lock_guard<common::ProfiledMutex> lock_guard(lock_);
   Frame *frame = get_internal(frame_id);
   if (frame != nullptr) {
     return frame;
@@ -44,7 +44,7 @@ Frame *FrameManager::alloc(int file_desc, PageNum page_num)
 Frame *FrameManager::get(int file_desc, PageNum page_num)
 {
   FrameId frame_id(file_desc, page_num);
-  std::lock_guard<std::mutex> lock_guard(lock_);
+  std::lock_guard<common::ProfiledMutex> lock_guard(lock_);
   return get_internal(frame_id);
 }
 
@@ -72,7 +72,7 @@ Frame *FrameManager::get_internal(const FrameId &frame_id)
  */
 std::list<Frame *> FrameManager::find_list(int file_desc)
 {
-  std::lock_guard<std::mutex> lock_guard(lock_);
+  std::lock_guard<common::ProfiledMutex> lock_guard(lock_);
 
   std::list<Frame *> frames;
   auto fetcher = [&frames, file_desc](const FrameId &frame_id, Frame *const frame) -> bool {
@@ -86,11 +86,20 @@ std::list<Frame *> FrameManager::find_list(int file_desc)
   return frames;
 }
 
+void FrameManager::foreach_frame(std::function<void(const Frame &frame)> visitor)
+{
+  std::lock_guard<common::ProfiledMutex> lock_guard(lock_);
+  frames_.foreach ([&visitor](const FrameId &, Frame *const frame) -> bool {
+    visitor(*frame);
+    return true;
+  });
+}
+
 RC FrameManager::free(int file_desc, PageNum page_num, Frame *frame)
 {
   FrameId frame_id(file_desc, page_num);
 
-  std::lock_guard<std::mutex> lock_guard(lock_);
+  std::lock_guard<common::ProfiledMutex> lock_guard(lock_);
   return free_internal(frame_id, frame);
 }
 
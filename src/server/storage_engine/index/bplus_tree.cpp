@@ -2,6 +2,10 @@
 
 #include "common/log/log.h"
 #include "common/lang/lower_bound.h"
+#include "include/common/server_metrics.h"
+
+#include <mutex>
+#include <set>
 
 using namespace std;
 using namespace common;
@@ -709,6 +713,107 @@ bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, FileBuf
 
 /////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * 当前打开的所有索引，用来计算 bplus_tree.max_height 指标
+ */
+static std::mutex                  open_handlers_lock;
+static std::set<BplusTreeHandler *> open_handlers;
+
+static void register_open_handler(BplusTreeHandler *handler)
+{
+  std::lock_guard<std::mutex> guard(open_handlers_lock);
+  open_handlers.insert(handler);
+}
+
+static void unregister_open_handler(BplusTreeHandler *handler)
+{
+  std::lock_guard<std::mutex> guard(open_handlers_lock);
+  open_handlers.erase(handler);
+}
+
+int BplusTreeHandler::max_open_height()
+{
+  std::lock_guard<std::mutex> guard(open_handlers_lock);
+  int max_height = 0;
+  for (BplusTreeHandler *handler : open_handlers) {
+    max_height = std::max(max_height, handler->height());
+  }
+  return max_height;
+}
+
+BplusTreeHandler::~BplusTreeHandler()
+{
+  unregister_open_handler(this);
+}
+
+RC BplusTreeHandler::init_height()
+{
+  // 沿着最左边的子节点一直走到叶子节点
+  int height = 0;
+  PageNum page_num = file_header_.root_page;
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(page_num, &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to fetch page. page num=%d, rc=%d:%s", page_num, rc, strrc(rc));
+      return rc;
+    }
+
+    height++;
+    IndexNodeHandler node(file_header_, frame);
+    if (node.is_leaf()) {
+      page_num = BP_INVALID_PAGE_NUM;
+    } else {
+      InternalIndexNodeHandler internal_node(file_header_, frame);
+      page_num = internal_node.value_at(0);
+    }
+    file_buffer_pool_->unpin_page(frame);
+  }
+
+  height_.store(height, std::memory_order_relaxed);
+  return RC::SUCCESS;
+}
+
+RC BplusTreeHandler::leaf_page_count(int &count)
+{
+  count = 0;
+
+  // 先沿着最左边的子节点找到第一个叶子节点
+  PageNum page_num = file_header_.root_page;
+  bool leaf = false;
+  while (page_num != BP_INVALID_PAGE_NUM && !leaf) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(page_num, &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to fetch page. page num=%d, rc=%d:%s", page_num, rc, strrc(rc));
+      return rc;
+    }
+
+    IndexNodeHandler node(file_header_, frame);
+    leaf = node.is_leaf();
+    if (!leaf) {
+      InternalIndexNodeHandler internal_node(file_header_, frame);
+      page_num = internal_node.value_at(0);
+    }
+    file_buffer_pool_->unpin_page(frame);
+  }
+
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(page_num, &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to fetch page. page num=%d, rc=%d:%s", page_num, rc, strrc(rc));
+      return rc;
+    }
+
+    count++;
+    LeafIndexNodeHandler leaf_node(file_header_, frame);
+    page_num = leaf_node.next_page();
+    file_buffer_pool_->unpin_page(frame);
+  }
+  return RC::SUCCESS;
+}
+
 RC BplusTreeHandler::sync()
 {
   if (header_dirty_) {
@@ -815,6 +920,9 @@ RC BplusTreeHandler::create(const char *file_name, bool is_unique, std::vector<A
 
   this->sync();
 
+  height_.store(0, std::memory_order_relaxed);
+  register_open_handler(this);
+
   LOG_INFO("Successfully create index %s", file_name);
   return RC::SUCCESS;
 }
@@ -869,12 +977,22 @@ RC BplusTreeHandler::open(const char *file_name)
     key_comparator_.init(file_header_.multi_attr_types[0], total_attr_length);
     key_printer_.init(file_header_.multi_attr_types[0], total_attr_length);
   }
+
+  rc = init_height();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to calculate height of index %s, rc=%d:%s", file_name, rc, strrc(rc));
+    close();
+    return rc;
+  }
+  register_open_handler(this);
+
   LOG_INFO("Successfully open index %s", file_name);
   return RC::SUCCESS;
 }
 
 RC BplusTreeHandler::close()
 {
+  unregister_open_handler(this);
   if (file_buffer_pool_ != nullptr) {
     file_buffer_pool_->close_file();
   }
@@ -1214,6 +1332,7 @@ RC BplusTreeHandler::insert_entry_into_parent(Frame *frame, Frame *new_frame, co
     update_root_page_num_locked(root_frame->page_num());
     root_frame->mark_dirty();
     file_buffer_pool_->unpin_page(root_frame);
+    height_.fetch_add(1, std::memory_order_relaxed);
 
     return RC::SUCCESS;
   } else {
@@ -1293,6 +1412,7 @@ RC BplusTreeHandler::split(Frame *frame, Frame *&new_frame)
 
   frame->mark_dirty();
   new_frame->mark_dirty();
+  ServerMetrics::instance().bplus_tree_splits.inc();
   return RC::SUCCESS;
 }
 
@@ -1325,6 +1445,7 @@ RC BplusTreeHandler::create_new_tree(const char *key, const RID *rid)
   update_root_page_num_locked(frame->page_num());
   frame->mark_dirty();
   file_buffer_pool_->unpin_page(frame);
+  height_.store(1, std::memory_order_relaxed);
 
   return rc;
 }
@@ -1442,7 +1563,7 @@ RC BplusTreeHandler::get_entry(const char *multi_keys[], std::list<RID> &rids, i
     return rc;
   }
   RID rid;
-  while ((rc = scanner.next_entry(rid, false)) == RC::SUCCESS) {
+  while ((rc = scanner.next_entry(rid)) == RC::SUCCESS) {
     rids.push_back(rid);
   }
 
@@ -1488,6 +1609,11 @@ RC BplusTreeHandler::adjust_root(Frame *root_frame)
   }
 
   update_root_page_num_locked(new_root_page_num);
+  if (new_root_page_num == BP_INVALID_PAGE_NUM) {
+    height_.store(0, std::memory_order_relaxed);
+  } else {
+    height_.fetch_sub(1, std::memory_order_relaxed);
+  }
 
   PageNum old_root_page_num = root_frame->page_num();
   file_buffer_pool_->dispose_page(old_root_page_num);
@@ -1588,6 +1714,7 @@ RC BplusTreeHandler::coalesce(Frame *neighbor_frame, Frame *frame, Frame *parent
   }
 
   file_buffer_pool_->dispose_page(right_frame->page_num());
+  ServerMetrics::instance().bplus_tree_merges.inc();
   return coalesce_or_redistribute<InternalIndexNodeHandler>(parent_frame);
 }
 
@@ -1619,6 +1746,7 @@ RC BplusTreeHandler::redistribute(Frame *neighbor_frame, Frame *frame, Frame *pa
   neighbor_frame->mark_dirty();
   frame->mark_dirty();
   parent_frame->mark_dirty();
+  ServerMetrics::instance().bplus_tree_redistributions.inc();
 
   return RC::SUCCESS;
 }
@@ -1828,7 +1956,7 @@ bool BplusTreeScanner::touch_end()
   return compare_result > 0;
 }
 
-RC BplusTreeScanner::next_entry(RID &rid, bool isdelete)
+RC BplusTreeScanner::next_entry(RID &rid)
 {
   if (nullptr == current_frame_) {
     return RC::RECORD_EOF;
@@ -1837,10 +1965,7 @@ RC BplusTreeScanner::next_entry(RID &rid, bool isdelete)
   if (!first_emitted_) {
     fetch_item(rid);
     first_emitted_ = true;
-
-    if (!isdelete) {
-      iter_index_++;
-    }
+    iter_index_++;
     return RC::SUCCESS;
   }
 
@@ -1850,9 +1975,7 @@ RC BplusTreeScanner::next_entry(RID &rid, bool isdelete)
       return RC::RECORD_EOF;
     }
     fetch_item(rid);
-    if (!isdelete) {
-      iter_index_++;
-    }
+    iter_index_++;
     return RC::SUCCESS;
   }
 
@@ -1870,7 +1993,7 @@ RC BplusTreeScanner::next_entry(RID &rid, bool isdelete)
 
   //  iter_index_ = -1; // `next` will add 1
   iter_index_ = 0;
-  return next_entry(rid, isdelete);
+  return next_entry(rid);
 }
 
 RC BplusTreeScanner::close()
@@ -138,9 +138,9 @@ RC BplusTreeIndexScanner::open(
   return tree_scanner_.open(left_key, left_len, left_inclusive, right_key, right_len, right_inclusive);
 }
 
-RC BplusTreeIndexScanner::next_entry(RID *rid, bool isdelete)
+RC BplusTreeIndexScanner::next_entry(RID *rid)
 {
-  return tree_scanner_.next_entry(*rid, isdelete);
+  return tree_scanner_.next_entry(*rid);
 }
 
 RC BplusTreeIndexScanner::destroy()
@@ -1,6 +1,7 @@
 #include "include/storage_engine/recorder/record_manager.h"
 #include "include/storage_engine/recorder/table.h"
 #include "include/storage_engine/transaction/trx.h"
+#include "include/common/server_metrics.h"
 
 
 using namespace common;
@@ -261,6 +262,8 @@ PageNum RecordPageHandler::get_page_num() const
 
 bool RecordPageHandler::is_full() const { return page_header_->record_num >= page_header_->record_capacity; }
 
+int RecordPageHandler::record_num() const { return page_header_->record_num; }
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileHandler::~RecordFileHandler() { this->close(); }
@@ -310,11 +313,35 @@ RC RecordFileHandler::init_free_pages()
   return rc;
 }
 
-RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+RC RecordFileHandler::get_stat(RecordFileStat &stat)
 {
-  RC ret = RC::SUCCESS;
+  stat = RecordFileStat();
 
+  BufferPoolIterator bp_iterator;
+  bp_iterator.init(*file_buffer_pool_);
   RecordPageHandler record_page_handler;
+  while (bp_iterator.has_next()) {
+    PageNum page_num = bp_iterator.next();
+    RC rc = record_page_handler.init(*file_buffer_pool_, page_num, true /*readonly*/);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+    stat.pages++;
+    stat.records += record_page_handler.record_num();
+    record_page_handler.cleanup();
+  }
+
+  lock_.lock();
+  stat.free_pages = static_cast<int>(free_pages_.size());
+  lock_.unlock();
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::open_free_page(RecordPageHandler &record_page_handler, int record_size)
+{
+  RC ret = RC::SUCCESS;
+
   bool              page_found       = false;
   PageNum           current_page_num = 0;
 
@@ -357,6 +384,7 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
     }
     // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
     frame->unpin();
+    ServerMetrics::instance().record_pages_allocated.inc();
 
     // 这里的加锁顺序看起来与上面是相反的，但是不会出现死锁。
     // 上面的逻辑是先加未满page集合的锁（第334行），然后加页面写锁（第340行），接着释放页面写锁（第351行），最后释放未满page集合的锁（第354行）；
@@ -366,8 +394,50 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
     lock_.unlock();
   }
 
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+{
+  RecordPageHandler record_page_handler;
+  RC ret = open_free_page(record_page_handler, record_size);
+  if (ret != RC::SUCCESS) {
+    return ret;
+  }
+
   // 找到空闲位置
-  return record_page_handler.insert_record(data, rid);
+  ret = record_page_handler.insert_record(data, rid);
+  if (ret == RC::SUCCESS) {
+    ServerMetrics::instance().records_inserted.inc();
+  }
+  return ret;
+}
+
+RC RecordFileHandler::insert_records(std::vector<Record> &records, int record_size, size_t &inserted_count)
+{
+  RC ret = RC::SUCCESS;
+  size_t i = 0;
+  while (i < records.size() && RC_SUCC(ret)) {
+    // 每个页面只获取一次，填满之后再换下一个页面
+    RecordPageHandler record_page_handler;
+    ret = open_free_page(record_page_handler, record_size);
+    if (ret != RC::SUCCESS) {
+      break;
+    }
+
+    const size_t first = i;
+    for (; i < records.size() && !record_page_handler.is_full(); i++) {
+      ret = record_page_handler.insert_record(records[i].data(), &records[i].rid());
+      if (ret != RC::SUCCESS) {
+        LOG_WARN("failed to insert record into page. page num=%d, rc=%s",
+                 record_page_handler.get_page_num(), strrc(ret));
+        break;
+      }
+    }
+    ServerMetrics::instance().records_inserted.inc(i - first);
+  }
+  inserted_count = i;
+  return ret;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -398,6 +468,7 @@ RC RecordFileHandler::delete_record(const RID *rid)
   // insert record是加上未满page集合的锁，然后拿到指定页面锁再释放未满page集合的锁
   page_handler.cleanup();
   if (RC_SUCC(rc)) {
+    ServerMetrics::instance().records_deleted.inc();
     // 因为这里已经释放了页面锁，并发时，其它线程可能又把该页面填满了，那就不应该再放入free_pages_中。
     // 但是这里可以不关心，因为在查找空闲页面时，会自动过滤掉已经满的页面。
     lock_.lock();
@@ -408,6 +479,41 @@ RC RecordFileHandler::delete_record(const RID *rid)
   return rc;
 }
 
+RC RecordFileHandler::delete_records(const std::vector<RID> &rids, size_t &deleted_count)
+{
+  RC rc = RC::SUCCESS;
+  std::vector<PageNum> touched_pages;
+
+  size_t i = 0;
+  while (i < rids.size() && RC_SUCC(rc)) {
+    const PageNum page_num = rids[i].page_num;
+
+    RecordPageHandler page_handler;
+    if ((rc = page_handler.init(*file_buffer_pool_, page_num, false /*readonly*/)) != RC::SUCCESS) {
+      LOG_ERROR("Failed to init record page handler.page number=%d. rc=%s", page_num, strrc(rc));
+      break;
+    }
+
+    for (; i < rids.size() && rids[i].page_num == page_num; i++) {
+      rc = page_handler.delete_record(&rids[i]);
+      if (RC_FAIL(rc)) {
+        LOG_ERROR("Failed to delete record. page_num=%d, slot_num=%d, rc=%s", page_num, rids[i].slot_num, strrc(rc));
+        break;
+      }
+      ServerMetrics::instance().records_deleted.inc();
+    }
+    // 与delete_record一样，先释放页面再加未满page集合的锁
+    page_handler.cleanup();
+    touched_pages.push_back(page_num);
+  }
+
+  lock_.lock();
+  free_pages_.insert(touched_pages.begin(), touched_pages.end());
+  lock_.unlock();
+  deleted_count = i;
+  return rc;
+}
+
 RC RecordFileHandler::get_record(RecordPageHandler &page_handler, const RID *rid, bool readonly, Record *rec)
 {
   if (nullptr == rid || nullptr == rec) {
@@ -519,6 +625,12 @@ RC RecordFileScanner::fetch_next_record()
   return RC::RECORD_EOF;
 }
 
+RecordScanStat &RecordScanStat::thread_local_stat()
+{
+  static thread_local RecordScanStat stat;
+  return stat;
+}
+
 /**
  * @brief 遍历当前页面，尝试找到一条有效的记录
  */
@@ -532,6 +644,8 @@ RC RecordFileScanner::fetch_next_record_in_page()
       LOG_TRACE("failed to get next record from page. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
+    ServerMetrics::instance().records_scanned.inc();
+    RecordScanStat::thread_local_stat().records++;
 
     // 如果有过滤条件，就用过滤条件过滤一下
     if (condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
@@ -2,6 +2,7 @@
 #include "include/storage_engine/recorder/record_manager.h"
 #include "include/storage_engine/schema/schema_util.h"
 #include "include/storage_engine/index/bplus_tree_index.h"
+#include <algorithm>
 #include <random>
 
 
@@ -26,6 +27,21 @@ Table::~Table()
   LOG_INFO("Table has been closed: %s", name());
 }
 
+RC Table::create_system_table(int32_t table_id,
+    const char *name,
+    int attribute_count,
+    const AttrInfoSqlNode attributes[],
+    SystemTable *system_table)
+{
+  RC rc = table_meta_.init(table_id, name, attribute_count, attributes);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to init system table meta. name:%s, rc=%s", name, strrc(rc));
+    return rc;
+  }
+  system_table_ = system_table;
+  return RC::SUCCESS;
+}
+
 RC Table::create(int32_t table_id, 
     const char *path,
     const char *name,
@@ -349,6 +365,7 @@ RC Table::insert_record(Record &record)
 
   // TODO [Lab2] 增加索引的处理逻辑
 
+  bump_version();
   return rc;
 }
 
@@ -359,9 +376,211 @@ RC Table::delete_record(const Record &record)
   // TODO [Lab2] 增加索引的处理逻辑
 
   rc = record_handler_->delete_record(&record.rid());
+  if (RC_SUCC(rc)) {
+    bump_version();
+  }
   return rc;
 }
 
+RC Table::insert_records(std::vector<Record> &records)
+{
+  size_t inserted_count = 0;
+  RC rc = record_handler_->insert_records(records, table_meta_.record_size(), inserted_count);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Insert records failed. table name=%s, inserted=%lu/%lu, rc=%s", table_meta_.name(),
+              static_cast<unsigned long>(inserted_count), static_cast<unsigned long>(records.size()), strrc(rc));
+    rollback_insert_records(records, inserted_count, 0, {});
+    return rc;
+  }
+
+  // 记录都写入之后再统一维护索引，每个索引按照键值顺序插入
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    Index *index = indexes_[i];
+    std::vector<const Record *> ordered_records;
+    sort_by_index_key(*index, records, ordered_records);
+    for (size_t j = 0; j < ordered_records.size(); j++) {
+      const Record *record = ordered_records[j];
+      rc = index->insert_entry(record->data(), &record->rid());
+      if (RC_FAIL(rc)) {
+        LOG_ERROR("Failed to insert index entry. table name=%s, index name=%s, rc=%s",
+                  name(), index->index_meta().name(), strrc(rc));
+        ordered_records.resize(j);
+        rollback_insert_records(records, records.size(), i, ordered_records);
+        return rc;
+      }
+    }
+  }
+
+  bump_version();
+  return rc;
+}
+
+void Table::rollback_insert_records(const std::vector<Record> &records, size_t inserted_count, size_t index_count,
+    const std::vector<const Record *> &partial_index_records)
+{
+  // 前 index_count 个索引已经插入了所有记录的索引项，第 index_count 个索引只插入了一部分
+  for (size_t i = 0; i < index_count; i++) {
+    for (size_t j = 0; j < inserted_count; j++) {
+      RC rc = indexes_[i]->delete_entry(records[j].data(), &records[j].rid());
+      if (RC_FAIL(rc)) {
+        LOG_ERROR("Failed to rollback index entry. table name=%s, index name=%s, rc=%s",
+                  name(), indexes_[i]->index_meta().name(), strrc(rc));
+      }
+    }
+  }
+  if (!partial_index_records.empty()) {
+    Index *index = indexes_[index_count];
+    for (const Record *record : partial_index_records) {
+      RC rc = index->delete_entry(record->data(), &record->rid());
+      if (RC_FAIL(rc)) {
+        LOG_ERROR("Failed to rollback index entry. table name=%s, index name=%s, rc=%s",
+                  name(), index->index_meta().name(), strrc(rc));
+      }
+    }
+  }
+
+  if (inserted_count == 0) {
+    return;
+  }
+  std::vector<RID> rids;
+  rids.reserve(inserted_count);
+  for (size_t i = 0; i < inserted_count; i++) {
+    rids.push_back(records[i].rid());
+  }
+  std::sort(rids.begin(), rids.end(), [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; });
+  size_t deleted_count = 0;
+  RC rc = record_handler_->delete_records(rids, deleted_count);
+  if (RC_FAIL(rc)) {
+    LOG_PANIC("Failed to rollback inserted records. table name=%s, deleted=%lu/%lu, rc=%s", name(),
+              static_cast<unsigned long>(deleted_count), static_cast<unsigned long>(rids.size()), strrc(rc));
+  }
+}
+
+void Table::sort_by_index_key(
+    const Index &index, const std::vector<Record> &records, std::vector<const Record *> &ordered_records) const
+{
+  const IndexMeta &index_meta = index.index_meta();
+  std::vector<const FieldMeta *> key_fields;
+  for (size_t i = 0; i < index_meta.field_amount(); i++) {
+    key_fields.push_back(table_meta_.field(index_meta.field(i)));
+  }
+
+  ordered_records.clear();
+  ordered_records.reserve(records.size());
+  for (const Record &record : records) {
+    ordered_records.push_back(&record);
+  }
+  std::stable_sort(ordered_records.begin(), ordered_records.end(), [&key_fields](const Record *a, const Record *b) {
+    for (const FieldMeta *field : key_fields) {
+      Value value_a(field->type(), const_cast<char *>(a->data()) + field->offset(), field->len());
+      Value value_b(field->type(), const_cast<char *>(b->data()) + field->offset(), field->len());
+      int cmp = value_a.compare(value_b);
+      if (cmp != 0) {
+        return cmp < 0;
+      }
+    }
+    return false;
+  });
+}
+
+RC Table::delete_records(std::vector<Record> &records)
+{
+  RC rc = RC::SUCCESS;
+  if (records.empty()) {
+    return rc;
+  }
+
+  std::sort(records.begin(), records.end(), [](const Record &a, const Record &b) {
+    return RID::compare(&a.rid(), &b.rid()) < 0;
+  });
+
+  // 先删除索引项，再删除记录。删除索引项失败时把已经删除的索引项插回去，记录还没有动
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    Index *index = indexes_[i];
+    // 按照键值顺序删除，访问B+树的叶子页面基本是顺序的
+    std::vector<const Record *> ordered_records;
+    sort_by_index_key(*index, records, ordered_records);
+    for (size_t j = 0; j < ordered_records.size(); j++) {
+      const Record *record = ordered_records[j];
+      rc = index->delete_entry(record->data(), &record->rid());
+      if (RC_FAIL(rc)) {
+        LOG_ERROR("Failed to delete index entry. table name=%s, index name=%s, rc=%s",
+                  name(), index->index_meta().name(), strrc(rc));
+        ordered_records.resize(j);
+        std::vector<const Record *> all_records;
+        all_records.reserve(records.size());
+        for (const Record &r : records) {
+          all_records.push_back(&r);
+        }
+        restore_index_entries(all_records, i, ordered_records);
+        records.clear();
+        return rc;
+      }
+    }
+  }
+
+  std::vector<RID> rids;
+  rids.reserve(records.size());
+  for (const Record &record : records) {
+    rids.push_back(record.rid());
+  }
+
+  // 记录按照RID的顺序删除，中途失败时没有删除的记录是records的后缀，把它们的索引项插回去
+  size_t deleted_count = 0;
+  rc = record_handler_->delete_records(rids, deleted_count);
+  if (RC_FAIL(rc)) {
+    LOG_ERROR("Failed to delete records. table name=%s, deleted=%lu/%lu, rc=%s",
+              name(), static_cast<unsigned long>(deleted_count), static_cast<unsigned long>(records.size()), strrc(rc));
+    std::vector<const Record *> remaining_records;
+    remaining_records.reserve(records.size() - deleted_count);
+    for (size_t i = deleted_count; i < records.size(); i++) {
+      remaining_records.push_back(&records[i]);
+    }
+    restore_index_entries(remaining_records, indexes_.size(), {});
+    records.resize(deleted_count);
+  }
+  if (deleted_count > 0) {
+    bump_version();
+  }
+  return rc;
+}
+
+void Table::restore_index_entries(const std::vector<const Record *> &records, size_t index_count,
+    const std::vector<const Record *> &partial_index_records)
+{
+  for (size_t i = 0; i < index_count; i++) {
+    Index *index = indexes_[i];
+    for (const Record *record : records) {
+      RC rc = index->insert_entry(record->data(), &record->rid());
+      if (RC_FAIL(rc)) {
+        LOG_PANIC("Failed to restore index entry. table name=%s, index name=%s, rc=%s",
+                  name(), index->index_meta().name(), strrc(rc));
+      }
+    }
+  }
+  if (!partial_index_records.empty()) {
+    Index *index = indexes_[index_count];
+    for (const Record *record : partial_index_records) {
+      RC rc = index->insert_entry(record->data(), &record->rid());
+      if (RC_FAIL(rc)) {
+        LOG_PANIC("Failed to restore index entry. table name=%s, index name=%s, rc=%s",
+                  name(), index->index_meta().name(), strrc(rc));
+      }
+    }
+  }
+}
+
+uint64_t Table::next_version()
+{
+  static std::atomic<uint64_t> global_version{0};
+  return global_version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void Table::bump_version()
+{
+  version_.store(next_version(), std::memory_order_release);
+}
+
 RC Table::visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor)
 {
   return record_handler_->visit_record(rid, readonly, visitor);
@@ -416,8 +635,9 @@ RC Table::make_record(int value_num, const Value *values, Record &record)
   }
 
   // 复制所有字段的值
+  // 清零之后，没有赋值的系统字段和空值位图都是确定的
   int record_size = table_meta_.record_size();
-  char *record_data = (char *)malloc(record_size);
+  char *record_data = (char *)calloc(1, record_size);
 
   RC rc = RC::SUCCESS;
   for (int i = 0; i < value_num; i++) {
@@ -1,4 +1,5 @@
 #include "include/storage_engine/schema/database.h"
+#include "include/storage_engine/schema/system_table.h"
 
 Db::~Db()
 {
@@ -127,7 +128,7 @@ Table *Db::find_table(const char *table_name) const
   if (iter != opened_tables_.end()) {
     return iter->second;
   }
-  return nullptr;
+  return SystemTable::find(table_name);
 }
 
 Table *Db::find_table(int32_t table_id) const
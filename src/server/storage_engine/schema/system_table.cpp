@@ -0,0 +1,328 @@
+#include "include/storage_engine/schema/system_table.h"
+#include "include/storage_engine/schema/database.h"
+#include "include/storage_engine/recorder/record_manager.h"
+#include "include/storage_engine/index/bplus_tree_index.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/session/session.h"
+#include "include/common/global_context.h"
+#include "include/query_engine/executor/slow_query_log.h"
+#include "common/log/log.h"
+
+#include <memory>
+#include <mutex>
+#include <string.h>
+#include <time.h>
+
+static AttrInfoSqlNode int_column(const char *name)
+{
+  return AttrInfoSqlNode{INTS, name, sizeof(int), false};
+}
+
+static AttrInfoSqlNode float_column(const char *name)
+{
+  return AttrInfoSqlNode{FLOATS, name, sizeof(float), false};
+}
+
+static AttrInfoSqlNode chars_column(const char *name, size_t length)
+{
+  return AttrInfoSqlNode{CHARS, name, length, false};
+}
+
+static Value ms_value(int64_t ns)
+{
+  return Value(static_cast<float>(ns / 1000000.0));
+}
+
+RC SystemTable::init(int32_t table_id, const char *name, const std::vector<AttrInfoSqlNode> &attributes)
+{
+  return table_.create_system_table(
+      table_id, name, static_cast<int>(attributes.size()), attributes.data(), this);
+}
+
+namespace {
+
+/**
+ * @brief sys.sessions 每个会话一行：正在执行或者最近执行的语句、状态以及持续的时间
+ */
+class SessionsTable : public SystemTable
+{
+public:
+  RC init(int32_t table_id)
+  {
+    return SystemTable::init(table_id, "sys.sessions", {
+        int_column("session_id"),
+        chars_column("db", 32),
+        chars_column("state", 16),
+        float_column("time_ms"),
+        chars_column("sql", 256),
+    });
+  }
+
+  RC fill_rows(Db *, std::vector<std::vector<Value>> &rows) override
+  {
+    std::vector<Session::SessionInfo> sessions;
+    Session::list_sessions(sessions);
+    for (const Session::SessionInfo &session : sessions) {
+      rows.push_back({
+          Value(static_cast<int>(session.id)),
+          Value(session.db_name.c_str()),
+          Value(session.running ? "running" : "idle"),
+          ms_value(session.elapsed_us * 1000),
+          Value(session.sql.c_str()),
+      });
+    }
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief sys.buffer_pool 内存中每个页帧一行
+ */
+class BufferPoolTable : public SystemTable
+{
+public:
+  RC init(int32_t table_id)
+  {
+    return SystemTable::init(table_id, "sys.buffer_pool", {
+        chars_column("file_name", 256),
+        int_column("page_num"),
+        int_column("pin_count"),
+        int_column("dirty"),
+    });
+  }
+
+  RC fill_rows(Db *, std::vector<std::vector<Value>> &rows) override
+  {
+    std::vector<BufferFrameInfo> frames;
+    BufferPoolManager::instance().list_frames(frames);
+    for (const BufferFrameInfo &frame : frames) {
+      rows.push_back({
+          Value(frame.file_name.c_str()),
+          Value(static_cast<int>(frame.page_num)),
+          Value(frame.pin_count),
+          Value(frame.dirty ? 1 : 0),
+      });
+    }
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief sys.table_stats 当前数据库中每个表一行，需要读取表的所有数据页面
+ */
+class TablesTable : public SystemTable
+{
+public:
+  RC init(int32_t table_id)
+  {
+    return SystemTable::init(table_id, "sys.table_stats", {
+        chars_column("table_name", 64),
+        int_column("pages"),
+        int_column("rows"),
+        int_column("free_pages"),
+        int_column("record_size"),
+    });
+  }
+
+  RC fill_rows(Db *db, std::vector<std::vector<Value>> &rows) override
+  {
+    std::vector<std::string> table_names;
+    db->all_tables(table_names);
+    for (const std::string &table_name : table_names) {
+      Table *table = db->find_table(table_name.c_str());
+      if (table == nullptr || table->is_view()) {
+        continue;  // 视图没有数据文件
+      }
+
+      RecordFileStat stat;
+      RC rc = table->record_handler()->get_stat(stat);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to get stat of table. table=%s, rc=%s", table_name.c_str(), strrc(rc));
+        return rc;
+      }
+      rows.push_back({
+          Value(table_name.c_str()),
+          Value(stat.pages),
+          Value(static_cast<int>(stat.records)),
+          Value(stat.free_pages),
+          Value(table->table_meta().record_size()),
+      });
+    }
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief sys.indexes 当前数据库中每个索引一行
+ */
+class IndexesTable : public SystemTable
+{
+public:
+  RC init(int32_t table_id)
+  {
+    return SystemTable::init(table_id, "sys.indexes", {
+        chars_column("table_name", 64),
+        chars_column("index_name", 64),
+        int_column("is_unique"),
+        int_column("height"),
+        int_column("leaf_pages"),
+    });
+  }
+
+  RC fill_rows(Db *db, std::vector<std::vector<Value>> &rows) override
+  {
+    std::vector<std::string> table_names;
+    db->all_tables(table_names);
+    for (const std::string &table_name : table_names) {
+      Table *table = db->find_table(table_name.c_str());
+      if (table == nullptr || table->is_view()) {
+        continue;
+      }
+
+      for (Index *index : table->indexes()) {
+        auto *bplus_tree_index = dynamic_cast<BplusTreeIndex *>(index);
+        if (bplus_tree_index == nullptr) {
+          continue;
+        }
+        BplusTreeHandler &handler = bplus_tree_index->get_index_handler();
+        int leaf_pages = 0;
+        RC rc = handler.leaf_page_count(leaf_pages);
+        if (rc != RC::SUCCESS) {
+          LOG_WARN("failed to count leaf pages. table=%s, index=%s, rc=%s",
+                   table_name.c_str(), index->index_meta().name(), strrc(rc));
+          return rc;
+        }
+        rows.push_back({
+            Value(table_name.c_str()),
+            Value(index->index_meta().name()),
+            Value(index->index_meta().is_unique() ? 1 : 0),
+            Value(handler.height()),
+            Value(leaf_pages),
+        });
+      }
+    }
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief sys.slow_queries 慢查询日志在内存中保存的最近的记录，没有开启慢查询日志时为空
+ */
+class SlowQueriesTable : public SystemTable
+{
+public:
+  RC init(int32_t table_id)
+  {
+    return SystemTable::init(table_id, "sys.slow_queries", {
+        chars_column("start_time", 32),
+        int_column("session_id"),
+        chars_column("db", 32),
+        chars_column("result", 32),
+        float_column("query_ms"),
+        float_column("parse_ms"),
+        float_column("analyze_ms"),
+        float_column("plan_ms"),
+        float_column("optimize_ms"),
+        float_column("execute_ms"),
+        int_column("rows_examined"),
+        int_column("rows_returned"),
+        int_column("pages_read"),
+        chars_column("sql", 256),
+        chars_column("plan", 1024),
+    });
+  }
+
+  RC fill_rows(Db *, std::vector<std::vector<Value>> &rows) override
+  {
+    SlowQueryLog *slow_query_log = GCTX.slow_query_log_;
+    if (slow_query_log == nullptr) {
+      return RC::SUCCESS;
+    }
+
+    for (const SlowQueryLog::Entry &entry : slow_query_log->recent_entries()) {
+      char time_buf[32];
+      const time_t seconds = entry.start_time_us / 1000000;
+      struct tm tm;
+      localtime_r(&seconds, &tm);
+      strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &tm);
+
+      const QueryProfile &profile = entry.profile;
+      rows.push_back({
+          Value(time_buf),
+          Value(static_cast<int>(entry.session_id)),
+          Value(entry.db_name.c_str()),
+          Value(strrc(entry.rc)),
+          ms_value(profile.total_ns),
+          ms_value(profile.parse_ns),
+          ms_value(profile.analyze_ns),
+          ms_value(profile.plan_ns),
+          ms_value(profile.optimize_ns),
+          ms_value(profile.execute_ns),
+          Value(static_cast<int>(profile.rows_examined)),
+          Value(static_cast<int>(profile.rows_returned)),
+          Value(static_cast<int>(profile.page_reads)),
+          Value(entry.sql.c_str()),
+          Value(entry.plan.c_str()),
+      });
+    }
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief 所有的系统表，第一次查找时创建
+ * @details 表的编号使用负数，不会与普通的表冲突
+ */
+class SystemTables
+{
+public:
+  SystemTables()
+  {
+    add<SessionsTable>(-1);
+    add<BufferPoolTable>(-2);
+    add<TablesTable>(-3);
+    add<IndexesTable>(-4);
+    add<SlowQueriesTable>(-5);
+  }
+
+  Table *find(const char *table_name) const
+  {
+    for (const std::unique_ptr<SystemTable> &system_table : tables_) {
+      if (0 == strcmp(system_table->table()->name(), table_name)) {
+        return system_table->table();
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  template <typename T>
+  void add(int32_t table_id)
+  {
+    auto system_table = std::make_unique<T>();
+    RC rc = system_table->init(table_id);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("failed to init system table. table_id=%d, rc=%s", table_id, strrc(rc));
+      return;
+    }
+    tables_.push_back(std::move(system_table));
+  }
+
+private:
+  std::vector<std::unique_ptr<SystemTable>> tables_;
+};
+
+}  // namespace
+
+Table *SystemTable::find(const char *table_name)
+{
+  if (0 != strncmp(table_name, "sys.", 4)) {
+    return nullptr;
+  }
+
+  // 系统表的字段依赖事务模块的系统字段，所以在第一次使用时才创建。进程退出时不释放
+  static SystemTables *system_tables = nullptr;
+  static std::once_flag init_flag;
+  std::call_once(init_flag, []() { system_tables = new SystemTables(); });
+  return system_tables->find(table_name);
+}
@@ -8,6 +8,18 @@
 
 static TrxManager *global_trx_manager = nullptr;
 
+RC Trx::delete_records(Table *table, std::vector<Record> &records)
+{
+  RC rc = RC::SUCCESS;
+  for (Record &record : records) {
+    rc = delete_record(table, record);
+    if (RC_FAIL(rc)) {
+      break;
+    }
+  }
+  return rc;
+}
+
 TrxManager *TrxManager::create(const char *name)
 {
  if (common::is_blank(name) || 0 == strcasecmp(name, "vacuous")) {
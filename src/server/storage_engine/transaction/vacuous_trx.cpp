@@ -1,4 +1,5 @@
 #include "include/storage_engine/transaction/vacuous_trx.h"
+#include "include/common/server_metrics.h"
 
 using namespace std;
 
@@ -47,6 +48,11 @@ RC VacuousTrx::delete_record(Table *table, Record &record)
  return table->delete_record(record);
 }
 
+RC VacuousTrx::delete_records(Table *table, std::vector<Record> &records)
+{
+ return table->delete_records(records);
+}
+
 RC VacuousTrx::visit_record(Table *table, Record &record, bool readonly)
 {
  return RC::SUCCESS;
@@ -59,10 +65,12 @@ RC VacuousTrx::start_if_need()
 
 RC VacuousTrx::commit()
 {
+ ServerMetrics::instance().trx_commits.inc();
  return RC::SUCCESS;
 }
 
 RC VacuousTrx::rollback()
 {
+ ServerMetrics::instance().trx_rollbacks.inc();
  return RC::SUCCESS;
 }
@@ -0,0 +1,157 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "include/common/rc.h"
+#include "include/query_engine/executor/admission_controller.h"
+#include "gtest/gtest.h"
+
+static const size_t CHUNK = AdmissionController::GRANT_CHUNK_SIZE;
+
+/**
+ * @brief 等到有count个查询在排队
+ */
+static void wait_queued(AdmissionController &controller, QueryClass query_class, int count)
+{
+  while (controller.queued(query_class) < count) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(test_admission_controller, queue_full)
+{
+  AdmissionController::Options options;
+  options.analytic_slots = 1;
+  options.max_queue_length = 1;
+  options.queue_timeout_ms = 10000;
+  AdmissionController controller(options);
+
+  auto running = std::make_unique<AdmissionTicket>();
+  ASSERT_EQ(controller.admit(QueryClass::ANALYTIC, *running), RC::SUCCESS);
+  ASSERT_EQ(controller.running(QueryClass::ANALYTIC), 1);
+
+  // 第二个查询排队，第三个查询超过队列长度，立即拒绝
+  RC waiter_rc = RC::INTERNAL;
+  std::thread waiter([&]() {
+    AdmissionTicket ticket;
+    waiter_rc = controller.admit(QueryClass::ANALYTIC, ticket);
+  });
+  wait_queued(controller, QueryClass::ANALYTIC, 1);
+
+  AdmissionTicket rejected;
+  ASSERT_EQ(controller.admit(QueryClass::ANALYTIC, rejected), RC::QUERY_QUEUE_FULL);
+  ASSERT_EQ(controller.rejected(), 1);
+  ASSERT_EQ(rejected.memory_reservation(), nullptr);
+
+  // OLTP查询有自己的队列，不受影响
+  {
+    AdmissionTicket oltp;
+    ASSERT_EQ(controller.admit(QueryClass::OLTP, oltp), RC::SUCCESS);
+  }
+
+  // 第一个查询结束之后排队的查询开始执行
+  running.reset();
+  waiter.join();
+  ASSERT_EQ(waiter_rc, RC::SUCCESS);
+  ASSERT_EQ(controller.running(QueryClass::ANALYTIC), 0);
+  ASSERT_EQ(controller.queued(QueryClass::ANALYTIC), 0);
+  ASSERT_EQ(controller.rejected(), 1);
+  ASSERT_EQ(controller.memory_reserved(), 0);
+}
+
+TEST(test_admission_controller, queue_timeout)
+{
+  AdmissionController::Options options;
+  options.analytic_slots = 1;
+  options.queue_timeout_ms = 100;
+  AdmissionController controller(options);
+
+  {
+    AdmissionTicket running;
+    ASSERT_EQ(controller.admit(QueryClass::ANALYTIC, running), RC::SUCCESS);
+
+    auto start = std::chrono::steady_clock::now();
+    AdmissionTicket waiter;
+    ASSERT_EQ(controller.admit(QueryClass::ANALYTIC, waiter), RC::QUERY_QUEUE_TIMEOUT);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    ASSERT_EQ(controller.rejected(), 1);
+    ASSERT_EQ(controller.queued(QueryClass::ANALYTIC), 0);
+  }
+
+  // 内存预算不够初始分配时也要排队
+  options.analytic_slots = 0;
+  options.memory_budget = options.initial_grant;
+  AdmissionController memory_controller(options);
+  {
+    AdmissionTicket running;
+    ASSERT_EQ(memory_controller.admit(QueryClass::ANALYTIC, running), RC::SUCCESS);
+    ASSERT_EQ(memory_controller.memory_reserved(), options.initial_grant);
+
+    AdmissionTicket waiter;
+    ASSERT_EQ(memory_controller.admit(QueryClass::ANALYTIC, waiter), RC::QUERY_QUEUE_TIMEOUT);
+    ASSERT_EQ(memory_controller.rejected(), 1);
+  }
+  ASSERT_EQ(memory_controller.memory_reserved(), 0);
+  ASSERT_EQ(controller.memory_reserved(), 0);
+}
+
+TEST(test_admission_controller, chunked_grow)
+{
+  AdmissionController::Options options;
+  options.memory_budget = 2 * CHUNK + 100;
+  options.query_memory_limit = 4 * CHUNK;
+  options.initial_grant = 0;
+  AdmissionController controller(options);
+
+  {
+    AdmissionTicket ticket;
+    ASSERT_EQ(controller.admit(QueryClass::ANALYTIC, ticket), RC::SUCCESS);
+    MemoryReservation *reservation = ticket.memory_reservation();
+    ASSERT_NE(reservation, nullptr);
+    ASSERT_EQ(controller.memory_reserved(), 0);
+
+    // 按块从全局预算申请，块内的申请不再访问全局预算
+    ASSERT_TRUE(reservation->reserve(1));
+    ASSERT_EQ(reservation->granted(), CHUNK);
+    ASSERT_EQ(controller.memory_reserved(), CHUNK);
+    ASSERT_TRUE(reservation->reserve(CHUNK - 1));
+    ASSERT_EQ(controller.memory_reserved(), CHUNK);
+
+    ASSERT_TRUE(reservation->reserve(CHUNK));
+    ASSERT_EQ(controller.memory_reserved(), 2 * CHUNK);
+
+    // 全局预算不够一整块时只申请需要的部分
+    ASSERT_TRUE(reservation->reserve(60));
+    ASSERT_EQ(reservation->granted(), 2 * CHUNK + 60);
+    ASSERT_EQ(controller.memory_reserved(), 2 * CHUNK + 60);
+    ASSERT_FALSE(reservation->reserve(41));
+    ASSERT_TRUE(reservation->reserve(40));
+    ASSERT_EQ(controller.memory_reserved(), options.memory_budget);
+    ASSERT_EQ(reservation->used(), options.memory_budget);
+
+    // 归还的内存可以再次使用，但是直到查询结束才还给全局预算
+    reservation->release(CHUNK);
+    ASSERT_EQ(reservation->used(), CHUNK + 100);
+    ASSERT_EQ(controller.memory_reserved(), options.memory_budget);
+    ASSERT_TRUE(reservation->reserve(CHUNK));
+    ASSERT_EQ(reservation->peak(), options.memory_budget);
+  }
+  ASSERT_EQ(controller.memory_reserved(), 0);
+
+  // 单个查询的上限
+  options.memory_budget = 16 * CHUNK;
+  options.query_memory_limit = CHUNK + 10;
+  AdmissionController limit_controller(options);
+  {
+    AdmissionTicket ticket;
+    ASSERT_EQ(limit_controller.admit(QueryClass::ANALYTIC, ticket), RC::SUCCESS);
+    MemoryReservation *reservation = ticket.memory_reservation();
+    ASSERT_TRUE(reservation->reserve(CHUNK + 1));
+    ASSERT_EQ(reservation->granted(), CHUNK + 10);
+    ASSERT_FALSE(reservation->reserve(10));
+    ASSERT_TRUE(reservation->reserve(9));
+    ASSERT_EQ(limit_controller.memory_reserved(), CHUNK + 10);
+  }
+  ASSERT_EQ(limit_controller.memory_reserved(), 0);
+  ASSERT_EQ(limit_controller.rejected(), 0);
+}
@@ -0,0 +1,166 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/log/async_log.h"
+#include "gtest/gtest.h"
+
+using namespace common;
+
+static const size_t BUFFER_SIZE = 4096;
+
+/**
+ * @brief 收集写出的日志。打开 gate 之前写出的线程会一直等待，模拟写日志文件很慢
+ */
+class LogCollector
+{
+public:
+  LogCollector() : gate_(open_.get_future().share()) {}
+
+  AsyncLogWriter::WriteFunc write_func()
+  {
+    return [this](const std::string &batch) {
+      gate_.wait();
+      std::lock_guard<std::mutex> guard(lock_);
+      output_ += batch;
+    };
+  }
+
+  void open() { open_.set_value(); }
+
+  std::vector<std::string> lines()
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    std::vector<std::string> result;
+    size_t start = 0;
+    for (size_t end = output_.find('\n'); end != std::string::npos; end = output_.find('\n', start)) {
+      result.push_back(output_.substr(start, end - start));
+      start = end + 1;
+    }
+    return result;
+  }
+
+private:
+  std::promise<void>       open_;
+  std::shared_future<void> gate_;
+  std::mutex               lock_;
+  std::string              output_;
+};
+
+/**
+ * @brief 长度是100字节的日志，包含线程和序号
+ */
+static std::string make_line(int thread, int seq)
+{
+  std::string line = "thread " + std::to_string(thread) + " line " + std::to_string(seq) + " ";
+  line.resize(99, 'x');
+  line.push_back('\n');
+  return line;
+}
+
+static void append_lines(AsyncLogWriter &writer, int thread, int count)
+{
+  for (int i = 0; i < count; i++) {
+    const std::string line = make_line(thread, i);
+    writer.append(line.data(), line.size());
+  }
+}
+
+TEST(test_async_log, overflow_drop)
+{
+  LogCollector collector;
+  AsyncLogWriter writer(BUFFER_SIZE, LOG_OVERFLOW_DROP, 10, collector.write_func());
+  writer.start();
+
+  // 后台线程卡在写文件上，缓存写满之后直接丢弃，不会阻塞写日志的线程
+  const int count = 200;
+  append_lines(writer, 0, count);
+  const uint64_t dropped = writer.dropped_lines();
+  ASSERT_GT(dropped, 0);
+  ASSERT_LT(dropped, count);
+
+  collector.open();
+  writer.stop();
+
+  // 没有丢弃的日志保持顺序，最后记录丢弃的条数
+  std::vector<std::string> lines = collector.lines();
+  ASSERT_EQ(lines.size(), count - dropped + 1);
+  int last_seq = -1;
+  for (size_t i = 0; i + 1 < lines.size(); i++) {
+    int seq = -1;
+    ASSERT_EQ(sscanf(lines[i].c_str(), "thread 0 line %d ", &seq), 1);
+    ASSERT_GT(seq, last_seq);
+    last_seq = seq;
+  }
+  ASSERT_EQ(lines.back(),
+      "[async log] " + std::to_string(dropped) + " log lines dropped because the log buffer is full");
+}
+
+TEST(test_async_log, overflow_block)
+{
+  LogCollector collector;
+  AsyncLogWriter writer(BUFFER_SIZE, LOG_OVERFLOW_BLOCK, 10, collector.write_func());
+  writer.start();
+
+  // 写入的数据远远超过缓存大小，后台线程写出之前写日志的线程一直等待
+  const int count = 200;
+  std::atomic<bool> finished{false};
+  std::thread producer([&]() {
+    append_lines(writer, 0, count);
+    finished = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(finished);
+
+  collector.open();
+  producer.join();
+  writer.stop();
+
+  ASSERT_EQ(writer.dropped_lines(), 0);
+  std::vector<std::string> lines = collector.lines();
+  ASSERT_EQ(lines.size(), count);
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(lines[i] + "\n", make_line(0, i));
+  }
+}
+
+TEST(test_async_log, drain_on_thread_exit)
+{
+  LogCollector collector;
+  collector.open();
+  AsyncLogWriter writer(BUFFER_SIZE, LOG_OVERFLOW_BLOCK, 100000, collector.write_func());
+  writer.start();
+
+  // 线程退出之后缓存中剩下的日志仍然会写出去，每个线程的日志保持顺序
+  const int thread_num = 4;
+  const int count = 30;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back(append_lines, std::ref(writer), t, count);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  writer.flush();
+  std::vector<std::string> lines = collector.lines();
+  ASSERT_EQ(lines.size(), thread_num * count);
+  std::vector<int> next_seq(thread_num, 0);
+  for (const std::string &line : lines) {
+    int thread = -1;
+    int seq = -1;
+    ASSERT_EQ(sscanf(line.c_str(), "thread %d line %d ", &thread, &seq), 2);
+    ASSERT_EQ(seq, next_seq[thread]++);
+  }
+
+  // 已经退出的线程的缓存读取完之后释放，不会重复写出
+  writer.flush();
+  writer.stop();
+  ASSERT_EQ(collector.lines().size(), thread_num * count);
+  ASSERT_EQ(writer.dropped_lines(), 0);
+}
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <fcntl.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "include/common/rc.h"
+#include "include/session/buffer_chain.h"
+#include "include/session/buffered_writer.h"
+#include "gtest/gtest.h"
+
+/**
+ * 使用非阻塞的socketpair，发送缓存设置得很小，writev只能写出一部分数据
+ */
+class BufferChainTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_), 0);
+    int size = 4096;
+    setsockopt(fds_[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    setsockopt(fds_[1], SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    fcntl(fds_[0], F_SETFL, fcntl(fds_[0], F_GETFL) | O_NONBLOCK);
+    fcntl(fds_[1], F_SETFL, fcntl(fds_[1], F_GETFL) | O_NONBLOCK);
+  }
+
+  void TearDown() override
+  {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  std::string read_all()
+  {
+    std::string data;
+    char buf[8192];
+    ssize_t len = 0;
+    while ((len = ::read(fds_[1], buf, sizeof(buf))) > 0) {
+      data.append(buf, len);
+    }
+    return data;
+  }
+
+  int fds_[2] = {-1, -1};
+};
+
+static std::string make_data(int size, int seed)
+{
+  std::string data(size, 0);
+  for (int i = 0; i < size; i++) {
+    data[i] = static_cast<char>('a' + (i * 7 + seed) % 26);
+  }
+  return data;
+}
+
+TEST_F(BufferChainTest, partial_writev)
+{
+  BufferChain chain(1000);
+  const std::string data = make_data(100 * 1000 + 123, 0);
+  chain.append(data.data(), 300);
+  chain.append(data.data() + 300, data.size() - 300);
+  ASSERT_EQ(chain.size(), data.size());
+
+  // 对端不接收时只能写出一部分，剩下的数据从中间的某个块继续写
+  int64_t write_size = 0;
+  ASSERT_EQ(chain.write_to(fds_[0], write_size), RC::SUCCESS);
+  ASSERT_GT(write_size, 0);
+  ASSERT_LT(write_size, data.size());
+  ASSERT_EQ(chain.size(), data.size() - write_size);
+
+  std::string received;
+  int64_t total = write_size;
+  while (!chain.empty()) {
+    received += read_all();
+    ASSERT_EQ(chain.write_to(fds_[0], write_size), RC::SUCCESS);
+    total += write_size;
+    ASSERT_EQ(chain.size(), data.size() - total);
+  }
+  received += read_all();
+  ASSERT_EQ(received, data);
+}
+
+TEST_F(BufferChainTest, block_reuse)
+{
+  BufferChain chain(64);
+  int64_t write_size = 0;
+
+  // 写完之后留下的备用块再次使用时，从块的开头开始存放数据
+  for (int round = 0; round < 10; round++) {
+    const std::string data = make_data(64 * round + 10, round);
+    chain.append(data.data(), data.size());
+    ASSERT_EQ(chain.write_to(fds_[0], write_size), RC::SUCCESS);
+    ASSERT_EQ(write_size, data.size());
+    ASSERT_TRUE(chain.empty());
+    ASSERT_EQ(read_all(), data);
+  }
+
+  // 第一个块写出一部分之后，继续在最后一个块追加
+  const std::string data = make_data(50, 100);
+  chain.append(data.data(), 20);
+  ASSERT_EQ(chain.write_to(fds_[0], write_size), RC::SUCCESS);
+  chain.append(data.data() + 20, 30);
+  ASSERT_EQ(chain.write_to(fds_[0], write_size), RC::SUCCESS);
+  ASSERT_EQ(read_all(), data);
+
+  // clear 丢弃所有数据，之后仍然可以使用
+  chain.append(data.data(), data.size());
+  chain.clear();
+  ASSERT_TRUE(chain.empty());
+  chain.append(data.data(), 10);
+  ASSERT_EQ(chain.write_to(fds_[0], write_size), RC::SUCCESS);
+  ASSERT_EQ(read_all(), data.substr(0, 10));
+}
+
+TEST_F(BufferChainTest, write_stall_timeout)
+{
+  BufferedWriter writer(fds_[0], 16 * 1024);
+  writer.set_write_timeout(200);
+
+  // 对端一直不接收数据，超过高水位之后等待，超时返回错误而不是一直阻塞
+  const std::string data = make_data(64 * 1024, 0);
+  auto start = std::chrono::steady_clock::now();
+  int32_t write_size = 0;
+  RC rc = writer.write(data.data(), data.size(), write_size);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_EQ(rc, RC::IOERR_WRITE);
+  ASSERT_GE(elapsed, std::chrono::milliseconds(200));
+  ASSERT_LT(elapsed, std::chrono::seconds(5));
+
+  // 对端接收之后可以继续写出
+  std::string received = read_all();
+  writer.set_deferred_flush(true);
+  bool drained = false;
+  while (!drained) {
+    ASSERT_EQ(writer.flush_pending(drained), RC::SUCCESS);
+    received += read_all();
+  }
+  ASSERT_EQ(received, data);
+  writer.set_deferred_flush(false);
+}
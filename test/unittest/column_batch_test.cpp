@@ -0,0 +1,143 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/structor/tuple/tuple.h"
+#include "include/query_engine/structor/tuple/values_tuple.h"
+#include "include/session/column_batch.h"
+#include "gtest/gtest.h"
+
+using namespace binary_result;
+
+static RC append_row(ColumnBatch &batch, const std::vector<Value> &cells)
+{
+  ValueListTuple tuple;
+  tuple.set_cells(cells);
+  return batch.append(tuple);
+}
+
+static Value null_value()
+{
+  Value value;
+  value.set_null();
+  return value;
+}
+
+static Value date_value(int date)
+{
+  Value value;
+  value.set_date(date);
+  return value;
+}
+
+static bool is_null(const char *nulls, int row)
+{
+  return (nulls[row / 8] >> (row % 8)) & 1;
+}
+
+TEST(test_column_batch, column_type_of)
+{
+  ASSERT_EQ(column_type_of(INTS), COLUMN_INT32);
+  ASSERT_EQ(column_type_of(FLOATS), COLUMN_FLOAT32);
+  ASSERT_EQ(column_type_of(BOOLEANS), COLUMN_BOOL);
+  ASSERT_EQ(column_type_of(DATES), COLUMN_DATE);
+  ASSERT_EQ(column_type_of(CHARS), COLUMN_STRING);
+  ASSERT_EQ(column_type_of(TEXTS), COLUMN_STRING);
+
+  // 不知道类型的列(比如SHOW TABLES)当做字符串
+  ASSERT_EQ(column_type_of(UNDEFINED), COLUMN_STRING);
+}
+
+TEST(test_column_batch, encode)
+{
+  const std::vector<ColumnType> types = {COLUMN_INT32, COLUMN_FLOAT32, COLUMN_DATE, COLUMN_STRING};
+  ColumnBatch batch(types);
+
+  // 第一行全是NULL，列的类型不受影响
+  ASSERT_EQ(append_row(batch, {null_value(), null_value(), null_value(), null_value()}), RC::SUCCESS);
+  ASSERT_EQ(append_row(batch, {Value(7), Value(1.5f), date_value(20240229), Value("abc")}), RC::SUCCESS);
+  ASSERT_EQ(append_row(batch, {Value(-3), null_value(), date_value(19700101), Value("")}), RC::SUCCESS);
+  ASSERT_EQ(batch.rows(), 3);
+
+  std::string frames;
+  batch.encode(frames);
+  ASSERT_EQ(batch.rows(), 0);
+
+  ASSERT_EQ(frames[0], FRAME_BATCH);
+  ASSERT_EQ(get_u32(frames.data() + 1), frames.size() - FRAME_HEADER_SIZE);
+  const char *p = frames.data() + FRAME_HEADER_SIZE;
+  ASSERT_EQ(get_u32(p), 3);
+  p += 4;
+
+  // INT32
+  ASSERT_EQ(p[0], 0b001);
+  p += 1;
+  int32_t ints[3];
+  memcpy(ints, p, sizeof(ints));
+  p += sizeof(ints);
+  ASSERT_EQ(ints[1], 7);
+  ASSERT_EQ(ints[2], -3);
+
+  // FLOAT32
+  ASSERT_TRUE(is_null(p, 0));
+  ASSERT_FALSE(is_null(p, 1));
+  ASSERT_TRUE(is_null(p, 2));
+  p += 1;
+  float floats[3];
+  memcpy(floats, p, sizeof(floats));
+  p += sizeof(floats);
+  ASSERT_EQ(floats[1], 1.5f);
+
+  // DATE
+  ASSERT_EQ(p[0], 0b001);
+  p += 1;
+  int32_t dates[3];
+  memcpy(dates, p, sizeof(dates));
+  p += sizeof(dates);
+  ASSERT_EQ(dates[1], 20240229);
+  ASSERT_EQ(dates[2], 19700101);
+
+  // STRING: NULL和空字符串通过位图区分
+  ASSERT_EQ(p[0], 0b001);
+  p += 1;
+  uint32_t offsets[4];
+  memcpy(offsets, p, sizeof(offsets));
+  p += sizeof(offsets);
+  ASSERT_EQ(offsets[0], 0);
+  ASSERT_EQ(offsets[1], 0);
+  ASSERT_EQ(offsets[2], 3);
+  ASSERT_EQ(offsets[3], 3);
+  ASSERT_EQ(std::string(p, 3), "abc");
+  p += 3;
+  ASSERT_EQ(p, frames.data() + frames.size());
+}
+
+TEST(test_column_batch, type_mismatch)
+{
+  const std::vector<ColumnType> types = {COLUMN_INT32, COLUMN_STRING};
+  ColumnBatch batch(types);
+  ASSERT_EQ(append_row(batch, {Value(1), Value("a")}), RC::SUCCESS);
+
+  // 定长列不会把其他类型的值转换之后保存，出错的行不会追加
+  ASSERT_EQ(append_row(batch, {Value(2.5f), Value("b")}), RC::SCHEMA_FIELD_TYPE_MISMATCH);
+  ASSERT_EQ(append_row(batch, {Value("3"), Value("c")}), RC::SCHEMA_FIELD_TYPE_MISMATCH);
+  ASSERT_EQ(batch.rows(), 1);
+
+  // 字符串列接受任何类型的值
+  ASSERT_EQ(append_row(batch, {Value(4), Value(4)}), RC::SUCCESS);
+  ASSERT_EQ(batch.rows(), 2);
+
+  std::string frames;
+  batch.encode(frames);
+  const char *p = frames.data() + FRAME_HEADER_SIZE + 4;
+  int32_t ints[2];
+  memcpy(ints, p + 1, sizeof(ints));
+  ASSERT_EQ(ints[0], 1);
+  ASSERT_EQ(ints[1], 4);
+  p += 1 + sizeof(ints);
+  uint32_t offsets[3];
+  memcpy(offsets, p + 1, sizeof(offsets));
+  p += 1 + sizeof(offsets);
+  ASSERT_EQ(std::string(p, offsets[2]), "a4");
+}
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/metrics/hdr_histogram.h"
+#include "gtest/gtest.h"
+
+using namespace common;
+
+static HdrHistogramSnapshot *take_snapshot(HdrHistogram &histogram)
+{
+  histogram.snapshot();
+  return static_cast<HdrHistogramSnapshot *>(histogram.get_snapshot());
+}
+
+/**
+ * @brief 与排序之后的原始数据比较，分位数不小于真实值，并且相对误差不超过 1/64
+ */
+static void check_quantiles(const HdrHistogramSnapshot &snapshot, std::vector<long> values)
+{
+  std::sort(values.begin(), values.end());
+  for (double q : {0.0, 0.001, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999, 1.0}) {
+    const long rank = std::max(1L, static_cast<long>(std::ceil(q * values.size())));
+    const double exact = values[rank - 1];
+    const double result = snapshot.quantile(q);
+    ASSERT_GE(result, exact) << "quantile " << q;
+    ASSERT_LE(result - exact, exact / 64) << "quantile " << q;
+  }
+}
+
+TEST(test_hdr_histogram, bucket_boundary)
+{
+  // 每个桶的上界落在这个桶里，上界加一落在下一个桶里，桶的宽度不超过上界的 1/64
+  long lowest = 0;
+  for (int i = 0; i < HdrHistogram::bucket_count(); i++) {
+    const long highest = HdrHistogram::bucket_highest_units(i);
+    ASSERT_EQ(HdrHistogram::bucket_index(lowest), i);
+    ASSERT_EQ(HdrHistogram::bucket_index(highest), i);
+    if (i >= 128) {
+      ASSERT_LE(highest - lowest + 1, highest / 64);
+    }
+    lowest = highest + 1;
+  }
+  ASSERT_EQ(lowest, 1L << HdrHistogram::MAX_VALUE_BITS);
+}
+
+TEST(test_hdr_histogram, quantile_error)
+{
+  HdrHistogram linear;
+  std::vector<long> linear_values;
+  for (long i = 1; i <= 100000; i++) {
+    linear.update(i);
+    linear_values.push_back(i);
+  }
+  check_quantiles(*take_snapshot(linear), linear_values);
+
+  // 长尾分布，跨越很多个2的幂区间
+  std::mt19937 random(42);
+  std::lognormal_distribution<double> distribution(6, 2);
+  HdrHistogram skewed;
+  std::vector<long> skewed_values;
+  for (int i = 0; i < 200000; i++) {
+    const long value = std::llround(distribution(random));
+    skewed.update(value);
+    skewed_values.push_back(value);
+  }
+  check_quantiles(*take_snapshot(skewed), skewed_values);
+
+  // 小于128的值每个值一个桶，分位数是准确的
+  HdrHistogram small;
+  for (int i = 0; i < 100; i++) {
+    small.update(i % 10);
+  }
+  HdrHistogramSnapshot *snapshot = take_snapshot(small);
+  ASSERT_EQ(snapshot->quantile(0.5), 4);
+  ASSERT_EQ(snapshot->quantile(0.95), 9);
+  ASSERT_EQ(snapshot->count_below_power_of_two(2), 40);
+}
+
+TEST(test_hdr_histogram, min_max)
+{
+  HdrHistogram empty(0.001);
+  HdrHistogramSnapshot *snapshot = take_snapshot(empty);
+  ASSERT_EQ(snapshot->count(), 0);
+  ASSERT_EQ(snapshot->min(), 0);
+  ASSERT_EQ(snapshot->max(), 0);
+  ASSERT_EQ(snapshot->quantile(0.99), 0);
+
+  // 以毫秒记录、精确到微秒，最大值和最小值不受桶宽度的影响
+  HdrHistogram histogram(0.001);
+  histogram.update(12.345);
+  histogram.update(987.654);
+  histogram.update(100.0);
+  histogram.update(0.0001);
+  snapshot = take_snapshot(histogram);
+  ASSERT_EQ(snapshot->count(), 4);
+  ASSERT_DOUBLE_EQ(snapshot->min(), 0);
+  ASSERT_DOUBLE_EQ(snapshot->max(), 987.654);
+  ASSERT_DOUBLE_EQ(snapshot->quantile(1), 987.654);
+  ASSERT_NEAR(snapshot->sum(), 12.345 + 987.654 + 100.0, 1e-9);
+
+  // 分位数不会超出最小值和最大值
+  HdrHistogram single;
+  single.update(1000003);
+  snapshot = take_snapshot(single);
+  ASSERT_EQ(snapshot->quantile(0), 1000003);
+  ASSERT_EQ(snapshot->quantile(0.5), 1000003);
+  ASSERT_EQ(snapshot->min(), 1000003);
+
+  // 超出范围的值放在最后一个桶中
+  HdrHistogram overflow;
+  overflow.update(std::ldexp(1.0, HdrHistogram::MAX_VALUE_BITS + 3));
+  snapshot = take_snapshot(overflow);
+  ASSERT_EQ(snapshot->max(), (1L << HdrHistogram::MAX_VALUE_BITS) - 1);
+}
+
+TEST(test_hdr_histogram, shard_merge)
+{
+  // 线程数比分片多，有的分片由多个线程写入
+  const int thread_num = HdrHistogram::SHARD_NUM * 2;
+  const int count = 20000;
+  HdrHistogram sharded;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&sharded, t]() {
+      for (int i = 0; i < count; i++) {
+        sharded.update(t * 1000 + i % 5000 + 1);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  HdrHistogram single;
+  std::vector<long> values;
+  for (int t = 0; t < thread_num; t++) {
+    for (int i = 0; i < count; i++) {
+      values.push_back(t * 1000 + i % 5000 + 1);
+      single.update(values.back());
+    }
+  }
+
+  // 合并之后与单线程记录的结果完全一致
+  HdrHistogramSnapshot *merged = take_snapshot(sharded);
+  HdrHistogramSnapshot *expected = take_snapshot(single);
+  ASSERT_EQ(merged->count(), static_cast<long>(values.size()));
+  ASSERT_EQ(merged->sum(), expected->sum());
+  ASSERT_EQ(merged->min(), 1);
+  ASSERT_EQ(merged->max(), (thread_num - 1) * 1000 + 5000);
+  for (double q = 0; q <= 1; q += 0.01) {
+    ASSERT_EQ(merged->quantile(q), expected->quantile(q));
+  }
+  check_quantiles(*merged, values);
+
+  // snapshot 不会清零，之后的数据继续累加
+  sharded.update(1);
+  ASSERT_EQ(take_snapshot(sharded)->count(), static_cast<long>(values.size()) + 1);
+}
@@ -0,0 +1,123 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/compress/lz4_block.h"
+#include "gtest/gtest.h"
+
+using namespace common;
+
+/**
+ * @brief 压缩之后再解压，检查和原始数据一致，返回压缩后的长度
+ */
+static int round_trip(const std::string &data)
+{
+  std::vector<char> compressed(lz4_compress_bound(data.size()));
+  const int compressed_size = lz4_compress(data.data(), data.size(), compressed.data(), compressed.size());
+  EXPECT_GT(compressed_size, 0);
+  EXPECT_LE(compressed_size, lz4_compress_bound(data.size()));
+
+  std::string decompressed(data.size(), '\0');
+  const int decompressed_size = lz4_decompress(compressed.data(), compressed_size, decompressed.data(), decompressed.size());
+  EXPECT_EQ(decompressed_size, data.size());
+  EXPECT_EQ(decompressed, data);
+  return compressed_size;
+}
+
+static std::string random_bytes(int size, unsigned seed)
+{
+  std::mt19937 random(seed);
+  std::string data(size, '\0');
+  for (char &c : data) {
+    c = static_cast<char>(random());
+  }
+  return data;
+}
+
+TEST(test_lz4_block, empty)
+{
+  // 空的块只有一个token
+  ASSERT_EQ(round_trip(""), 1);
+
+  char dst[1];
+  ASSERT_EQ(lz4_compress("", 0, dst, 0), 0);
+}
+
+TEST(test_lz4_block, short_input)
+{
+  // 少于13个字节时不查找匹配，全部是字面量
+  std::string data;
+  for (int i = 0; i < 32; i++) {
+    round_trip(data);
+    data.push_back(static_cast<char>('a' + i % 3));
+  }
+}
+
+TEST(test_lz4_block, compressible)
+{
+  std::string data;
+  while (data.size() < 64 * 1024) {
+    data += "id|name|score\n" + std::to_string(data.size() % 1000) + "|tdb|99.5\n";
+  }
+  ASSERT_LT(round_trip(data), data.size() / 4);
+
+  // 长度超过15的字面量和匹配需要扩展字节，重复的单个字节是重叠的匹配
+  ASSERT_LT(round_trip(std::string(100000, 'x')), 1000);
+  ASSERT_LT(round_trip(random_bytes(300, 1) + std::string(5000, 'y') + random_bytes(300, 1)), 1000);
+}
+
+TEST(test_lz4_block, incompressible)
+{
+  for (int size : {13, 100, 4096, 65536, 100000}) {
+    const std::string data = random_bytes(size, size);
+    // 不能压缩的数据也不会超过 lz4_compress_bound
+    ASSERT_GE(round_trip(data), size);
+  }
+}
+
+TEST(test_lz4_block, dst_too_small)
+{
+  const std::string data = random_bytes(4096, 7);
+  std::vector<char> compressed(lz4_compress_bound(data.size()));
+  ASSERT_EQ(lz4_compress(data.data(), data.size(), compressed.data(), data.size() / 2), 0);
+
+  const int compressed_size = lz4_compress(data.data(), data.size(), compressed.data(), compressed.size());
+  ASSERT_GT(compressed_size, 0);
+  std::string decompressed(data.size() - 1, '\0');
+  ASSERT_EQ(lz4_decompress(compressed.data(), compressed_size, decompressed.data(), decompressed.size()), -1);
+}
+
+TEST(test_lz4_block, standard_block)
+{
+  // 按照LZ4块格式手工构造：字面量"abc"，偏移量3匹配4个字节，最后5个字节的字面量
+  const char block[] = {0x30, 'a', 'b', 'c', 0x03, 0x00, 0x50, 'b', 'c', 'a', 'b', 'c'};
+  char dst[12];
+  ASSERT_EQ(lz4_decompress(block, sizeof(block), dst, sizeof(dst)), 12);
+  ASSERT_EQ(std::string(dst, 12), "abcabcabcabc");
+}
+
+TEST(test_lz4_block, corrupted_input)
+{
+  char dst[64];
+  // 偏移量为0或者超出已经解压的数据
+  const char zero_offset[] = {0x10, 'a', 0x00, 0x00, 0x00};
+  ASSERT_EQ(lz4_decompress(zero_offset, sizeof(zero_offset), dst, sizeof(dst)), -1);
+  const char far_offset[] = {0x10, 'a', 0x02, 0x00, 0x00};
+  ASSERT_EQ(lz4_decompress(far_offset, sizeof(far_offset), dst, sizeof(dst)), -1);
+
+  // 字面量的长度超过输入
+  const char short_literals[] = {0x50, 'a', 'b'};
+  ASSERT_EQ(lz4_decompress(short_literals, sizeof(short_literals), dst, sizeof(dst)), -1);
+
+  // 截断的压缩数据
+  std::string data;
+  while (data.size() < 4096) {
+    data += "truncated block " + std::to_string(data.size());
+  }
+  std::vector<char> compressed(lz4_compress_bound(data.size()));
+  const int compressed_size = lz4_compress(data.data(), data.size(), compressed.data(), compressed.size());
+  std::string decompressed(data.size(), '\0');
+  for (int size : {1, 2, compressed_size / 2, compressed_size - 1}) {
+    ASSERT_NE(lz4_decompress(compressed.data(), size, decompressed.data(), decompressed.size()), data.size());
+  }
+}
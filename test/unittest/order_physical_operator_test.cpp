@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "include/query_engine/analyzer/statement/orderby_stmt.h"
+#include "include/query_engine/executor/admission_controller.h"
+#include "include/query_engine/planner/operator/order_physical_operator.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/tuple/row_tuple.h"
+#include "include/session/plain_communicator.h"
+#include "include/session/session.h"
+#include "include/session/session_request.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/transaction/trx.h"
+#include "gtest/gtest.h"
+
+/**
+ * 表结构是 (id int, grp int null, name char(8))，id是插入的顺序，grp的取值很少并且有NULL，
+ * 按照grp排序时有很多相同的排序键，用来检查排序是稳定的
+ */
+static const int ROW_NUM = 8000;
+
+/**
+ * @brief 按顺序返回内存中的记录
+ */
+class MemoryScanPhysicalOperator : public PhysicalOperator
+{
+public:
+  MemoryScanPhysicalOperator(const Table *table, std::vector<Record> &records) : records_(records)
+  {
+    tuple_.set_schema(table, table->name(), table->table_meta().field_metas());
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN; }
+
+  RC open(Trx *) override
+  {
+    next_ = 0;
+    return RC::SUCCESS;
+  }
+
+  RC next() override
+  {
+    if (next_ >= records_.size()) {
+      return RC::RECORD_EOF;
+    }
+    tuple_._set_record(&records_[next_++]);
+    return RC::SUCCESS;
+  }
+
+  RC close() override { return RC::SUCCESS; }
+
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  std::vector<Record> &records_;
+  size_t next_ = 0;
+  RowTuple tuple_;
+};
+
+struct TestRow
+{
+  int id;
+  int grp;  ///< -1 表示NULL
+  std::string name;
+};
+
+class OrderPhysicalOperatorTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_EQ(TrxManager::init_global("vacuous"), RC::SUCCESS);
+
+    const AttrInfoSqlNode attributes[] = {
+        {INTS, "id", 4, false},
+        {INTS, "grp", 4, true},
+        {CHARS, "name", 8, false},
+    };
+    table_ = std::make_unique<Table>();
+    ASSERT_EQ(table_->create_system_table(1, "t", 3, attributes, nullptr), RC::SUCCESS);
+
+    std::mt19937 random(20240101);
+    records_.resize(ROW_NUM);
+    for (int i = 0; i < ROW_NUM; i++) {
+      TestRow row{i, static_cast<int>(random() % 20), "n" + std::to_string(random() % 50)};
+      if (i % 7 == 0) {
+        row.grp = -1;
+      }
+      Value values[3] = {Value(row.id), Value(row.grp), Value(row.name.c_str())};
+      if (row.grp < 0) {
+        values[1].set_null();
+      }
+      ASSERT_EQ(table_->make_record(3, values, records_[i]), RC::SUCCESS);
+      records_[i].set_rid(i / 100 + 1, i % 100);
+      rows_.push_back(row);
+    }
+  }
+
+  /**
+   * @brief 执行排序，返回输出的id
+   */
+  std::vector<int> sort(const std::vector<std::pair<const char *, bool>> &keys, size_t &spilled_bytes)
+  {
+    std::vector<std::unique_ptr<FieldExpr>> exprs;
+    std::vector<std::unique_ptr<OrderByUnit>> units;
+    std::vector<OrderByUnit *> order_units;
+    for (const auto &[field_name, asc] : keys) {
+      exprs.emplace_back(new FieldExpr(table_.get(), table_->table_meta().field(field_name)));
+      exprs.back()->set_field_table_alias(table_->name());
+      auto unit = std::make_unique<OrderByUnit>();
+      unit->set_expr(exprs.back().get());
+      unit->set_sort_type(asc);
+      order_units.push_back(unit.get());
+      units.emplace_back(std::move(unit));
+    }
+
+    OrderPhysicalOperator order(std::move(order_units));
+    order.add_child(std::make_unique<MemoryScanPhysicalOperator>(table_.get(), records_));
+
+    const int id_index = table_->table_meta().sys_field_num();
+    std::vector<int> ids;
+    RC rc = order.open(nullptr);
+    EXPECT_EQ(rc, RC::SUCCESS);
+    while (RC_SUCC(rc) && RC_SUCC(rc = order.next())) {
+      Value value;
+      EXPECT_EQ(order.current_tuple()->cell_at(id_index, value), RC::SUCCESS);
+      ids.push_back(value.get_int());
+    }
+    EXPECT_EQ(rc, RC::RECORD_EOF);
+    spilled_bytes = order.spilled_bytes();
+    order.close();
+    return ids;
+  }
+
+  std::unique_ptr<Table> table_;
+  std::vector<Record> records_;
+  std::vector<TestRow> rows_;
+};
+
+TEST_F(OrderPhysicalOperatorTest, spill_matches_memory_sort)
+{
+  // grp升序时NULL在最前面，降序时在最后面；相同的排序键保持输入的顺序
+  std::vector<TestRow> expected_asc = rows_;
+  std::stable_sort(expected_asc.begin(), expected_asc.end(), [](const TestRow &a, const TestRow &b) {
+    return a.grp < b.grp;
+  });
+  std::vector<TestRow> expected_desc = rows_;
+  std::stable_sort(expected_desc.begin(), expected_desc.end(), [](const TestRow &a, const TestRow &b) {
+    return a.grp != b.grp ? a.grp > b.grp : a.name < b.name;
+  });
+  auto ids_of = [](const std::vector<TestRow> &rows) {
+    std::vector<int> ids;
+    for (const TestRow &row : rows) {
+      ids.push_back(row.id);
+    }
+    return ids;
+  };
+
+  const std::vector<std::pair<const char *, bool>> asc_keys = {{"grp", true}};
+  const std::vector<std::pair<const char *, bool>> desc_keys = {{"grp", false}, {"name", true}};
+
+  // 没有内存预留时全部在内存中排序
+  size_t spilled_bytes = 0;
+  ASSERT_EQ(sort(asc_keys, spilled_bytes), ids_of(expected_asc));
+  ASSERT_EQ(spilled_bytes, 0);
+  ASSERT_EQ(sort(desc_keys, spilled_bytes), ids_of(expected_desc));
+  ASSERT_EQ(spilled_bytes, 0);
+
+  // 单个查询只能使用64KB，准入时不预先分配内存，数据会分成很多有序段溢出到磁盘，并且需要提前归并
+  AdmissionController::Options options;
+  options.memory_budget = 1024 * 1024;
+  options.query_memory_limit = 64 * 1024;
+  options.initial_grant = 0;
+  AdmissionController controller(options);
+
+  PlainCommunicator communicator;
+  SessionRequest request(&communicator);
+  Session session;
+  session.set_current_request(&request);
+  Session::set_current_session(&session);
+
+  {
+    AdmissionTicket ticket;
+    ASSERT_EQ(controller.admit(QueryClass::ANALYTIC, ticket), RC::SUCCESS);
+    request.set_memory_reservation(ticket.memory_reservation());
+
+    ASSERT_EQ(sort(asc_keys, spilled_bytes), ids_of(expected_asc));
+    ASSERT_GT(spilled_bytes, 0);
+    ASSERT_EQ(sort(desc_keys, spilled_bytes), ids_of(expected_desc));
+    ASSERT_GT(spilled_bytes, 0);
+
+    // 排序结束之后归还了使用的内存
+    ASSERT_EQ(ticket.memory_reservation()->used(), 0);
+    ASSERT_LE(ticket.memory_reservation()->peak(), options.query_memory_limit);
+    request.set_memory_reservation(nullptr);
+  }
+  ASSERT_EQ(controller.memory_reserved(), 0);
+
+  session.set_current_request(nullptr);
+  Session::set_current_session(nullptr);
+}
@@ -0,0 +1,137 @@
+#include <filesystem>
+
+#include "include/common/rc.h"
+#include "include/query_engine/executor/query_cache.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/schema/database.h"
+#include "include/storage_engine/transaction/trx.h"
+#include "gtest/gtest.h"
+
+/**
+ * 没有涉及任何表的缓存项，只测试容量和LRU淘汰，不需要Db
+ */
+static void put_result(QueryCache &cache, const std::string &key, size_t size)
+{
+  cache.put(key, {}, std::string(size, 'x'));
+}
+
+TEST(test_query_cache, make_key)
+{
+  // 合并引号之外的空白，去掉结尾的分号，引号中的内容保持不变
+  ASSERT_EQ(QueryCache::make_key("sys", "select  *\n from t ;"), QueryCache::make_key("sys", "select * from t"));
+  ASSERT_NE(QueryCache::make_key("sys", "select 'a  b'"), QueryCache::make_key("sys", "select 'a b'"));
+
+  // 不同的数据库和参数是不同的缓存项
+  ASSERT_NE(QueryCache::make_key("sys", "select * from t"), QueryCache::make_key("db1", "select * from t"));
+  ASSERT_NE(QueryCache::make_key("sys", "select * from t", "plain:text"),
+      QueryCache::make_key("sys", "select * from t", "mysql:text"));
+
+  // 只缓存SELECT
+  ASSERT_TRUE(QueryCache::make_key("sys", "insert into t values(1)").empty());
+  ASSERT_TRUE(QueryCache::make_key("sys", "selectx").empty());
+}
+
+TEST(test_query_cache, lru_eviction)
+{
+  QueryCache cache(1000);
+  std::string result;
+
+  put_result(cache, "a", 200);
+  put_result(cache, "b", 200);
+  put_result(cache, "c", 200);
+  put_result(cache, "d", 200);
+  put_result(cache, "e", 200);
+  ASSERT_EQ(cache.size(), 1000);
+  ASSERT_EQ(cache.entry_count(), 5);
+
+  // 没有Db时不能校验版本号，当做过期处理
+  Db *no_db = nullptr;
+  ASSERT_FALSE(cache.get("a", no_db, result));
+  ASSERT_EQ(cache.entry_count(), 4);
+
+  // 重新写入a之后，最久没有使用的是b
+  put_result(cache, "a", 200);
+  put_result(cache, "f", 200);  // 淘汰b
+  ASSERT_EQ(cache.evictions(), 1);
+  ASSERT_EQ(cache.entry_count(), 5);
+
+  put_result(cache, "g", 250);  // 淘汰c和d
+  ASSERT_EQ(cache.evictions(), 3);
+  ASSERT_EQ(cache.size(), 200 * 3 + 250);
+
+  // 同一个key再次写入时替换原来的结果
+  put_result(cache, "g", 100);
+  ASSERT_EQ(cache.size(), 200 * 3 + 100);
+  ASSERT_EQ(cache.entry_count(), 4);
+}
+
+TEST(test_query_cache, capacity_limit)
+{
+  QueryCache cache(1000);
+
+  // 超过容量1/4的结果不缓存
+  put_result(cache, "big", 251);
+  ASSERT_EQ(cache.entry_count(), 0);
+  ASSERT_EQ(cache.size(), 0);
+
+  put_result(cache, "limit", 250);
+  ASSERT_EQ(cache.entry_count(), 1);
+  ASSERT_EQ(cache.size(), 250);
+
+  // 不缓存的大结果也不会挤掉已有的缓存项
+  put_result(cache, "limit", 1000);
+  ASSERT_EQ(cache.entry_count(), 1);
+  ASSERT_EQ(cache.evictions(), 0);
+}
+
+TEST(test_query_cache, version_invalidation)
+{
+  const char *db_path = "query_cache_test_db";
+  std::filesystem::remove_all(db_path);
+  std::filesystem::create_directory(db_path);
+
+  BufferPoolManager bpm;
+  BufferPoolManager::set_instance(&bpm);
+  ASSERT_EQ(TrxManager::init_global("vacuous"), RC::SUCCESS);
+
+  {
+    Db db;
+    ASSERT_EQ(db.init("test", db_path), RC::SUCCESS);
+    const AttrInfoSqlNode attributes[] = {{INTS, "id", 4, false}};
+    ASSERT_EQ(db.create_table("t1", 1, attributes), RC::SUCCESS);
+    ASSERT_EQ(db.create_table("t2", 1, attributes), RC::SUCCESS);
+    Table *t1 = db.find_table("t1");
+    Table *t2 = db.find_table("t2");
+
+    QueryCache cache(1 << 20);
+    std::vector<std::pair<std::string, uint64_t>> table_versions;
+    QueryCache::collect_table_versions({t1, t2}, &db, table_versions);
+    cache.put("q", std::move(table_versions), "result");
+
+    std::string result;
+    ASSERT_TRUE(cache.get("q", &db, result));
+    ASSERT_EQ(result, "result");
+    ASSERT_EQ(cache.hits(), 1);
+
+    // 修改查询涉及的任何一个表，缓存项都会过期
+    Value value(1);
+    Record record;
+    ASSERT_EQ(t2->make_record(1, &value, record), RC::SUCCESS);
+    ASSERT_EQ(t2->insert_record(record), RC::SUCCESS);
+
+    ASSERT_FALSE(cache.get("q", &db, result));
+    ASSERT_EQ(cache.invalidations(), 1);
+    ASSERT_EQ(cache.entry_count(), 0);
+
+    // 重新缓存之后又可以命中
+    table_versions.clear();
+    QueryCache::collect_table_versions({t1, t2}, &db, table_versions);
+    cache.put("q", std::move(table_versions), "result2");
+    ASSERT_TRUE(cache.get("q", &db, result));
+    ASSERT_EQ(result, "result2");
+  }
+
+  BufferPoolManager::set_instance(nullptr);
+  std::filesystem::remove_all(db_path);
+}
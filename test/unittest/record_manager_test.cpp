@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/recorder/record.h"
+#include "include/storage_engine/recorder/record_manager.h"
+#include "gtest/gtest.h"
+
+/**
+ * 记录的内容是记录的编号，重复填满整个记录
+ */
+static const int RECORD_SIZE = 64;
+static const char *DATA_FILE = "record_manager_test.data";
+
+static void make_records(int first, int count, std::vector<char> &data, std::vector<Record> &records)
+{
+  data.assign((size_t)count * RECORD_SIZE, 0);
+  records.resize(count);
+  for (int i = 0; i < count; i++) {
+    char *record_data = data.data() + (size_t)i * RECORD_SIZE;
+    const int id = first + i;
+    for (int offset = 0; offset < RECORD_SIZE; offset += sizeof(id)) {
+      memcpy(record_data + offset, &id, sizeof(id));
+    }
+    records[i].set_data(record_data, RECORD_SIZE);
+  }
+}
+
+static int record_id(RecordFileHandler &handler, const RID &rid, RC &rc)
+{
+  int id = -1;
+  rc = handler.visit_record(rid, true /*readonly*/, [&id](Record &record) { memcpy(&id, record.data(), sizeof(id)); });
+  return id;
+}
+
+class RecordFileHandlerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ::remove(DATA_FILE);
+    ASSERT_EQ(bpm_.create_file(DATA_FILE), RC::SUCCESS);
+    ASSERT_EQ(bpm_.open_file(DATA_FILE, bp_), RC::SUCCESS);
+    ASSERT_EQ(handler_.init(bp_), RC::SUCCESS);
+  }
+
+  void TearDown() override
+  {
+    handler_.close();
+    bpm_.close_file(DATA_FILE);
+    ::remove(DATA_FILE);
+  }
+
+  BufferPoolManager bpm_;
+  FileBufferPool *bp_ = nullptr;
+  RecordFileHandler handler_;
+};
+
+TEST_F(RecordFileHandlerTest, insert_records)
+{
+  const int count = 1000;
+  std::vector<char> data;
+  std::vector<Record> records;
+  make_records(0, count, data, records);
+
+  size_t inserted_count = 0;
+  ASSERT_EQ(handler_.insert_records(records, RECORD_SIZE, inserted_count), RC::SUCCESS);
+  ASSERT_EQ(inserted_count, count);
+
+  // 一个页面填满之后才会换下一个页面，记录在页面中是连续的
+  auto rid_less = [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; };
+  std::set<RID, decltype(rid_less)> rids(rid_less);
+  std::set<PageNum> pages;
+  for (int i = 0; i < count; i++) {
+    const RID &rid = records[i].rid();
+    ASSERT_TRUE(rids.insert(rid).second);
+    if (i > 0 && rid.page_num == records[i - 1].rid().page_num) {
+      ASSERT_EQ(rid.slot_num, records[i - 1].rid().slot_num + 1);
+    } else {
+      ASSERT_TRUE(pages.insert(rid.page_num).second);
+    }
+
+    RC rc = RC::SUCCESS;
+    ASSERT_EQ(record_id(handler_, rid, rc), i);
+    ASSERT_EQ(rc, RC::SUCCESS);
+  }
+  ASSERT_GT(pages.size(), 1);
+
+  // 空的批量插入什么都不做
+  std::vector<Record> empty;
+  ASSERT_EQ(handler_.insert_records(empty, RECORD_SIZE, inserted_count), RC::SUCCESS);
+  ASSERT_EQ(inserted_count, 0);
+}
+
+TEST_F(RecordFileHandlerTest, delete_records)
+{
+  const int count = 1000;
+  std::vector<char> data;
+  std::vector<Record> records;
+  make_records(0, count, data, records);
+  size_t inserted_count = 0;
+  ASSERT_EQ(handler_.insert_records(records, RECORD_SIZE, inserted_count), RC::SUCCESS);
+
+  // 删除编号是偶数的记录
+  std::vector<RID> rids;
+  for (int i = 0; i < count; i += 2) {
+    rids.push_back(records[i].rid());
+  }
+  std::sort(rids.begin(), rids.end(), [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; });
+  size_t deleted_count = 0;
+  ASSERT_EQ(handler_.delete_records(rids, deleted_count), RC::SUCCESS);
+  ASSERT_EQ(deleted_count, rids.size());
+
+  for (int i = 0; i < count; i++) {
+    RC rc = RC::SUCCESS;
+    const int id = record_id(handler_, records[i].rid(), rc);
+    if (i % 2 == 0) {
+      ASSERT_EQ(rc, RC::RECORD_NOT_EXIST);
+    } else {
+      ASSERT_EQ(rc, RC::SUCCESS);
+      ASSERT_EQ(id, i);
+    }
+  }
+
+  // 删除不存在的记录时停止，已经删除的是前面的部分
+  std::vector<RID> retry = {records[1].rid(), records[3].rid(), records[0].rid(), records[5].rid()};
+  ASSERT_EQ(handler_.delete_records(retry, deleted_count), RC::RECORD_NOT_EXIST);
+  ASSERT_EQ(deleted_count, 2);
+  RC rc = RC::SUCCESS;
+  record_id(handler_, records[5].rid(), rc);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  // 删除后空出来的位置可以再次插入
+  std::vector<char> more_data;
+  std::vector<Record> more_records;
+  make_records(count, 100, more_data, more_records);
+  ASSERT_EQ(handler_.insert_records(more_records, RECORD_SIZE, inserted_count), RC::SUCCESS);
+  ASSERT_EQ(inserted_count, 100);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(record_id(handler_, more_records[i].rid(), rc), count + i);
+    ASSERT_EQ(rc, RC::SUCCESS);
+  }
+}
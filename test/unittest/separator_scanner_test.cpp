@@ -0,0 +1,77 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "include/query_engine/executor/separator_scanner.h"
+#include "gtest/gtest.h"
+
+/**
+ * 返回所有分隔符和换行符相对于begin的位置，最后一个总是end
+ */
+static std::vector<long> scan_all(const char *begin, const char *end, char delim, bool use_simd)
+{
+  std::vector<long> positions;
+  SeparatorScanner scanner(begin, end, delim, use_simd);
+  while (true) {
+    const char *pos = scanner.next();
+    positions.push_back(pos - begin);
+    if (pos == end) {
+      break;
+    }
+  }
+  return positions;
+}
+
+static std::vector<long> expected_positions(const std::string &data, char delim)
+{
+  std::vector<long> positions;
+  for (size_t i = 0; i < data.size(); i++) {
+    if (data[i] == delim || data[i] == '\n') {
+      positions.push_back(i);
+    }
+  }
+  positions.push_back(data.size());
+  return positions;
+}
+
+TEST(test_separator_scanner, scalar)
+{
+  const std::string data = "1|abc|2.5\n22|de|3\n\n|||\nlast";
+  ASSERT_EQ(scan_all(data.data(), data.data() + data.size(), '|', false), expected_positions(data, '|'));
+
+  // 空的输入直接返回end
+  ASSERT_EQ(scan_all(data.data(), data.data(), '|', false), std::vector<long>{0});
+}
+
+TEST(test_separator_scanner, simd_matches_scalar)
+{
+  if (!SeparatorScanner::simd_supported()) {
+    GTEST_SKIP() << "AVX2 is not supported";
+  }
+
+  // 随机数据中混合分隔符、换行符和其它字符，覆盖不同的长度和起始地址的对齐方式
+  std::mt19937 random(20240101);
+  const char alphabet[] = "||\n\nabcdefgh,;0123456789 \t\xff\x80";
+  std::uniform_int_distribution<int> char_dist(0, sizeof(alphabet) - 2);
+  std::string buffer(4096 + 64, '\0');
+  for (char &c : buffer) {
+    c = alphabet[char_dist(random)];
+  }
+
+  for (char delim : {'|', ',', '\t', '\xff'}) {
+    for (size_t offset = 0; offset < 33; offset++) {
+      for (size_t length : {0, 1, 31, 32, 33, 63, 64, 65, 100, 1000, 4096}) {
+        const char *begin = buffer.data() + offset;
+        const char *end = begin + length;
+        const std::vector<long> scalar = scan_all(begin, end, delim, false);
+        ASSERT_EQ(scalar, expected_positions(std::string(begin, end), delim));
+        ASSERT_EQ(scan_all(begin, end, delim, true), scalar)
+            << "delim=" << static_cast<int>(delim) << ", offset=" << offset << ", length=" << length;
+      }
+    }
+  }
+
+  // 没有任何分隔符的长数据
+  const std::string plain(1000, 'x');
+  ASSERT_EQ(scan_all(plain.data(), plain.data() + plain.size(), '|', true), std::vector<long>{1000});
+}